@@ -73,6 +73,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 - Compliance: fixed BARR-C:2018 Rule 1.8b violations
 - dropped CMD_SYNC a tier from EVE3 to EVE2
 - fixed BITMAP_SOURCE to use 24 bit and therefore allow FLASH sources on BT81x
+- fixed BITMAP_TRANSFORM_C and BITMAP_TRANSFORM_F to use 24 bit, these are signed 15.8
 
 */
 
@@ -738,24 +739,24 @@ static inline uint32_t BITMAP_TRANSFORM_E(const uint32_t val)
 
 #endif
 
-//#define BITMAP_TRANSFORM_C(c) ((DL_BITMAP_TRANSFORM_C) | ((c) & 0x1FFFFUL))
+//#define BITMAP_TRANSFORM_C(c) ((DL_BITMAP_TRANSFORM_C) | ((c) & 0xFFFFFFUL))
 /**
  * @brief Set the C coefficient of the bitmap transform matrix.
  * @return a 32 bit word for use with EVE_cmd_dl()
  */
 static inline uint32_t BITMAP_TRANSFORM_C(const uint32_t val)
 {
-    return (DL_BITMAP_TRANSFORM_C | (val & 0x1FFFFUL));
+    return (DL_BITMAP_TRANSFORM_C | (val & 0xFFFFFFUL));
 }
 
-//#define BITMAP_TRANSFORM_F(f) ((DL_BITMAP_TRANSFORM_F) | ((f) & 0x1FFFFUL))
+//#define BITMAP_TRANSFORM_F(f) ((DL_BITMAP_TRANSFORM_F) | ((f) & 0xFFFFFFUL))
 /**
  * @brief Set the F coefficient of the bitmap transform matrix.
  * @return a 32 bit word for use with EVE_cmd_dl()
  */
 static inline uint32_t BITMAP_TRANSFORM_F(const uint32_t val)
 {
-    return (DL_BITMAP_TRANSFORM_F | (val & 0x1FFFFUL));
+    return (DL_BITMAP_TRANSFORM_F | (val & 0xFFFFFFUL));
 }
 
 //#define BLEND_FUNC(src,dst) ((DL_BLEND_FUNC) | (((src) & 7UL) << 3U) | ((dst) & 7UL))
@@ -0,0 +1,521 @@
+/*
+@file    EVE_batch.c
+@brief   deferred drawing that merges BEGIN / END blocks of the same primitive
+@version 1.0
+@date    2026-10-18
+@author  Christian Lara
+
+@section info
+
+Code that draws a few rectangles, lines or points usually wraps every draw in its own
+EVE_begin() / EVE_end() with the state in front of it. The functions here record the draws
+into segments of vertices with the same primitive and state in storage of the caller, and
+EVE_batch_flush() writes them to the display-list:
+- segments with the same primitive share one BEGIN, END is only sent once at the end
+- state is only sent when it differs from the segment before
+- segments that were recorded after EVE_batch_independent(p, 1U) promise not to overlap each other,
+  a run of these is grouped by primitive and state in the order the groups first appear
+
+Strips are never moved and a state change in a strip or between the two vertices of a line
+or rectangle continues it without a new BEGIN.
+When the storage runs full the batch is flushed and recording continues, a strip that was cut
+gets a new BEGIN with the last vertex again and a half line or rectangle is carried over.
+
+Only what was set with the EVE_batch_xxx() functions is sent, the rest is left as the
+display-list has it. Anything drawn directly between the recording and EVE_batch_flush() ends
+up below the batch, the display-list state after the flush is that of the last segment written.
+The functions work in and outside of burst-mode, EVE_batch_flush() uses the generic functions.
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+@section History
+
+1.0
+- initial version
+
+*/
+
+#include "EVE_batch.h"
+
+#ifndef NULL /* define NULL if it not already is */
+#include <stdio.h>
+#endif
+
+#define BATCH_NO_PRIM 0xffU
+
+static uint8_t is_strip(uint8_t const prim)
+{
+    return (((prim >= (uint8_t) EVE_LINE_STRIP) && (prim <= (uint8_t) EVE_EDGE_STRIP_B)) ? 1U : 0U);
+}
+
+static uint8_t is_pair(uint8_t const prim)
+{
+    return (((prim == (uint8_t) EVE_LINES) || (prim == (uint8_t) EVE_RECTS)) ? 1U : 0U);
+}
+
+/* a segment is moved only when it was marked and it is complete on its own */
+static uint8_t is_movable(const EVE_batch_segment_t * const p_seg)
+{
+    uint8_t ret = 0U;
+
+    if (((p_seg->flags & EVE_BATCH_INDEPENDENT) != 0U) && (0U == (p_seg->flags & EVE_BATCH_CONTINUE)) &&
+        (0U == is_strip(p_seg->prim)))
+    {
+        ret = ((0U == is_pair(p_seg->prim)) || (0U == (p_seg->count & 1U))) ? 1U : 0U;
+    }
+    return (ret);
+}
+
+static uint8_t same_group(const EVE_batch_segment_t * const p_a, const EVE_batch_segment_t * const p_b)
+{
+    uint8_t ret = 0U;
+
+    if ((p_a->prim == p_b->prim) && (p_a->set == p_b->set))
+    {
+        ret = 1U;
+        if (((p_a->set & EVE_BATCH_SET_COLOR_RGB) != 0U) && (p_a->color != p_b->color))
+        {
+            ret = 0U;
+        }
+        if (((p_a->set & EVE_BATCH_SET_COLOR_A) != 0U) && (p_a->alpha != p_b->alpha))
+        {
+            ret = 0U;
+        }
+        if (((p_a->set & EVE_BATCH_SET_TAG) != 0U) && (p_a->tag != p_b->tag))
+        {
+            ret = 0U;
+        }
+        if (((p_a->set & (EVE_BATCH_SET_LINE_WIDTH | EVE_BATCH_SET_POINT_SIZE)) != 0U) && (p_a->size != p_b->size))
+        {
+            ret = 0U;
+        }
+    }
+    return (ret);
+}
+
+/* group every run of movable segments, a segment goes behind the last one of its group,
+   the state a segment leaves unset is only ever set by segments that were recorded later
+   and the groups keep that order */
+static void batch_group(EVE_batch_t * const p_batch)
+{
+    EVE_batch_segment_t * const p_seg = p_batch->p_segments;
+    uint16_t start = 0U;
+
+    while (start < p_batch->segments)
+    {
+        uint16_t end = start;
+
+        while ((end < p_batch->segments) && (is_movable(&p_seg[end]) != 0U) &&
+               ((end == start) || (0U == (p_seg[end].flags & EVE_BATCH_RUN_START))))
+        {
+            end++;
+        }
+
+        for (uint16_t index = (uint16_t) (start + 1U); index < end; index++)
+        {
+            uint16_t last = index;
+
+            for (uint16_t search = start; search < index; search++)
+            {
+                if (same_group(&p_seg[search], &p_seg[index]) != 0U)
+                {
+                    last = search;
+                }
+            }
+
+            if ((last != index) && ((last + 1U) != index))
+            {
+                EVE_batch_segment_t const moved = p_seg[index];
+
+                for (uint16_t move = index; move > (last + 1U); move--)
+                {
+                    p_seg[move] = p_seg[move - 1U];
+                }
+                p_seg[last + 1U] = moved;
+            }
+        }
+        start = (end > start) ? end : (uint16_t) (start + 1U);
+    }
+}
+
+/* write the segments to the display-list */
+static uint16_t batch_emit(EVE_batch_t * const p_batch)
+{
+    uint8_t prim = BATCH_NO_PRIM;
+    uint8_t odd = 0U; /* a line or rectangle since the last BEGIN is missing its second vertex */
+    uint8_t known = 0U;
+    uint32_t color = 0U;
+    uint16_t line_width = 0U;
+    uint16_t point_size = 0U;
+    uint8_t alpha = 0U;
+    uint8_t tag = 0U;
+    uint16_t commands = 0U;
+
+    batch_group(p_batch);
+
+    for (uint16_t index = 0U; index < p_batch->segments; index++)
+    {
+        const EVE_batch_segment_t * const p_seg = &p_batch->p_segments[index];
+
+        if (0U == p_seg->count)
+        {
+            continue;
+        }
+
+        if ((p_seg->prim != prim) ||
+            (((is_strip(prim) != 0U) || (odd != 0U)) && (0U == (p_seg->flags & EVE_BATCH_CONTINUE))))
+        {
+            prim = p_seg->prim;
+            odd = 0U;
+            EVE_begin((uint32_t) prim);
+            commands++;
+        }
+
+        if (((p_seg->set & EVE_BATCH_SET_COLOR_RGB) != 0U) &&
+            ((0U == (known & EVE_BATCH_SET_COLOR_RGB)) || (color != p_seg->color)))
+        {
+            color = p_seg->color;
+            EVE_color_rgb(color);
+            commands++;
+        }
+        if (((p_seg->set & EVE_BATCH_SET_COLOR_A) != 0U) &&
+            ((0U == (known & EVE_BATCH_SET_COLOR_A)) || (alpha != p_seg->alpha)))
+        {
+            alpha = p_seg->alpha;
+            EVE_color_a(alpha);
+            commands++;
+        }
+        if (((p_seg->set & EVE_BATCH_SET_TAG) != 0U) &&
+            ((0U == (known & EVE_BATCH_SET_TAG)) || (tag != p_seg->tag)))
+        {
+            tag = p_seg->tag;
+            EVE_tag(tag);
+            commands++;
+        }
+        if (((p_seg->set & EVE_BATCH_SET_LINE_WIDTH) != 0U) &&
+            ((0U == (known & EVE_BATCH_SET_LINE_WIDTH)) || (line_width != p_seg->size)))
+        {
+            line_width = p_seg->size;
+            EVE_line_width(line_width);
+            commands++;
+        }
+        if (((p_seg->set & EVE_BATCH_SET_POINT_SIZE) != 0U) &&
+            ((0U == (known & EVE_BATCH_SET_POINT_SIZE)) || (point_size != p_seg->size)))
+        {
+            point_size = p_seg->size;
+            EVE_point_size(point_size);
+            commands++;
+        }
+        known |= p_seg->set;
+
+        for (uint16_t vertex = 0U; vertex < p_seg->count; vertex++)
+        {
+            EVE_cmd_dl(p_batch->p_vertices[p_seg->first + vertex]);
+        }
+        commands += p_seg->count;
+        if (is_pair(prim) != 0U)
+        {
+            odd ^= (uint8_t) (p_seg->count & 1U);
+        }
+    }
+
+    if (prim != BATCH_NO_PRIM)
+    {
+        EVE_end();
+        commands++;
+    }
+
+    p_batch->segments = 0U;
+    p_batch->vertices = 0U;
+    p_batch->open = 0U;
+    return (commands);
+}
+
+/* start a segment with the current state */
+static void batch_segment(EVE_batch_t * const p_batch)
+{
+    EVE_batch_segment_t * const p_seg = &p_batch->p_segments[p_batch->segments];
+    uint8_t const prim = p_batch->prim;
+
+    p_seg->color = p_batch->color;
+    p_seg->alpha = p_batch->alpha;
+    p_seg->tag = p_batch->tag;
+    p_seg->prim = prim;
+    p_seg->set = p_batch->set & (EVE_BATCH_SET_COLOR_RGB | EVE_BATCH_SET_COLOR_A | EVE_BATCH_SET_TAG);
+    p_seg->size = 0U;
+
+    if ((prim == (uint8_t) EVE_LINES) || (prim == (uint8_t) EVE_LINE_STRIP) || (prim == (uint8_t) EVE_RECTS))
+    {
+        p_seg->set |= p_batch->set & EVE_BATCH_SET_LINE_WIDTH;
+        p_seg->size = p_batch->line_width;
+    }
+    else if (prim == (uint8_t) EVE_POINTS)
+    {
+        p_seg->set |= p_batch->set & EVE_BATCH_SET_POINT_SIZE;
+        p_seg->size = p_batch->point_size;
+    }
+    else
+    {
+        /* bitmaps and edge strips have no size */
+    }
+
+    p_seg->flags = p_batch->flags;
+    if (((is_strip(prim) != 0U) && (p_batch->strip_open != 0U)) || ((is_pair(prim) != 0U) && (p_batch->phase != 0U)))
+    {
+        p_seg->flags |= EVE_BATCH_CONTINUE;
+    }
+    p_seg->first = p_batch->vertices;
+    p_seg->count = 0U;
+    p_batch->flags &= (uint8_t) ~EVE_BATCH_RUN_START;
+
+    p_batch->segments++;
+    p_batch->open = 1U;
+    p_batch->strip_open = is_strip(prim);
+}
+
+/* the storage is full, flush it and carry over what the next vertex still needs */
+static void batch_overflow(EVE_batch_t * const p_batch)
+{
+    uint32_t carry = 0U;
+    uint8_t carried = 0U;
+
+    if (p_batch->segments > 0U)
+    {
+        EVE_batch_segment_t * const p_seg = &p_batch->p_segments[p_batch->segments - 1U];
+
+        if ((p_seg->count > 0U) && (p_seg->prim == p_batch->prim))
+        {
+            if ((is_strip(p_seg->prim) != 0U) && (p_batch->strip_open != 0U))
+            {
+                carry = p_batch->p_vertices[p_seg->first + p_seg->count - 1U]; /* the strip goes on from here */
+                carried = 1U;
+            }
+            else if ((is_pair(p_seg->prim) != 0U) && (p_batch->phase != 0U))
+            {
+                carry = p_batch->p_vertices[p_seg->first + p_seg->count - 1U]; /* the first half of a pair */
+                p_seg->count--;
+                carried = 1U;
+            }
+            else
+            {
+                /* nothing is pending */
+            }
+        }
+    }
+
+    (void) batch_emit(p_batch);
+    p_batch->strip_open = 0U;
+
+    if (carried != 0U)
+    {
+        batch_segment(p_batch);
+        p_batch->p_vertices[p_batch->vertices] = carry;
+        p_batch->vertices++;
+        p_batch->p_segments[p_batch->segments - 1U].count++;
+    }
+}
+
+static void batch_vertex(EVE_batch_t * const p_batch, uint32_t const command)
+{
+    if ((p_batch->vertices >= p_batch->vertices_max) ||
+        ((0U == p_batch->open) && (p_batch->segments >= p_batch->segments_max)))
+    {
+        batch_overflow(p_batch);
+    }
+
+    if (0U == p_batch->open)
+    {
+        batch_segment(p_batch);
+    }
+
+    p_batch->p_vertices[p_batch->vertices] = command;
+    p_batch->vertices++;
+    p_batch->p_segments[p_batch->segments - 1U].count++;
+    p_batch->phase ^= 1U;
+}
+
+/**
+ * @brief Set up a batch with storage of the caller.
+ * @note - At least one segment and two vertices, four bytes per vertex and 16 bytes per segment
+ * can go on the stack as the batch is not needed after EVE_batch_flush().
+ */
+void EVE_batch_init(EVE_batch_t * const p_batch, EVE_batch_segment_t * const p_segments, uint16_t const segments,
+                    uint32_t * const p_vertices, uint16_t const vertices)
+{
+    if ((p_batch != NULL) && (p_segments != NULL) && (p_vertices != NULL) && (segments > 0U) && (vertices > 1U))
+    {
+        p_batch->p_segments = p_segments;
+        p_batch->p_vertices = p_vertices;
+        p_batch->segments_max = segments;
+        p_batch->vertices_max = vertices;
+        p_batch->segments = 0U;
+        p_batch->vertices = 0U;
+        p_batch->color = 0U;
+        p_batch->line_width = 0U;
+        p_batch->point_size = 0U;
+        p_batch->alpha = 0U;
+        p_batch->tag = 0U;
+        p_batch->prim = (uint8_t) EVE_POINTS;
+        p_batch->set = 0U;
+        p_batch->flags = 0U;
+        p_batch->open = 0U;
+        p_batch->strip_open = 0U;
+        p_batch->phase = 0U;
+    }
+}
+
+/**
+ * @brief Begin drawing a graphics primitive, every call starts a new strip.
+ */
+void EVE_batch_begin(EVE_batch_t * const p_batch, uint32_t const prim)
+{
+    if (p_batch != NULL)
+    {
+        p_batch->prim = (uint8_t) prim;
+        p_batch->open = 0U;
+        p_batch->strip_open = 0U;
+        p_batch->phase = 0U;
+    }
+}
+
+/**
+ * @brief Set the color for the following vertices.
+ */
+void EVE_batch_color_rgb(EVE_batch_t * const p_batch, uint32_t const color)
+{
+    uint32_t const command = DL_COLOR_RGB | (color & 0x00ffffffUL);
+
+    if ((p_batch != NULL) && ((0U == (p_batch->set & EVE_BATCH_SET_COLOR_RGB)) || (p_batch->color != command)))
+    {
+        p_batch->color = command;
+        p_batch->set |= EVE_BATCH_SET_COLOR_RGB;
+        p_batch->open = 0U;
+    }
+}
+
+/**
+ * @brief Set the alpha for the following vertices.
+ */
+void EVE_batch_color_a(EVE_batch_t * const p_batch, uint8_t const alpha)
+{
+    if ((p_batch != NULL) && ((0U == (p_batch->set & EVE_BATCH_SET_COLOR_A)) || (p_batch->alpha != alpha)))
+    {
+        p_batch->alpha = alpha;
+        p_batch->set |= EVE_BATCH_SET_COLOR_A;
+        p_batch->open = 0U;
+    }
+}
+
+/**
+ * @brief Set the tag for the following vertices.
+ */
+void EVE_batch_tag(EVE_batch_t * const p_batch, uint8_t const tag)
+{
+    if ((p_batch != NULL) && ((0U == (p_batch->set & EVE_BATCH_SET_TAG)) || (p_batch->tag != tag)))
+    {
+        p_batch->tag = tag;
+        p_batch->set |= EVE_BATCH_SET_TAG;
+        p_batch->open = 0U;
+    }
+}
+
+/**
+ * @brief Set the line width in 1/16 pixel for the following lines, strips and rectangles.
+ */
+void EVE_batch_line_width(EVE_batch_t * const p_batch, uint16_t const width)
+{
+    if ((p_batch != NULL) && ((0U == (p_batch->set & EVE_BATCH_SET_LINE_WIDTH)) || (p_batch->line_width != width)))
+    {
+        p_batch->line_width = width;
+        p_batch->set |= EVE_BATCH_SET_LINE_WIDTH;
+        p_batch->open = 0U;
+    }
+}
+
+/**
+ * @brief Set the point radius in 1/16 pixel for the following points.
+ */
+void EVE_batch_point_size(EVE_batch_t * const p_batch, uint16_t const size)
+{
+    if ((p_batch != NULL) && ((0U == (p_batch->set & EVE_BATCH_SET_POINT_SIZE)) || (p_batch->point_size != size)))
+    {
+        p_batch->point_size = size;
+        p_batch->set |= EVE_BATCH_SET_POINT_SIZE;
+        p_batch->open = 0U;
+    }
+}
+
+/**
+ * @brief Mark the following draws as not overlapping each other, 0 to go back to the recorded order.
+ * @note - Overlapping with anything recorded while this is off is fine, these segments are not moved.
+ */
+void EVE_batch_independent(EVE_batch_t * const p_batch, uint8_t const independent)
+{
+    uint8_t const flags = (independent != 0U) ? EVE_BATCH_INDEPENDENT : 0U;
+
+    if ((p_batch != NULL) && ((p_batch->flags & EVE_BATCH_INDEPENDENT) != flags))
+    {
+        p_batch->flags = (independent != 0U) ? (EVE_BATCH_INDEPENDENT | EVE_BATCH_RUN_START) : 0U;
+        p_batch->open = 0U;
+    }
+}
+
+/**
+ * @brief Add a vertex, in the precision set with EVE_vertex_format().
+ */
+void EVE_batch_vertex2f(EVE_batch_t * const p_batch, int16_t const xc0, int16_t const yc0)
+{
+    if (p_batch != NULL)
+    {
+        batch_vertex(p_batch, VERTEX2F(xc0, yc0));
+    }
+}
+
+/**
+ * @brief Add a vertex with bitmap handle and cell.
+ */
+void EVE_batch_vertex2ii(EVE_batch_t * const p_batch, uint16_t const xc0, uint16_t const yc0, uint8_t const handle, uint8_t const cell)
+{
+    if (p_batch != NULL)
+    {
+        batch_vertex(p_batch, VERTEX2II(xc0, yc0, handle, cell));
+    }
+}
+
+/**
+ * @brief Write everything that was recorded to the display-list and empty the batch.
+ * @return - the number of display-list commands written
+ * @note - The state set with the EVE_batch_xxx() functions is kept for the next recording.
+ */
+uint16_t EVE_batch_flush(EVE_batch_t * const p_batch)
+{
+    uint16_t commands = 0U;
+
+    if (p_batch != NULL)
+    {
+        commands = batch_emit(p_batch);
+        p_batch->strip_open = 0U;
+        p_batch->phase = 0U;
+    }
+    return (commands);
+}
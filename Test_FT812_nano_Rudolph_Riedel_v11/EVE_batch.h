@@ -0,0 +1,110 @@
+/*
+@file    EVE_batch.h
+@brief   prototypes for the deferred drawing that merges BEGIN / END blocks of the same primitive
+@version 1.0
+@date    2026-10-18
+@author  Christian Lara
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+@section History
+
+1.0
+- initial version
+
+*/
+
+#ifndef EVE_BATCH_H
+#define EVE_BATCH_H
+
+#include "EVE.h"
+#include "EVE_commands.h"
+
+/* the values a segment sets, anything else is left as the display-list has it */
+#define EVE_BATCH_SET_COLOR_RGB 0x01U
+#define EVE_BATCH_SET_COLOR_A 0x02U
+#define EVE_BATCH_SET_TAG 0x04U
+#define EVE_BATCH_SET_LINE_WIDTH 0x08U
+#define EVE_BATCH_SET_POINT_SIZE 0x10U
+
+#define EVE_BATCH_INDEPENDENT 0x01U /* does not overlap the other independent segments, may be moved */
+#define EVE_BATCH_CONTINUE 0x02U /* the rest of a strip or pair after a state change, no new BEGIN */
+#define EVE_BATCH_RUN_START 0x04U /* first segment after EVE_batch_independent(p, 1U), runs are grouped separately */
+
+typedef struct
+{
+    uint32_t color; /* COLOR_RGB command */
+    uint16_t size; /* LINE_WIDTH or POINT_SIZE in 1/16 pixel, depending on the primitive */
+    uint16_t first; /* index of the first vertex */
+    uint16_t count;
+    uint8_t alpha;
+    uint8_t tag;
+    uint8_t prim; /* EVE_BITMAPS ... EVE_RECTS */
+    uint8_t set; /* EVE_BATCH_SET_xxx */
+    uint8_t flags; /* EVE_BATCH_xxx */
+} EVE_batch_segment_t;
+
+typedef struct
+{
+    EVE_batch_segment_t *p_segments; /* storage of the caller */
+    uint32_t *p_vertices; /* VERTEX2F / VERTEX2II commands */
+    uint16_t segments_max;
+    uint16_t vertices_max;
+    uint16_t segments;
+    uint16_t vertices;
+    uint32_t color; /* state for the following vertices */
+    uint16_t line_width;
+    uint16_t point_size;
+    uint8_t alpha;
+    uint8_t tag;
+    uint8_t prim;
+    uint8_t set;
+    uint8_t flags; /* EVE_BATCH_INDEPENDENT for the following vertices */
+    uint8_t open; /* 1 = the last segment takes the next vertex */
+    uint8_t strip_open; /* 1 = a strip was started and a state change continues it */
+    uint8_t phase; /* 1 = a line or rectangle waits for its second vertex */
+} EVE_batch_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+void EVE_batch_init(EVE_batch_t * const p_batch, EVE_batch_segment_t * const p_segments, uint16_t const segments,
+                    uint32_t * const p_vertices, uint16_t const vertices);
+void EVE_batch_begin(EVE_batch_t * const p_batch, uint32_t const prim);
+void EVE_batch_color_rgb(EVE_batch_t * const p_batch, uint32_t const color);
+void EVE_batch_color_a(EVE_batch_t * const p_batch, uint8_t const alpha);
+void EVE_batch_tag(EVE_batch_t * const p_batch, uint8_t const tag);
+void EVE_batch_line_width(EVE_batch_t * const p_batch, uint16_t const width);
+void EVE_batch_point_size(EVE_batch_t * const p_batch, uint16_t const size);
+void EVE_batch_independent(EVE_batch_t * const p_batch, uint8_t const independent);
+void EVE_batch_vertex2f(EVE_batch_t * const p_batch, int16_t const xc0, int16_t const yc0);
+void EVE_batch_vertex2ii(EVE_batch_t * const p_batch, uint16_t const xc0, uint16_t const yc0, uint8_t const handle, uint8_t const cell);
+uint16_t EVE_batch_flush(EVE_batch_t * const p_batch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_BATCH_H */
@@ -210,6 +210,27 @@ without the traling _burst in the name when exceution speed is not an issue - e.
 - added EVE_vertex_translate_x() / EVE_vertex_translate_x_burst()
 - added EVE_vertex_translate_y() / EVE_vertex_translate_y_burst()
 - added "const" statements for BARR-C:2018 / CERT C compliance
+- added the optional frame hash with EVE_FRAME_HASH: EVE_burst_frame() drops frames that are identical
+    to the one on screen, added EVE_get_frames_skipped() and EVE_frame_hash_invalidate()
+- added the optional state journal with EVE_JOURNAL: EVE_journal_begin() / EVE_journal_end() record
+    the burst stream of the state-setting commands, EVE_busy() replays it after a coprocessor fault
+- added the optional adaptive polling with EVE_BACKOFF: EVE_execute_cmd() estimates how long the
+    coprocessor needs for what was written to the CMD-FIFO and only reads REG_CMDB_SPACE after that,
+    added EVE_get_busy_waits() and EVE_get_busy_polls()
+- added the optional render-state cache with EVE_STATE_CACHE: COLOR_RGB, COLOR_A, LINE_WIDTH, POINT_SIZE,
+    VERTEX_FORMAT, TAG and BEGIN are only sent when they change what the display-list uses,
+    added EVE_get_state_dropped() and EVE_state_invalidate()
+- added EVE_start_dl_burst() / EVE_end_dl_burst() to write display-lists without coprocessor commands
+    directly to RAM_DL
+- added the optional command subsets EVE_CMD_NO_CONTROLS, EVE_CMD_NO_MEDIA and EVE_CMD_NO_MATRIX,
+    these leave out the gauges and other controls, the video / snapshot / sketch commands and the
+    coprocessor matrix commands that EVE_matrix replaces on the host
+- reworked private_string_write(): strings are read and sent one 32-bit word at a time with a SWAR
+    zero-byte test on aligned strings, the non-burst variant uses spi_transmit_32() now
+- added EVE_cmd_text_packed() / EVE_cmd_text_packed_burst() for strings packed with EVE_PACK_WORD()
+- fix: with EVE_BACKOFF the journal that EVE_busy() replays after a fault is added to the FIFO estimate
+- the words of a string skip the state cache, with EVE_BACKOFF only words that look like a coprocessor
+    command go thru the FIFO model, short strings were not faster than with the byte by byte writer
 
 */
 
@@ -226,6 +247,430 @@ without the traling _burst in the name when exceution speed is not an issue - e.
 static volatile uint8_t cmd_burst = 0U; /* flag to indicate cmd-burst is active */
 static volatile uint8_t fault_recovered = E_OK; /* flag to indicate if EVE_busy triggered a fault recovery */
 
+#if defined (EVE_DMA)
+#define DL_DIRECT_MAX 1024U /* EVE_dma_buffer has room for the address and 1024 words */
+#else
+#define DL_DIRECT_MAX 2048U /* RAM_DL is 8 kB */
+#endif
+
+static uint8_t dl_direct = 0U; /* EVE_start_dl_burst() is active, the burst goes to RAM_DL */
+static uint16_t dl_direct_words = 0U;
+static uint8_t dl_direct_overflow = 0U;
+
+static inline void dl_direct_transmit(uint32_t const data)
+{
+    if (0U == dl_direct)
+    {
+        spi_transmit_burst(data);
+    }
+    else if (dl_direct_words < DL_DIRECT_MAX)
+    {
+        spi_transmit_burst(data);
+        dl_direct_words++;
+    }
+    else
+    {
+        dl_direct_overflow = 1U; /* the registers follow right after RAM_DL */
+    }
+}
+
+/* from here on every burst transfer in this file stays inside of RAM_DL while that is written directly */
+#define spi_transmit_burst(data) dl_direct_transmit(data)
+
+#if defined (EVE_BACKOFF)
+#if !defined (EVE_DELAY_US)
+#error "EVE_BACKOFF needs EVE_DELAY_US() from the target"
+#endif
+
+/* the cost of a command for the coprocessor, these are just a starting point as the scale adapts */
+#if !defined (EVE_BACKOFF_NS_WORD)
+#define EVE_BACKOFF_NS_WORD 200UL /* every word that is written, display-list commands and parameters */
+#endif
+
+#if !defined (EVE_BACKOFF_NS_WIDGET)
+#define EVE_BACKOFF_NS_WIDGET 20000UL /* widgets that render into the display-list, like CMD_TEXT */
+#endif
+
+#if !defined (EVE_BACKOFF_MIN_US)
+#define EVE_BACKOFF_MIN_US 4U /* first delay between two reads of REG_CMDB_SPACE */
+#endif
+
+#if !defined (EVE_BACKOFF_MAX_US)
+#define EVE_BACKOFF_MAX_US 1000U /* the delay is doubled with every read up to this */
+#endif
+
+#define BACKOFF_SCALE_ONE 256U /* fifo_scale is 8.8 fixed point */
+#define BACKOFF_SCALE_MIN 2U
+#define BACKOFF_SCALE_MAX 8192U
+
+static uint32_t fifo_work_ns = 0U; /* estimated time the coprocessor needs for what is in the FIFO */
+static uint8_t fifo_unbounded = 0U; /* a command with unknown duration is in the FIFO, like CMD_INFLATE */
+static uint16_t fifo_scale = BACKOFF_SCALE_ONE; /* correction of the estimate, learned by EVE_execute_cmd() */
+static uint32_t busy_waits = 0U;
+static uint32_t busy_polls = 0U;
+
+/* add the estimated cost of one word written to REG_CMDB_WRITE to the FIFO model */
+static void fifo_account(uint32_t const data)
+{
+    fifo_work_ns += EVE_BACKOFF_NS_WORD;
+
+    switch (data)
+    {
+        case CMD_APPEND:
+        case CMD_BUTTON:
+        case CMD_CLOCK:
+        case CMD_DIAL:
+        case CMD_GAUGE:
+        case CMD_GRADIENT:
+        case CMD_KEYS:
+        case CMD_NUMBER:
+        case CMD_PROGRESS:
+        case CMD_SCROLLBAR:
+        case CMD_SLIDER:
+        case CMD_TEXT:
+        case CMD_TOGGLE:
+            fifo_work_ns += EVE_BACKOFF_NS_WIDGET;
+            break;
+        case CMD_CALIBRATE:
+        case CMD_INFLATE:
+        case CMD_LOADIMAGE:
+        case CMD_LOGO:
+        case CMD_MEDIAFIFO:
+        case CMD_MEMCPY:
+        case CMD_MEMCRC:
+        case CMD_MEMSET:
+        case CMD_MEMZERO:
+        case CMD_PLAYVIDEO:
+        case CMD_SCREENSAVER:
+        case CMD_SKETCH:
+        case CMD_SNAPSHOT:
+        case CMD_SNAPSHOT2:
+        case CMD_SPINNER:
+        case CMD_VIDEOFRAME:
+            fifo_unbounded = 1U;
+            break;
+        default:
+            /* the flash, animation and newer commands of EVE3 / EVE4 */
+            if ((0xffffff00UL == (data & 0xffffff00UL)) && ((data & 0xffUL) >= 0x44UL))
+            {
+                fifo_unbounded = 1U;
+            }
+            break;
+    }
+}
+
+/* the coprocessor is done with everything that was written */
+static void fifo_empty(void)
+{
+    fifo_work_ns = 0U;
+    fifo_unbounded = 0U;
+}
+
+static inline void backoff_transmit(uint32_t const data)
+{
+    if (0U == dl_direct) /* RAM_DL is no work for the coprocessor */
+    {
+        if (0xffffff00UL == (data & 0xffffff00UL))
+        {
+            fifo_account(data);
+        }
+        else
+        {
+            fifo_work_ns += EVE_BACKOFF_NS_WORD; /* display-list commands, parameters and strings */
+        }
+    }
+    spi_transmit_burst(data);
+}
+
+/* from here on every burst transfer in this file goes into the FIFO model */
+#undef spi_transmit_burst
+#define spi_transmit_burst(data) backoff_transmit(data)
+#endif
+
+#if defined (EVE_FRAME_HASH)
+/* word-wise FNV-1a over everything that is sent with spi_transmit_burst() */
+#define FRAME_HASH_SEED 2166136261UL
+#define FRAME_HASH_PRIME 16777619UL
+
+static uint32_t frame_hash = FRAME_HASH_SEED; /* running hash of the current burst */
+static uint32_t frame_hash_shown = 0U; /* hash of the display-list that is currently on screen */
+static uint8_t frame_hash_valid = 0U; /* frame_hash_shown is only usable after the first frame */
+static uint8_t frame_dry_run = 0U; /* only calculate the hash, do not send anything */
+static uint32_t frames_skipped = 0U;
+
+static inline void frame_hash_transmit(uint32_t const data)
+{
+    frame_hash = (frame_hash ^ data) * FRAME_HASH_PRIME;
+
+    if (0U == frame_dry_run)
+    {
+        spi_transmit_burst(data);
+    }
+}
+
+/* from here on every burst transfer in this file goes thru the hash */
+#undef spi_transmit_burst
+#define spi_transmit_burst(data) frame_hash_transmit(data)
+#endif
+
+#if defined (EVE_JOURNAL)
+#if !defined (EVE_JOURNAL_SIZE)
+#define EVE_JOURNAL_SIZE 32U /* in 32 bit words */
+#endif
+
+#if (EVE_JOURNAL_SIZE > 1023U)
+#error "EVE_JOURNAL_SIZE is limited to 1023 words as the replay goes into the empty CMD-FIFO with a single transfer"
+#endif
+
+#define JOURNAL_IDLE 0U
+#define JOURNAL_RECORDING 1U
+#define JOURNAL_OVERFLOW 2U
+
+static uint32_t journal[EVE_JOURNAL_SIZE]; /* the encoded commands, replayed as they are */
+static uint16_t journal_len = 0U;
+static uint8_t journal_state = JOURNAL_IDLE;
+
+static inline void journal_transmit(uint32_t const data)
+{
+    if (JOURNAL_RECORDING == journal_state)
+    {
+        if (journal_len < EVE_JOURNAL_SIZE)
+        {
+            journal[journal_len] = data;
+            journal_len++;
+        }
+        else
+        {
+            journal_state = JOURNAL_OVERFLOW;
+        }
+    }
+    spi_transmit_burst(data);
+}
+
+/* from here on every burst transfer in this file is also recorded while the journal is open */
+#undef spi_transmit_burst
+#define spi_transmit_burst(data) journal_transmit(data)
+#endif
+
+/* the characters of a string are never a coprocessor command, these words skip the state cache */
+static inline void string_transmit_burst(uint32_t const data)
+{
+    spi_transmit_burst(data);
+}
+
+#if defined (EVE_STATE_CACHE)
+#if !defined (EVE_STATE_STACK)
+#define EVE_STATE_STACK 4U /* levels of SAVE_CONTEXT that are tracked, deeper levels are restored as unknown */
+#endif
+
+/* the render state that is tracked, one display-list command each */
+#define STATE_COLOR_RGB 0U
+#define STATE_COLOR_A 1U
+#define STATE_LINE_WIDTH 2U
+#define STATE_POINT_SIZE 3U
+#define STATE_VERTEX_FORMAT 4U
+#define STATE_TAG 5U
+#define STATE_BEGIN 6U /* not part of the graphics context, SAVE_CONTEXT / RESTORE_CONTEXT do not touch it */
+#define STATE_SLOTS 7U
+#define STATE_NONE 0xffU
+
+#define STATE_ALL ((uint8_t) ((1U << STATE_SLOTS) - 1U))
+#define STATE_CONTEXT ((uint8_t) (STATE_ALL & ~(1U << STATE_BEGIN)))
+
+static uint32_t state_word[STATE_SLOTS]; /* the last command sent for each slot */
+static uint8_t state_known = 0U; /* bit set for every slot that holds what the display-list currently uses */
+static uint32_t state_stack[EVE_STATE_STACK][STATE_BEGIN];
+static uint8_t state_stack_known[EVE_STATE_STACK];
+static uint8_t state_depth = 0U;
+static uint8_t state_lost = 0U; /* SAVE_CONTEXT levels beyond EVE_STATE_STACK */
+static uint32_t state_dropped = 0U;
+
+/* the display-list starts with the default values of the graphics context */
+static void state_defaults(void)
+{
+    state_word[STATE_COLOR_RGB] = DL_COLOR_RGB | 0x00ffffffUL;
+    state_word[STATE_COLOR_A] = DL_COLOR_A | 0xffUL;
+    state_word[STATE_LINE_WIDTH] = LINE_WIDTH(16U);
+    state_word[STATE_POINT_SIZE] = POINT_SIZE(16U);
+    state_word[STATE_VERTEX_FORMAT] = VERTEX_FORMAT(4U);
+    state_word[STATE_TAG] = DL_TAG | 0xffUL;
+    state_known = STATE_CONTEXT; /* there is no primitive yet */
+    state_depth = 0U;
+    state_lost = 0U;
+}
+
+/* a coprocessor command was sent, forget what it may have changed */
+static void state_coprocessor(uint32_t const command)
+{
+    switch (command)
+    {
+        case CMD_TEXT:
+        case CMD_NUMBER:
+            /* these draw bitmaps with the current color, the primitive is left at BITMAPS and
+               VERTEX_FORMAT is not guaranteed for coordinates the coprocessor does not reach with VERTEX2II */
+            state_known &= (uint8_t) ~((1U << STATE_BEGIN) | (1U << STATE_VERTEX_FORMAT));
+            break;
+        case CMD_BGCOLOR:
+        case CMD_FGCOLOR:
+        case CMD_GRADCOLOR:
+        case CMD_INFLATE:
+        case CMD_INTERRUPT:
+        case CMD_LOADIDENTITY:
+        case CMD_MEMCPY:
+        case CMD_MEMCRC:
+        case CMD_MEMSET:
+        case CMD_MEMWRITE:
+        case CMD_MEMZERO:
+        case CMD_ROMFONT:
+        case CMD_ROTATE:
+        case CMD_SCALE:
+        case CMD_SETBASE:
+        case CMD_SETBITMAP:
+        case CMD_SETFONT:
+        case CMD_SETFONT2:
+        case CMD_SETMATRIX:
+        case CMD_SETSCRATCH:
+        case CMD_TRACK:
+        case CMD_TRANSLATE:
+            /* coprocessor state, RAM_G or bitmap parameters that are not tracked */
+            break;
+        default:
+            /* widgets, CMD_APPEND, CMD_DLSTART and everything else that is not known */
+            state_known = 0U;
+            break;
+    }
+}
+
+/* decide if a display-list command changes anything, returns 0 when it can be dropped */
+static uint8_t state_filter(uint32_t const command)
+{
+    uint8_t slot = STATE_NONE;
+    uint8_t ret = 1U;
+
+    switch ((uint8_t) (command >> 24U))
+    {
+        case 0x04U: /* COLOR_RGB */
+            slot = STATE_COLOR_RGB;
+            break;
+        case 0x10U: /* COLOR_A */
+            slot = STATE_COLOR_A;
+            break;
+        case 0x0eU: /* LINE_WIDTH */
+            slot = STATE_LINE_WIDTH;
+            break;
+        case 0x0dU: /* POINT_SIZE */
+            slot = STATE_POINT_SIZE;
+            break;
+        case 0x27U: /* VERTEX_FORMAT */
+            slot = STATE_VERTEX_FORMAT;
+            break;
+        case 0x03U: /* TAG */
+            slot = STATE_TAG;
+            break;
+        case 0x1fU: /* BEGIN */
+            if ((command == (DL_BEGIN | EVE_POINTS)) || (command == (DL_BEGIN | EVE_BITMAPS)))
+            {
+                slot = STATE_BEGIN;
+            }
+            else
+            {
+                /* BEGIN starts a new strip and a new pair of vertices for lines and rectangles, it is always sent */
+                state_word[STATE_BEGIN] = command;
+                state_known |= (uint8_t) (1U << STATE_BEGIN);
+            }
+            break;
+        case 0x21U: /* END */
+            state_known &= (uint8_t) ~(1U << STATE_BEGIN);
+            break;
+        case 0x22U: /* SAVE_CONTEXT */
+            if (state_depth < EVE_STATE_STACK)
+            {
+                for (uint8_t index = 0U; index < STATE_BEGIN; index++)
+                {
+                    state_stack[state_depth][index] = state_word[index];
+                }
+                state_stack_known[state_depth] = state_known & STATE_CONTEXT;
+                state_depth++;
+            }
+            else
+            {
+                state_lost++;
+            }
+            break;
+        case 0x23U: /* RESTORE_CONTEXT */
+            if (state_lost > 0U)
+            {
+                state_lost--;
+                state_known &= (uint8_t) ~STATE_CONTEXT;
+            }
+            else if (state_depth > 0U)
+            {
+                state_depth--;
+                for (uint8_t index = 0U; index < STATE_BEGIN; index++)
+                {
+                    state_word[index] = state_stack[state_depth][index];
+                }
+                state_known = (state_known & (uint8_t) (1U << STATE_BEGIN)) | state_stack_known[state_depth];
+            }
+            else
+            {
+                state_known &= (uint8_t) ~STATE_CONTEXT;
+            }
+            break;
+        case 0x1dU: /* CALL */
+        case 0x1eU: /* JUMP */
+        case 0x24U: /* RETURN */
+        case 0x25U: /* MACRO */
+            state_known = 0U;
+            break;
+        default:
+            /* vertices and the state that is not tracked */
+            break;
+    }
+
+    if (slot != STATE_NONE)
+    {
+        if (((state_known & (1U << slot)) != 0U) && (state_word[slot] == command))
+        {
+#if defined (EVE_FRAME_HASH)
+            if (0U == frame_dry_run) /* the hash run of EVE_burst_frame() is not counted */
+            {
+                state_dropped++;
+            }
+#else
+            state_dropped++;
+#endif
+            ret = 0U;
+        }
+        else
+        {
+            state_word[slot] = command;
+            state_known |= (uint8_t) (1U << slot);
+        }
+    }
+    return (ret);
+}
+
+static inline void state_transmit(uint32_t const data)
+{
+    if (0xffffff00UL == (data & 0xffffff00UL))
+    {
+        state_coprocessor(data); /* parameters that look like a command only forget a little more */
+    }
+    spi_transmit_burst(data);
+}
+
+/* from here on every burst transfer in this file is checked for coprocessor commands */
+#undef spi_transmit_burst
+#define spi_transmit_burst(data) state_transmit(data)
+#else
+static inline uint8_t state_filter(uint32_t const command)
+{
+    (void) command;
+    return (1U);
+}
+#endif
+
 /* ##################################################################
     helper functions
 ##################################################################### */
@@ -419,12 +864,27 @@ uint8_t EVE_busy(void)
         ret = EVE_FAULT_RECOVERED;
         fault_recovered = EVE_FAULT_RECOVERED; /* save fault recovery state */
         CoprocessorFaultRecover();
+#if defined (EVE_BACKOFF)
+        fifo_empty();
+#endif
+#if defined (EVE_FRAME_HASH)
+        EVE_frame_hash_invalidate();
+#endif
+#if defined (EVE_JOURNAL)
+        EVE_journal_replay(); /* fonts, colors and the like are back before the next frame is built */
+#endif
+#if defined (EVE_STATE_CACHE)
+        EVE_state_invalidate();
+#endif
     }
     else
     {
         if (0xffcU == space)
         {
             ret = E_OK;
+#if defined (EVE_BACKOFF)
+            fifo_empty();
+#endif
         }
         else if (space > 0x800U)
         {
@@ -443,6 +903,180 @@ uint8_t EVE_busy(void)
     return (ret);
 }
 
+#if defined (EVE_FRAME_HASH)
+/**
+ * @brief Build a frame with p_build() in burst-mode and only send it when it differs from the frame on screen.
+ * @note - p_build() has to contain everything from EVE_cmd_dlstart() to EVE_cmd_swap() but not
+ * EVE_start_cmd_burst() / EVE_end_cmd_burst(), these are called here.
+ * @note - p_build() must not change any state, without DMA it is called twice for frames that changed,
+ * the first run only calculates the hash as the bytes can not be taken back once they are sent.
+ * @note - With DMA the buffer is built only once and the transfer is not started for identical frames.
+ * @note - Anything that changes the result without changing the command stream, like new data in RAM_G
+ * for a bitmap or the static part of the display-list, needs a call to EVE_frame_hash_invalidate().
+ * @return - E_OK - the frame was sent
+ * @return - EVE_FRAME_SKIPPED - the frame is identical to the one on screen and was dropped
+ */
+uint8_t EVE_burst_frame(void (* const p_build)(void))
+{
+    uint8_t ret = E_OK;
+
+#if defined (EVE_DMA)
+    EVE_start_cmd_burst();
+    p_build();
+
+    if ((frame_hash_valid != 0U) && (frame_hash == frame_hash_shown))
+    {
+        cmd_burst = 0U; /* the buffer is simply not transferred */
+        ret = EVE_FRAME_SKIPPED;
+    }
+    else
+    {
+        EVE_end_cmd_burst();
+    }
+#else
+    frame_dry_run = 1U;
+    frame_hash = FRAME_HASH_SEED;
+    cmd_burst = 42U;
+    p_build();
+    cmd_burst = 0U;
+    frame_dry_run = 0U;
+
+    if ((frame_hash_valid != 0U) && (frame_hash == frame_hash_shown))
+    {
+        ret = EVE_FRAME_SKIPPED;
+    }
+    else
+    {
+        EVE_start_cmd_burst();
+        p_build();
+        EVE_end_cmd_burst();
+    }
+#endif
+
+    if (EVE_FRAME_SKIPPED == ret)
+    {
+        frames_skipped++;
+    }
+    else
+    {
+        frame_hash_shown = frame_hash;
+        frame_hash_valid = 1U;
+    }
+    return (ret);
+}
+
+/**
+ * @brief Get the number of frames EVE_burst_frame() dropped since EVE_init().
+ */
+uint32_t EVE_get_frames_skipped(void)
+{
+    return (frames_skipped);
+}
+
+/**
+ * @brief Force EVE_burst_frame() to send the next frame.
+ */
+void EVE_frame_hash_invalidate(void)
+{
+    frame_hash_valid = 0U;
+}
+#endif /* EVE_FRAME_HASH */
+
+#if defined (EVE_JOURNAL)
+/**
+ * @brief Start burst-mode and record everything that is sent until EVE_journal_end().
+ * @note - Meant for the commands that set up coprocessor state at init, like EVE_cmd_setfont2(),
+ * EVE_cmd_romfont(), EVE_cmd_bgcolor() or EVE_cmd_setscratch(), these are lost when EVE_busy()
+ * resets the coprocessor after a fault.
+ * @note - Only burst-mode commands are recorded, commands that wait for a result like EVE_cmd_setrotate()
+ * can not be used, the touch calibration and REG_ROTATE are registers that are not reset by the recovery.
+ * @note - Data in RAM_G, like a static part of the display-list that was copied there, is not touched
+ * by the recovery and does not need to be recorded.
+ * @note - Calling this again replaces the journal.
+ */
+void EVE_journal_begin(void)
+{
+    journal_len = 0U;
+    EVE_start_cmd_burst();
+    journal_state = JOURNAL_RECORDING;
+}
+
+/**
+ * @brief Stop recording and send the recorded commands.
+ * @return - E_OK - the journal is complete and is replayed after the next coprocessor fault
+ * @return - E_NOT_OK - the commands did not fit into EVE_JOURNAL_SIZE words, the journal is discarded
+ */
+uint8_t EVE_journal_end(void)
+{
+    uint8_t ret = E_OK;
+
+    if (JOURNAL_OVERFLOW == journal_state)
+    {
+        journal_len = 0U;
+        ret = E_NOT_OK;
+    }
+    journal_state = JOURNAL_IDLE;
+    EVE_end_cmd_burst();
+    return (ret);
+}
+
+/**
+ * @brief Send the recorded commands again with a single transfer to REG_CMDB_WRITE.
+ * @note - Called by EVE_busy() after the fault recovery, the commands are not encoded again.
+ * @note - Does not wait for the coprocessor to execute the commands.
+ */
+void EVE_journal_replay(void)
+{
+    if (journal_len > 0U)
+    {
+        EVE_cs_set();
+        spi_transmit((uint8_t) 0xB0U); /* high-byte of REG_CMDB_WRITE + MEM_WRITE */
+        spi_transmit((uint8_t) 0x25U); /* middle-byte of REG_CMDB_WRITE */
+        spi_transmit((uint8_t) 0x78U); /* low-byte of REG_CMDB_WRITE */
+
+        for (uint16_t index = 0U; index < journal_len; index++)
+        {
+            spi_transmit_32(journal[index]);
+#if defined (EVE_BACKOFF)
+            fifo_account(journal[index]); /* EVE_busy() emptied the estimate before the replay */
+#endif
+        }
+        EVE_cs_clear();
+    }
+}
+
+/**
+ * @brief Discard the journal, nothing is replayed after a coprocessor fault.
+ */
+void EVE_journal_clear(void)
+{
+    journal_len = 0U;
+    journal_state = JOURNAL_IDLE;
+}
+#endif /* EVE_JOURNAL */
+
+#if defined (EVE_STATE_CACHE)
+/**
+ * @brief Get the number of display-list commands that were dropped as they would not have changed anything.
+ */
+uint32_t EVE_get_state_dropped(void)
+{
+    return (state_dropped);
+}
+
+/**
+ * @brief Forget the tracked render state, the next command for every slot is sent.
+ * @note - Needed after anything that changes the display-list without the functions in this file,
+ * like writing to RAM_DL directly.
+ */
+void EVE_state_invalidate(void)
+{
+    state_known = 0U;
+    state_depth = 0U;
+    state_lost = 0U;
+}
+#endif /* EVE_STATE_CACHE */
+
 /**
  * @brief Helper function to check if EVE_busy() tried to recover from a coprocessor fault.
  * The internal fault indicator is cleared so it could be set by EVE_busy() again.
@@ -463,17 +1097,97 @@ uint8_t EVE_get_and_reset_fault_state(void)
 
 /**
  * @brief Helper function, wait for the coprocessor to complete the FIFO queue.
+ * @note - With EVE_BACKOFF the wait starts with a delay for the estimated time the coprocessor needs
+ * for the commands that were written, after that REG_CMDB_SPACE is read with a delay that doubles
+ * from EVE_BACKOFF_MIN_US to EVE_BACKOFF_MAX_US. The estimate is scaled by how many reads were needed.
  */
 void EVE_execute_cmd(void)
 {
+#if defined (EVE_BACKOFF)
+    uint32_t wait_us = 0U;
+    uint16_t backoff = EVE_BACKOFF_MIN_US;
+    uint32_t polls = 1U;
+    uint8_t const predicted = (0U == fifo_unbounded) ? 1U : 0U;
+
+    if (predicted != 0U)
+    {
+        uint32_t const work_us = (fifo_work_ns > 100000000UL) ? 100000UL : (fifo_work_ns / 1000UL);
+
+        wait_us = (work_us * fifo_scale) >> 8U;
+    }
+
+    while (wait_us > 0U)
+    {
+        uint16_t const chunk = (wait_us > 10000UL) ? 10000U : (uint16_t) wait_us;
+
+        EVE_DELAY_US(chunk);
+        wait_us -= chunk;
+    }
+
+    while (EVE_busy() != E_OK)
+    {
+        EVE_DELAY_US(backoff);
+        backoff = ((backoff * 2U) > EVE_BACKOFF_MAX_US) ? EVE_BACKOFF_MAX_US : (uint16_t) (backoff * 2U);
+        polls++;
+    }
+
+    if (predicted != 0U)
+    {
+        /* done on the first read: maybe waited too long, more reads: the estimate was too short */
+        if ((1U == polls) && (fifo_scale > BACKOFF_SCALE_MIN))
+        {
+            fifo_scale -= (fifo_scale >> 4U) + 1U;
+        }
+        else if ((polls > 2U) && (fifo_scale < BACKOFF_SCALE_MAX))
+        {
+            fifo_scale += (fifo_scale >> 3U) + 1U;
+        }
+        else
+        {
+            /* close enough */
+        }
+    }
+
+    busy_waits++;
+    busy_polls += polls;
+#else
     while (EVE_busy() != E_OK)
     {
     }
+#endif
 }
 
+#if defined (EVE_BACKOFF)
+/**
+ * @brief Get the number of times EVE_execute_cmd() waited for the coprocessor since EVE_init().
+ */
+uint32_t EVE_get_busy_waits(void)
+{
+    return (busy_waits);
+}
+
+/**
+ * @brief Get the number of REG_CMDB_SPACE reads EVE_execute_cmd() needed since EVE_init().
+ * @note - Divided by EVE_get_busy_waits() this is the number of reads per wait, 1 is ideal.
+ */
+uint32_t EVE_get_busy_polls(void)
+{
+    return (busy_polls);
+}
+#endif
+
 /* begin a coprocessor command, this is used for non-display-list and non-burst-mode commands.*/
 static void eve_begin_cmd(const uint32_t command)
 {
+#if defined (EVE_BACKOFF)
+    fifo_account(command); /* the parameters are not counted, the command decides the cost */
+#endif
+#if defined (EVE_STATE_CACHE)
+    if (0xffffff00UL == (command & 0xffffff00UL))
+    {
+        state_coprocessor(command);
+    }
+#endif
     EVE_cs_set();
     spi_transmit((uint8_t) 0xB0U); /* high-byte of REG_CMDB_WRITE + MEM_WRITE */
     spi_transmit((uint8_t) 0x25U); /* middle-byte of REG_CMDB_WRITE */
@@ -984,6 +1698,7 @@ void EVE_cmd_resetfonts(void)
     EVE_execute_cmd();
 }
 
+#if !defined (EVE_CMD_NO_MEDIA)
 /**
  * @brief Initialize video frame decoder for video from the flash memory.
  * @note - Meant to be called outside display-list building.
@@ -996,6 +1711,7 @@ void EVE_cmd_videostartf(void)
     EVE_cs_clear();
     EVE_execute_cmd();
 }
+#endif /* EVE_CMD_NO_MEDIA */
 
 #endif /* EVE_GEN > 2 */
 
@@ -1126,6 +1842,7 @@ void EVE_cmd_loadimage(const uint32_t ptr, const uint32_t options, const uint8_t
     }
 }
 
+#if !defined (EVE_CMD_NO_MEDIA)
 /**
  * @brief Ask the coprocessor engine to play back a short animation of the FTDI or Bridgetek logo.
  * @note - Takes 2.5s to complete during which RAM_CMD and RAM_DL must not be written to.
@@ -1139,7 +1856,9 @@ void EVE_cmd_logo(void)
     eve_begin_cmd(CMD_LOGO);
     EVE_cs_clear();
 }
+#endif /* EVE_CMD_NO_MEDIA */
 
+#if !defined (EVE_CMD_NO_MEDIA)
 /**
  * @brief Set up a streaming media FIFO in RAM_G.
  * @note - Meant to be called outside display-list building.
@@ -1154,6 +1873,7 @@ void EVE_cmd_mediafifo(const uint32_t ptr, const uint32_t size)
     EVE_cs_clear();
     EVE_execute_cmd();
 }
+#endif /* EVE_CMD_NO_MEDIA */
 
 /**
  * @brief Copy a block of memory with the coprocessor.
@@ -1269,6 +1989,7 @@ void EVE_cmd_memzero(const uint32_t ptr, const uint32_t num)
     EVE_execute_cmd();
 }
 
+#if !defined (EVE_CMD_NO_MEDIA)
 /**
  * @brief Play back motion-JPEG encoded AVI video.
  * @note - Meant to be called outside display-list building.
@@ -1295,6 +2016,7 @@ void EVE_cmd_playvideo(const uint32_t options, const uint8_t * const p_data, con
         }
     }
 }
+#endif /* EVE_CMD_NO_MEDIA */
 
 /**
  * @brief Read a register value using the coprocessor.
@@ -1334,6 +2056,7 @@ void EVE_cmd_setrotate(const uint32_t rotation)
     EVE_execute_cmd();
 }
 
+#if !defined (EVE_CMD_NO_MEDIA)
 /**
  * @brief Take a snapshot of the current screen.
  * @note - Meant to be called outside display-list building.
@@ -1347,7 +2070,9 @@ void EVE_cmd_snapshot(const uint32_t ptr)
     EVE_cs_clear();
     EVE_execute_cmd();
 }
+#endif /* EVE_CMD_NO_MEDIA */
 
+#if !defined (EVE_CMD_NO_MEDIA)
 /**
  * @brief Take a snapshot of part of the current screen with format option.
  * @note - Meant to be called outside display-list building.
@@ -1364,6 +2089,7 @@ void EVE_cmd_snapshot2(const uint32_t fmt, const uint32_t ptr, const int16_t xc0
     EVE_cs_clear();
     EVE_execute_cmd();
 }
+#endif /* EVE_CMD_NO_MEDIA */
 
 /**
  * @brief Wait for the end of the video scan out period.
@@ -1391,6 +2117,7 @@ void EVE_cmd_sync_burst(void)
     spi_transmit_burst(CMD_SYNC);
 }
 
+#if !defined (EVE_CMD_NO_CONTROLS)
 /**
  * @brief Track touches for a graphics object.
  * @note - Meant to be called outside display-list building.
@@ -1406,7 +2133,9 @@ void EVE_cmd_track(const int16_t xc0, const int16_t yc0, const uint16_t wid, con
     EVE_cs_clear();
     EVE_execute_cmd();
 }
+#endif /* EVE_CMD_NO_CONTROLS */
 
+#if !defined (EVE_CMD_NO_MEDIA)
 /**
  * @brief Load the next frame of a video.
  * @note - Meant to be called outside display-list building.
@@ -1421,7 +2150,9 @@ void EVE_cmd_videoframe(const uint32_t dest, const uint32_t result_ptr)
     EVE_cs_clear();
     EVE_execute_cmd();
 }
+#endif /* EVE_CMD_NO_MEDIA */
 
+#if !defined (EVE_CMD_NO_MEDIA)
 /**
  * @brief Initialize video frame decoder for video provided using the media FIFO.
  * @note - Meant to be called outside display-list building.
@@ -1434,6 +2165,7 @@ void EVE_cmd_videostart(void)
     EVE_cs_clear();
     EVE_execute_cmd();
 }
+#endif /* EVE_CMD_NO_MEDIA */
 
 /* ##################################################################
         patching and initialization
@@ -1831,6 +2563,22 @@ uint8_t EVE_init(void)
 #if defined (EVE_DMA)
             EVE_init_dma(); /* prepare DMA */
 #endif
+
+#if defined (EVE_FRAME_HASH)
+            EVE_frame_hash_invalidate(); /* whatever is on screen now is not from EVE_burst_frame() */
+            frames_skipped = 0U;
+#endif
+
+#if defined (EVE_JOURNAL)
+            EVE_journal_clear(); /* the state of the chip before the reset is gone */
+#endif
+
+#if defined (EVE_BACKOFF)
+            fifo_empty();
+            fifo_scale = BACKOFF_SCALE_ONE;
+            busy_waits = 0U;
+            busy_polls = 0U;
+#endif
         }
     }
 
@@ -1858,6 +2606,10 @@ void EVE_start_cmd_burst(void)
 
     cmd_burst = 42U;
 
+#if defined (EVE_FRAME_HASH)
+    frame_hash = FRAME_HASH_SEED;
+#endif
+
 #if defined (EVE_DMA)
     EVE_dma_buffer[0U] = 0x7825B000UL; /* REG_CMDB_WRITE + MEM_WRITE low mid hi 00 */
     EVE_dma_buffer_index = 1U;
@@ -1884,64 +2636,226 @@ void EVE_end_cmd_burst(void)
 #endif
 }
 
+/**
+ * @brief Begin writing a display-list directly to RAM_DL, the coprocessor is not involved.
+ * @note - Needs to be used with EVE_end_dl_burst().
+ * @note - Only display-list commands are allowed in the sequence, like EVE_vertex2f_burst() or EVE_cmd_dl_burst(),
+ * no EVE_cmd_...() coprocessor commands and no EVE_cmd_dlstart_burst(), the list always starts at RAM_DL.
+ * @note - The coprocessor needs to be idle and the previous swap has to be done, EVE_frame_ready() only
+ * returns E_OK when both are true. Display-lists from the coprocessor can follow, these start with CMD_DLSTART.
+ */
+void EVE_start_dl_burst(void)
+{
+#if defined (EVE_DMA)
+    if (EVE_dma_busy)
+    {
+        EVE_execute_cmd(); /* the last transfer needs to be done before the buffer is used again */
+    }
+#endif
+
+    cmd_burst = 42U;
+    dl_direct = 1U;
+    dl_direct_words = 0U;
+    dl_direct_overflow = 0U;
+
+#if defined (EVE_STATE_CACHE)
+    state_defaults();
+#endif
+
+#if defined (EVE_DMA)
+    EVE_dma_buffer[0U] = 0x0000B000UL; /* EVE_RAM_DL + MEM_WRITE low mid hi 00 */
+    EVE_dma_buffer_index = 1U;
+#else
+    EVE_cs_set();
+    spi_transmit((uint8_t) 0xB0U); /* high-byte of EVE_RAM_DL + MEM_WRITE */
+    spi_transmit((uint8_t) 0x00U); /* middle-byte of EVE_RAM_DL */
+    spi_transmit((uint8_t) 0x00U); /* low-byte of EVE_RAM_DL */
+#endif
+}
+
+/**
+ * @brief End writing a display-list to RAM_DL and swap it in.
+ * @param swap - EVE_DLSWAP_FRAME to swap with the next VSYNC, EVE_DLSWAP_LINE to swap after the current line,
+ * EVE_DLSWAP_DONE to not swap as EVE_frame_ready() does that with EVE_DLSWAP_LINE
+ * @return - E_OK - the list was written
+ * @return - E_NOT_OK - the list did not fit into RAM_DL, the words past the end were dropped and there was no swap
+ */
+uint8_t EVE_end_dl_burst(const uint8_t swap)
+{
+    uint8_t ret = E_OK;
+
+    cmd_burst = 0U;
+    dl_direct = 0U;
+
+#if defined (EVE_DMA)
+    EVE_start_dma_transfer(); /* begin DMA transfer */
+    while (EVE_dma_busy)
+    {
+        /* REG_DLSWAP can only be written after the list */
+    }
+#else
+    EVE_cs_clear();
+#endif
+
+    if (dl_direct_overflow != 0U)
+    {
+        ret = E_NOT_OK;
+    }
+    else if (swap != EVE_DLSWAP_DONE)
+    {
+        EVE_memWrite8(REG_DLSWAP, swap);
+    }
+    else
+    {
+        /* the swap is written by the caller */
+    }
+    return (ret);
+}
+
+/* Strings are read one 32-bit word at a time on little endian targets with 32-bit registers,
+ * the zero-byte test works on all four characters at once (SWAR).
+ * Only strings that start on a 4-byte boundary are read with word loads, an aligned load never
+ * crosses into the next page or memory region behind the terminator and it also does not trap on
+ * cores without unaligned access like the ESP8266.
+ * Other strings, AVR and the big endian targets assemble the word byte by byte with constant shifts. */
+#if defined (__BYTE_ORDER__) && defined (__ORDER_LITTLE_ENDIAN__) && !defined (__AVR__)
+#if (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define STRING_SWAR
+typedef uint32_t __attribute__((__may_alias__)) string_word_t;
+#endif
+#endif
+
+#if defined (STRING_SWAR)
+/* bit 7 is set for the first 0x00 byte, bytes above it can be flagged as well */
+static inline uint32_t string_zero_flags(uint32_t const word)
+{
+    return ((word - 0x01010101UL) & ~word & 0x80808080UL);
+}
+#endif
+
+/* the next four characters as one little endian word, the terminator and everything after it is 0x00 */
+static inline uint32_t string_word(const uint8_t * const p_bytes, uint8_t * const p_end)
+{
+    uint32_t word = 0U;
+
+    *p_end = 1U;
+
+#if defined (STRING_SWAR)
+    if (0U == (((uintptr_t) p_bytes) & 3U))
+    {
+        uint32_t flags;
+
+        word = *((const string_word_t *) p_bytes);
+        flags = string_zero_flags(word);
+
+        if (flags != 0U)
+        {
+            /* keep the bytes below the lowest flag */
+            word &= ((flags & (~flags + 1U)) >> 7U) - 1U;
+        }
+        else
+        {
+            *p_end = 0U;
+        }
+    }
+    else
+#endif
+    if (p_bytes[0U] != 0U)
+    {
+        word = p_bytes[0U];
+        if (p_bytes[1U] != 0U)
+        {
+            word |= ((uint32_t) p_bytes[1U]) << 8U;
+            if (p_bytes[2U] != 0U)
+            {
+                word |= ((uint32_t) p_bytes[2U]) << 16U;
+                if (p_bytes[3U] != 0U)
+                {
+                    word |= ((uint32_t) p_bytes[3U]) << 24U;
+                    *p_end = 0U;
+                }
+            }
+        }
+    }
+    else
+    {
+        /* empty rest of the string */
+    }
+
+    return (word);
+}
+
 /* write a string to coprocessor memory in context of a command: */
 /* no chip-select, just plain SPI-transfers */
 static void private_string_write(const char * const p_text)
 {
     /* treat the array as bunch of bytes */
     const uint8_t *const p_bytes = (const uint8_t *)p_text;
+    uint8_t end = 0U;
+    uint8_t textindex = 0U;
 
     if (0U == cmd_burst)
     {
-        uint8_t textindex = 0U;
-        uint8_t padding;
-
-        /* either leave on Zero or when the string is too long */
-        while ((textindex < 249U) && (p_bytes[textindex] != 0U))
+        /* 62 words and one more character for up to 249 characters, */
+        /* the padding to the next word is the terminator */
+        for (; (textindex < 248U) && (0U == end); textindex += 4U)
         {
-            spi_transmit(p_bytes[textindex]);
-            textindex++;
+            spi_transmit_32(string_word(&p_bytes[textindex], &end));
         }
 
-        /* transmit at least one 0x00 byte */
-        /* and up to four if the string happens to be 4-byte aligned already */
-        padding = textindex & 3U; /* 0, 1, 2 or 3 */
-        padding = 4U - padding;   /* 4, 3, 2 or 1 */
-
-        while (padding > 0U)
+        if (0U == end)
         {
-            spi_transmit(0U);
-            padding--;
+            spi_transmit_32(string_word(&p_bytes[textindex], &end) & 0x000000ffUL);
         }
     }
     else /* we are in burst mode, so every transfer is 32 bits */
     {
-        uint8_t exit_flag = 0U;
+        for (; (textindex < 249U) && (0U == end); textindex += 4U)
+        {
+            string_transmit_burst(string_word(&p_bytes[textindex], &end));
+        }
 
-        for (uint8_t textindex = 0U; (textindex < 249U) && (0U == exit_flag); textindex += 4U)
+        if (0U == end) /* left the loop because the string is too long, send zeroes to terminate the string */
         {
-            uint32_t calc = 0U;
+            string_transmit_burst(0U);
+        }
+    }
+}
 
-            for (uint8_t index = 0U; index < 4U; index++)
-            {
-                uint8_t data;
+/* write a string that was packed into words with EVE_PACK_WORD() at compile time */
+static void private_packed_write(const uint32_t * const p_words, uint8_t const count)
+{
+    uint8_t end = 0U;
 
-                data = p_bytes[textindex + index];
+    for (uint8_t index = 0U; (index < count) && (0U == end); index++)
+    {
+        uint32_t const word = p_words[index];
 
-                if (0U == data)
-                {
-                    exit_flag = 1U; /* leave outer loop */
-                    break; /* leave inner loop */
-                }
-                calc += ((uint32_t)data) << (index * 8U);
-            }
+        if (((word & 0x000000ffUL) == 0U) || ((word & 0x0000ff00UL) == 0U) ||
+            ((word & 0x00ff0000UL) == 0U) || ((word & 0xff000000UL) == 0U))
+        {
+            end = 1U;
+        }
 
-            spi_transmit_burst(calc);
+        if (0U == cmd_burst)
+        {
+            spi_transmit_32(word);
+        }
+        else
+        {
+            string_transmit_burst(word);
         }
+    }
 
-        if(0U == exit_flag) /* left outer loop because the string is too long, send zeroes to terminate the string */
+    if (0U == end) /* the array is missing the word with the terminator */
+    {
+        if (0U == cmd_burst)
+        {
+            spi_transmit_32(0U);
+        }
+        else
         {
-            spi_transmit_burst(0U);
+            string_transmit_burst(0U);
         }
     }
 }
@@ -2455,6 +3369,7 @@ void EVE_cmd_fillwidth_burst(const uint32_t pixel)
     spi_transmit_burst(pixel);
 }
 
+#if !defined (EVE_CMD_NO_CONTROLS)
 /**
  * @brief Draw a smooth color gradient with transparency.
  */
@@ -2490,7 +3405,9 @@ void EVE_cmd_gradienta_burst(const int16_t xc0, const int16_t yc0, const uint32_
     spi_transmit_burst(i16_i16_to_u32(xc1, yc1));
     spi_transmit_burst(argb1);
 }
+#endif /* EVE_CMD_NO_CONTROLS */
 
+#if !defined (EVE_CMD_NO_MATRIX)
 /**
  * @brief Apply a rotation and scale around a specified coordinate.
  */
@@ -2526,6 +3443,7 @@ void EVE_cmd_rotatearound_burst(const int32_t xc0, const int32_t yc0, const uint
     spi_transmit_burst(angle & 0xFFFFUL);
     spi_transmit_burst(i32_to_u32(scale));
 }
+#endif /* EVE_CMD_NO_MATRIX */
 
 /**
  * @brief Draw a button with a label, varargs version.
@@ -2921,6 +3839,7 @@ void EVE_cmd_calibrate(void)
     }
 }
 
+#if !defined (EVE_CMD_NO_CONTROLS)
 /**
  * @brief Draw an analog clock.
  */
@@ -2958,7 +3877,9 @@ void EVE_cmd_clock_burst(const int16_t xc0, const int16_t yc0, const uint16_t ra
     spi_transmit_burst(u16_u16_to_u32(hours, mins));
     spi_transmit_burst(u16_u16_to_u32(secs, msecs));
 }
+#endif /* EVE_CMD_NO_CONTROLS */
 
+#if !defined (EVE_CMD_NO_CONTROLS)
 /**
  * @brief Draw a rotary dial control.
  */
@@ -2991,6 +3912,7 @@ void EVE_cmd_dial_burst(const int16_t xc0, const int16_t yc0, const uint16_t rad
     spi_transmit_burst(u16_u16_to_u32(rad, options));
     spi_transmit_burst(u16_u16_to_u32(val, 0x0000));
 }
+#endif /* EVE_CMD_NO_CONTROLS */
 
 /**
  * @brief Start a new display list.
@@ -3006,6 +3928,9 @@ void EVE_cmd_dlstart(void)
     {
         spi_transmit_burst(CMD_DLSTART);
     }
+#if defined (EVE_STATE_CACHE)
+    state_defaults();
+#endif
 }
 
 /**
@@ -3014,6 +3939,9 @@ void EVE_cmd_dlstart(void)
 void EVE_cmd_dlstart_burst(void)
 {
     spi_transmit_burst(CMD_DLSTART);
+#if defined (EVE_STATE_CACHE)
+    state_defaults();
+#endif
 }
 
 /**
@@ -3043,6 +3971,7 @@ void EVE_cmd_fgcolor_burst(const uint32_t color)
     spi_transmit_burst(color);
 }
 
+#if !defined (EVE_CMD_NO_CONTROLS)
 /**
  * @brief Draw a gauge.
  */
@@ -3080,7 +4009,9 @@ void EVE_cmd_gauge_burst(const int16_t xc0, const int16_t yc0, const uint16_t ra
     spi_transmit_burst(u16_u16_to_u32(major, minor));
     spi_transmit_burst(u16_u16_to_u32(val, range));
 }
+#endif /* EVE_CMD_NO_CONTROLS */
 
+#if !defined (EVE_CMD_NO_MATRIX)
 /**
  * @brief Retrieves the current matrix within the context of the coprocessor engine.
  * @note - waits for completion and reads values from RAM_CMD after completion
@@ -3136,7 +4067,9 @@ void EVE_cmd_getmatrix(int32_t * const p_a, int32_t * const p_b, int32_t * const
         }
     }
 }
+#endif /* EVE_CMD_NO_MATRIX */
 
+#if !defined (EVE_CMD_NO_CONTROLS)
 /**
  * @brief Set up the highlight color used in 3D effects for CMD_BUTTON and CMD_KEYS.
  */
@@ -3163,7 +4096,9 @@ void EVE_cmd_gradcolor_burst(const uint32_t color)
     spi_transmit_burst(CMD_GRADCOLOR);
     spi_transmit_burst(color);
 }
+#endif /* EVE_CMD_NO_CONTROLS */
 
+#if !defined (EVE_CMD_NO_CONTROLS)
 /**
  * @brief Draw a smooth color gradient.
  */
@@ -3199,7 +4134,9 @@ void EVE_cmd_gradient_burst(const int16_t xc0, const int16_t yc0, const uint32_t
     spi_transmit_burst(i16_i16_to_u32(xc1, yc1));
     spi_transmit_burst(rgb1);
 }
+#endif /* EVE_CMD_NO_CONTROLS */
 
+#if !defined (EVE_CMD_NO_CONTROLS)
 /**
  * @brief Draw a row of key buttons with labels.
  * @note - The tag value of each button is set to the ASCII value of its label.
@@ -3241,7 +4178,9 @@ void EVE_cmd_keys_burst(const int16_t xc0, const int16_t yc0, const uint16_t wid
     spi_transmit_burst(u16_u16_to_u32(font, options));
     private_string_write(p_text);
 }
+#endif /* EVE_CMD_NO_CONTROLS */
 
+#if !defined (EVE_CMD_NO_MATRIX)
 /**
  * @brief Set the current matrix to the identity matrix.
  */
@@ -3265,6 +4204,7 @@ void EVE_cmd_loadidentity_burst(void)
 {
     spi_transmit_burst(CMD_LOADIDENTITY);
 }
+#endif /* EVE_CMD_NO_MATRIX */
 
 /**
  * @brief Draw a number.
@@ -3304,6 +4244,7 @@ void EVE_cmd_number_burst(const int16_t xc0, const int16_t yc0, const uint16_t f
     spi_transmit_burst(i32_to_u32(number));
 }//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++----------------------------------------------------
 
+#if !defined (EVE_CMD_NO_CONTROLS)
 /**
  * @brief Draw a progress bar.
  */
@@ -3341,6 +4282,7 @@ void EVE_cmd_progress_burst(const int16_t xc0, const int16_t yc0, const uint16_t
     spi_transmit_burst(u16_u16_to_u32(options, val));
     spi_transmit_burst(u16_u16_to_u32(range, 0x0000));
 }
+#endif /* EVE_CMD_NO_CONTROLS */
 
 /**
  * @brief Load a ROM font into bitmap handle.
@@ -3374,6 +4316,7 @@ void EVE_cmd_romfont_burst(const uint32_t font, const uint32_t romslot)
     spi_transmit_burst(romslot);
 }
 
+#if !defined (EVE_CMD_NO_MATRIX)
 /**
  * @brief Apply a rotation to the current matrix.
  * @note - range for angle is 0...65535
@@ -3401,7 +4344,9 @@ void EVE_cmd_rotate_burst(const uint32_t angle)
     spi_transmit_burst(CMD_ROTATE);
     spi_transmit_burst(angle & 0xFFFFUL);
 }
+#endif /* EVE_CMD_NO_MATRIX */
 
+#if !defined (EVE_CMD_NO_MATRIX)
 /**
  * @brief Apply a scale to the current matrix.
  */
@@ -3431,7 +4376,9 @@ void EVE_cmd_scale_burst(const int32_t scx, const int32_t scy)
     spi_transmit_burst(i32_to_u32(scx));
     spi_transmit_burst(i32_to_u32(scy));
 }
+#endif /* EVE_CMD_NO_MATRIX */
 
+#if !defined (EVE_CMD_NO_MEDIA)
 /**
  * @brief Start an animated screensaver.
  */
@@ -3455,7 +4402,9 @@ void EVE_cmd_screensaver_burst(void)
 {
     spi_transmit_burst(CMD_SCREENSAVER);
 }
+#endif /* EVE_CMD_NO_MEDIA */
 
+#if !defined (EVE_CMD_NO_CONTROLS)
 /**
  * @brief Draw a scroll bar.
  */
@@ -3493,6 +4442,7 @@ void EVE_cmd_scrollbar_burst(const int16_t xc0, const int16_t yc0, const uint16_
     spi_transmit_burst(u16_u16_to_u32(options, val));
     spi_transmit_burst(u16_u16_to_u32(size, range));
 }
+#endif /* EVE_CMD_NO_CONTROLS */
 
 /**
  * @brief Set the base for number output.
@@ -3623,6 +4573,7 @@ void EVE_cmd_setfont2_burst(const uint32_t font, const uint32_t ptr, const uint3
     spi_transmit_burst(firstchar);
 }
 
+#if !defined (EVE_CMD_NO_MATRIX)
 /**
  * @brief Assign the value of the current matrix to the bitmap transform matrix.
  */
@@ -3646,6 +4597,7 @@ void EVE_cmd_setmatrix_burst(void)
 {
     spi_transmit_burst(CMD_SETMATRIX);
 }
+#endif /* EVE_CMD_NO_MATRIX */
 
 /**
  * @brief Set the scratch bitmap for widget use.
@@ -3674,6 +4626,7 @@ void EVE_cmd_setscratch_burst(const uint32_t handle)
     spi_transmit_burst(handle);
 }
 
+#if !defined (EVE_CMD_NO_MEDIA)
 /**
  * @brief Start a continuous sketch update.
  */
@@ -3711,7 +4664,9 @@ void EVE_cmd_sketch_burst(const int16_t xc0, const int16_t yc0, const uint16_t w
     spi_transmit_burst(ptr);
     spi_transmit_burst(u16_u16_to_u32(format, 0x0000));
 }
+#endif /* EVE_CMD_NO_MEDIA */
 
+#if !defined (EVE_CMD_NO_CONTROLS)
 /**
  * @brief Draw a slider.
  */
@@ -3749,7 +4704,9 @@ void EVE_cmd_slider_burst(const int16_t xc0, const int16_t yc0, const uint16_t w
     spi_transmit_burst(u16_u16_to_u32(options, val));
     spi_transmit_burst(u16_u16_to_u32(range, 0x0000));
 }
+#endif /* EVE_CMD_NO_CONTROLS */
 
+#if !defined (EVE_CMD_NO_CONTROLS)
 /**
  * @brief Start an animated spinner.
  */
@@ -3779,6 +4736,7 @@ void EVE_cmd_spinner_burst(const int16_t xc0, const int16_t yc0, const uint16_t
     spi_transmit_burst(i16_i16_to_u32(xc0, yc0));
     spi_transmit_burst(u16_u16_to_u32(style, scale));
 }
+#endif /* EVE_CMD_NO_CONTROLS */
 
 /**
  * @brief Stop periodic operation of CMD_SKETCH, CMD_SPINNER or CMD_SCREENSAVER.
@@ -3868,6 +4826,44 @@ void EVE_cmd_text_burst(const int16_t xc0, const int16_t yc0, const uint16_t fon
     private_string_write(p_text);
 }
 
+/**
+ * @brief Draw a text string that was packed at compile time with EVE_PACK_WORD().
+ * @param p_words the packed string, the word with the terminator ends it
+ * @param count the number of words in p_words[], usually EVE_PACKED_WORDS() of the literal
+ */
+void EVE_cmd_text_packed(const int16_t xc0, const int16_t yc0, const uint16_t font, const uint16_t options,
+                         const uint32_t * const p_words, const uint8_t count)
+{
+    if (0U == cmd_burst)
+    {
+        eve_begin_cmd(CMD_TEXT);
+        spi_transmit_32(i16_i16_to_u32(xc0, yc0));
+        spi_transmit_32(u16_u16_to_u32(font, options));
+        private_packed_write(p_words, count);
+        EVE_cs_clear();
+    }
+    else
+    {
+        spi_transmit_burst(CMD_TEXT);
+        spi_transmit_burst(i16_i16_to_u32(xc0, yc0));
+        spi_transmit_burst(u16_u16_to_u32(font, options));
+        private_packed_write(p_words, count);
+    }
+}
+
+/**
+ * @brief Draw a text string that was packed at compile time, only works in burst-mode.
+ */
+void EVE_cmd_text_packed_burst(const int16_t xc0, const int16_t yc0, const uint16_t font, const uint16_t options,
+                               const uint32_t * const p_words, const uint8_t count)
+{
+    spi_transmit_burst(CMD_TEXT);
+    spi_transmit_burst(i16_i16_to_u32(xc0, yc0));
+    spi_transmit_burst(u16_u16_to_u32(font, options));
+    private_packed_write(p_words, count);
+}
+
+#if !defined (EVE_CMD_NO_CONTROLS)
 /**
  * @brief Draw a toggle switch with labels.
  */
@@ -3905,7 +4901,9 @@ void EVE_cmd_toggle_burst(const int16_t xc0, const int16_t yc0, const uint16_t w
     spi_transmit_burst(u16_u16_to_u32(options, state));
     private_string_write(p_text);
 }
+#endif /* EVE_CMD_NO_CONTROLS */
 
+#if !defined (EVE_CMD_NO_MATRIX)
 /**
  * @brief Apply a translation to the current matrix.
  */
@@ -3935,6 +4933,7 @@ void EVE_cmd_translate_burst(const int32_t tr_x, const int32_t tr_y)
     spi_transmit_burst(i32_to_u32(tr_x));
     spi_transmit_burst(i32_to_u32(tr_y));
 }
+#endif /* EVE_CMD_NO_MATRIX */
 
 /* ##################################################################
     display list command functions for use with the coprocessor
@@ -3951,14 +4950,17 @@ void EVE_cmd_translate_burst(const int32_t tr_x, const int32_t tr_y)
  */
 void EVE_cmd_dl(const uint32_t command)
 {
-    if (0U == cmd_burst)
-    {
-        eve_begin_cmd(command);
-        EVE_cs_clear();
-    }
-    else
+    if (state_filter(command) != 0U)
     {
-        spi_transmit_burst(command);
+        if (0U == cmd_burst)
+        {
+            eve_begin_cmd(command);
+            EVE_cs_clear();
+        }
+        else
+        {
+            spi_transmit_burst(command);
+        }
     }
 }
 
@@ -3967,7 +4969,10 @@ void EVE_cmd_dl(const uint32_t command)
  */
 void EVE_cmd_dl_burst(const uint32_t command)
 {
-    spi_transmit_burst(command);
+    if (state_filter(command) != 0U)
+    {
+        spi_transmit_burst(command);
+    }
 }
 
 /**
@@ -3999,14 +5004,17 @@ void EVE_alpha_func_burst(const uint8_t func, const uint8_t ref)
  */
 void EVE_begin(const uint32_t prim)
 {
-    if (0U == cmd_burst)
-    {
-        eve_begin_cmd(DL_BEGIN | prim);
-        EVE_cs_clear();
-    }
-    else
+    if (state_filter(DL_BEGIN | prim) != 0U)
     {
-        spi_transmit_burst(DL_BEGIN | prim);
+        if (0U == cmd_burst)
+        {
+            eve_begin_cmd(DL_BEGIN | prim);
+            EVE_cs_clear();
+        }
+        else
+        {
+            spi_transmit_burst(DL_BEGIN | prim);
+        }
     }
 }
 
@@ -4015,7 +5023,10 @@ void EVE_begin(const uint32_t prim)
  */
 void EVE_begin_burst(const uint32_t prim)
 {
-    spi_transmit_burst(DL_BEGIN | prim);
+    if (state_filter(DL_BEGIN | prim) != 0U)
+    {
+        spi_transmit_burst(DL_BEGIN | prim);
+    }
 }
 
 /** * @brief Specify the bitmap handle.  */
@@ -4188,6 +5199,8 @@ void EVE_blend_func_burst(const uint8_t src, const uint8_t dst)
  */
 void EVE_call(const uint16_t dest)
 {
+    (void) state_filter(CALL(dest));
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CALL(dest));
@@ -4205,6 +5218,7 @@ void EVE_call(const uint16_t dest)
  */
 void EVE_call_burst(const uint16_t dest)
 {
+    (void) state_filter(CALL(dest));
     spi_transmit_burst(CALL(dest));
 }
 
@@ -4358,14 +5372,17 @@ void EVE_clear_tag_burst(const uint8_t val)
  */
 void EVE_color_rgb(const uint32_t color)
 {
-    if (0U == cmd_burst)
-    {
-        eve_begin_cmd(DL_COLOR_RGB | (color & 0x00ffffffUL));
-        EVE_cs_clear();
-    }
-    else
+    if (state_filter(DL_COLOR_RGB | (color & 0x00ffffffUL)) != 0U)
     {
-        spi_transmit_burst(DL_COLOR_RGB | (color & 0x00ffffffUL));
+        if (0U == cmd_burst)
+        {
+            eve_begin_cmd(DL_COLOR_RGB | (color & 0x00ffffffUL));
+            EVE_cs_clear();
+        }
+        else
+        {
+            spi_transmit_burst(DL_COLOR_RGB | (color & 0x00ffffffUL));
+        }
     }
 }
 
@@ -4374,7 +5391,10 @@ void EVE_color_rgb(const uint32_t color)
  */
 void EVE_color_rgb_burst(const uint32_t color)
 {
-    spi_transmit_burst(DL_COLOR_RGB | (color & 0x00ffffffUL));
+    if (state_filter(DL_COLOR_RGB | (color & 0x00ffffffUL)) != 0U)
+    {
+        spi_transmit_burst(DL_COLOR_RGB | (color & 0x00ffffffUL));
+    }
 }
 
 /**
@@ -4382,14 +5402,17 @@ void EVE_color_rgb_burst(const uint32_t color)
  */
 void EVE_color_a(const uint8_t alpha)
 {
-    if (0U == cmd_burst)
-    {
-        eve_begin_cmd(DL_COLOR_A | ((uint32_t) alpha));
-        EVE_cs_clear();
-    }
-    else
+    if (state_filter(DL_COLOR_A | ((uint32_t) alpha)) != 0U)
     {
-        spi_transmit_burst(DL_COLOR_A | ((uint32_t) alpha));
+        if (0U == cmd_burst)
+        {
+            eve_begin_cmd(DL_COLOR_A | ((uint32_t) alpha));
+            EVE_cs_clear();
+        }
+        else
+        {
+            spi_transmit_burst(DL_COLOR_A | ((uint32_t) alpha));
+        }
     }
 }
 
@@ -4398,7 +5421,10 @@ void EVE_color_a(const uint8_t alpha)
  */
 void EVE_color_a_burst(const uint8_t alpha)
 {
-    spi_transmit_burst(DL_COLOR_A | ((uint32_t) alpha));
+    if (state_filter(DL_COLOR_A | ((uint32_t) alpha)) != 0U)
+    {
+        spi_transmit_burst(DL_COLOR_A | ((uint32_t) alpha));
+    }
 }
 
 /**
@@ -4454,6 +5480,8 @@ void EVE_display_burst(void)
  */
 void EVE_end(void)
 {
+    (void) state_filter(DL_END);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(DL_END);
@@ -4470,6 +5498,7 @@ void EVE_end(void)
  */
 void EVE_end_burst(void)
 {
+    (void) state_filter(DL_END);
     spi_transmit_burst(DL_END);
 }
 
@@ -4479,6 +5508,8 @@ void EVE_end_burst(void)
  */
 void EVE_jump(const uint16_t dest)
 {
+    (void) state_filter(JUMP(dest));
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(JUMP(dest));
@@ -4496,6 +5527,7 @@ void EVE_jump(const uint16_t dest)
  */
 void EVE_jump_burst(const uint16_t dest)
 {
+    (void) state_filter(JUMP(dest));
     spi_transmit_burst(JUMP(dest));
 }
 
@@ -4504,14 +5536,17 @@ void EVE_jump_burst(const uint16_t dest)
  */
 void EVE_line_width(const uint16_t width)
 {
-    if (0U == cmd_burst)
-    {
-        eve_begin_cmd(LINE_WIDTH(width));
-        EVE_cs_clear();
-    }
-    else
+    if (state_filter(LINE_WIDTH(width)) != 0U)
     {
-        spi_transmit_burst(LINE_WIDTH(width));
+        if (0U == cmd_burst)
+        {
+            eve_begin_cmd(LINE_WIDTH(width));
+            EVE_cs_clear();
+        }
+        else
+        {
+            spi_transmit_burst(LINE_WIDTH(width));
+        }
     }
 }
 
@@ -4520,7 +5555,10 @@ void EVE_line_width(const uint16_t width)
  */
 void EVE_line_width_burst(const uint16_t width)
 {
-    spi_transmit_burst(LINE_WIDTH(width));
+    if (state_filter(LINE_WIDTH(width)) != 0U)
+    {
+        spi_transmit_burst(LINE_WIDTH(width));
+    }
 }
 
 /**
@@ -4529,6 +5567,8 @@ void EVE_line_width_burst(const uint16_t width)
  */
 void EVE_macro(const uint8_t macro)
 {
+    (void) state_filter(MACRO(macro));
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(MACRO(macro));
@@ -4546,6 +5586,7 @@ void EVE_macro(const uint8_t macro)
  */
 void EVE_macro_burst(const uint8_t macro)
 {
+    (void) state_filter(MACRO(macro));
     spi_transmit_burst(MACRO(macro));
 }
 
@@ -4604,14 +5645,17 @@ void EVE_palette_source_burst(const uint32_t addr)
  */
 void EVE_point_size(const uint16_t size)
 {
-    if (0U == cmd_burst)
+    if (state_filter(POINT_SIZE(size)) != 0U)
     {
-        eve_begin_cmd(POINT_SIZE(size));
-        EVE_cs_clear();
-    }
-    else
-    {
-        spi_transmit_burst(POINT_SIZE(size));
+        if (0U == cmd_burst)
+        {
+            eve_begin_cmd(POINT_SIZE(size));
+            EVE_cs_clear();
+        }
+        else
+        {
+            spi_transmit_burst(POINT_SIZE(size));
+        }
     }
 }
 
@@ -4620,7 +5664,10 @@ void EVE_point_size(const uint16_t size)
  */
 void EVE_point_size_burst(const uint16_t size)
 {
-    spi_transmit_burst(POINT_SIZE(size));
+    if (state_filter(POINT_SIZE(size)) != 0U)
+    {
+        spi_transmit_burst(POINT_SIZE(size));
+    }
 }
 
 /**
@@ -4628,6 +5675,8 @@ void EVE_point_size_burst(const uint16_t size)
  */
 void EVE_restore_context(void)
 {
+    (void) state_filter(DL_RESTORE_CONTEXT);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(DL_RESTORE_CONTEXT);
@@ -4644,6 +5693,7 @@ void EVE_restore_context(void)
  */
 void EVE_restore_context_burst(void)
 {
+    (void) state_filter(DL_RESTORE_CONTEXT);
     spi_transmit_burst(DL_RESTORE_CONTEXT);
 }
 
@@ -4652,6 +5702,8 @@ void EVE_restore_context_burst(void)
  */
 void EVE_return(void)
 {
+    (void) state_filter(DL_RETURN);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(DL_RETURN);
@@ -4668,6 +5720,7 @@ void EVE_return(void)
  */
 void EVE_return_burst(void)
 {
+    (void) state_filter(DL_RETURN);
     spi_transmit_burst(DL_RETURN);
 }
 
@@ -4676,6 +5729,8 @@ void EVE_return_burst(void)
  */
 void EVE_save_context(void)
 {
+    (void) state_filter(DL_SAVE_CONTEXT);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(DL_SAVE_CONTEXT);
@@ -4692,6 +5747,7 @@ void EVE_save_context(void)
  */
 void EVE_save_context_burst(void)
 {
+    (void) state_filter(DL_SAVE_CONTEXT);
     spi_transmit_burst(DL_SAVE_CONTEXT);
 }
 
@@ -4822,14 +5878,17 @@ void EVE_stencil_op_burst(const uint8_t sfail, const uint8_t spass)
  */
 void EVE_tag(const uint8_t tag)
 {
-    if (0U == cmd_burst)
-    {
-        eve_begin_cmd(DL_TAG | tag);
-        EVE_cs_clear();
-    }
-    else
+    if (state_filter(DL_TAG | tag) != 0U)
     {
-        spi_transmit_burst(DL_TAG | tag);
+        if (0U == cmd_burst)
+        {
+            eve_begin_cmd(DL_TAG | tag);
+            EVE_cs_clear();
+        }
+        else
+        {
+            spi_transmit_burst(DL_TAG | tag);
+        }
     }
 }
 
@@ -4838,7 +5897,10 @@ void EVE_tag(const uint8_t tag)
  */
 void EVE_tag_burst(const uint8_t tag)
 {
-    spi_transmit_burst(DL_TAG | tag);
+    if (state_filter(DL_TAG | tag) != 0U)
+    {
+        spi_transmit_burst(DL_TAG | tag);
+    }
 }
 
 /**
@@ -4915,10 +5977,18 @@ void EVE_vertex2ii_burst(const uint16_t xc0, const uint16_t yc0, const uint8_t h
 
 /*** @brief Set the precision of VERTEX2F coordinates.*/
 void EVE_vertex_format(const uint8_t frac){
-    if (0U == cmd_burst){ 
-        eve_begin_cmd(VERTEX_FORMAT(frac));
-        EVE_cs_clear();}
-    else{spi_transmit_burst(VERTEX_FORMAT(frac));}
+    if (state_filter(VERTEX_FORMAT(frac)) != 0U)
+    {
+        if (0U == cmd_burst)
+        {
+            eve_begin_cmd(VERTEX_FORMAT(frac));
+            EVE_cs_clear();
+        }
+        else
+        {
+            spi_transmit_burst(VERTEX_FORMAT(frac));
+        }
+    }
 }//----------------------------------------------------------
 
 /**
@@ -4926,7 +5996,10 @@ void EVE_vertex_format(const uint8_t frac){
  */
 void EVE_vertex_format_burst(const uint8_t frac)
 {
-    spi_transmit_burst(VERTEX_FORMAT(frac));
+    if (state_filter(VERTEX_FORMAT(frac)) != 0U)
+    {
+        spi_transmit_burst(VERTEX_FORMAT(frac));
+    }
 }
 
 /**
@@ -137,6 +137,14 @@ EVE_cmd_animstartram_burst()
 - added EVE_vertex_translate_x() / EVE_vertex_translate_x_burst()
 - added EVE_vertex_translate_y() / EVE_vertex_translate_y_burst()
 - added "const" statements for BARR-C:2018 / CERT C compliance
+- added EVE_FRAME_SKIPPED to the list of return codes
+- added prototypes for EVE_burst_frame(), EVE_get_frames_skipped() and EVE_frame_hash_invalidate()
+- added prototypes for EVE_journal_begin(), EVE_journal_end(), EVE_journal_replay() and EVE_journal_clear()
+- added prototypes for EVE_get_busy_waits() and EVE_get_busy_polls()
+- added prototypes for EVE_get_state_dropped() and EVE_state_invalidate()
+- added prototypes for EVE_start_dl_burst() and EVE_end_dl_burst()
+- the prototypes of the commands in EVE_CMD_NO_CONTROLS, EVE_CMD_NO_MEDIA and EVE_CMD_NO_MATRIX are left out with these
+- added EVE_PACKED_WORDS() / EVE_PACK_WORD() and prototypes for EVE_cmd_text_packed(), EVE_cmd_text_packed_burst()
 
 */
 
@@ -166,6 +174,7 @@ EVE_cmd_animstartram_burst()
 #define EVE_IS_BUSY 12U
 #define EVE_FIFO_HALF_EMPTY 13U
 #define EVE_FAULT_RECOVERED 14U
+#define EVE_FRAME_SKIPPED 15U
 
 #define EVE_FLASH_STATUS_INIT 0U
 #define EVE_FLASH_STATUS_DETACHED 1U
@@ -191,6 +200,20 @@ static inline uint32_t i32_to_u32(const int32_t arg1)
     return ((uint32_t) arg1);
 }
 
+/* ##################################################################
+    strings packed at compile time
+##################################################################### */
+
+/* Packs a string literal into the little endian words the coprocessor reads, for EVE_cmd_text_packed():
+ * #define TXT_HELLO "Hello"
+ * static const uint32_t txt_hello[EVE_PACKED_WORDS(TXT_HELLO)] = {EVE_PACK_WORD(TXT_HELLO, 0U), EVE_PACK_WORD(TXT_HELLO, 1U)}; */
+#define EVE_PACKED_WORDS(text) ((uint8_t) ((sizeof(text) + 3U) / 4U))
+#define EVE_PACK_CHAR(text, index) \
+    (((index) < sizeof(text)) ? ((uint32_t) ((uint8_t) (text)[((index) < sizeof(text)) ? (index) : 0U])) : 0UL)
+#define EVE_PACK_WORD(text, word) \
+    (EVE_PACK_CHAR(text, (4U * (word))) | (EVE_PACK_CHAR(text, ((4U * (word)) + 1U)) << 8U) | \
+    (EVE_PACK_CHAR(text, ((4U * (word)) + 2U)) << 16U) | (EVE_PACK_CHAR(text, ((4U * (word)) + 3U)) << 24U))
+
 /* ##################################################################
     helper functions
 ##################################################################### */
@@ -210,6 +233,29 @@ uint8_t EVE_busy(void);
 uint8_t EVE_get_and_reset_fault_state(void);
 void EVE_execute_cmd(void);
 
+#if defined (EVE_BACKOFF)
+uint32_t EVE_get_busy_waits(void);
+uint32_t EVE_get_busy_polls(void);
+#endif
+
+#if defined (EVE_FRAME_HASH)
+uint8_t EVE_burst_frame(void (* const p_build)(void));
+uint32_t EVE_get_frames_skipped(void);
+void EVE_frame_hash_invalidate(void);
+#endif
+
+#if defined (EVE_JOURNAL)
+void EVE_journal_begin(void);
+uint8_t EVE_journal_end(void);
+void EVE_journal_replay(void);
+void EVE_journal_clear(void);
+#endif
+
+#if defined (EVE_STATE_CACHE)
+uint32_t EVE_get_state_dropped(void);
+void EVE_state_invalidate(void);
+#endif
+
 /* ##################################################################
     commands and functions to be used outside of display-lists
 ##################################################################### */
@@ -247,7 +293,9 @@ void EVE_cmd_flashupdate(const uint32_t dest, const uint32_t src, const uint32_t
 void EVE_cmd_flashwrite(const uint32_t ptr, const uint32_t num, const uint8_t * const p_data);
 void EVE_cmd_inflate2(const uint32_t ptr, const uint32_t options, const uint8_t * const p_data, const uint32_t len);
 void EVE_cmd_resetfonts(void);
+#if !defined (EVE_CMD_NO_MEDIA)
 void EVE_cmd_videostartf(void);
+#endif
 
 #endif /* EVE_GEN > 2 */
 
@@ -257,22 +305,32 @@ uint32_t EVE_cmd_getptr(void);
 void EVE_cmd_inflate(const uint32_t ptr, const uint8_t * const p_data, const uint32_t len);
 void EVE_cmd_interrupt(const uint32_t msec);
 void EVE_cmd_loadimage(const uint32_t ptr, const uint32_t options, const uint8_t * const p_data, const uint32_t len);
+#if !defined (EVE_CMD_NO_MEDIA)
 void EVE_cmd_logo(void);
 void EVE_cmd_mediafifo(const uint32_t ptr, const uint32_t size);
+#endif
 void EVE_cmd_memcpy(const uint32_t dest, const uint32_t src, const uint32_t num);
 void EVE_cmd_memcpy_burst(const uint32_t dest, const uint32_t src, const uint32_t num);
 uint32_t EVE_cmd_memcrc(const uint32_t ptr, const uint32_t num);
 void EVE_cmd_memset(const uint32_t ptr, const uint8_t value, const uint32_t num);
 void EVE_cmd_memzero(const uint32_t ptr, const uint32_t num);
+#if !defined (EVE_CMD_NO_MEDIA)
 void EVE_cmd_playvideo(const uint32_t options, const uint8_t * const p_data, const uint32_t len);
+#endif
 void EVE_cmd_setrotate(const uint32_t rotation);
+#if !defined (EVE_CMD_NO_MEDIA)
 void EVE_cmd_snapshot(const uint32_t ptr);
 void EVE_cmd_snapshot2(const uint32_t fmt, const uint32_t ptr, const int16_t xc0, const int16_t yc0, const uint16_t wid, const uint16_t hgt);
+#endif
 void EVE_cmd_sync(void);
 void EVE_cmd_sync_burst(void);
+#if !defined (EVE_CMD_NO_CONTROLS)
 void EVE_cmd_track(const int16_t xc0, const int16_t yc0, const uint16_t wid, const uint16_t hgt, const uint16_t tag);
+#endif
+#if !defined (EVE_CMD_NO_MEDIA)
 void EVE_cmd_videoframe(const uint32_t dest, const uint32_t result_ptr);
 void EVE_cmd_videostart(void);
+#endif
 /*void EVE_cmd_memwrite(uint32_t dest, uint32_t num, const uint8_t *p_data);*/
 /*uint32_t EVE_cmd_regread(uint32_t ptr);*/
 
@@ -293,6 +351,8 @@ uint8_t EVE_init(void);
 
 void EVE_start_cmd_burst(void);
 void EVE_end_cmd_burst(void);
+void EVE_start_dl_burst(void);
+uint8_t EVE_end_dl_burst(const uint8_t swap);
 
 /* EVE4: BT817 / BT818 */
 #if EVE_GEN > 3
@@ -337,10 +397,14 @@ void EVE_cmd_bitmap_transform_burst(const int32_t xc0, const int32_t yc0, const
                                     const int32_t tx1, const int32_t ty1, const int32_t tx2, const int32_t ty2);
 void EVE_cmd_fillwidth(const uint32_t pixel);
 void EVE_cmd_fillwidth_burst(const uint32_t pixel);
+#if !defined (EVE_CMD_NO_CONTROLS)
 void EVE_cmd_gradienta(const int16_t xc0, const int16_t yc0, const uint32_t argb0, const int16_t xc1, const int16_t yc1, const uint32_t argb1);
 void EVE_cmd_gradienta_burst(const int16_t xc0, const int16_t yc0, const uint32_t argb0, const int16_t xc1, const int16_t yc1, const uint32_t argb1);
+#endif
+#if !defined (EVE_CMD_NO_MATRIX)
 void EVE_cmd_rotatearound(const int32_t xc0, const int32_t yc0, const uint32_t angle, const int32_t scale);
 void EVE_cmd_rotatearound_burst(const int32_t xc0, const int32_t yc0, const uint32_t angle, const int32_t scale);
+#endif
 
 void EVE_cmd_button_var(const int16_t xc0, const int16_t yc0, const uint16_t wid, const uint16_t hgt,
                         const uint16_t font, const uint16_t options, const char * const p_text,
@@ -384,22 +448,29 @@ void EVE_cmd_button(const int16_t xc0, const int16_t yc0, const uint16_t wid, co
 void EVE_cmd_button_burst(const int16_t xc0, const int16_t yc0, const uint16_t wid, const uint16_t hgt,
                             const uint16_t font, const uint16_t options, const char * const p_text);
 void EVE_cmd_calibrate(void);
+#if !defined (EVE_CMD_NO_CONTROLS)
 void EVE_cmd_clock(const int16_t xc0, const int16_t yc0, const uint16_t rad, const uint16_t options,
                     const uint16_t hours, const uint16_t mins, const uint16_t secs, const uint16_t msecs);
 void EVE_cmd_clock_burst(const int16_t xc0, const int16_t yc0, const uint16_t rad, const uint16_t options,
                             const uint16_t hours, const uint16_t mins, const uint16_t secs, const uint16_t msecs);
 void EVE_cmd_dial(const int16_t xc0, const int16_t yc0, const uint16_t rad, const uint16_t options, const uint16_t val);
 void EVE_cmd_dial_burst(const int16_t xc0, const int16_t yc0, const uint16_t rad, const uint16_t options, const uint16_t val);
+#endif
 void EVE_cmd_dlstart(void);
 void EVE_cmd_number_burst_bold(const int16_t xc0, const int16_t yc0, const uint16_t font, const uint16_t options, const int32_t number);
 void EVE_cmd_dlstart_burst(void);
 void EVE_cmd_fgcolor(const uint32_t color);
 void EVE_cmd_fgcolor_burst(const uint32_t color);
+#if !defined (EVE_CMD_NO_CONTROLS)
 void EVE_cmd_gauge(const int16_t xc0, const int16_t yc0, const uint16_t rad, const uint16_t options,
                     const uint16_t major, const uint16_t minor, const uint16_t val, const uint16_t range);
 void EVE_cmd_gauge_burst(const int16_t xc0, const int16_t yc0, const uint16_t rad, const uint16_t options,
                             const uint16_t major, const uint16_t minor, const uint16_t val, const uint16_t range);
+#endif
+#if !defined (EVE_CMD_NO_MATRIX)
 void EVE_cmd_getmatrix(int32_t * const p_a, int32_t * const p_b, int32_t * const p_c, int32_t * const p_d, int32_t * const p_e, int32_t * const p_f);
+#endif
+#if !defined (EVE_CMD_NO_CONTROLS)
 void EVE_cmd_gradcolor(const uint32_t color);
 void EVE_cmd_gradcolor_burst(const uint32_t color);
 void EVE_cmd_gradient(const int16_t xc0, const int16_t yc0, const uint32_t rgb0, const int16_t xc1, const int16_t yc1, const uint32_t rgb1);
@@ -408,26 +479,37 @@ void EVE_cmd_keys(const int16_t xc0, const int16_t yc0, const uint16_t wid, cons
                     const uint16_t font, const uint16_t options, const char * const p_text);
 void EVE_cmd_keys_burst(const int16_t xc0, const int16_t yc0, const uint16_t wid, const uint16_t hgt,
                         const uint16_t font, const uint16_t options, const char * const p_text);
+#endif
+#if !defined (EVE_CMD_NO_MATRIX)
 void EVE_cmd_loadidentity(void);
 void EVE_cmd_loadidentity_burst(void);
+#endif
 void EVE_cmd_number(const int16_t xc0, const int16_t yc0, const uint16_t font, const uint16_t options, const int32_t number);
 void EVE_cmd_number_burst(const int16_t xc0, const int16_t yc0, const uint16_t font, const uint16_t options, const int32_t number);
+#if !defined (EVE_CMD_NO_CONTROLS)
 void EVE_cmd_progress(const int16_t xc0, const int16_t yc0, const uint16_t wid, const uint16_t hgt,
                         const uint16_t options, const uint16_t val, const uint16_t range);
 void EVE_cmd_progress_burst(const int16_t xc0, const int16_t yc0, const uint16_t wid, const uint16_t hgt,
                             const uint16_t options, const uint16_t val, const uint16_t range);
+#endif
 void EVE_cmd_romfont(const uint32_t font, const uint32_t romslot);
 void EVE_cmd_romfont_burst(const uint32_t font, const uint32_t romslot);
+#if !defined (EVE_CMD_NO_MATRIX)
 void EVE_cmd_rotate(const uint32_t angle);
 void EVE_cmd_rotate_burst(const uint32_t angle);
 void EVE_cmd_scale(const int32_t scx, const int32_t scy);
 void EVE_cmd_scale_burst(const int32_t scx, const int32_t scy);
+#endif
+#if !defined (EVE_CMD_NO_MEDIA)
 void EVE_cmd_screensaver(void);
 void EVE_cmd_screensaver_burst(void);
+#endif
+#if !defined (EVE_CMD_NO_CONTROLS)
 void EVE_cmd_scrollbar(const int16_t xc0, const int16_t yc0, const uint16_t wid, const uint16_t hgt,
                         const uint16_t options, const uint16_t val, const uint16_t size, const uint16_t range);
 void EVE_cmd_scrollbar_burst(const int16_t xc0, const int16_t yc0, const uint16_t wid, const uint16_t hgt,
                                 const uint16_t options, const uint16_t val, const uint16_t size, const uint16_t range);
+#endif
 void EVE_cmd_setbase(const uint32_t base);
 void EVE_cmd_setbase_burst(const uint32_t base);
 void EVE_cmd_setbitmap(const uint32_t addr, const uint16_t fmt, const uint16_t width, const uint16_t height);
@@ -436,20 +518,26 @@ void EVE_cmd_setfont(const uint32_t font, const uint32_t ptr);
 void EVE_cmd_setfont_burst(const uint32_t font, const uint32_t ptr);
 void EVE_cmd_setfont2(const uint32_t font, const uint32_t ptr, const uint32_t firstchar);
 void EVE_cmd_setfont2_burst(const uint32_t font, const uint32_t ptr, const uint32_t firstchar);
+#if !defined (EVE_CMD_NO_MATRIX)
 void EVE_cmd_setmatrix(void);
 void EVE_cmd_setmatrix_burst(void);
+#endif
 void EVE_cmd_setscratch(const uint32_t handle);
 void EVE_cmd_setscratch_burst(const uint32_t handle);
+#if !defined (EVE_CMD_NO_MEDIA)
 void EVE_cmd_sketch(const int16_t xc0, const int16_t yc0, const uint16_t wid, const uint16_t hgt,
                     const uint32_t ptr, const uint16_t format);
 void EVE_cmd_sketch_burst(const int16_t xc0, const int16_t yc0, const uint16_t wid, const uint16_t hgt,
                             const uint32_t ptr, const uint16_t format);
+#endif
+#if !defined (EVE_CMD_NO_CONTROLS)
 void EVE_cmd_slider(const int16_t xc0, const int16_t yc0, const uint16_t wid, const uint16_t hgt,
                     const uint16_t options, const uint16_t val, const uint16_t range);
 void EVE_cmd_slider_burst(const int16_t xc0, const int16_t yc0, const uint16_t wid, const uint16_t hgt,
                             const uint16_t options, const uint16_t val, const uint16_t range);
 void EVE_cmd_spinner(const int16_t xc0, const int16_t yc0, const uint16_t style, const uint16_t scale);
 void EVE_cmd_spinner_burst(const int16_t xc0, const int16_t yc0, const uint16_t style, const uint16_t scale);
+#endif
 void EVE_cmd_stop(void);
 void EVE_cmd_stop_burst(void);
 void EVE_cmd_swap(void);
@@ -457,12 +545,20 @@ void EVE_cmd_swap_burst(void);
 void EVE_cmd_text_bold(const int16_t xc0, const int16_t yc0, const uint16_t font, const uint16_t options, const char * const p_text);
 void EVE_cmd_text(const int16_t xc0, const int16_t yc0, const uint16_t font, const uint16_t options, const char * const p_text);
 void EVE_cmd_text_burst(const int16_t xc0, const int16_t yc0, const uint16_t font, const uint16_t options, const char * const p_text);
+void EVE_cmd_text_packed(const int16_t xc0, const int16_t yc0, const uint16_t font, const uint16_t options,
+                         const uint32_t * const p_words, const uint8_t count);
+void EVE_cmd_text_packed_burst(const int16_t xc0, const int16_t yc0, const uint16_t font, const uint16_t options,
+                               const uint32_t * const p_words, const uint8_t count);
+#if !defined (EVE_CMD_NO_CONTROLS)
 void EVE_cmd_toggle(const int16_t xc0, const int16_t yc0, const uint16_t wid, const uint16_t font,
                     const uint16_t options, const uint16_t state, const char * const p_text);
 void EVE_cmd_toggle_burst(const int16_t xc0, const int16_t yc0, const uint16_t wid, const uint16_t font,
                             const uint16_t options, const uint16_t state, const char * const p_text);
+#endif
+#if !defined (EVE_CMD_NO_MATRIX)
 void EVE_cmd_translate(const int32_t tr_x, const int32_t tr_y);
 void EVE_cmd_translate_burst(const int32_t tr_x, const int32_t tr_y);
+#endif
 
 /* ##################################################################
     display list command functions for use with the coprocessor
@@ -35,4 +35,25 @@
 #define EVE_ROTATE INVERT    // invertir o no la pantalla 
 #define PRESICION  PRESICION_  //PRESICION PIXEL
 
+//OPCIONES DE LA LIBRERIA EVE++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//#define EVE_FRAME_HASH  // EVE_burst_frame() no envia frames identicos al que ya esta en pantalla
+                          // sin DMA arma cada frame dos veces y aqui el reloj cambia los ms en cada frame,
+                          // nunca hay dos iguales, solo conviene con DMA o en pantallas que se quedan quietas
+#define EVE_JOURNAL     // EVE_busy() repite el estado del coprocesador de TFT_init() despues de una falla
+#define EVE_JOURNAL_SIZE 8U // palabras de 32 bits, alcanza para el bgcolor de TFT_init()
+#if (defined (ARDUINO) || defined (SOFTWARE_TEST)) && !defined (EVE_NO_BACKOFF) // solo esos targets tienen EVE_DELAY_US()
+#define EVE_BACKOFF     // EVE_execute_cmd() espera el tiempo estimado antes de leer REG_CMDB_SPACE
+#endif
+#if !defined (EVE_NO_STATE_CACHE) // EVE_NO_STATE_CACHE para comparar el display-list sin el
+#define EVE_STATE_CACHE // color, ancho de linea, tag y BEGIN solo se envian cuando cambian
+#endif
+#define EVE_STATE_STACK 2U // niveles de SAVE_CONTEXT que se siguen, ahorra RAM en el Nano
+#define EVE_HANDLES_FIRST 2U // EVE_handles usa 2...14, el 0 queda para EVE_cmd_setbitmap() y el 1 es SIGNAL_HANDLE
+#define EVE_TEXT_FONTS 1U // EVE_text guarda las medidas de una sola fuente ROM (RELOJ_FONT), 98 bytes
+#define EVE_GLYPHCACHE_CELLS 10U // glifos UTF-8 en RAM_G, 4 bytes de RAM por celda, solo los 10 fijos de "Ningún usuario"
+#define EVE_CMD_NO_CONTROLS // sin gauge, slider, keys ni los demas controles, solo se usan text, number y button
+#define EVE_CMD_NO_MEDIA    // sin video, snapshot, sketch, logo ni screensaver
+#define EVE_CMD_NO_MATRIX   // sin loadidentity / rotate / setmatrix..., EVE_matrix calcula la matriz en el host
+//#define EVE_MULTI_TOUCH // solo con touch capacitivo, EVE_gesture lee los cinco puntos de una vez
+
 #endif
\ No newline at end of file
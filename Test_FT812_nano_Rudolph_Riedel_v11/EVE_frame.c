@@ -0,0 +1,253 @@
+/*
+@file    EVE_frame.c
+@brief   frame scheduler that is locked to REG_FRAMES / REG_DLSWAP instead of a timer on the host
+@version 1.2
+@date    2026-10-18
+@author  Christian Lara
+
+@section info
+
+A new display-list is only started right after the previous swap became visible, so the
+time from reading the inputs to the swap is the same for every frame.
+
+How to use:
+- EVE_frame_init() once after EVE_init()
+- poll EVE_frame_ready() as often as possible, when it returns E_OK read the touch and build the frame,
+    with a host timer the polls outside of a window around the predicted VSYNC return without any SPI transfer
+- call EVE_frame_submit() after EVE_end_cmd_burst(), not when the frame was not sent at all
+
+Swap policies:
+- EVE_DLSWAP_FRAME - the display-list ends with CMD_SWAP, the swap lands with the next VSYNC
+- EVE_DLSWAP_LINE - the display-list ends without CMD_SWAP, REG_DLSWAP is written by EVE_frame_ready()
+    as soon as the co-processor is done, the swap lands after the current line, this has less
+    latency but may show a tear line
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+1.1
+- added EVE_frame_submit_count() and EVE_frame_swap_count() so EVE_surface can tell when a buffer left the screen
+
+1.2
+- EVE_frame_ready() predicts the next VSYNC from the host timer and EVE_frame_period_us() and does no SPI transfer before it
+
+*/
+
+#include "EVE_frame.h"
+
+#if defined (ARDUINO)
+#define FRAME_MICROS() micros()
+#elif defined (SOFTWARE_TEST)
+#define FRAME_MICROS() EVE_test_time_us()
+#endif
+
+static uint8_t frame_policy = EVE_DLSWAP_FRAME;
+static uint8_t frame_interval = 1U; /* number of panel frames per frame */
+static uint8_t frame_pending = 0U; /* a frame was submitted and its swap is not visible yet */
+static uint8_t frame_swap_issued = 0U; /* REG_DLSWAP was written for EVE_DLSWAP_LINE */
+static uint32_t frame_start = 0U; /* value of REG_FRAMES when the last frame was started */
+static uint32_t frame_submitted = 0U; /* value of REG_FRAMES when the last frame was submitted */
+static uint16_t frame_elapsed = 0U;
+static uint32_t frame_period = 0U;
+static uint8_t frame_latency = 0U;
+static uint32_t frame_latency_us = 0U;
+static uint32_t frame_submits = 0U; /* frames passed to EVE_frame_submit() */
+static uint32_t frame_swaps = 0U; /* of these, the frames that were seen on screen */
+
+#if defined (FRAME_MICROS)
+static uint32_t frame_submitted_us = 0U;
+static uint32_t frame_next_us = 0U; /* start of the window in which the next VSYNC is expected */
+static uint32_t frame_poll_us = 0U; /* time of the last call to EVE_frame_ready() */
+#endif
+
+/**
+ * @brief Set up the scheduler, needs to be called after EVE_init().
+ * @param policy - EVE_DLSWAP_FRAME or EVE_DLSWAP_LINE
+ * @param interval - number of panel frames per frame, 1 for every VSYNC
+ */
+void EVE_frame_init(const uint8_t policy, const uint8_t interval)
+{
+    uint32_t const hcycle = EVE_memRead16(REG_HCYCLE);
+    uint32_t const vcycle = EVE_memRead16(REG_VCYCLE);
+
+    frame_policy = policy;
+    frame_interval = (interval > 0U) ? interval : 1U;
+    frame_pending = 0U;
+    frame_swap_issued = 0U;
+
+#if defined (EVE_PCLK_FREQ)
+    frame_period = (uint32_t) (((uint64_t) hcycle * vcycle * 1000000ULL) / EVE_PCLK_FREQ);
+#else
+    /* REG_PCLK divides the system clock */
+    frame_period = (hcycle * vcycle * EVE_memRead8(REG_PCLK)) / (EVE_memRead32(REG_FREQUENCY) / 1000000UL);
+#endif
+
+    frame_start = EVE_memRead32(REG_FRAMES) - frame_interval; /* the first frame can be started right away */
+#if defined (FRAME_MICROS)
+    frame_next_us = FRAME_MICROS();
+    frame_poll_us = frame_next_us;
+#endif
+}
+
+/**
+ * @brief Check if the next frame should be built now.
+ * @note - Also issues the swap for EVE_DLSWAP_LINE and measures the latency of the previous frame.
+ * @return - E_OK - the previous swap is visible and the next frame is due, build it now
+ * @return - EVE_IS_BUSY - wait
+ */
+uint8_t EVE_frame_ready(void)
+{
+    uint8_t ret = EVE_IS_BUSY;
+#if defined (FRAME_MICROS)
+    uint32_t const now = FRAME_MICROS();
+    uint32_t const previous = frame_poll_us;
+    /* REG_FRAMES and REG_DLSWAP do not change before the next VSYNC, only the line swap is not tied to it */
+    uint8_t const due = (((int32_t) (now - frame_next_us) >= 0) ||
+                         ((frame_pending != 0U) && (EVE_DLSWAP_LINE == frame_policy))) ? 1U : 0U;
+
+    frame_poll_us = now;
+#else
+    uint8_t const due = 1U;
+#endif
+
+    if ((due != 0U) && (frame_pending != 0U))
+    {
+        if (E_OK == EVE_busy()) /* the co-processor needs to be done with the list before REG_DLSWAP tells anything */
+        {
+            if ((EVE_DLSWAP_LINE == frame_policy) && (0U == frame_swap_issued))
+            {
+                EVE_memWrite8(REG_DLSWAP, EVE_DLSWAP_LINE);
+                frame_swap_issued = 1U;
+            }
+            else if (EVE_DLSWAP_DONE == EVE_memRead8(REG_DLSWAP))
+            {
+                frame_latency = (uint8_t) (EVE_memRead32(REG_FRAMES) - frame_submitted);
+#if defined (FRAME_MICROS)
+                frame_latency_us = FRAME_MICROS() - frame_submitted_us;
+#else
+                frame_latency_us = (uint32_t) frame_latency * frame_period;
+#endif
+                frame_pending = 0U;
+                frame_swaps = frame_submits;
+            }
+            else
+            {
+                /* swap is waiting for VSYNC */
+            }
+        }
+    }
+
+    if ((due != 0U) && (0U == frame_pending))
+    {
+        uint32_t const frames = EVE_memRead32(REG_FRAMES);
+
+        if ((frames - frame_start) >= frame_interval)
+        {
+            frame_elapsed = (uint16_t) (frames - frame_start);
+            frame_start = frames;
+            ret = E_OK;
+#if defined (FRAME_MICROS)
+            /* the VSYNC was between the previous call and this one, the margin is for the tolerance of the clocks */
+            frame_next_us = previous + (frame_interval * frame_period) - (frame_period / 256U);
+#endif
+        }
+    }
+
+#if defined (FRAME_MICROS)
+    if ((frame_pending != 0U) && (frame_policy != EVE_DLSWAP_LINE) &&
+        ((int32_t) (now - frame_next_us - (frame_period / 4U)) >= 0))
+    {
+        frame_next_us += frame_period; /* the swap missed this VSYNC, it can only land with the next one */
+    }
+#endif
+
+    return (ret);
+}
+
+/**
+ * @brief Mark the frame that was just sent as waiting for its swap.
+ */
+void EVE_frame_submit(void)
+{
+    frame_submitted = EVE_memRead32(REG_FRAMES);
+#if defined (FRAME_MICROS)
+    frame_submitted_us = FRAME_MICROS();
+#endif
+    frame_swap_issued = 0U;
+    frame_pending = 1U;
+    frame_submits++;
+}
+
+/**
+ * @brief Number of panel frames between the last two frames, to advance animations and clocks.
+ */
+uint16_t EVE_frame_elapsed(void)
+{
+    return (frame_elapsed);
+}
+
+/**
+ * @brief Duration of one panel frame in micro-seconds, calculated from the display timing registers.
+ */
+uint32_t EVE_frame_period_us(void)
+{
+    return (frame_period);
+}
+
+/**
+ * @brief Number of VSYNCs between EVE_frame_submit() and the swap becoming visible for the last frame.
+ */
+uint8_t EVE_frame_latency(void)
+{
+    return (frame_latency);
+}
+
+/**
+ * @brief Time in micro-seconds from EVE_frame_submit() until the swap was seen to be visible.
+ * @note - Measured with micros() on Arduino, the resolution is the polling rate of EVE_frame_ready().
+ * Without a host timer this is EVE_frame_latency() times EVE_frame_period_us().
+ */
+uint32_t EVE_frame_latency_us(void)
+{
+    return (frame_latency_us);
+}
+
+/**
+ * @brief Number of frames passed to EVE_frame_submit() so far.
+ */
+uint32_t EVE_frame_submit_count(void)
+{
+    return (frame_submits);
+}
+
+/**
+ * @brief Number of submitted frames whose swap was seen to be done, EVE_frame_submit_count() once the last one is visible.
+ */
+uint32_t EVE_frame_swap_count(void)
+{
+    return (frame_swaps);
+}
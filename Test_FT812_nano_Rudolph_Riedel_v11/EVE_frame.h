@@ -0,0 +1,65 @@
+/*
+@file    EVE_frame.h
+@brief   prototypes for the frame scheduler that is locked to REG_FRAMES / REG_DLSWAP
+@version 1.1
+@date    2026-10-18
+@author  Christian Lara
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+1.1
+- added EVE_frame_submit_count() and EVE_frame_swap_count()
+
+*/
+
+#ifndef EVE_FRAME_H
+#define EVE_FRAME_H
+
+#include "EVE.h"
+#include "EVE_commands.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+void EVE_frame_init(const uint8_t policy, const uint8_t interval);
+uint8_t EVE_frame_ready(void);
+void EVE_frame_submit(void);
+uint16_t EVE_frame_elapsed(void);
+uint32_t EVE_frame_period_us(void);
+uint8_t EVE_frame_latency(void);
+uint32_t EVE_frame_latency_us(void);
+uint32_t EVE_frame_submit_count(void);
+uint32_t EVE_frame_swap_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_FRAME_H */
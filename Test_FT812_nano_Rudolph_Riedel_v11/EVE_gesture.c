@@ -0,0 +1,302 @@
+/*
+@file    EVE_gesture.c
+@brief   multi-touch capture with one SPI transfer per sample and a fixed-point gesture recognizer
+@version 1.0
+@date    2026-10-18
+@author  Christian Lara
+
+@section info
+
+With EVE_MULTI_TOUCH the capacitive touch engine is switched to extended mode and the five
+touch points are read with a single transfer of the 120 bytes from REG_CTOUCH_TOUCH1_XY (0x30211c)
+to REG_CTOUCH_TOUCH3_XY (0x302190), reading them one by one would be five transfers.
+Without EVE_MULTI_TOUCH only the 12 bytes from REG_TOUCH_SCREEN_XY to REG_TOUCH_TAG are read,
+REG_CTOUCH_EXTENDED is not touched as it is REG_TOUCH_ADC_MODE for resistive touch.
+
+The recognizer only uses integer math, the distance between two points is approximated
+with max + 3/8 min which is within 7% of the real distance and the same error applies to
+the start distance of a pinch.
+
+How to use:
+- EVE_gesture_init() once after EVE_init()
+- while the screen is touched, call EVE_gesture_capture() and EVE_gesture_update() once per frame,
+  keep calling both until EVE_gesture_active() returns 0 to finish the gesture after the release
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#include "EVE_gesture.h"
+
+#ifndef NULL /* define NULL if it not already is */
+#include <stdio.h>
+#endif
+
+#define GESTURE_IDLE 0U
+#define GESTURE_TRACKING 1U
+#define GESTURE_DONE 2U /* long-press or pinch were reported, the release does not report a swipe */
+
+#if defined (EVE_MULTI_TOUCH)
+#define CAPTURE_ADDRESS REG_CTOUCH_TOUCH1_XY
+#define CAPTURE_SIZE 120U
+#else
+#define CAPTURE_ADDRESS REG_TOUCH_SCREEN_XY
+#define CAPTURE_SIZE 12U
+#endif
+
+static uint8_t gesture_state = GESTURE_IDLE;
+static uint8_t gesture_tag = 0U;
+static uint16_t gesture_time = 0U;
+static int16_t gesture_x0 = 0;
+static int16_t gesture_y0 = 0;
+static int16_t gesture_xl = 0;
+static int16_t gesture_yl = 0;
+static uint16_t pinch_start = 0U;
+static uint16_t pinch_scale = 256U;
+
+static int16_t read_i16(const uint8_t * const p_data, uint8_t const offset)
+{
+    return ((int16_t) ((uint16_t) p_data[offset] | ((uint16_t) p_data[offset + 1U] << 8U)));
+}
+
+static int16_t abs_i16(int16_t const value)
+{
+    return ((value < 0) ? (int16_t) -value : value);
+}
+
+/* alpha max plus beta min approximation of the distance */
+static uint16_t distance(int16_t const dx, int16_t const dy)
+{
+    uint16_t const adx = (uint16_t) abs_i16(dx);
+    uint16_t const ady = (uint16_t) abs_i16(dy);
+    uint16_t const dmax = (adx > ady) ? adx : ady;
+    uint16_t const dmin = (adx > ady) ? ady : adx;
+
+    return ((uint16_t) (dmax + ((3U * dmin) >> 3U)));
+}
+
+/**
+ * @brief Set up the touch engine for the capture.
+ */
+void EVE_gesture_init(void)
+{
+#if defined (EVE_MULTI_TOUCH)
+    EVE_memWrite8(REG_CTOUCH_EXTENDED, 0U); /* 0 = extended mode with up to five touch points */
+#endif
+    gesture_state = GESTURE_IDLE;
+}
+
+/**
+ * @brief Read all touch points with a single SPI transfer.
+ * @return - the number of points that are touched
+ */
+uint8_t EVE_gesture_capture(EVE_touch_points_t * const p_points)
+{
+    uint8_t regs[CAPTURE_SIZE];
+    uint8_t count = 0U;
+
+    if (p_points != NULL)
+    {
+        EVE_memRead_sram_buffer(CAPTURE_ADDRESS, regs, CAPTURE_SIZE);
+
+#if defined (EVE_MULTI_TOUCH)
+        p_points->yc0[0] = read_i16(regs, 0x08U); /* REG_CTOUCH_TOUCH0_XY */
+        p_points->xc0[0] = read_i16(regs, 0x0aU);
+        p_points->yc0[1] = read_i16(regs, 0x00U); /* REG_CTOUCH_TOUCH1_XY */
+        p_points->xc0[1] = read_i16(regs, 0x02U);
+        p_points->yc0[2] = read_i16(regs, 0x70U); /* REG_CTOUCH_TOUCH2_XY */
+        p_points->xc0[2] = read_i16(regs, 0x72U);
+        p_points->yc0[3] = read_i16(regs, 0x74U); /* REG_CTOUCH_TOUCH3_XY */
+        p_points->xc0[3] = read_i16(regs, 0x76U);
+        p_points->yc0[4] = read_i16(regs, 0x04U); /* REG_CTOUCH_TOUCH4_Y */
+        p_points->xc0[4] = read_i16(regs, 0x50U); /* REG_CTOUCH_TOUCH4_X */
+        p_points->tag = regs[0x10U]; /* REG_TOUCH_TAG */
+#else
+        p_points->yc0[0] = read_i16(regs, 0x00U); /* REG_TOUCH_SCREEN_XY */
+        p_points->xc0[0] = read_i16(regs, 0x02U);
+        p_points->tag = regs[0x08U]; /* REG_TOUCH_TAG */
+#endif
+
+        for (uint8_t index = 0U; index < EVE_TOUCH_POINTS; index++)
+        {
+            if (p_points->xc0[index] != EVE_TOUCH_NONE)
+            {
+                count++;
+            }
+        }
+        p_points->count = count;
+    }
+    return (count);
+}
+
+/**
+ * @brief Feed one sample into the recognizer.
+ * @param elapsed_ms - time since the last sample
+ * @return - EVE_GESTURE_xxx, p_gesture is filled for anything other than EVE_GESTURE_NONE
+ * @note - Swipes are reported on release, a long-press once after EVE_GESTURE_LONG_PRESS_MS without moving
+ * more than EVE_GESTURE_SLOP, a pinch for every change of the scale by EVE_GESTURE_PINCH_STEP.
+ */
+uint8_t EVE_gesture_update(const EVE_touch_points_t * const p_points, const uint16_t elapsed_ms, EVE_gesture_t * const p_gesture)
+{
+    uint8_t ret = EVE_GESTURE_NONE;
+    int16_t xc0 = EVE_TOUCH_NONE;
+    int16_t yc0 = EVE_TOUCH_NONE;
+    int16_t xc1 = EVE_TOUCH_NONE;
+    int16_t yc1 = EVE_TOUCH_NONE;
+
+    if ((NULL == p_points) || (NULL == p_gesture))
+    {
+        return (ret);
+    }
+
+    /* the first two points that are touched */
+    for (uint8_t index = 0U; index < EVE_TOUCH_POINTS; index++)
+    {
+        if (p_points->xc0[index] != EVE_TOUCH_NONE)
+        {
+            if (EVE_TOUCH_NONE == xc0)
+            {
+                xc0 = p_points->xc0[index];
+                yc0 = p_points->yc0[index];
+            }
+            else if (EVE_TOUCH_NONE == xc1)
+            {
+                xc1 = p_points->xc0[index];
+                yc1 = p_points->yc0[index];
+            }
+            else
+            {
+                /* only two points are used */
+            }
+        }
+    }
+
+    if (0U == p_points->count)
+    {
+        if (GESTURE_TRACKING == gesture_state)
+        {
+            int16_t const dx = (int16_t) (gesture_xl - gesture_x0);
+            int16_t const dy = (int16_t) (gesture_yl - gesture_y0);
+
+            if (gesture_time <= EVE_GESTURE_SWIPE_MAX_MS)
+            {
+                if ((abs_i16(dx) >= EVE_GESTURE_SWIPE_MIN) && (abs_i16(dx) > (2 * abs_i16(dy))))
+                {
+                    ret = (dx < 0) ? EVE_GESTURE_SWIPE_LEFT : EVE_GESTURE_SWIPE_RIGHT;
+                }
+                else if ((abs_i16(dy) >= EVE_GESTURE_SWIPE_MIN) && (abs_i16(dy) > (2 * abs_i16(dx))))
+                {
+                    ret = (dy < 0) ? EVE_GESTURE_SWIPE_UP : EVE_GESTURE_SWIPE_DOWN;
+                }
+                else
+                {
+                    /* a tap, the tag handling takes care of it */
+                }
+            }
+            p_gesture->dx = dx;
+            p_gesture->dy = dy;
+        }
+        gesture_state = GESTURE_IDLE;
+    }
+    else if (GESTURE_IDLE == gesture_state)
+    {
+        gesture_state = GESTURE_TRACKING;
+        gesture_tag = p_points->tag;
+        gesture_time = 0U;
+        gesture_x0 = xc0;
+        gesture_y0 = yc0;
+        gesture_xl = xc0;
+        gesture_yl = yc0;
+        pinch_start = 0U;
+        pinch_scale = 256U;
+    }
+    else
+    {
+        gesture_time = ((gesture_time + elapsed_ms) < gesture_time) ? 0xffffU : (uint16_t) (gesture_time + elapsed_ms);
+        gesture_xl = xc0;
+        gesture_yl = yc0;
+
+        if (xc1 != EVE_TOUCH_NONE)
+        {
+            uint16_t const dist = distance((int16_t) (xc1 - xc0), (int16_t) (yc1 - yc0));
+
+            if (0U == pinch_start)
+            {
+                pinch_start = (dist > 0U) ? dist : 1U;
+            }
+            else
+            {
+                uint16_t const scale = (uint16_t) (((uint32_t) dist << 8U) / pinch_start);
+                uint16_t const diff = (scale > pinch_scale) ? (uint16_t) (scale - pinch_scale) : (uint16_t) (pinch_scale - scale);
+
+                if (diff >= EVE_GESTURE_PINCH_STEP)
+                {
+                    pinch_scale = scale;
+                    p_gesture->scale = scale;
+                    gesture_state = GESTURE_DONE;
+                    ret = EVE_GESTURE_PINCH;
+                }
+            }
+        }
+        else if ((GESTURE_TRACKING == gesture_state) && (gesture_time >= EVE_GESTURE_LONG_PRESS_MS))
+        {
+            if ((abs_i16((int16_t) (xc0 - gesture_x0)) <= EVE_GESTURE_SLOP) &&
+                (abs_i16((int16_t) (yc0 - gesture_y0)) <= EVE_GESTURE_SLOP))
+            {
+                gesture_state = GESTURE_DONE;
+                ret = EVE_GESTURE_LONG_PRESS;
+            }
+        }
+        else
+        {
+            /* keep tracking */
+        }
+        p_gesture->dx = (int16_t) (xc0 - gesture_x0);
+        p_gesture->dy = (int16_t) (yc0 - gesture_y0);
+    }
+
+    if (ret != EVE_GESTURE_NONE)
+    {
+        p_gesture->type = ret;
+        p_gesture->tag = gesture_tag;
+        if (ret != EVE_GESTURE_PINCH)
+        {
+            p_gesture->scale = 256U;
+        }
+    }
+    return (ret);
+}
+
+/**
+ * @brief Check if a gesture is in progress and more samples are needed.
+ */
+uint8_t EVE_gesture_active(void)
+{
+    return ((gesture_state != GESTURE_IDLE) ? 1U : 0U);
+}
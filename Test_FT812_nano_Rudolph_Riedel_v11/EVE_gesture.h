@@ -0,0 +1,107 @@
+/*
+@file    EVE_gesture.h
+@brief   prototypes for the multi-touch capture and the gesture recognizer
+@version 1.0
+@date    2026-10-18
+@author  Christian Lara
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#ifndef EVE_GESTURE_H
+#define EVE_GESTURE_H
+
+#include "EVE_touch.h"
+
+/* define EVE_MULTI_TOUCH for capacitive touch controllers (FT813 / BT815 / BT817) to use all five touch points,
+   without it only the first touch point is used which also works with resistive touch (FT812 / BT816) */
+#if defined (EVE_MULTI_TOUCH)
+#define EVE_TOUCH_POINTS 5U
+#else
+#define EVE_TOUCH_POINTS 1U
+#endif
+
+/* thresholds, distances in pixels, times in ms */
+#if !defined (EVE_GESTURE_SWIPE_MIN)
+#define EVE_GESTURE_SWIPE_MIN 60
+#endif
+#if !defined (EVE_GESTURE_SWIPE_MAX_MS)
+#define EVE_GESTURE_SWIPE_MAX_MS 600U
+#endif
+#if !defined (EVE_GESTURE_LONG_PRESS_MS)
+#define EVE_GESTURE_LONG_PRESS_MS 800U
+#endif
+#if !defined (EVE_GESTURE_SLOP)
+#define EVE_GESTURE_SLOP 12
+#endif
+#if !defined (EVE_GESTURE_PINCH_STEP)
+#define EVE_GESTURE_PINCH_STEP 16U /* minimum change of the scale in 1/256 to report a pinch */
+#endif
+
+#define EVE_GESTURE_NONE        0U
+#define EVE_GESTURE_SWIPE_LEFT  1U
+#define EVE_GESTURE_SWIPE_RIGHT 2U
+#define EVE_GESTURE_SWIPE_UP    3U
+#define EVE_GESTURE_SWIPE_DOWN  4U
+#define EVE_GESTURE_PINCH       5U
+#define EVE_GESTURE_LONG_PRESS  6U
+
+typedef struct
+{
+    int16_t xc0[EVE_TOUCH_POINTS]; /* EVE_TOUCH_NONE (-32768) for points that are not touched */
+    int16_t yc0[EVE_TOUCH_POINTS];
+    uint8_t count; /* number of points that are touched */
+    uint8_t tag; /* REG_TOUCH_TAG */
+} EVE_touch_points_t;
+
+typedef struct
+{
+    uint8_t type; /* EVE_GESTURE_xxx */
+    uint8_t tag; /* tag at the start of the gesture */
+    int16_t dx; /* movement since the start of the gesture */
+    int16_t dy;
+    uint16_t scale; /* pinch: distance of the first two points relative to the start, 8.8 fixed point, 256 = 1.0 */
+} EVE_gesture_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+void EVE_gesture_init(void);
+uint8_t EVE_gesture_capture(EVE_touch_points_t * const p_points);
+uint8_t EVE_gesture_update(const EVE_touch_points_t * const p_points, const uint16_t elapsed_ms, EVE_gesture_t * const p_gesture);
+uint8_t EVE_gesture_active(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_GESTURE_H */
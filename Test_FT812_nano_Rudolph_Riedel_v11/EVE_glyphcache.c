@@ -0,0 +1,555 @@
+/*
+@file    EVE_glyphcache.c
+@brief   glyph cache that uploads only the glyphs of a UTF-8 font a string needs
+@version 1.0
+@date    2026-10-19
+@author  Christian Lara
+
+@section info
+
+FT81x has no CMD_FONTCACHE, a font for UTF-8 text either goes to RAM_G in full or not at all.
+Here the master font stays in the flash of the host, as generated by tools/eve_glyph_pack,
+and RAM_G only holds EVE_GLYPHCACHE_CELLS glyph cells, these are the cells of one bitmap handle.
+EVE_glyphcache_prepare() decodes the string, every code point that has no cell yet is written
+with EVE_memWrite_flash_buffer() to a free cell or to the one that was not used for the
+longest time. EVE_glyphcache_text_burst() draws the string with BEGIN(BITMAPS) and one VERTEX2II
+per glyph, the cell of the glyph is the cell of VERTEX2II.
+
+EVE_glyphcache_prepare() goes before the burst, it writes to RAM_G.
+EVE_glyphcache_commit() after the frame was sent, same as EVE_handles_commit(). A cell is only
+replaced when the last three frames did not use it, one of these can still be on the screen
+and the other one in the display list that waits for the swap. The glyphs of the static part
+of the display list are set with EVE_glyphcache_pin() and are not replaced at all.
+When a string needs more cells than are free it is drawn without the glyphs that are missing
+and EVE_glyphcache_prepare() returns E_NOT_OK, same for glyphs that are not in the master font.
+
+The handle comes from EVE_handle_assign(), EVE_handles_prologue_burst() sets it up.
+The position is the top left corner of the cell like with CMD_TEXT, EVE_OPT_CENTERX,
+EVE_OPT_CENTERY and EVE_OPT_RIGHTX work the same, other options are ignored.
+Spaces only advance and have no cell, code points beyond U+FFFF are replaced with U+FFFD.
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#include "EVE_glyphcache.h"
+#include "EVE_handles.h"
+
+#ifndef NULL /* define NULL if it not already is */
+#include <stdio.h>
+#endif
+
+#define GLYPH_SPACE 0x20U
+#define GLYPH_INVALID 0xfffdU
+#define GLYPH_FREE 0U /* code of a cell that has no glyph */
+#define GLYPH_AGE_SAFE 3U /* frames a cell has to be unused before it can be replaced */
+#define GLYPH_AGE_MAX 0xfeU
+#define GLYPH_AGE_PINNED 0xffU
+#define GLYPH_VERTEX_MAX 511L /* VERTEX2II has 9 bits for x and y */
+#define GLYPH_NONE EVE_GLYPHCACHE_CELLS
+
+typedef struct
+{
+    uint16_t code;
+    uint8_t advance;
+    uint8_t age; /* frames since the last use */
+} glyph_cell_t;
+
+static glyph_cell_t glyph_cells[EVE_GLYPHCACHE_CELLS];
+static EVE_glyph_font_t const *p_glyph_font = NULL;
+static EVE_asset_t glyph_asset = {0U, 0U, 0U, 0U, 0U, 0U};
+static uint8_t glyph_handle = EVE_HANDLE_NONE;
+static uint16_t glyph_cell_bytes = 0U;
+static uint8_t glyph_space = 0U; /* advance of the space */
+static uint8_t glyph_burst = 0U;
+static uint32_t glyph_uploaded = 0U; /* bytes written to RAM_G since EVE_glyphcache_init() */
+
+/* same linestride as CMD_SETBITMAP uses */
+static uint16_t glyph_stride(uint16_t const format, uint16_t const width)
+{
+    uint16_t stride = width;
+
+    if (EVE_L1 == format)
+    {
+        stride = (width + 7U) / 8U;
+    }
+    else if (EVE_L2 == format)
+    {
+        stride = (width + 3U) / 4U;
+    }
+    else if (EVE_L4 == format)
+    {
+        stride = (width + 1U) / 2U;
+    }
+    else
+    {
+        /* EVE_L8 */
+    }
+    return (stride);
+}
+
+/* the next code point of the string, 0 at the end */
+static uint16_t glyph_decode(const uint8_t ** const pp_bytes)
+{
+    const uint8_t *p_bytes = *pp_bytes;
+    uint32_t code = *p_bytes;
+    uint8_t follow = 0U;
+
+    if (code != 0U)
+    {
+        p_bytes++;
+
+        if (code >= 0xf0U)
+        {
+            code &= 0x07U;
+            follow = 3U;
+        }
+        else if (code >= 0xe0U)
+        {
+            code &= 0x0fU;
+            follow = 2U;
+        }
+        else if (code >= 0xc0U)
+        {
+            code &= 0x1fU;
+            follow = 1U;
+        }
+        else if (code >= 0x80U)
+        {
+            code = GLYPH_INVALID; /* continuation byte without a start */
+        }
+        else
+        {
+            /* ASCII */
+        }
+
+        for (; follow > 0U; follow--)
+        {
+            if ((*p_bytes & 0xc0U) != 0x80U)
+            {
+                code = GLYPH_INVALID; /* the sequence is cut short, the byte that follows is not used up */
+                break;
+            }
+            code = (code << 6U) | (*p_bytes & 0x3fU);
+            p_bytes++;
+        }
+
+        if ((code > 0xffffU) || (GLYPH_FREE == code))
+        {
+            code = GLYPH_INVALID;
+        }
+        *pp_bytes = p_bytes;
+    }
+    return ((uint16_t) code);
+}
+
+/* binary search in the code points of the master font */
+static uint8_t glyph_find_master(uint16_t const code, uint16_t * const p_index)
+{
+    uint16_t low = 0U;
+    uint16_t high = p_glyph_font->count;
+    uint8_t ret = E_NOT_OK;
+
+    while (low < high)
+    {
+        uint16_t const middle = (uint16_t) ((low + high) / 2U);
+        const uint8_t *const p_code = &p_glyph_font->p_codes[(uint32_t) middle * 2U];
+        uint16_t const found = (uint16_t) fetch_flash_byte(p_code) | ((uint16_t) fetch_flash_byte(&p_code[1U]) << 8U);
+
+        if (found == code)
+        {
+            *p_index = middle;
+            ret = E_OK;
+            break;
+        }
+
+        if (found < code)
+        {
+            low = middle + 1U;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return (ret);
+}
+
+static uint8_t glyph_find_cell(uint16_t const code)
+{
+    uint8_t cell = 0U;
+
+    while ((cell < EVE_GLYPHCACHE_CELLS) && (glyph_cells[cell].code != code))
+    {
+        cell++;
+    }
+    return (cell);
+}
+
+/* a free cell first, otherwise the one that was not used for the longest time */
+static uint8_t glyph_victim(void)
+{
+    uint8_t victim = GLYPH_NONE;
+    uint16_t oldest = 0U;
+
+    for (uint8_t cell = 0U; cell < EVE_GLYPHCACHE_CELLS; cell++)
+    {
+        uint16_t age = glyph_cells[cell].age;
+
+        if (GLYPH_FREE == glyph_cells[cell].code)
+        {
+            age = 0x100U;
+        }
+
+        if ((age != GLYPH_AGE_PINNED) && (age >= GLYPH_AGE_SAFE) && (age > oldest))
+        {
+            oldest = age;
+            victim = cell;
+        }
+    }
+    return (victim);
+}
+
+static uint8_t glyph_prepare(const char * const p_text, uint8_t const pin)
+{
+    uint8_t ret = E_NOT_OK;
+
+    if ((p_glyph_font != NULL) && (p_text != NULL))
+    {
+        const uint8_t *p_bytes = (const uint8_t *) p_text;
+        uint16_t code;
+
+        ret = E_OK;
+        while ((code = glyph_decode(&p_bytes)) != 0U)
+        {
+            uint8_t cell = GLYPH_NONE;
+            uint16_t index;
+
+            if (GLYPH_SPACE != code)
+            {
+                cell = glyph_find_cell(code);
+                if ((GLYPH_NONE == cell) && (E_OK == glyph_find_master(code, &index)))
+                {
+                    cell = glyph_victim();
+                    if (cell != GLYPH_NONE)
+                    {
+                        EVE_memWrite_flash_buffer(glyph_asset.source + ((uint32_t) cell * glyph_cell_bytes),
+                                                  &p_glyph_font->p_cells[(uint32_t) index * glyph_cell_bytes],
+                                                  glyph_cell_bytes);
+                        glyph_uploaded += glyph_cell_bytes;
+                        glyph_cells[cell].code = code;
+                        glyph_cells[cell].advance = fetch_flash_byte(&p_glyph_font->p_advance[index]);
+                    }
+                }
+
+                if (GLYPH_NONE == cell)
+                {
+                    ret = E_NOT_OK;
+                }
+                else if ((pin != 0U) || (glyph_cells[cell].age != GLYPH_AGE_PINNED))
+                {
+                    glyph_cells[cell].age = (pin != 0U) ? GLYPH_AGE_PINNED : 0U;
+                }
+                else
+                {
+                    /* stays pinned */
+                }
+            }
+        }
+    }
+    return (ret);
+}
+
+static uint8_t glyph_advance(uint16_t const code, uint8_t const cell)
+{
+    uint8_t advance = 0U;
+    uint16_t index;
+
+    if (GLYPH_SPACE == code)
+    {
+        advance = glyph_space;
+    }
+    else if (cell != GLYPH_NONE)
+    {
+        advance = glyph_cells[cell].advance;
+    }
+    else if (E_OK == glyph_find_master(code, &index))
+    {
+        advance = fetch_flash_byte(&p_glyph_font->p_advance[index]);
+    }
+    else
+    {
+        /* not in the master font */
+    }
+    return (advance);
+}
+
+static uint16_t glyph_measure(const uint8_t *p_bytes)
+{
+    uint16_t width = 0U;
+    uint16_t code;
+
+    while ((code = glyph_decode(&p_bytes)) != 0U)
+    {
+        width += glyph_advance(code, glyph_find_cell(code));
+    }
+    return (width);
+}
+
+static void glyph_put(uint32_t const word)
+{
+    if (0U == glyph_burst)
+    {
+        EVE_cmd_dl(word);
+    }
+    else
+    {
+        EVE_cmd_dl_burst(word);
+    }
+}
+
+static void glyph_emit(int16_t const xc0, int16_t const yc0, uint16_t const options, const uint8_t * const p_text)
+{
+    const uint8_t *p_bytes = p_text;
+    int32_t xpos = xc0;
+    int32_t ypos = yc0;
+    int32_t origin_x = 0;
+    int32_t origin_y = 0;
+    uint8_t begin = 0U;
+    uint16_t code;
+
+    if ((options & EVE_OPT_RIGHTX) != 0U)
+    {
+        xpos -= (int32_t) glyph_measure(p_text);
+    }
+    else if ((options & EVE_OPT_CENTERX) != 0U)
+    {
+        xpos -= (int32_t) (glyph_measure(p_text) / 2U);
+    }
+    else
+    {
+        /* starts at xc0 */
+    }
+
+    if ((options & EVE_OPT_CENTERY) != 0U)
+    {
+        ypos -= (int32_t) (p_glyph_font->height / 2U);
+    }
+
+    while ((code = glyph_decode(&p_bytes)) != 0U)
+    {
+        uint8_t const cell = (GLYPH_SPACE == code) ? GLYPH_NONE : glyph_find_cell(code);
+
+        if (cell != GLYPH_NONE)
+        {
+            if (0U == begin)
+            {
+                begin = 1U;
+                glyph_put(DL_BEGIN | EVE_BITMAPS);
+
+                if ((ypos < 0) || (ypos > GLYPH_VERTEX_MAX))
+                {
+                    origin_y = ypos;
+                    glyph_put(VERTEX_TRANSLATE_Y(origin_y * 16L));
+                }
+            }
+
+            if (((xpos - origin_x) < 0) || ((xpos - origin_x) > GLYPH_VERTEX_MAX))
+            {
+                origin_x = xpos;
+                glyph_put(VERTEX_TRANSLATE_X(origin_x * 16L));
+            }
+
+            glyph_put(VERTEX2II((uint16_t) (xpos - origin_x), (uint16_t) (ypos - origin_y), glyph_handle, cell));
+        }
+        xpos += (int32_t) glyph_advance(code, cell);
+    }
+
+    if (origin_x != 0)
+    {
+        glyph_put(VERTEX_TRANSLATE_X(0L));
+    }
+
+    if (origin_y != 0)
+    {
+        glyph_put(VERTEX_TRANSLATE_Y(0L));
+    }
+}
+
+/**
+ * @brief Set the master font and the RAM_G area of the cache, all cells are free after this.
+ * @param address needs EVE_glyphcache_size() bytes, 4 byte aligned
+ * @return the bitmap handle from EVE_handle_assign() or EVE_HANDLE_NONE
+ * @note - the master font has to stay in place as long as the cache is used
+ */
+uint8_t EVE_glyphcache_init(EVE_glyph_font_t const * const p_font, uint32_t const address)
+{
+    uint16_t index;
+
+    if (glyph_handle != EVE_HANDLE_NONE)
+    {
+        EVE_handle_release(glyph_handle);
+        glyph_handle = EVE_HANDLE_NONE;
+    }
+    p_glyph_font = NULL;
+
+    if ((p_font != NULL) && (p_font->count != 0U))
+    {
+        p_glyph_font = p_font;
+        glyph_cell_bytes = glyph_stride(p_font->format, p_font->width) * p_font->height;
+        glyph_uploaded = 0U;
+
+        for (uint8_t cell = 0U; cell < EVE_GLYPHCACHE_CELLS; cell++)
+        {
+            glyph_cells[cell].code = GLYPH_FREE;
+            glyph_cells[cell].advance = 0U;
+            glyph_cells[cell].age = GLYPH_AGE_MAX;
+        }
+
+        glyph_space = (uint8_t) (p_font->width / 3U);
+        if (E_OK == glyph_find_master(GLYPH_SPACE, &index))
+        {
+            glyph_space = fetch_flash_byte(&p_font->p_advance[index]);
+        }
+
+        glyph_asset.source = address;
+        glyph_asset.format = p_font->format;
+        glyph_asset.width = p_font->width;
+        glyph_asset.height = p_font->height;
+        glyph_handle = EVE_handle_assign(&glyph_asset);
+    }
+    return (glyph_handle);
+}
+
+/**
+ * @brief Bytes of RAM_G the cache needs for the master font.
+ */
+uint32_t EVE_glyphcache_size(EVE_glyph_font_t const * const p_font)
+{
+    uint32_t size = 0U;
+
+    if (p_font != NULL)
+    {
+        size = (uint32_t) glyph_stride(p_font->format, p_font->width) * p_font->height * EVE_GLYPHCACHE_CELLS;
+    }
+    return (size);
+}
+
+/**
+ * @brief Upload the glyphs of a string that are not in the cache yet.
+ * @return E_OK or E_NOT_OK when a glyph is not in the master font or no cell could be replaced
+ * @note - not in burst-mode, before EVE_start_cmd_burst() / EVE_burst_frame()
+ */
+uint8_t EVE_glyphcache_prepare(const char * const p_text)
+{
+    return (glyph_prepare(p_text, 0U));
+}
+
+/**
+ * @brief Same as EVE_glyphcache_prepare() but the cells are not replaced again, for the static part of the display list.
+ */
+uint8_t EVE_glyphcache_pin(const char * const p_text)
+{
+    return (glyph_prepare(p_text, 1U));
+}
+
+/**
+ * @brief Release the pinned cells, for when the static part of the display list is replaced.
+ */
+void EVE_glyphcache_unpin(void)
+{
+    for (uint8_t cell = 0U; cell < EVE_GLYPHCACHE_CELLS; cell++)
+    {
+        if (GLYPH_AGE_PINNED == glyph_cells[cell].age)
+        {
+            glyph_cells[cell].age = 0U; /* still on the screen */
+        }
+    }
+}
+
+/**
+ * @brief The frame was sent, the cells it uses are one frame older now.
+ */
+void EVE_glyphcache_commit(void)
+{
+    for (uint8_t cell = 0U; cell < EVE_GLYPHCACHE_CELLS; cell++)
+    {
+        if (glyph_cells[cell].age < GLYPH_AGE_MAX)
+        {
+            glyph_cells[cell].age++;
+        }
+    }
+}
+
+/**
+ * @brief Width of a string in pixels, glyphs that are not in the master font have no width.
+ */
+uint16_t EVE_glyphcache_width(const char * const p_text)
+{
+    uint16_t width = 0U;
+
+    if ((p_glyph_font != NULL) && (p_text != NULL))
+    {
+        width = glyph_measure((const uint8_t *) p_text);
+    }
+    return (width);
+}
+
+/**
+ * @brief Draw a string from the cache, for the static part of the display list.
+ */
+void EVE_glyphcache_text(int16_t const xc0, int16_t const yc0, uint16_t const options, const char * const p_text)
+{
+    if ((p_glyph_font != NULL) && (p_text != NULL))
+    {
+        glyph_burst = 0U;
+        glyph_emit(xc0, yc0, options, (const uint8_t *) p_text);
+    }
+}
+
+/**
+ * @brief Draw a string from the cache, only works in burst-mode.
+ */
+void EVE_glyphcache_text_burst(int16_t const xc0, int16_t const yc0, uint16_t const options,
+                               const char * const p_text)
+{
+    if ((p_glyph_font != NULL) && (p_text != NULL))
+    {
+        glyph_burst = 1U;
+        glyph_emit(xc0, yc0, options, (const uint8_t *) p_text);
+    }
+}
+
+/**
+ * @brief Bytes written to RAM_G since EVE_glyphcache_init().
+ */
+uint32_t EVE_glyphcache_uploaded(void)
+{
+    return (glyph_uploaded);
+}
@@ -0,0 +1,86 @@
+/*
+@file    EVE_glyphcache.h
+@brief   prototypes for the glyph cache that uploads only the glyphs of a UTF-8 font a string needs
+@version 1.0
+@date    2026-10-19
+@author  Christian Lara
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#ifndef EVE_GLYPHCACHE_H
+#define EVE_GLYPHCACHE_H
+
+#include "EVE.h"
+#include "EVE_commands.h"
+
+/* number of glyphs in RAM_G, every cell takes 4 bytes of RAM on the host, VERTEX2II allows 128 cells */
+#if !defined (EVE_GLYPHCACHE_CELLS)
+#define EVE_GLYPHCACHE_CELLS 32U
+#endif
+
+#if (EVE_GLYPHCACHE_CELLS > 127U)
+#error "EVE_GLYPHCACHE_CELLS has to be 127 or less"
+#endif
+
+/* the master font, all arrays are in the flash of the host, eve_glyph_pack generates it */
+typedef struct
+{
+    const uint8_t *p_codes; /* the code points, two bytes little endian each, sorted ascending */
+    const uint8_t *p_advance; /* advance in pixels, one byte per glyph */
+    const uint8_t *p_cells; /* the glyph bitmaps, one cell after the other in the order of p_codes */
+    uint16_t count; /* number of glyphs */
+    uint16_t format; /* EVE_L1, EVE_L4 or EVE_L8 */
+    uint16_t width; /* of a cell in pixels */
+    uint16_t height; /* of a cell in pixels, the baseline is at the same row in all cells */
+} EVE_glyph_font_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+uint8_t EVE_glyphcache_init(EVE_glyph_font_t const * const p_font, uint32_t const address);
+uint32_t EVE_glyphcache_size(EVE_glyph_font_t const * const p_font);
+uint8_t EVE_glyphcache_prepare(const char * const p_text);
+uint8_t EVE_glyphcache_pin(const char * const p_text);
+void EVE_glyphcache_unpin(void);
+void EVE_glyphcache_commit(void);
+uint16_t EVE_glyphcache_width(const char * const p_text);
+void EVE_glyphcache_text(int16_t const xc0, int16_t const yc0, uint16_t const options, const char * const p_text);
+void EVE_glyphcache_text_burst(int16_t const xc0, int16_t const yc0, uint16_t const options,
+                               const char * const p_text);
+uint32_t EVE_glyphcache_uploaded(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_GLYPHCACHE_H */
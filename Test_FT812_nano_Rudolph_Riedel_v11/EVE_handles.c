@@ -0,0 +1,220 @@
+/*
+@file    EVE_handles.c
+@brief   persistent assignment of bitmap handles to images and fonts in RAM_G
+@version 1.1
+@date    2026-10-19
+@author  Christian Lara
+
+@section info
+
+The bitmap handles keep their BITMAP_SOURCE, BITMAP_LAYOUT and BITMAP_SIZE from one display list
+to the next, the same goes for the fonts the coprocessor knows from CMD_SETFONT2.
+So instead of a EVE_cmd_setbitmap() in front of every use, an asset gets a handle once with
+EVE_handle_assign() and the frame only needs BEGIN(BITMAPS) and VERTEX2II(x, y, handle, 0)
+or the handle as font number for EVE_cmd_text().
+
+The handle is set up by the prologue, EVE_handles_prologue_burst() goes into the frame
+before anything uses the handles, it only has content when an assignment changed.
+EVE_handles_commit() after the frame was sent, the prologue of a frame that was built but
+not sent is repeated in the next one. As the frame can be built twice, building it does not
+change anything here.
+
+After EVE_get_and_reset_fault_state() returned EVE_FAULT_RECOVERED, EVE_handles_invalidate()
+has all handles set up again as the coprocessor forgot the fonts.
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+1.1
+- fix: a handle that was released and assigned again between the prologue and EVE_handles_commit() was not set up
+- fix: EVE_handles_commit() after EVE_handles_invalidate() cleared the handles of the prologue before
+
+*/
+
+#include "EVE_handles.h"
+
+#ifndef NULL /* define NULL if it not already is */
+#include <stdio.h>
+#endif
+
+#define HANDLES_COUNT ((EVE_HANDLES_LAST - EVE_HANDLES_FIRST) + 1U)
+
+static EVE_asset_t const *handle_asset[HANDLES_COUNT]; /* NULL - the handle is free */
+static uint16_t handle_dirty = 0U; /* the handle needs to be set up by the prologue */
+static uint16_t handle_sent = 0U; /* set up by the prologue of the frame that was built last */
+
+/**
+ * @brief Assign a handle to an asset, an asset that already has one gets the same handle back.
+ * @return - the handle, EVE_HANDLE_NONE if all handles are in use
+ */
+uint8_t EVE_handle_assign(EVE_asset_t const * const p_asset)
+{
+    uint8_t ret = EVE_HANDLE_NONE;
+    uint8_t free_slot = EVE_HANDLE_NONE;
+
+    if (p_asset != NULL)
+    {
+        for (uint8_t index = 0U; index < HANDLES_COUNT; index++)
+        {
+            if (handle_asset[index] == p_asset)
+            {
+                ret = index;
+                break;
+            }
+            if ((NULL == handle_asset[index]) && (EVE_HANDLE_NONE == free_slot))
+            {
+                free_slot = index;
+            }
+        }
+
+        if ((EVE_HANDLE_NONE == ret) && (free_slot != EVE_HANDLE_NONE))
+        {
+            handle_asset[free_slot] = p_asset;
+            handle_dirty |= (uint16_t) (1U << free_slot);
+            ret = free_slot;
+        }
+
+        if (ret != EVE_HANDLE_NONE)
+        {
+            ret += EVE_HANDLES_FIRST;
+        }
+    }
+    return (ret);
+}
+
+/**
+ * @brief Free a handle, it can be assigned again once no display list uses it anymore.
+ */
+void EVE_handle_release(uint8_t const handle)
+{
+    uint8_t const index = (uint8_t) (handle - EVE_HANDLES_FIRST); /* wraps around for handles below EVE_HANDLES_FIRST */
+
+    if (index < HANDLES_COUNT)
+    {
+        handle_asset[index] = NULL;
+        handle_dirty &= (uint16_t) ~(1U << index);
+        handle_sent &= (uint16_t) ~(1U << index); /* a commit must not clear an assignment that came after the prologue */
+    }
+}
+
+static void handles_setup(uint8_t const index, uint8_t const burst)
+{
+    EVE_asset_t const * const p_asset = handle_asset[index];
+    uint8_t const handle = index + EVE_HANDLES_FIRST;
+
+    if (burst != 0U)
+    {
+        if (p_asset->font != 0U)
+        {
+            EVE_cmd_setfont2_burst(handle, p_asset->source, p_asset->first_char);
+        }
+        else
+        {
+            EVE_bitmap_handle_burst(handle);
+            EVE_cmd_setbitmap_burst(p_asset->source, p_asset->format, p_asset->width, p_asset->height);
+        }
+    }
+    else
+    {
+        if (p_asset->font != 0U)
+        {
+            EVE_cmd_setfont2(handle, p_asset->source, p_asset->first_char);
+        }
+        else
+        {
+            EVE_bitmap_handle(handle);
+            EVE_cmd_setbitmap(p_asset->source, p_asset->format, p_asset->width, p_asset->height);
+        }
+    }
+}
+
+static void handles_prologue(uint8_t const burst)
+{
+    handle_sent = handle_dirty;
+
+    if (handle_dirty != 0U)
+    {
+        for (uint8_t index = 0U; index < HANDLES_COUNT; index++)
+        {
+            if ((handle_dirty & (uint16_t) (1U << index)) != 0U)
+            {
+                handles_setup(index, burst);
+            }
+        }
+
+        /* code that uses EVE_cmd_setbitmap() without selecting a handle expects handle 0 */
+        if (burst != 0U)
+        {
+            EVE_bitmap_handle_burst(0U);
+        }
+        else
+        {
+            EVE_bitmap_handle(0U);
+        }
+    }
+}
+
+/**
+ * @brief Set up the handles that changed, at the start of the display list.
+ */
+void EVE_handles_prologue(void)
+{
+    handles_prologue(0U);
+}
+
+/**
+ * @brief Set up the handles that changed, at the start of the display list, only works in burst-mode.
+ */
+void EVE_handles_prologue_burst(void)
+{
+    handles_prologue(1U);
+}
+
+/**
+ * @brief The frame with the last prologue was sent, these handles are set up now.
+ */
+void EVE_handles_commit(void)
+{
+    handle_dirty &= (uint16_t) ~handle_sent;
+    handle_sent = 0U;
+}
+
+/**
+ * @brief Set up all assigned handles again with the next prologue.
+ */
+void EVE_handles_invalidate(void)
+{
+    for (uint8_t index = 0U; index < HANDLES_COUNT; index++)
+    {
+        if (handle_asset[index] != NULL)
+        {
+            handle_dirty |= (uint16_t) (1U << index);
+        }
+    }
+    handle_sent = 0U; /* the frame that is still to be committed did not set up anything */
+}
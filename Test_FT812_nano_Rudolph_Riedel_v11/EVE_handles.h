@@ -0,0 +1,83 @@
+/*
+@file    EVE_handles.h
+@brief   prototypes for the persistent assignment of bitmap handles to images and fonts in RAM_G
+@version 1.0
+@date    2026-10-18
+@author  Christian Lara
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#ifndef EVE_HANDLES_H
+#define EVE_HANDLES_H
+
+#include "EVE.h"
+#include "EVE_commands.h"
+
+/* the handles the manager hands out, 15 is the scratch handle of the coprocessor
+   and handles that are set up by other code every frame need to be left out */
+#if !defined (EVE_HANDLES_FIRST)
+#define EVE_HANDLES_FIRST 0U
+#endif
+
+#if !defined (EVE_HANDLES_LAST)
+#define EVE_HANDLES_LAST 14U
+#endif
+
+#define EVE_HANDLE_NONE 0xffU
+
+/* the caller keeps the asset, the manager only stores a pointer to it */
+typedef struct
+{
+    uint32_t source; /* address of the bitmap in RAM_G, for a font the address of the font metric block */
+    uint16_t format; /* EVE_ARGB1555, EVE_RGB565 ..., not used for fonts */
+    uint16_t width; /* not used for fonts */
+    uint16_t height; /* not used for fonts */
+    uint8_t font; /* 0 - bitmap, 1 - font for EVE_cmd_setfont2() */
+    uint8_t first_char; /* first character of the font */
+} EVE_asset_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+uint8_t EVE_handle_assign(EVE_asset_t const * const p_asset);
+void EVE_handle_release(uint8_t const handle);
+void EVE_handles_prologue(void);
+void EVE_handles_prologue_burst(void);
+void EVE_handles_commit(void);
+void EVE_handles_invalidate(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_HANDLES_H */
@@ -0,0 +1,300 @@
+/*
+@file    EVE_matrix.c
+@brief   the bitmap transform matrix computed on the host
+@version 1.0
+@date    2026-10-18
+@author  Christian Lara
+
+@section info
+
+EVE_cmd_loadidentity(), EVE_cmd_translate(), EVE_cmd_rotate(), EVE_cmd_scale() and EVE_cmd_setmatrix()
+have the coprocessor build the matrix for every frame, that is nine or more words in the CMD-FIFO
+and the coprocessor needs to work them off before it gets to the next command.
+The functions here do the same math on the host with the same 16.16 matrix and the same order of
+operations, EVE_matrix_set() only writes BITMAP_TRANSFORM_A...F to the display list, six words.
+
+Like with the coprocessor the matrix maps screen pixels to bitmap pixels, each call applies the
+inverse of its transform in front of the current matrix:
+EVE_matrix_translate(&m, 50 * EVE_MATRIX_ONE, 50 * EVE_MATRIX_ONE);
+EVE_matrix_rotate(&m, angle);
+EVE_matrix_translate(&m, -50 * EVE_MATRIX_ONE, -50 * EVE_MATRIX_ONE);
+rotates a 100x100 bitmap around its center.
+
+The sine and cosine are calculated to 30 bits and are not rounded to 16.16 before they are
+applied, the products use 64 bit intermediates.
+The result differs by no more than 1/256 from the exact result rounded to the 8.8 / 15.8 format
+of the display list, the transform is in the graphics context so wrap it in
+EVE_save_context() / EVE_restore_context() to keep it from applying to the fonts that follow.
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#include "EVE_matrix.h"
+
+#ifndef NULL /* define NULL if it not already is */
+#include <stdio.h>
+#endif
+
+#define MATRIX_Q30_ONE ((int64_t) 1073741824L) /* 1.0 in 2.30 */
+#define MATRIX_TWO_PI_Q30 ((int64_t) 6746518852LL) /* 2 * pi in 2.30 */
+
+/* a * b in 2.30 */
+static int64_t matrix_mul_q30(int64_t const val_a, int64_t const val_b)
+{
+    return ((val_a * val_b) >> 30U);
+}
+
+/* sine and cosine in 2.30 of an angle in 1/65536 of a circle */
+static void matrix_sincos(uint16_t const angle, int32_t * const p_sin, int32_t * const p_cos)
+{
+    uint16_t const quadrant = angle >> 14U;
+    uint16_t part = angle & 0x3fffU;
+    uint8_t swap = 0U;
+    int64_t rad;
+    int64_t rad2;
+    int64_t term;
+    int32_t sin_v;
+    int32_t cos_v;
+    int32_t temp;
+
+    if (part > 0x2000U) /* the series only needs to be good to 45 degrees */
+    {
+        part = 0x4000U - part;
+        swap = 1U;
+    }
+
+    rad = (((int64_t) part) * MATRIX_TWO_PI_Q30) >> 16U;
+    rad2 = matrix_mul_q30(rad, rad);
+
+    /* x - x^3/3! + x^5/5! - x^7/7!, the next term is below 2^-23 */
+    term = MATRIX_Q30_ONE - (rad2 / 72);
+    term = MATRIX_Q30_ONE - (matrix_mul_q30(rad2, term) / 42);
+    term = MATRIX_Q30_ONE - (matrix_mul_q30(rad2, term) / 20);
+    term = MATRIX_Q30_ONE - (matrix_mul_q30(rad2, term) / 6);
+    sin_v = (int32_t) matrix_mul_q30(rad, term);
+
+    /* 1 - x^2/2! + x^4/4! - x^6/6! + x^8/8! */
+    term = MATRIX_Q30_ONE - (rad2 / 56);
+    term = MATRIX_Q30_ONE - (matrix_mul_q30(rad2, term) / 30);
+    term = MATRIX_Q30_ONE - (matrix_mul_q30(rad2, term) / 12);
+    term = MATRIX_Q30_ONE - (matrix_mul_q30(rad2, term) / 2);
+    cos_v = (int32_t) term;
+
+    if (swap != 0U)
+    {
+        temp = sin_v;
+        sin_v = cos_v;
+        cos_v = temp;
+    }
+
+    switch (quadrant)
+    {
+        case 1U:
+            temp = sin_v;
+            sin_v = cos_v;
+            cos_v = -temp;
+            break;
+        case 2U:
+            sin_v = -sin_v;
+            cos_v = -cos_v;
+            break;
+        case 3U:
+            temp = sin_v;
+            sin_v = -cos_v;
+            cos_v = temp;
+            break;
+        default:
+            break;
+    }
+
+    *p_sin = sin_v;
+    *p_cos = cos_v;
+}
+
+/* k1 * v1 + k2 * v2 with k1 / k2 in 2.30 and v1 / v2 in 16.16, rounded */
+static int32_t matrix_dot(int32_t const k1, int32_t const v1, int32_t const k2, int32_t const v2)
+{
+    int64_t const sum = (((int64_t) k1) * v1) + (((int64_t) k2) * v2);
+    return ((int32_t) ((sum + 536870912L) >> 30U));
+}
+
+/* val / div in 16.16, rounded */
+static int32_t matrix_div(int32_t const val, int32_t const div)
+{
+    int64_t num = ((int64_t) val) * 65536;
+    int64_t const half = ((div < 0) ? -(int64_t) div : (int64_t) div) / 2;
+
+    num += ((num < 0) == (div < 0)) ? half : -half;
+    return ((int32_t) (num / div));
+}
+
+/* val 16.16 to the display list format with 8 fractional bits, rounded */
+static uint32_t matrix_to_dl(int32_t const val, uint32_t const mask)
+{
+    return (((uint32_t) ((val + 128) >> 8U)) & mask);
+}
+
+/**
+ * @brief Set the matrix to identity, like EVE_cmd_loadidentity().
+ */
+void EVE_matrix_identity(EVE_matrix_t * const p_matrix)
+{
+    if (p_matrix != NULL)
+    {
+        p_matrix->a = EVE_MATRIX_ONE;
+        p_matrix->b = 0;
+        p_matrix->c = 0;
+        p_matrix->d = 0;
+        p_matrix->e = EVE_MATRIX_ONE;
+        p_matrix->f = 0;
+    }
+}
+
+/**
+ * @brief Apply a translation, like EVE_cmd_translate().
+ * @note - tx0 / ty0 are in 16.16 pixels, the bitmap moves by that on the screen.
+ */
+void EVE_matrix_translate(EVE_matrix_t * const p_matrix, int32_t const tx0, int32_t const ty0)
+{
+    if (p_matrix != NULL)
+    {
+        p_matrix->c -= tx0;
+        p_matrix->f -= ty0;
+    }
+}
+
+/**
+ * @brief Apply a clockwise rotation, like EVE_cmd_rotate().
+ * @note - angle is in units of 1/65536 of a circle, only the lower 16 bits are used.
+ */
+void EVE_matrix_rotate(EVE_matrix_t * const p_matrix, uint32_t const angle)
+{
+    int32_t sin_v;
+    int32_t cos_v;
+    int32_t row_a;
+    int32_t row_b;
+    int32_t row_c;
+
+    if (p_matrix != NULL)
+    {
+        matrix_sincos((uint16_t) angle, &sin_v, &cos_v);
+        row_a = p_matrix->a;
+        row_b = p_matrix->b;
+        row_c = p_matrix->c;
+        p_matrix->a = matrix_dot(cos_v, row_a, sin_v, p_matrix->d);
+        p_matrix->b = matrix_dot(cos_v, row_b, sin_v, p_matrix->e);
+        p_matrix->c = matrix_dot(cos_v, row_c, sin_v, p_matrix->f);
+        p_matrix->d = matrix_dot(-sin_v, row_a, cos_v, p_matrix->d);
+        p_matrix->e = matrix_dot(-sin_v, row_b, cos_v, p_matrix->e);
+        p_matrix->f = matrix_dot(-sin_v, row_c, cos_v, p_matrix->f);
+    }
+}
+
+/**
+ * @brief Apply a scale, like EVE_cmd_scale().
+ * @note - scx / scy are in 16.16, a factor of 0 leaves the matrix as it is.
+ */
+void EVE_matrix_scale(EVE_matrix_t * const p_matrix, int32_t const scx, int32_t const scy)
+{
+    if ((p_matrix != NULL) && (scx != 0) && (scy != 0))
+    {
+        p_matrix->a = matrix_div(p_matrix->a, scx);
+        p_matrix->b = matrix_div(p_matrix->b, scx);
+        p_matrix->c = matrix_div(p_matrix->c, scx);
+        p_matrix->d = matrix_div(p_matrix->d, scy);
+        p_matrix->e = matrix_div(p_matrix->e, scy);
+        p_matrix->f = matrix_div(p_matrix->f, scy);
+    }
+}
+
+/**
+ * @brief Apply a rotation and scale around a point, like EVE_cmd_rotatearound().
+ * @note - xc0 / yc0 are in pixels, angle in units of 1/65536 of a circle, scale in 16.16.
+ */
+void EVE_matrix_rotatearound(EVE_matrix_t * const p_matrix, int32_t const xc0, int32_t const yc0,
+                             uint32_t const angle, int32_t const scale)
+{
+    EVE_matrix_translate(p_matrix, xc0 * EVE_MATRIX_ONE, yc0 * EVE_MATRIX_ONE);
+    EVE_matrix_rotate(p_matrix, angle);
+    EVE_matrix_scale(p_matrix, scale, scale);
+    EVE_matrix_translate(p_matrix, -xc0 * EVE_MATRIX_ONE, -yc0 * EVE_MATRIX_ONE);
+}
+
+/**
+ * @brief The six BITMAP_TRANSFORM_A...F words for the matrix, for use with EVE_cmd_dl().
+ * @note - A, B, D and E are signed 8.8 with 17 bits, C and F are signed 15.8 with 24 bits,
+ * values outside of that wrap around like with the coprocessor.
+ */
+void EVE_matrix_words(EVE_matrix_t const * const p_matrix, uint32_t p_words[6])
+{
+    if ((p_matrix != NULL) && (p_words != NULL))
+    {
+        p_words[0U] = DL_BITMAP_TRANSFORM_A | matrix_to_dl(p_matrix->a, 0x1ffffUL);
+        p_words[1U] = DL_BITMAP_TRANSFORM_B | matrix_to_dl(p_matrix->b, 0x1ffffUL);
+        p_words[2U] = DL_BITMAP_TRANSFORM_C | matrix_to_dl(p_matrix->c, 0xffffffUL);
+        p_words[3U] = DL_BITMAP_TRANSFORM_D | matrix_to_dl(p_matrix->d, 0x1ffffUL);
+        p_words[4U] = DL_BITMAP_TRANSFORM_E | matrix_to_dl(p_matrix->e, 0x1ffffUL);
+        p_words[5U] = DL_BITMAP_TRANSFORM_F | matrix_to_dl(p_matrix->f, 0xffffffUL);
+    }
+}
+
+/**
+ * @brief Write the matrix to the display list, replaces EVE_cmd_setmatrix().
+ */
+void EVE_matrix_set(EVE_matrix_t const * const p_matrix)
+{
+    uint32_t words[6];
+
+    if (p_matrix != NULL)
+    {
+        EVE_matrix_words(p_matrix, words);
+        for (uint8_t index = 0U; index < 6U; index++)
+        {
+            EVE_cmd_dl(words[index]);
+        }
+    }
+}
+
+/**
+ * @brief Write the matrix to the display list, only works in burst-mode.
+ */
+void EVE_matrix_set_burst(EVE_matrix_t const * const p_matrix)
+{
+    uint32_t words[6];
+
+    if (p_matrix != NULL)
+    {
+        EVE_matrix_words(p_matrix, words);
+        for (uint8_t index = 0U; index < 6U; index++)
+        {
+            EVE_cmd_dl_burst(words[index]);
+        }
+    }
+}
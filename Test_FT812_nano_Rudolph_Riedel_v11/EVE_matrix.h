@@ -0,0 +1,76 @@
+/*
+@file    EVE_matrix.h
+@brief   prototypes for the bitmap transform matrix computed on the host
+@version 1.0
+@date    2026-10-18
+@author  Christian Lara
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#ifndef EVE_MATRIX_H
+#define EVE_MATRIX_H
+
+#include "EVE.h"
+#include "EVE_commands.h"
+
+#define EVE_MATRIX_ONE 65536L /* 1.0 in 16.16 */
+
+/* same layout and direction as the matrix of the coprocessor, it maps screen pixels to bitmap pixels */
+typedef struct
+{
+    int32_t a; /* 16.16 */
+    int32_t b;
+    int32_t c;
+    int32_t d;
+    int32_t e;
+    int32_t f;
+} EVE_matrix_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+void EVE_matrix_identity(EVE_matrix_t * const p_matrix);
+void EVE_matrix_translate(EVE_matrix_t * const p_matrix, int32_t const tx0, int32_t const ty0);
+void EVE_matrix_rotate(EVE_matrix_t * const p_matrix, uint32_t const angle);
+void EVE_matrix_scale(EVE_matrix_t * const p_matrix, int32_t const scx, int32_t const scy);
+void EVE_matrix_rotatearound(EVE_matrix_t * const p_matrix, int32_t const xc0, int32_t const yc0,
+                             uint32_t const angle, int32_t const scale);
+void EVE_matrix_words(EVE_matrix_t const * const p_matrix, uint32_t p_words[6]);
+void EVE_matrix_set(EVE_matrix_t const * const p_matrix);
+void EVE_matrix_set_burst(EVE_matrix_t const * const p_matrix);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_MATRIX_H */
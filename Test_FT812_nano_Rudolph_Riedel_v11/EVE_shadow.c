@@ -0,0 +1,244 @@
+/*
+@file    EVE_shadow.c
+@brief   delta upload of RAM_G regions through a host-side shadow copy
+@version 1.0
+@date    2026-10-18
+@author  Christian Lara
+
+@section info
+
+The host keeps a mirror of each registered RAM_G region, for example a status image or a chart
+buffer that is redrawn by the host. EVE_shadow_update() compares the new content with the mirror
+in blocks of EVE_SHADOW_BLOCK bytes and only uploads the blocks that changed. Dirty blocks that are
+close together are merged into one transfer, runs of EVE_SHADOW_RUN_MIN or more identical bytes
+in a dirty span are filled by the coprocessor with CMD_MEMZERO / CMD_MEMSET (12 / 16 bytes over
+SPI instead of the run).
+
+Uploads use EVE_memWrite_sram_buffer() and EVE_cmd_memset() which wait for completion, so
+EVE_shadow_update() must be called outside of a display-list burst.
+After EVE_init() or anything else that changes the region without going through the mirror,
+call EVE_shadow_invalidate().
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#include "EVE_shadow.h"
+
+#ifndef NULL /* define NULL if it not already is */
+#include <stdio.h>
+#endif
+
+#include <string.h>
+
+#define MEMSET_SPI_BYTES 16U /* CMD_MEMSET + ptr + value + num */
+#define MEMZERO_SPI_BYTES 12U /* CMD_MEMZERO + ptr + num */
+#define WRITE_SPI_BYTES 3U /* the address of a memory write */
+
+static uint32_t shadow_sent = 0U;
+static uint32_t shadow_saved = 0U;
+
+/* length of the run of identical bytes that starts at p_data[0], stops at len */
+static uint32_t run_length(const uint8_t * const p_data, uint32_t const len)
+{
+    uint32_t count = 1U;
+
+    while ((count < len) && (p_data[count] == p_data[0U]))
+    {
+        count++;
+    }
+    return (count);
+}
+
+/* upload a dirty span, long runs of one value are filled by the coprocessor */
+static void upload_span(uint32_t const address, const uint8_t * const p_data, uint32_t const len)
+{
+    uint32_t start = 0U; /* first byte not sent yet */
+    uint32_t index = 0U;
+
+    while (index < len)
+    {
+        uint32_t const run = run_length(&p_data[index], len - index);
+
+        if (run >= EVE_SHADOW_RUN_MIN)
+        {
+            if (index > start)
+            {
+                EVE_memWrite_sram_buffer(address + start, &p_data[start], index - start);
+                shadow_sent += WRITE_SPI_BYTES + (index - start);
+            }
+            if (0U == p_data[index])
+            {
+                EVE_cmd_memzero(address + index, run);
+                shadow_sent += MEMZERO_SPI_BYTES;
+            }
+            else
+            {
+                EVE_cmd_memset(address + index, p_data[index], run);
+                shadow_sent += MEMSET_SPI_BYTES;
+            }
+            start = index + run;
+        }
+        index += run;
+    }
+
+    if (len > start)
+    {
+        EVE_memWrite_sram_buffer(address + start, &p_data[start], len - start);
+        shadow_sent += WRITE_SPI_BYTES + (len - start);
+    }
+}
+
+/* unchanged bytes at both ends of a span are not sent, the mirror is not updated yet */
+static void flush_span(EVE_shadow_t const * const p_shadow, uint32_t const offset, const uint8_t * const p_data,
+                       uint32_t span_start, uint32_t span_end)
+{
+    const uint8_t * const p_mirror = &p_shadow->p_mirror[offset];
+
+    if (p_shadow->valid != 0U)
+    {
+        while ((span_start < span_end) && (p_mirror[span_start] == p_data[span_start]))
+        {
+            span_start++;
+        }
+        while ((span_end > span_start) && (p_mirror[span_end - 1U] == p_data[span_end - 1U]))
+        {
+            span_end--;
+        }
+    }
+    if (span_end > span_start)
+    {
+        upload_span(p_shadow->address + offset + span_start, &p_data[span_start], span_end - span_start);
+    }
+}
+
+/**
+ * @brief Register a RAM_G region, p_mirror needs size bytes on the host.
+ * @note - The mirror starts invalid, the first update uploads the full range it is given.
+ */
+void EVE_shadow_init(EVE_shadow_t * const p_shadow, uint32_t const address, uint8_t * const p_mirror, uint32_t const size)
+{
+    if (p_shadow != NULL)
+    {
+        p_shadow->address = address;
+        p_shadow->p_mirror = p_mirror;
+        p_shadow->size = size;
+        p_shadow->valid = 0U;
+    }
+}
+
+/**
+ * @brief Mark the mirror as out of date, e.g. after EVE_init() or after writing the region directly.
+ */
+void EVE_shadow_invalidate(EVE_shadow_t * const p_shadow)
+{
+    if (p_shadow != NULL)
+    {
+        p_shadow->valid = 0U;
+    }
+}
+
+/**
+ * @brief Bring len bytes at offset in the region up to date with p_data.
+ * @return - the number of bytes that went over SPI for this update
+ * @note - Must be called outside of a display-list burst.
+ * @note - With an invalid mirror every block of the range counts as dirty, the mirror becomes
+ * valid when the update covers the whole region.
+ */
+uint32_t EVE_shadow_update(EVE_shadow_t * const p_shadow, uint32_t const offset, const uint8_t * const p_data, uint32_t const len)
+{
+    uint32_t const sent_before = shadow_sent;
+    uint32_t const full_upload = WRITE_SPI_BYTES + len;
+
+    if ((p_shadow != NULL) && (p_data != NULL) && (p_shadow->p_mirror != NULL) &&
+        (offset < p_shadow->size) && (len <= (p_shadow->size - offset)))
+    {
+        uint8_t * const p_mirror = &p_shadow->p_mirror[offset];
+        uint32_t span_start = 0U;
+        uint32_t span_end = 0U; /* span_start == span_end: no open span */
+        uint32_t block = 0U;
+
+        while (block < len)
+        {
+            uint32_t const block_len = ((len - block) < EVE_SHADOW_BLOCK) ? (len - block) : EVE_SHADOW_BLOCK;
+
+            if ((0U == p_shadow->valid) || (memcmp(&p_mirror[block], &p_data[block], block_len) != 0))
+            {
+                if ((span_end > span_start) && ((block - span_end) > EVE_SHADOW_GAP))
+                {
+                    flush_span(p_shadow, offset, p_data, span_start, span_end);
+                    span_start = block;
+                }
+                else if (span_end == span_start)
+                {
+                    span_start = block;
+                }
+                else
+                {
+                    /* the gap is small enough to send along */
+                }
+                span_end = block + block_len;
+            }
+            block += block_len;
+        }
+
+        if (span_end > span_start)
+        {
+            flush_span(p_shadow, offset, p_data, span_start, span_end);
+        }
+
+        (void) memcpy(p_mirror, p_data, len);
+        if ((0U == offset) && (len == p_shadow->size))
+        {
+            p_shadow->valid = 1U;
+        }
+        if ((shadow_sent - sent_before) < full_upload)
+        {
+            shadow_saved += full_upload - (shadow_sent - sent_before);
+        }
+    }
+    return (shadow_sent - sent_before);
+}
+
+/**
+ * @brief Bytes sent and bytes saved against full uploads since the last call, meant to be read once per frame.
+ */
+void EVE_shadow_stats(uint32_t * const p_sent, uint32_t * const p_saved)
+{
+    if (p_sent != NULL)
+    {
+        *p_sent = shadow_sent;
+    }
+    if (p_saved != NULL)
+    {
+        *p_saved = shadow_saved;
+    }
+    shadow_sent = 0U;
+    shadow_saved = 0U;
+}
@@ -0,0 +1,81 @@
+/*
+@file    EVE_shadow.h
+@brief   prototypes for the delta upload of RAM_G regions through a host-side shadow copy
+@version 1.0
+@date    2026-10-18
+@author  Christian Lara
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#ifndef EVE_SHADOW_H
+#define EVE_SHADOW_H
+
+#include "EVE.h"
+#include "EVE_commands.h"
+
+/* the region is compared in blocks of this size, changed blocks are uploaded */
+#if !defined (EVE_SHADOW_BLOCK)
+#define EVE_SHADOW_BLOCK 32U
+#endif
+
+/* runs of the same byte at least this long are filled with CMD_MEMSET / CMD_MEMZERO instead */
+#if !defined (EVE_SHADOW_RUN_MIN)
+#define EVE_SHADOW_RUN_MIN 48U
+#endif
+
+/* clean gaps up to this size between two dirty spans are sent along, a new transfer costs more */
+#if !defined (EVE_SHADOW_GAP)
+#define EVE_SHADOW_GAP 8U
+#endif
+
+typedef struct
+{
+    uint32_t address; /* start of the region in RAM_G */
+    uint8_t *p_mirror; /* host copy of the region, size bytes */
+    uint32_t size;
+    uint8_t valid; /* 0 = the mirror does not match RAM_G, the next update sends everything */
+} EVE_shadow_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+void EVE_shadow_init(EVE_shadow_t * const p_shadow, uint32_t const address, uint8_t * const p_mirror, uint32_t const size);
+void EVE_shadow_invalidate(EVE_shadow_t * const p_shadow);
+uint32_t EVE_shadow_update(EVE_shadow_t * const p_shadow, uint32_t const offset, const uint8_t * const p_data, uint32_t const len);
+void EVE_shadow_stats(uint32_t * const p_sent, uint32_t * const p_saved);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_SHADOW_H */
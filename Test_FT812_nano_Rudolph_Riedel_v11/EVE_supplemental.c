@@ -38,6 +38,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 - added EVE_calibrate_write() and EVE_calibrate_read()
 - replaced several EVE_cmd_dl() calls with calls to dedicated functions
 - added "const" statements for BARR-C:2018 / CERT C compliance
+- added EVE_paletted_load() and EVE_paletted_draw()
 
 */
 
@@ -87,6 +88,57 @@ void EVE_widget_rectangle(const int16_t xc0, const int16_t yc0, const int16_t wi
     EVE_restore_context();
 }
 
+/*
+ * @brief Upload a paletted bitmap from tools/eve_asset_conv to RAM_G, the index data is deflated, the palette is not.
+ * @note - lut_addr needs to be 2-byte aligned for PALETTED565 / PALETTED4444 and 4-byte aligned for PALETTED8.
+ * @note - Meant to be called outside display-list building, does not support burst-mode.
+ */
+void EVE_paletted_load(const uint32_t addr, const uint8_t * const p_index, const uint32_t index_len,
+                        const uint32_t lut_addr, const uint8_t * const p_lut, const uint16_t lut_len)
+{
+    EVE_memWrite_flash_buffer(lut_addr, p_lut, lut_len);
+    EVE_cmd_inflate(addr, p_index, index_len);
+}
+
+/*
+ * @brief Draw a paletted bitmap with the currently selected bitmap handle.
+ * @note - The bitmap handle needs to be set up before with EVE_cmd_setbitmap().
+ * @note - PALETTED8 has no native support in FT81x and is drawn in four passes,
+ * alpha first, then red, green and blue each blended with the destination alpha.
+ * @note - xc0 / yc0 are in the precision set with EVE_vertex_format().
+ */
+void EVE_paletted_draw(const uint32_t format, const uint32_t lut_addr, const int16_t xc0, const int16_t yc0)
+{
+    EVE_begin(EVE_BITMAPS);
+
+    if (EVE_PALETTED8 == format)
+    {
+        EVE_save_context();
+        EVE_blend_func((uint8_t) EVE_ONE, (uint8_t) EVE_ZERO);
+        EVE_color_mask(0U, 0U, 0U, 1U);
+        EVE_palette_source(lut_addr + 3UL);
+        EVE_vertex2f(xc0, yc0);
+        EVE_blend_func((uint8_t) EVE_DST_ALPHA, (uint8_t) EVE_ONE_MINUS_DST_ALPHA);
+        EVE_color_mask(1U, 0U, 0U, 0U);
+        EVE_palette_source(lut_addr + 2UL);
+        EVE_vertex2f(xc0, yc0);
+        EVE_color_mask(0U, 1U, 0U, 0U);
+        EVE_palette_source(lut_addr + 1UL);
+        EVE_vertex2f(xc0, yc0);
+        EVE_color_mask(0U, 0U, 1U, 0U);
+        EVE_palette_source(lut_addr);
+        EVE_vertex2f(xc0, yc0);
+        EVE_restore_context();
+    }
+    else
+    {
+        EVE_palette_source(lut_addr);
+        EVE_vertex2f(xc0, yc0);
+    }
+
+    EVE_end();
+}
+
 static const int8_t sine_table[360] PROGMEM =
 {
     0, 2, 4, 7, 9, 11, 13, 15, 18, 20, 22, 24, 26, 29, 31, 33, 35, 37, 39, 41,
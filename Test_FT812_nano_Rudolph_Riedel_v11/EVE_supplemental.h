@@ -35,6 +35,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 - moved EVE_calibrate_manual() over from EVE_commands
 - added EVE_calibrate_write() and EVE_calibrate_read()
 - added "const" statements for BARR-C:2018 / CERT C compliance
+- added EVE_paletted_load() and EVE_paletted_draw()
 
 */
 
@@ -51,6 +52,9 @@ extern "C"
 
 void EVE_widget_circle(const int16_t xc0, const int16_t yc0, const uint16_t radius, const uint16_t border, const uint32_t bgcolor);
 void EVE_widget_rectangle(const int16_t xc0, const int16_t yc0, const int16_t wid, const int16_t hgt, const int16_t border, const uint16_t linewidth, const uint32_t bgcolor);
+void EVE_paletted_load(const uint32_t addr, const uint8_t * const p_index, const uint32_t index_len,
+                        const uint32_t lut_addr, const uint8_t * const p_lut, const uint16_t lut_len);
+void EVE_paletted_draw(const uint32_t format, const uint32_t lut_addr, const int16_t xc0, const int16_t yc0);
 void EVE_polar_cartesian(const uint16_t length, const uint16_t angle, int16_t * const p_xc0, int16_t * const p_yc0);
 
 void EVE_calibrate_write(const uint32_t tta, const uint32_t ttb, const uint32_t ttc, const uint32_t ttd, const uint32_t tte, const uint32_t ttf);
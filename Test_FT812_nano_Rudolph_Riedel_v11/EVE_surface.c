@@ -0,0 +1,169 @@
+/*
+@file    EVE_surface.c
+@brief   tear-free double-buffered bitmaps in RAM_G
+@version 1.0
+@date    2026-10-18
+@author  Christian Lara
+
+@section info
+
+A surface is one dynamic image with two buffers in RAM_G. The host only ever writes the buffer
+that is not on screen, the display list switches BITMAP_SOURCE to it once the write is complete
+and the old buffer becomes writable again only after the swap of that display list was seen
+in REG_DLSWAP by EVE_frame_ready(). EVE scans out a buffer that does not change, no tearing.
+
+Use per frame:
+- EVE_surface_back() returns the address to write to, 0 while both buffers are still in use
+- EVE_surface_ready() after the last write, coprocessor writes like CMD_INFLATE need to be executed first
+- EVE_surface_sync() once in the state update before the frame is built
+- EVE_surface_source_burst() in the display list in place of EVE_bitmap_source_burst()
+
+The flip is tied to EVE_frame_submit_count() / EVE_frame_swap_count(), so the frames need to go
+through EVE_frame_ready() and EVE_frame_submit().
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#include "EVE_surface.h"
+
+#ifndef NULL /* define NULL if it not already is */
+#include <stdio.h>
+#endif
+
+/**
+ * @brief Set up a surface, address_a is on screen first.
+ */
+void EVE_surface_init(EVE_surface_t * const p_surface, uint32_t const address_a, uint32_t const address_b)
+{
+    if (p_surface != NULL)
+    {
+        p_surface->address[0U] = address_a;
+        p_surface->address[1U] = address_b;
+        p_surface->front = 0U;
+        p_surface->state = EVE_SURFACE_IDLE;
+        p_surface->flip_frame = 0U;
+    }
+}
+
+/**
+ * @brief Start writing the back buffer.
+ * @return - the RAM_G address of the back buffer, 0 if the last flip is not visible yet and there is no free buffer
+ */
+uint32_t EVE_surface_back(EVE_surface_t * const p_surface)
+{
+    uint32_t address = 0U;
+
+    if (p_surface != NULL)
+    {
+        EVE_surface_sync(p_surface);
+        if ((EVE_SURFACE_IDLE == p_surface->state) || (EVE_SURFACE_WRITING == p_surface->state))
+        {
+            p_surface->state = EVE_SURFACE_WRITING;
+            address = p_surface->address[p_surface->front ^ 1U];
+        }
+    }
+    return (address);
+}
+
+/**
+ * @brief The back buffer is complete, the next display list shows it.
+ */
+void EVE_surface_ready(EVE_surface_t * const p_surface)
+{
+    if ((p_surface != NULL) && (EVE_SURFACE_WRITING == p_surface->state))
+    {
+        p_surface->state = EVE_SURFACE_READY;
+    }
+}
+
+/**
+ * @brief Advance the flip, call once before building the frame.
+ * @note - A ready back buffer is bound to the next submitted frame, once the swap of that frame
+ * was seen the back buffer becomes the front and the old front is free for writing.
+ * Do not call this or EVE_surface_back() between building and submitting a frame as the
+ * ready buffer would be bound to a frame that was built with the old address.
+ */
+void EVE_surface_sync(EVE_surface_t * const p_surface)
+{
+    if (p_surface != NULL)
+    {
+        if (EVE_SURFACE_READY == p_surface->state)
+        {
+            p_surface->flip_frame = EVE_frame_submit_count() + 1U;
+            p_surface->state = EVE_SURFACE_FLIPPING;
+        }
+        else if ((EVE_SURFACE_FLIPPING == p_surface->state) &&
+                 ((int32_t) (EVE_frame_swap_count() - p_surface->flip_frame) >= 0))
+        {
+            p_surface->front ^= 1U;
+            p_surface->state = EVE_SURFACE_IDLE;
+        }
+        else
+        {
+            /* nothing to do */
+        }
+    }
+}
+
+/**
+ * @brief The address the display list uses for the surface right now.
+ */
+uint32_t EVE_surface_address(EVE_surface_t const * const p_surface)
+{
+    uint32_t address = 0U;
+
+    if (p_surface != NULL)
+    {
+        uint8_t buffer = p_surface->front;
+
+        if (EVE_SURFACE_FLIPPING == p_surface->state)
+        {
+            buffer ^= 1U;
+        }
+        address = p_surface->address[buffer];
+    }
+    return (address);
+}
+
+/**
+ * @brief BITMAP_SOURCE for the surface, does not change the state so the frame can be built twice.
+ */
+void EVE_surface_source(EVE_surface_t const * const p_surface)
+{
+    EVE_bitmap_source(EVE_surface_address(p_surface));
+}
+
+/**
+ * @brief BITMAP_SOURCE for the surface, to be used between EVE_start_cmd_burst() and EVE_end_cmd_burst().
+ */
+void EVE_surface_source_burst(EVE_surface_t const * const p_surface)
+{
+    EVE_bitmap_source_burst(EVE_surface_address(p_surface));
+}
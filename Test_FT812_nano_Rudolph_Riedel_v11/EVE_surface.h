@@ -0,0 +1,75 @@
+/*
+@file    EVE_surface.h
+@brief   prototypes for tear-free double-buffered bitmaps in RAM_G
+@version 1.0
+@date    2026-10-18
+@author  Christian Lara
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#ifndef EVE_SURFACE_H
+#define EVE_SURFACE_H
+
+#include "EVE.h"
+#include "EVE_commands.h"
+#include "EVE_frame.h"
+
+#define EVE_SURFACE_IDLE     0U /* the back buffer is free */
+#define EVE_SURFACE_WRITING  1U /* the host is writing the back buffer */
+#define EVE_SURFACE_READY    2U /* the back buffer is complete, the next display list uses it */
+#define EVE_SURFACE_FLIPPING 3U /* a display list with the back buffer was submitted, waiting for its swap */
+
+typedef struct
+{
+    uint32_t address[2];
+    uint8_t front; /* index of the buffer that is on screen */
+    uint8_t state;
+    uint32_t flip_frame; /* EVE_frame_submit_count() of the first frame showing the back buffer */
+} EVE_surface_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+void EVE_surface_init(EVE_surface_t * const p_surface, uint32_t const address_a, uint32_t const address_b);
+uint32_t EVE_surface_back(EVE_surface_t * const p_surface);
+void EVE_surface_ready(EVE_surface_t * const p_surface);
+void EVE_surface_sync(EVE_surface_t * const p_surface);
+uint32_t EVE_surface_address(EVE_surface_t const * const p_surface);
+void EVE_surface_source(EVE_surface_t const * const p_surface);
+void EVE_surface_source_burst(EVE_surface_t const * const p_surface);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_SURFACE_H */
@@ -60,6 +60,13 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 - added STM32WB55xx to the STM32 target
 - reworked STM32 support, DMA is working for at least the F407, DMA for the H7 is still WIP
 - Bugfix: #136 thanks to Jwf68 on Github, EVE_PDN_PORT_NUM -> EVE_PD_PORT_NUM
+- added the emulation for the SOFTWARE_TEST target
+- the SOFTWARE_TEST emulation can drain the cmd-FIFO at a set rate on a virtual clock
+- the SOFTWARE_TEST emulation can run a VSYNC on the virtual clock that advances REG_FRAMES and finishes REG_DLSWAP
+- the SOFTWARE_TEST emulation can capture the words written to the cmd-FIFO
+- the SOFTWARE_TEST target can send the SPI to EVE_test_sink with EVE_TEST_SPI_SINK
+- the SOFTWARE_TEST emulation can raise a coprocessor fault that lasts until REG_CPURESET goes back to 0
+- the SOFTWARE_TEST emulation has the metric blocks of the ROM fonts 16...31 behind EVE_ROM_FONTROOT
 
  */
 
@@ -74,6 +81,430 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 /* ################################################################## */
 /* ################################################################## */
 
+#if defined (SOFTWARE_TEST)
+
+/* A stand-in for the EVE chip to run the library on a host without hardware.
+   The SPI bytes are decoded into memory accesses to RAM_G, RAM_DL and the registers,
+   The co-processor only counts the bytes written to REG_CMDB_WRITE, it is done instantly unless
+   EVE_test_set_drain() sets a rate, then REG_CMDB_SPACE follows a FIFO that is drained on a virtual
+   clock that advances with every SPI byte and with EVE_test_delay_us().
+   With EVE_test_set_frame() the same clock runs the VSYNC, REG_FRAMES counts up and a swap that was
+   requested in REG_DLSWAP is done with the next VSYNC, or right away for EVE_DLSWAP_LINE. */
+
+#include <string.h>
+
+#define TEST_REG_SIZE 4096U
+#define TEST_DL_SIZE 8192U
+#define TEST_FONT_METRICS 0x00201EE0UL /* EVE_ROM_FONTROOT points here on the FT81x */
+#define TEST_FONT_SIZE (16U * 148U) /* the metric blocks of the ROM fonts 16...31, zero until a test writes them */
+
+static uint8_t test_ram_g[EVE_RAM_G_SIZE];
+static uint8_t test_ram_dl[TEST_DL_SIZE];
+static uint8_t test_reg[TEST_REG_SIZE];
+static uint8_t test_font[TEST_FONT_SIZE];
+static uint8_t test_font_root[4U];
+static uint8_t test_state = 0U; /* 0..2 address bytes, 3 dummy byte for reads, 4 data */
+static uint8_t test_write = 0U;
+static uint8_t test_flags_read = 0U;
+static uint8_t test_int_line = 0U;
+static uint32_t test_address = 0U;
+static uint32_t test_transactions = 0U;
+static uint32_t test_cmd_bytes = 0U;
+static void (*p_test_isr)(void) = NULL;
+static uint32_t test_drain_rate = 0U; /* bytes per ms, 0 = instant */
+static uint32_t test_spi_ns = 125U; /* one SPI byte at 8 MHz */
+static uint32_t test_fifo_fill = 0U;
+static uint64_t test_drain_acc = 0U; /* in 1/1000000 bytes */
+static uint32_t test_time_ns = 0U;
+static uint32_t test_time_us = 0U;
+static uint32_t test_space_reads = 0U;
+static uint32_t test_frame_us = 0U; /* 0 = no VSYNC */
+static uint32_t test_vsync_us = 0U;
+static uint32_t *p_test_capture = NULL;
+static uint32_t test_capture_max = 0U;
+static uint32_t test_captured = 0U; /* whole words */
+static uint32_t test_capture_bytes = 0U;
+static uint8_t test_fault = 0U; /* REG_CMDB_SPACE shows the fault until the coprocessor is reset */
+
+#if defined (EVE_TEST_SPI_SINK)
+volatile uint32_t EVE_test_sink = 0U;
+#endif
+
+static uint8_t *test_mem(uint32_t const address)
+{
+    uint8_t *p_ret = NULL;
+
+    if (address < EVE_RAM_G_SIZE)
+    {
+        p_ret = &test_ram_g[address];
+    }
+    else if ((address >= EVE_RAM_DL) && (address < (EVE_RAM_DL + TEST_DL_SIZE)))
+    {
+        p_ret = &test_ram_dl[address - EVE_RAM_DL];
+    }
+    else if ((address >= EVE_RAM_REG) && (address < (EVE_RAM_REG + TEST_REG_SIZE)))
+    {
+        p_ret = &test_reg[address - EVE_RAM_REG];
+    }
+    else if ((address >= TEST_FONT_METRICS) && (address < (TEST_FONT_METRICS + TEST_FONT_SIZE)))
+    {
+        p_ret = &test_font[address - TEST_FONT_METRICS];
+    }
+    else if ((address >= EVE_ROM_FONTROOT) && (address < (EVE_ROM_FONTROOT + 4U)))
+    {
+        p_ret = &test_font_root[address - EVE_ROM_FONTROOT];
+    }
+    else
+    {
+        /* not emulated */
+    }
+    return (p_ret);
+}
+
+static void test_update_space(void)
+{
+    if (0U == test_fault)
+    {
+        EVE_test_write32(REG_CMDB_SPACE, 0xffcUL - ((test_fifo_fill + 3UL) & ~3UL));
+    }
+}
+
+/* advance the virtual clock and let the co-processor work on the FIFO */
+static void test_advance(uint32_t const nanoseconds)
+{
+    test_time_ns += nanoseconds;
+    test_time_us += test_time_ns / 1000UL;
+    test_time_ns %= 1000UL;
+
+    if (test_fifo_fill > 0UL)
+    {
+        uint32_t drained;
+
+        test_drain_acc += (uint64_t) nanoseconds * test_drain_rate;
+        drained = (uint32_t) (test_drain_acc / 1000000UL);
+        test_drain_acc %= 1000000UL;
+
+        if (drained >= test_fifo_fill)
+        {
+            test_fifo_fill = 0UL;
+            test_drain_acc = 0UL;
+        }
+        else
+        {
+            test_fifo_fill -= drained;
+        }
+        test_update_space();
+    }
+
+    if (EVE_DLSWAP_LINE == test_reg[REG_DLSWAP - EVE_RAM_REG])
+    {
+        test_reg[REG_DLSWAP - EVE_RAM_REG] = EVE_DLSWAP_DONE;
+    }
+
+    while ((test_frame_us != 0UL) && ((int32_t) (test_time_us - test_vsync_us) >= 0))
+    {
+        EVE_test_write32(REG_FRAMES, EVE_test_read32(REG_FRAMES) + 1UL);
+        test_reg[REG_DLSWAP - EVE_RAM_REG] = EVE_DLSWAP_DONE;
+        test_vsync_us += test_frame_us;
+    }
+}
+
+/* INT_N is active when interrupts are enabled and a flag that is not masked is set, the handler is called on the edge */
+static void test_update_int(void)
+{
+    uint8_t const active = ((EVE_test_read32(REG_INT_EN) & 1UL) != 0UL) &&
+                           ((EVE_test_read32(REG_INT_FLAGS) & EVE_test_read32(REG_INT_MASK)) != 0UL);
+
+    if ((active != 0U) && (0U == test_int_line) && (p_test_isr != NULL))
+    {
+        test_int_line = 1U;
+        p_test_isr();
+    }
+    test_int_line = active;
+}
+
+void EVE_test_reset(void)
+{
+    memset(test_ram_g, 0, sizeof(test_ram_g));
+    memset(test_ram_dl, 0, sizeof(test_ram_dl));
+    memset(test_reg, 0, sizeof(test_reg));
+    memset(test_font, 0, sizeof(test_font));
+    test_state = 0U;
+    test_int_line = 0U;
+    test_cmd_bytes = 0U;
+    test_fifo_fill = 0U;
+    test_drain_acc = 0U;
+    test_fault = 0U;
+    test_space_reads = 0U;
+    EVE_test_write32(REG_ID, 0x7cUL);
+    EVE_test_write32(REG_CMDB_SPACE, 0xffcUL);
+    EVE_test_write32(REG_INT_MASK, 0xffUL);
+    EVE_test_write32(REG_TOUCH_SCREEN_XY, 0x80008000UL);
+    EVE_test_write32(REG_TOUCH_TAG_XY, 0x80008000UL);
+    EVE_test_write32(EVE_ROM_FONTROOT, TEST_FONT_METRICS);
+}
+
+void EVE_test_cs_set(void)
+{
+    test_state = 0U;
+    test_address = 0U;
+    test_flags_read = 0U;
+    test_transactions++;
+}
+
+void EVE_test_cs_clear(void)
+{
+    if (test_flags_read != 0U)
+    {
+        EVE_test_write32(REG_INT_FLAGS, 0UL); /* REG_INT_FLAGS is cleared by reading it */
+    }
+    test_state = 0U;
+    test_update_int();
+}
+
+uint8_t EVE_test_spi(uint8_t const data)
+{
+    uint8_t ret = 0U;
+
+    test_advance(test_spi_ns);
+
+    if (test_state < 3U)
+    {
+        if (0U == test_state)
+        {
+            test_write = ((data & 0x80U) != 0U) ? 1U : 0U;
+        }
+        test_address = (test_address << 8U) | data;
+        test_state++;
+        if ((3U == test_state) && (test_write != 0U))
+        {
+            test_address &= 0x3fffffUL;
+            test_state = 4U; /* no dummy byte for writes */
+        }
+    }
+    else if (3U == test_state)
+    {
+        test_address &= 0x3fffffUL;
+        test_state = 4U;
+        if (REG_CMDB_SPACE == test_address)
+        {
+            test_space_reads++;
+        }
+    }
+    else
+    {
+        uint8_t * const p_mem = test_mem(test_address);
+
+        if ((test_write != 0U) && (REG_CMDB_WRITE == test_address))
+        {
+            test_cmd_bytes++; /* the address does not advance */
+            if ((p_test_capture != NULL) && (test_captured < test_capture_max))
+            {
+                uint32_t const shift = (test_capture_bytes & 3UL) * 8UL;
+
+                if (0UL == shift)
+                {
+                    p_test_capture[test_captured] = 0UL;
+                }
+                p_test_capture[test_captured] |= ((uint32_t) data) << shift;
+                test_capture_bytes++;
+                if (0UL == (test_capture_bytes & 3UL))
+                {
+                    test_captured++;
+                }
+            }
+            if ((test_drain_rate != 0UL) && (test_fifo_fill < 0xffcUL))
+            {
+                test_fifo_fill++;
+                test_update_space();
+            }
+        }
+        else if (test_write != 0U)
+        {
+            if (p_mem != NULL)
+            {
+                *p_mem = data;
+            }
+            if ((REG_CPURESET == test_address) && (0U == data) && (test_fault != 0U))
+            {
+                test_fault = 0U; /* the restarted coprocessor starts with an empty FIFO */
+                test_fifo_fill = 0UL;
+                test_drain_acc = 0UL;
+                test_update_space();
+            }
+            test_address++;
+        }
+        else
+        {
+            if ((test_address >= REG_INT_FLAGS) && (test_address < (REG_INT_FLAGS + 4UL)))
+            {
+                test_flags_read = 1U;
+            }
+            ret = (p_mem != NULL) ? *p_mem : 0U;
+            test_address++;
+        }
+    }
+    return (ret);
+}
+
+void EVE_test_set_int_handler(void (*p_isr)(void))
+{
+    p_test_isr = p_isr;
+}
+
+uint8_t EVE_test_int_asserted(void)
+{
+    return (test_int_line);
+}
+
+/**
+ * @brief Emulate a touch at xc0 / yc0 on an object with tag, sets the flags and asserts INT_N if enabled.
+ */
+void EVE_test_touch(int16_t const xc0, int16_t const yc0, uint8_t const tag)
+{
+    uint32_t const xy = i16_i16_to_u32(yc0, xc0);
+    uint32_t flags = EVE_test_read32(REG_INT_FLAGS) | EVE_INT_CONVCOMPLETE;
+
+    if (0x80008000UL == EVE_test_read32(REG_TOUCH_SCREEN_XY))
+    {
+        flags |= EVE_INT_TOUCH;
+    }
+    if (EVE_test_read32(REG_TOUCH_TAG) != tag)
+    {
+        flags |= EVE_INT_TAG;
+    }
+    EVE_test_write32(REG_TOUCH_SCREEN_XY, xy);
+    EVE_test_write32(REG_TOUCH_TAG_XY, xy);
+    EVE_test_write32(REG_TOUCH_TAG, tag);
+    EVE_test_write32(REG_INT_FLAGS, flags);
+    test_update_int();
+}
+
+void EVE_test_release(void)
+{
+    uint32_t flags = EVE_test_read32(REG_INT_FLAGS) | EVE_INT_TOUCH | EVE_INT_CONVCOMPLETE;
+
+    if (EVE_test_read32(REG_TOUCH_TAG) != 0UL)
+    {
+        flags |= EVE_INT_TAG;
+    }
+    EVE_test_write32(REG_TOUCH_SCREEN_XY, 0x80008000UL);
+    EVE_test_write32(REG_TOUCH_TAG_XY, 0x80008000UL);
+    EVE_test_write32(REG_TOUCH_TAG, 0UL);
+    EVE_test_write32(REG_INT_FLAGS, flags);
+    test_update_int();
+}
+
+uint32_t EVE_test_read32(uint32_t const address)
+{
+    uint32_t ret = 0UL;
+
+    for (uint8_t index = 0U; index < 4U; index++)
+    {
+        uint8_t const * const p_mem = test_mem(address + index);
+
+        if (p_mem != NULL)
+        {
+            ret |= ((uint32_t) *p_mem) << (index * 8U);
+        }
+    }
+    return (ret);
+}
+
+void EVE_test_write32(uint32_t const address, uint32_t const data)
+{
+    for (uint8_t index = 0U; index < 4U; index++)
+    {
+        uint8_t * const p_mem = test_mem(address + index);
+
+        if (p_mem != NULL)
+        {
+            *p_mem = (uint8_t) (data >> (index * 8U));
+        }
+    }
+}
+
+uint32_t EVE_test_transactions(void)
+{
+    return (test_transactions);
+}
+
+uint32_t EVE_test_cmd_bytes(void)
+{
+    return (test_cmd_bytes);
+}
+
+/**
+ * @brief Let the co-processor drain the cmd-FIFO with bytes_per_ms, 0 executes everything instantly.
+ * @param spi_ns - the time one SPI byte takes on the virtual clock
+ */
+void EVE_test_set_drain(uint32_t const bytes_per_ms, uint32_t const spi_ns)
+{
+    test_drain_rate = bytes_per_ms;
+    test_spi_ns = spi_ns;
+    test_fifo_fill = 0UL;
+    test_drain_acc = 0UL;
+    test_update_space();
+}
+
+void EVE_test_delay_us(uint16_t const microseconds)
+{
+    test_advance((uint32_t) microseconds * 1000UL);
+}
+
+uint32_t EVE_test_time_us(void)
+{
+    return (test_time_us);
+}
+
+uint32_t EVE_test_space_reads(void)
+{
+    return (test_space_reads);
+}
+
+/**
+ * @brief Raise a coprocessor fault, REG_CMDB_SPACE reads 0xfff until REG_CPURESET is written with 0.
+ */
+void EVE_test_fault(void)
+{
+    test_fault = 1U;
+    EVE_test_write32(REG_CMDB_SPACE, 0xfffUL);
+}
+
+/**
+ * @brief Copy the following words written to the cmd-FIFO to p_words, up to max words, NULL stops it.
+ * @note - The count starts over with every call.
+ */
+void EVE_test_capture(uint32_t * const p_words, uint32_t const max)
+{
+    p_test_capture = p_words;
+    test_capture_max = max;
+    test_captured = 0UL;
+    test_capture_bytes = 0UL;
+}
+
+/**
+ * @brief Number of words captured since EVE_test_capture().
+ */
+uint32_t EVE_test_captured(void)
+{
+    return (test_captured);
+}
+
+/**
+ * @brief Run a VSYNC every period_us on the virtual clock, 0 stops it.
+ */
+void EVE_test_set_frame(uint32_t const period_us)
+{
+    test_frame_us = period_us;
+    test_vsync_us = test_time_us + period_us;
+}
+
+#endif /* SOFTWARE_TEST */
+
+/* ################################################################## */
+/* ################################################################## */
+
 #if defined (__SAMC21E18A__) \
     || defined (__SAMC21J18A__) \
     || defined (__SAMC21J17A__) \
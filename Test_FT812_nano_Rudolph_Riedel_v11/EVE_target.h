@@ -93,6 +93,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 - added XMC4700_Relax_Kit
 - changed the Infineon XMC include to EVE_target_Arduino_Infineon_XMC.h
 - reworked STM32 support
+- added the SOFTWARE_TEST target, it replaces every other non-Arduino target when defined
 
 */
 
@@ -140,6 +141,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #if !defined (ARDUINO)
 
+#if defined (SOFTWARE_TEST)
+
+#include "EVE_target/EVE_target_Test.h"
+
+#else
+
 #if defined (__IMAGECRAFT__)
 #if defined (_AVR)
 
@@ -335,6 +342,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 /* ################################################################## */
 /* ################################################################## */
 
+#endif /* SOFTWARE_TEST */
+
 #endif /* !Arduino */
 
 #if defined (ARDUINO)
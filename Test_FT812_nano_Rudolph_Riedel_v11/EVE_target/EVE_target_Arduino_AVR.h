@@ -36,6 +36,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 - split up the optional default defines to allow to only change what needs
     changing thru the build-environment
 - changed #include "EVE_cpp_wrapper.h" to #include "../EVE_cpp_wrapper.h"
+- added EVE_INT for the pin INT_N is connected to
+- added EVE_DELAY_US() for EVE_BACKOFF
 
 */
 
@@ -65,9 +67,14 @@ extern "C"
 #if !defined (EVE_PDN)
 #define EVE_PDN 3
 #endif
+
+#if !defined (EVE_INT)
+#define EVE_INT 2 /* INT_N of EVE, needs a pin with external interrupt, INT0 on ATmega328 */
+#endif
 /* you may define these in your build-environment to use different settings */
 
 #define DELAY_MS(ms) delay(ms)
+#define EVE_DELAY_US(us) delayMicroseconds(us)
 
 static inline void EVE_pdn_set(void)
 {
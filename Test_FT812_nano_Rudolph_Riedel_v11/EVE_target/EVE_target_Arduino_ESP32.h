@@ -40,6 +40,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
   and using only the SPI class allows other SPI devices more easily
 - changed wrapper_spi_transmit_32() to use SPI.write32() which requires a byte-swap
 - restored the ESP-IDF code and made it selectable by macro EVE_USE_ESP_IDF
+- added EVE_DELAY_US() for EVE_BACKOFF
 
 */
 
@@ -81,6 +82,7 @@ extern "C"
 /* you may define these in your build-environment to use different settings */
 
 #define DELAY_MS(ms) delay(ms)
+#define EVE_DELAY_US(us) delayMicroseconds(us)
 
 static inline void EVE_pdn_set(void)
 {
@@ -35,6 +35,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 - split up the optional default defines to allow to only change what needs
     changing thru the build-environment
 - changed #include "EVE_cpp_wrapper.h" to #include "../EVE_cpp_wrapper.h"
+- added EVE_DELAY_US() for EVE_BACKOFF
 
 */
 
@@ -65,6 +66,7 @@ extern "C"
 /* you may define these in your build-environment to use different settings */
 
 #define DELAY_MS(ms) delay(ms)
+#define EVE_DELAY_US(us) delayMicroseconds(us)
 
 static inline void EVE_pdn_set(void)
 {
@@ -37,6 +37,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 - changed #include "EVE_cpp_wrapper.h" to #include "../EVE_cpp_wrapper.h"
 - renamed to EVE_target_Arduino_Infineon_XMC.h
 - removed the extra layer of #if defined protection for the target
+- added EVE_DELAY_US() for EVE_BACKOFF
 
 */
 
@@ -65,6 +66,7 @@ extern "C"
 /* you may define these in your build-environment to use different settings */
 
 #define DELAY_MS(ms) delay(ms)
+#define EVE_DELAY_US(us) delayMicroseconds(us)
 
 static inline void EVE_pdn_set(void)
 {
@@ -38,6 +38,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 - changed #include "EVE_cpp_wrapper.h" to #include "../EVE_cpp_wrapper.h"
 - EVE_SPI could not actually be configured as "SPI1" is not just a number,
   changed parameter to EVE_SPI_UNIT and "1" is the only valid option, for now
+- added EVE_DELAY_US() for EVE_BACKOFF
 
 */
 
@@ -94,6 +95,7 @@ void EVE_start_dma_transfer(void);
 #endif
 
 #define DELAY_MS(ms) delay(ms)
+#define EVE_DELAY_US(us) delayMicroseconds(us)
 
 static inline void EVE_pdn_set(void)
 {
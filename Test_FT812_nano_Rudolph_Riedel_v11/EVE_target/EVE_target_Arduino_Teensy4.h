@@ -37,6 +37,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
     changing thru the build-environment
 - changed #include "EVE_cpp_wrapper.h" to #include "../EVE_cpp_wrapper.h"
 - added ARDUINO_TEENSY40 to the Teensy 4 target
+- added EVE_DELAY_US() for EVE_BACKOFF
 
 */
 
@@ -78,6 +79,7 @@ void EVE_start_dma_transfer(void);
 #endif
 
 #define DELAY_MS(ms) delay(ms)
+#define EVE_DELAY_US(us) delayMicroseconds(us)
 
 static inline void EVE_pdn_set(void)
 {
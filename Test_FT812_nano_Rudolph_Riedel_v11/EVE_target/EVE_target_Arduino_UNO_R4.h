@@ -32,6 +32,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 5.0
 - started to work on DMA support
+- added EVE_DELAY_US() for EVE_BACKOFF
 
 */
 
@@ -70,6 +71,7 @@ extern "C"
 #endif
 
 #define DELAY_MS(ms) delay(ms)
+#define EVE_DELAY_US(us) delayMicroseconds(us)
 
 static inline void EVE_pdn_set(void)
 {
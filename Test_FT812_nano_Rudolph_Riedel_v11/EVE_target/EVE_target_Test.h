@@ -2,7 +2,7 @@
 @file    EVE_target_Test.h
 @brief   target specific includes, definitions and functions
 @version 5.0
-@date    2023-06-24
+@date    2026-10-19
 @author  Rudolph Riedel
 
 @section LICENSE
@@ -33,6 +33,15 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 5.0
 - new target for software tests
 - basic maintenance: checked for violations of white space and indent rules
+- reworked into a stand-in for the EVE chip: the SPI functions feed a small emulation in EVE_target.c
+    that decodes the transfers into register / RAM_G / RAM_DL accesses, REG_INT_FLAGS is cleared on read
+    and the INT line can be asserted from the test with EVE_test_touch()
+- added EVE_DELAY_US() on a virtual clock and EVE_test_set_drain() to emulate a co-processor that needs time
+- added EVE_test_set_frame() to run REG_FRAMES and REG_DLSWAP on the virtual clock
+- added EVE_test_capture() to record the words written to the cmd-FIFO
+- added EVE_test_fault() to raise a coprocessor fault
+- added EVE_TEST_SPI_SINK to send the SPI to EVE_test_sink instead of the emulation for benchmarks
+- the metric blocks of the ROM fonts are emulated, a test writes the widths and heights with EVE_test_write32()
 
 */
 
@@ -43,113 +52,108 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <stdint.h>
 
-/* ToDo: checkout Google Test / Mock */
-
-extern uint8_t EVE_spi_test_buffer[8192];
-extern uint8_t EVE_spi_test_buffer_index;
-extern uint8_t EVE_spi_test_buffer_receive[32];
-
-struct
-{
-    uint8_t called;
-} Test_EVE_pdn_set;
-
-struct
-{
-    uint8_t called;
-} Test_EVE_pdn_clear;
-
-struct
-{
-    uint8_t called;
-} Test_EVE_cs_set;
-
-struct
-{
-    uint8_t called;
-} Test_EVE_cs_clear;
-
-struct
-{
-    uint8_t called;
-} Test_EVE_spi_transmit;
-
-struct
-{
-    uint8_t called;
-} Test_EVE_spi_transmit_32;
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* emulation, implemented in EVE_target.c */
+void EVE_test_reset(void);
+void EVE_test_cs_set(void);
+void EVE_test_cs_clear(void);
+uint8_t EVE_test_spi(uint8_t data);
+
+/* test interface */
+void EVE_test_set_int_handler(void (*p_isr)(void));
+uint8_t EVE_test_int_asserted(void);
+void EVE_test_touch(int16_t xc0, int16_t yc0, uint8_t tag);
+void EVE_test_release(void);
+uint32_t EVE_test_read32(uint32_t address);
+void EVE_test_write32(uint32_t address, uint32_t data);
+uint32_t EVE_test_transactions(void);
+uint32_t EVE_test_cmd_bytes(void);
+void EVE_test_set_drain(uint32_t bytes_per_ms, uint32_t spi_ns);
+void EVE_test_delay_us(uint16_t microseconds);
+uint32_t EVE_test_time_us(void);
+uint32_t EVE_test_space_reads(void);
+void EVE_test_set_frame(uint32_t period_us);
+void EVE_test_capture(uint32_t *p_words, uint32_t max);
+uint32_t EVE_test_captured(void);
+void EVE_test_fault(void);
+
+#ifdef __cplusplus
+}
+#endif
 
-#define EVE_DELAY_1MS 4U  /* no real delay needed for the software tests */
+#define PROGMEM
 
 static inline void DELAY_MS(uint16_t val)
 {
-    for (uint16_t counter = 0; counter < EVE_DELAY_1MS; counter++)
-    {
-        __asm__ volatile("nop");
-    }
+    (void) val; /* no real delay needed for the software tests */
 }
+
+#define EVE_DELAY_US(us) EVE_test_delay_us(us)
+
 static inline void EVE_pdn_set(void)
 {
-    Test_EVE_pdn_set.called = Test_EVE_pdn_set.called + 1U;
+    EVE_test_reset();
 }
 
 static inline void EVE_pdn_clear(void)
 {
-    Test_EVE_pdn_clear.called = Test_EVE_pdn_clear.called + 1U;
 }
 
 static inline void EVE_cs_set(void)
 {
-    Test_EVE_cs_set.called = Test_EVE_cs_set.called + 1U;
-    EVE_spi_test_buffer_index = 0;
+    EVE_test_cs_set();
 }
 
 static inline void EVE_cs_clear(void)
 {
-    Test_EVE_cs_clear.called = Test_EVE_cs_clear.called + 1U;
+    EVE_test_cs_clear();
 }
 
+#if defined (EVE_TEST_SPI_SINK)
+/* benchmarks only: the SPI goes nowhere, so only the code that feeds it is measured, there is no emulation */
+extern volatile uint32_t EVE_test_sink;
+#endif
+
 static inline void spi_transmit(uint8_t data)
 {
-    Test_EVE_spi_transmit.called = Test_EVE_spi_transmit.called + 1U;
-    EVE_spi_test_buffer[EVE_spi_test_buffer_index] = data;
-    EVE_spi_test_buffer_index++;
+#if defined (EVE_TEST_SPI_SINK)
+    EVE_test_sink = data;
+#else
+    (void) EVE_test_spi(data);
+#endif
 }
 
 static inline void spi_transmit_32(uint32_t data)
 {
-    Test_EVE_spi_transmit_32.called = Test_EVE_spi_transmit_32.called + 1U;
-    EVE_spi_test_buffer[EVE_spi_test_buffer_index] = ((uint8_t)(data & 0x000000ffUL));
-    EVE_spi_test_buffer_index++;
-    EVE_spi_test_buffer[EVE_spi_test_buffer_index] = ((uint8_t)(data >> 8U));
-    EVE_spi_test_buffer_index++;
-    EVE_spi_test_buffer[EVE_spi_test_buffer_index] = ((uint8_t)(data >> 16U));
-    EVE_spi_test_buffer_index++;
-    EVE_spi_test_buffer[EVE_spi_test_buffer_index] = ((uint8_t)(data >> 24U));
-    EVE_spi_test_buffer_index++;
+    spi_transmit((uint8_t)(data & 0x000000ffUL));
+    spi_transmit((uint8_t)(data >> 8U));
+    spi_transmit((uint8_t)(data >> 16U));
+    spi_transmit((uint8_t)(data >> 24U));
 }
 
 /* spi_transmit_burst() is only used for cmd-FIFO commands */
 /* so it *always* has to transfer 4 bytes */
 static inline void spi_transmit_burst(uint32_t data)
 {
-    Test_EVE_spi_transmit_burst.called = Test_EVE_spi_transmit_burst.called + 1U;
+#if defined (EVE_TEST_SPI_SINK)
+    EVE_test_sink = data;
+#else
     spi_transmit_32(data);
+#endif
 }
 
 static inline uint8_t spi_receive(uint8_t data)
 {
-    Test_EVE_spi_transmit.called = Test_EVE_spi_receive.called + 1U;
-    uint8_t result = EVE_spi_test_buffer_receive[EVE_spi_test_buffer_index];
-    EVE_spi_test_buffer[EVE_spi_test_buffer_index] = data;
-    EVE_spi_test_buffer_index++;
+    return (EVE_test_spi(data));
 }
 
 static inline uint8_t fetch_flash_byte(const uint8_t *p_data)
 {
-    Test_EVE_fetch_flash_byte.called = Test_EVE_fetch_flash_byte.called + 1U;
-    (void) *p_data;
-    return (0x00);
+    return (*p_data);
 }
 
 #endif /* SOFTWARE_TEST */
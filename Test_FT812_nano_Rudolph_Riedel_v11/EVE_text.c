@@ -0,0 +1,350 @@
+/*
+@file    EVE_text.c
+@brief   text that is laid out on the host from the metrics of the ROM fonts
+@version 1.1
+@date    2026-10-19
+@author  Christian Lara
+
+@section info
+
+With CMD_TEXT the coprocessor reads the string and the font metrics for every label in every frame.
+EVE_text_load() reads the width table and the height of a ROM font 16...31 from the metric block
+once, with that the string is laid out on the host: BEGIN(BITMAPS) and one VERTEX2II per glyph,
+the font is the bitmap handle and the character the cell, same as the coprocessor does it.
+EVE_OPT_CENTERX, EVE_OPT_CENTERY and EVE_OPT_RIGHTX move the string like they do for CMD_TEXT.
+
+EVE_text_burst() goes to the display list directly, EVE_text_compile() writes the words to an array
+that can be kept and replayed with EVE_cmd_dl_burst() as long as the label does not change.
+EVE_text_width() measures a string without the coprocessor.
+
+VERTEX2II only covers 0...511, a string beyond that is placed with VERTEX_TRANSLATE_X / _Y,
+which is set back after the string. Labels that are close to each other can share one translation,
+EVE_text_origin_burst() sets it, the coordinates stay absolute. Spaces only advance, they have no vertex.
+Fonts that are not loaded and options other than the three above fall back to EVE_cmd_text_burst().
+EVE_text_load() reads from EVE and can not be used in the middle of a burst.
+
+test/test_text.c compares the glyph positions with the layout of CMD_TEXT, CENTERX and CENTERY
+round half of an odd width or height down like the coprocessor. Accepted deviations:
+- the display list is not the one of CMD_TEXT, VERTEX2II plus VERTEX_TRANSLATE instead of VERTEX2F
+  and the bitmap state, the pixels are the same
+- characters outside 32...127 are skipped, the coprocessor draws whatever the font has for them
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+1.1
+- test/test_text.c, the accepted deviations from CMD_TEXT in the info section
+
+*/
+
+#include "EVE_text.h"
+
+#ifndef NULL /* define NULL if it not already is */
+#include <stdio.h>
+#endif
+
+#define TEXT_ROM_FIRST 16U
+#define TEXT_ROM_LAST 31U
+#define TEXT_METRIC_SIZE 148U /* size of the metric block of a legacy font */
+#define TEXT_METRIC_HEIGHT 140U /* offset of the font height in the metric block */
+#define TEXT_FIRST_CHAR 32U /* the ROM fonts have no glyphs below the space */
+#define TEXT_CHARS 96U
+#define TEXT_VERTEX_MAX 511L /* VERTEX2II has 9 bits for x and y */
+#define TEXT_OPTIONS (EVE_OPT_CENTER | EVE_OPT_RIGHTX)
+
+typedef struct
+{
+    uint8_t font; /* 0 - unused */
+    uint8_t height;
+    uint8_t widths[TEXT_CHARS]; /* advance of the characters 32...127 */
+} text_font_t;
+
+static text_font_t text_fonts[EVE_TEXT_FONTS];
+
+static int32_t text_origin_x = 0; /* VERTEX_TRANSLATE from EVE_text_origin_burst() in pixels */
+static int32_t text_origin_y = 0;
+static uint32_t *p_text_out = NULL; /* NULL - the words go to the display list */
+static uint16_t text_out_len = 0U;
+static uint16_t text_out_max = 0U;
+
+static text_font_t const *text_find(uint8_t const font)
+{
+    text_font_t const *p_found = NULL;
+
+    for (uint8_t slot = 0U; slot < EVE_TEXT_FONTS; slot++)
+    {
+        if ((font != 0U) && (text_fonts[slot].font == font))
+        {
+            p_found = &text_fonts[slot];
+            break;
+        }
+    }
+    return (p_found);
+}
+
+static void text_put(uint32_t const word)
+{
+    if (NULL == p_text_out)
+    {
+        EVE_cmd_dl_burst(word);
+    }
+    else
+    {
+        if (text_out_len < text_out_max)
+        {
+            p_text_out[text_out_len] = word;
+        }
+        text_out_len++;
+    }
+}
+
+static uint16_t text_measure(text_font_t const * const p_font, const uint8_t * const p_bytes)
+{
+    uint16_t width = 0U;
+
+    for (uint16_t index = 0U; p_bytes[index] != 0U; index++)
+    {
+        uint8_t const character = p_bytes[index];
+
+        if ((character >= TEXT_FIRST_CHAR) && (character < (TEXT_FIRST_CHAR + TEXT_CHARS)))
+        {
+            width += p_font->widths[character - TEXT_FIRST_CHAR];
+        }
+    }
+    return (width);
+}
+
+static void text_emit(int16_t const xc0, int16_t const yc0, text_font_t const * const p_font,
+                      uint16_t const options, const uint8_t * const p_bytes)
+{
+    int32_t xpos = xc0;
+    int32_t ypos = yc0;
+    int32_t origin_x = text_origin_x;
+    int32_t origin_y = text_origin_y;
+    uint8_t begin = 0U;
+
+    if ((options & EVE_OPT_RIGHTX) != 0U)
+    {
+        xpos -= (int32_t) text_measure(p_font, p_bytes);
+    }
+    else if ((options & EVE_OPT_CENTERX) != 0U)
+    {
+        xpos -= (int32_t) (text_measure(p_font, p_bytes) / 2U);
+    }
+    else
+    {
+        /* starts at xc0 */
+    }
+
+    if ((options & EVE_OPT_CENTERY) != 0U)
+    {
+        ypos -= (int32_t) (p_font->height / 2U);
+    }
+
+    for (uint16_t index = 0U; p_bytes[index] != 0U; index++)
+    {
+        uint8_t const character = p_bytes[index];
+
+        if ((character > TEXT_FIRST_CHAR) && (character < (TEXT_FIRST_CHAR + TEXT_CHARS)))
+        {
+            if (0U == begin)
+            {
+                begin = 1U;
+                text_put(DL_BEGIN | EVE_BITMAPS);
+
+                if (((ypos - origin_y) < 0) || ((ypos - origin_y) > TEXT_VERTEX_MAX))
+                {
+                    origin_y = ypos;
+                    text_put(VERTEX_TRANSLATE_Y(origin_y * 16L));
+                }
+            }
+
+            if (((xpos - origin_x) < 0) || ((xpos - origin_x) > TEXT_VERTEX_MAX))
+            {
+                origin_x = xpos;
+                text_put(VERTEX_TRANSLATE_X(origin_x * 16L));
+            }
+
+            text_put(VERTEX2II((uint16_t) (xpos - origin_x), (uint16_t) (ypos - origin_y), p_font->font, character));
+        }
+
+        if ((character >= TEXT_FIRST_CHAR) && (character < (TEXT_FIRST_CHAR + TEXT_CHARS)))
+        {
+            xpos += (int32_t) p_font->widths[character - TEXT_FIRST_CHAR];
+        }
+    }
+
+    if (origin_x != text_origin_x)
+    {
+        text_put(VERTEX_TRANSLATE_X(text_origin_x * 16L));
+    }
+
+    if (origin_y != text_origin_y)
+    {
+        text_put(VERTEX_TRANSLATE_Y(text_origin_y * 16L));
+    }
+}
+
+/**
+ * @brief Read the width table and the height of a ROM font from EVE.
+ * @param font 16...31
+ * @return E_OK or E_NOT_OK if the font is no ROM font or all EVE_TEXT_FONTS are in use
+ * @note - not in burst-mode, usually once after EVE_init()
+ */
+uint8_t EVE_text_load(uint8_t const font)
+{
+    uint8_t ret = E_NOT_OK;
+
+    if (text_find(font) != NULL)
+    {
+        ret = E_OK;
+    }
+    else if ((font >= TEXT_ROM_FIRST) && (font <= TEXT_ROM_LAST))
+    {
+        for (uint8_t slot = 0U; slot < EVE_TEXT_FONTS; slot++)
+        {
+            if (0U == text_fonts[slot].font)
+            {
+                uint32_t const metrics = EVE_memRead32(EVE_ROM_FONTROOT) +
+                                         (TEXT_METRIC_SIZE * ((uint32_t) font - TEXT_ROM_FIRST));
+
+                EVE_memRead_sram_buffer(metrics + TEXT_FIRST_CHAR, text_fonts[slot].widths, TEXT_CHARS);
+                text_fonts[slot].height = (uint8_t) EVE_memRead32(metrics + TEXT_METRIC_HEIGHT);
+                text_fonts[slot].font = font;
+                ret = E_OK;
+                break;
+            }
+        }
+    }
+    else
+    {
+        /* RAM fonts and the extended fonts 32...34 are left to the coprocessor */
+    }
+    return (ret);
+}
+
+/**
+ * @brief Width of a string in pixels.
+ * @return 0 if the font is not loaded
+ */
+uint16_t EVE_text_width(uint8_t const font, const char * const p_text)
+{
+    uint16_t width = 0U;
+    text_font_t const *const p_font = text_find(font);
+
+    if ((p_font != NULL) && (p_text != NULL))
+    {
+        width = text_measure(p_font, (const uint8_t *) p_text);
+    }
+    return (width);
+}
+
+/**
+ * @brief Height of the font in pixels.
+ * @return 0 if the font is not loaded
+ */
+uint16_t EVE_text_height(uint8_t const font)
+{
+    uint16_t height = 0U;
+    text_font_t const *const p_font = text_find(font);
+
+    if (p_font != NULL)
+    {
+        height = p_font->height;
+    }
+    return (height);
+}
+
+/**
+ * @brief Lay out a string to display list words, these can be sent with EVE_cmd_dl_burst() later.
+ * @return number of words, 0 if the font is not loaded, the option is not supported,
+ * the words do not fit in max_words or there is nothing to draw
+ */
+uint16_t EVE_text_compile(int16_t const xc0, int16_t const yc0, uint8_t const font, uint16_t const options,
+                          const char * const p_text, uint32_t * const p_words, uint16_t const max_words)
+{
+    uint16_t ret = 0U;
+    text_font_t const *const p_font = text_find(font);
+
+    if ((p_font != NULL) && (p_text != NULL) && (p_words != NULL) && (0U == (options & ~TEXT_OPTIONS)))
+    {
+        p_text_out = p_words;
+        text_out_len = 0U;
+        text_out_max = max_words;
+        text_emit(xc0, yc0, p_font, options, (const uint8_t *) p_text);
+
+        if (text_out_len <= max_words)
+        {
+            ret = text_out_len;
+        }
+        p_text_out = NULL;
+    }
+    return (ret);
+}
+
+/**
+ * @brief Set VERTEX_TRANSLATE_X / _Y for the following labels, EVE_text_origin_burst(0, 0) after them.
+ * @note - the translation applies to everything else that is drawn as well, coprocessor widgets included
+ */
+void EVE_text_origin_burst(int16_t const xc0, int16_t const yc0)
+{
+    if (xc0 != text_origin_x)
+    {
+        text_origin_x = xc0;
+        EVE_vertex_translate_x_burst(text_origin_x * 16L);
+    }
+
+    if (yc0 != text_origin_y)
+    {
+        text_origin_y = yc0;
+        EVE_vertex_translate_y_burst(text_origin_y * 16L);
+    }
+}
+
+/**
+ * @brief Draw a string with VERTEX2II, the replacement for EVE_cmd_text_burst().
+ */
+void EVE_text_burst(int16_t const xc0, int16_t const yc0, uint8_t const font, uint16_t const options,
+                    const char * const p_text)
+{
+    text_font_t const *const p_font = text_find(font);
+
+    if ((NULL == p_font) || ((options & ~TEXT_OPTIONS) != 0U))
+    {
+        /* the output of the coprocessor is translated as well */
+        EVE_cmd_text_burst((int16_t) (xc0 - text_origin_x), (int16_t) (yc0 - text_origin_y), font, options, p_text);
+    }
+    else if (p_text != NULL)
+    {
+        text_emit(xc0, yc0, p_font, options, (const uint8_t *) p_text);
+    }
+    else
+    {
+        /* nothing to draw */
+    }
+}
@@ -0,0 +1,67 @@
+/*
+@file    EVE_text.h
+@brief   prototypes for text that is laid out on the host from the metrics of the ROM fonts
+@version 1.0
+@date    2026-10-19
+@author  Christian Lara
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#ifndef EVE_TEXT_H
+#define EVE_TEXT_H
+
+#include "EVE.h"
+#include "EVE_commands.h"
+
+/* number of fonts with metrics on the host, every font takes 98 bytes of RAM */
+#if !defined (EVE_TEXT_FONTS)
+#define EVE_TEXT_FONTS 2U
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+uint8_t EVE_text_load(uint8_t const font);
+uint16_t EVE_text_width(uint8_t const font, const char * const p_text);
+uint16_t EVE_text_height(uint8_t const font);
+uint16_t EVE_text_compile(int16_t const xc0, int16_t const yc0, uint8_t const font, uint16_t const options,
+                          const char * const p_text, uint32_t * const p_words, uint16_t const max_words);
+void EVE_text_origin_burst(int16_t const xc0, int16_t const yc0);
+void EVE_text_burst(int16_t const xc0, int16_t const yc0, uint8_t const font, uint16_t const options,
+                    const char * const p_text);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_TEXT_H */
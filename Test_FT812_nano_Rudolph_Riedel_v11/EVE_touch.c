@@ -0,0 +1,194 @@
+/*
+@file    EVE_touch.c
+@brief   interrupt driven touch events with an event queue, replaces polling of REG_TOUCH_TAG
+@version 1.0
+@date    2026-10-18
+@author  Christian Lara
+
+@section info
+
+EVE raises INT_N for EVE_INT_TAG and EVE_INT_TOUCH, EVE_touch_isr() only sets a flag as
+the SPI may be in use by the interrupted code. EVE_touch_service() does the SPI part
+outside of the interrupt, so nothing is transferred as long as the screen is not touched.
+EVE_INT_CONVCOMPLETE is only enabled while the screen is touched to follow movement.
+
+REG_INT_FLAGS and the touch registers are 124 bytes apart, reading both in a single
+transfer would cost more than two short transfers: 4 bytes from REG_INT_FLAGS and
+12 bytes from REG_TOUCH_SCREEN_XY to REG_TOUCH_TAG.
+
+The queue is lock-free for one producer and one consumer, EVE_touch_service() and
+EVE_touch_get() may run in different contexts as long as each one only runs in one.
+
+How to use:
+- connect INT_N to an interrupt capable pin with pull-up and call EVE_touch_isr() on the falling edge
+- EVE_touch_init() after EVE_init()
+- EVE_touch_service() as often as possible, e.g. every pass of loop()
+- EVE_touch_get() until it returns E_NOT_OK
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#include "EVE_touch.h"
+
+#ifndef NULL /* define NULL if it not already is */
+#include <stdio.h>
+#endif
+
+#define TOUCH_QUEUE_MASK ((uint8_t) (EVE_TOUCH_QUEUE_SIZE - 1U))
+#define TOUCH_INT_BASE (EVE_INT_TAG | EVE_INT_TOUCH)
+
+static volatile uint8_t touch_pending = 0U;
+static volatile uint8_t touch_head = 0U; /* only written by EVE_touch_service() */
+static volatile uint8_t touch_tail = 0U; /* only written by EVE_touch_get() */
+static volatile EVE_touch_event_t touch_queue[EVE_TOUCH_QUEUE_SIZE];
+static uint8_t touch_mask = TOUCH_INT_BASE;
+static uint16_t touch_dropped = 0U;
+
+/**
+ * @brief Enable the touch interrupts, needs to be called after EVE_init().
+ */
+void EVE_touch_init(void)
+{
+    touch_mask = TOUCH_INT_BASE;
+    touch_head = 0U;
+    touch_tail = 0U;
+    touch_dropped = 0U;
+    EVE_memWrite8(REG_INT_MASK, touch_mask);
+    (void) EVE_memRead8(REG_INT_FLAGS); /* clear what happened before */
+    EVE_memWrite8(REG_INT_EN, 1U);
+}
+
+/**
+ * @brief To be called from the interrupt of the pin INT_N is connected to.
+ */
+void EVE_touch_isr(void)
+{
+    touch_pending = 1U;
+}
+
+/**
+ * @brief Read the interrupt flags and touch registers after an interrupt and put an event in the queue.
+ * @return - E_OK - an event was read
+ * @return - E_NOT_OK - there was no interrupt, nothing was transferred
+ */
+uint8_t EVE_touch_service(void)
+{
+    uint8_t ret = E_NOT_OK;
+
+#if defined (EVE_DMA)
+    if (0 == EVE_dma_busy) /* try again later, the SPI is in use */
+    {
+#endif
+
+    if (touch_pending != 0U)
+    {
+        uint8_t regs[12];
+        uint8_t flags;
+        uint8_t mask;
+
+        touch_pending = 0U; /* before reading the flags to not miss the next edge */
+        flags = EVE_memRead8(REG_INT_FLAGS);
+        EVE_memRead_sram_buffer(REG_TOUCH_SCREEN_XY, regs, 12U);
+
+        if ((flags & touch_mask) != 0U)
+        {
+            uint8_t const next = (uint8_t) ((touch_head + 1U) & TOUCH_QUEUE_MASK);
+
+            if (next != touch_tail)
+            {
+                volatile EVE_touch_event_t * const p_slot = &touch_queue[touch_head];
+
+                p_slot->flags = flags;
+                p_slot->tag = regs[8];
+                p_slot->yc0 = (int16_t) ((uint16_t) regs[0] | ((uint16_t) regs[1] << 8U));
+                p_slot->xc0 = (int16_t) ((uint16_t) regs[2] | ((uint16_t) regs[3] << 8U));
+                touch_head = next; /* publish the event after it is complete */
+            }
+            else
+            {
+                touch_dropped++;
+            }
+            ret = E_OK;
+        }
+
+        /* follow the movement with EVE_INT_CONVCOMPLETE only while touched */
+        if ((0U == regs[0]) && (0x80U == regs[1]) && (0U == regs[2]) && (0x80U == regs[3])) /* 0x80008000 */
+        {
+            mask = TOUCH_INT_BASE;
+        }
+        else
+        {
+            mask = TOUCH_INT_BASE | EVE_INT_CONVCOMPLETE;
+        }
+
+        if (mask != touch_mask)
+        {
+            touch_mask = mask;
+            EVE_memWrite8(REG_INT_MASK, touch_mask);
+        }
+    }
+
+#if defined (EVE_DMA)
+    }
+#endif
+
+    return (ret);
+}
+
+/**
+ * @brief Take the oldest event from the queue.
+ * @return - E_OK - p_event was filled
+ * @return - E_NOT_OK - the queue is empty
+ */
+uint8_t EVE_touch_get(EVE_touch_event_t * const p_event)
+{
+    uint8_t ret = E_NOT_OK;
+
+    if ((p_event != NULL) && (touch_tail != touch_head))
+    {
+        volatile EVE_touch_event_t const * const p_slot = &touch_queue[touch_tail];
+
+        p_event->flags = p_slot->flags;
+        p_event->tag = p_slot->tag;
+        p_event->xc0 = p_slot->xc0;
+        p_event->yc0 = p_slot->yc0;
+        touch_tail = (uint8_t) ((touch_tail + 1U) & TOUCH_QUEUE_MASK); /* release the slot after it was copied */
+        ret = E_OK;
+    }
+    return (ret);
+}
+
+/**
+ * @brief Number of events lost because the queue was full.
+ */
+uint16_t EVE_touch_dropped(void)
+{
+    return (touch_dropped);
+}
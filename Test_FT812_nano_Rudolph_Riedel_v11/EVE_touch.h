@@ -0,0 +1,73 @@
+/*
+@file    EVE_touch.h
+@brief   prototypes for interrupt driven touch events
+@version 1.0
+@date    2026-10-18
+@author  Christian Lara
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#ifndef EVE_TOUCH_H
+#define EVE_TOUCH_H
+
+#include "EVE.h"
+#include "EVE_commands.h"
+
+#if !defined (EVE_TOUCH_QUEUE_SIZE)
+#define EVE_TOUCH_QUEUE_SIZE 8U /* needs to be a power of two, 256 max */
+#endif
+
+#define EVE_TOUCH_NONE ((int16_t) -32768) /* xc0 / yc0 when the screen is not touched */
+
+typedef struct
+{
+    uint8_t flags; /* REG_INT_FLAGS, EVE_INT_TAG / EVE_INT_TOUCH / EVE_INT_CONVCOMPLETE */
+    uint8_t tag; /* REG_TOUCH_TAG */
+    int16_t xc0; /* REG_TOUCH_SCREEN_XY */
+    int16_t yc0;
+} EVE_touch_event_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+void EVE_touch_init(void);
+void EVE_touch_isr(void);
+uint8_t EVE_touch_service(void);
+uint8_t EVE_touch_get(EVE_touch_event_t * const p_event);
+uint16_t EVE_touch_dropped(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_TOUCH_H */
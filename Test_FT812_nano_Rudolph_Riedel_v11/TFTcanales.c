@@ -0,0 +1,364 @@
+/**
+@file    TFTcanales.c
+@brief   vista general: las graficas de los seis puntos de medicion en una pantalla, con presupuesto de display-list
+@version 1.1
+@date    2026-10-18
+@author  Christian Lara
+
+@section info
+
+Las columnas se cierran por tiempo con canales_tick(), igual para los seis canales, asi que todos
+tienen las mismas columnas listas. Los grupos de un LOD se alinean con el numero absoluto de
+columna y no con la mas vieja, al avanzar la grafica los grupos no cambian y la traza no parpadea.
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- version inicial
+1.1
+- canales_dibujar() pone VERTEX_FORMAT, la vista general no agrega la parte estatica que lo tiene
+- canales_vista_nueva() para que el primer plan no mida un frame de la otra vista
+- en AVR 24 columnas por canal
+*/
+
+#include "EVE.h"
+#include "colores.h"
+#include "TFTsignal.h"
+#include "TFTcanales.h"
+
+typedef struct
+{
+    uint8_t minimo[CANAL_COLUMNAS];
+    uint8_t maximo[CANAL_COLUMNAS];
+    uint8_t acc_min; /* la columna que se esta juntando */
+    uint8_t acc_max;
+    uint8_t ultimo; /* sin muestras nuevas la columna repite el ultimo valor */
+    uint8_t lod; /* log2 de columnas por vertice, CANAL_LOD_NADA si no cabe */
+} canal_t;
+
+static canal_t canales[CANALES];
+static uint16_t col_siguiente = 0U;
+static uint16_t col_listas = 0U;
+static uint32_t col_total = 0U; /* columnas cerradas desde canales_init(), para alinear los grupos */
+static uint32_t acc_ms = 0U;
+
+#define CANAL_DL_FIJO 2048U /* lo que no son trazas, hasta medirlo */
+
+static uint16_t dl_fijo = CANAL_DL_FIJO;
+static uint16_t dl_plan = 0U; /* bytes de trazas del plan actual */
+static uint8_t dl_medir = 0U; /* 0: el frame anterior no era de la vista general, REG_CMD_DL no sirve */
+
+static const uint32_t color_canal[CANALES] = {ROYAL_BLUE, FIREBRICK, FOREST_GREEN, DARK_YELLOW, STEEL_BLUE, CRIMSON};
+
+/* estado del simulador */
+static uint16_t sim_lfsr = 0x1d2bU;
+static uint32_t sim_ms = 0U;
+
+static uint8_t a_pixel(int16_t muestra)
+{
+    if (muestra < 0)
+    {
+        muestra = 0;
+    }
+    if (muestra > SIGNAL_MAX)
+    {
+        muestra = SIGNAL_MAX;
+    }
+    return ((uint8_t) (((uint32_t) muestra * CANAL_ALTO) / (uint32_t) SIGNAL_MAX));
+}
+
+static void vaciar_columna(canal_t *p_canal)
+{
+    p_canal->acc_min = p_canal->ultimo;
+    p_canal->acc_max = p_canal->ultimo;
+}
+
+/* vertices que pinta el canal con un LOD, un grupo son 2^lod columnas alineadas con col_total */
+static uint16_t grupos(uint8_t const lod)
+{
+    uint16_t cuantos = 0U;
+
+    if (col_listas > 0U)
+    {
+        uint32_t const primera = col_total - col_listas;
+        uint32_t const ultima = col_total - 1U;
+
+        cuantos = (uint16_t) ((ultima >> lod) - (primera >> lod) + 1U);
+    }
+    return (cuantos);
+}
+
+static uint16_t costo(uint8_t const lod)
+{
+    uint16_t const cuantos = grupos(lod);
+
+    return ((cuantos > 0U) ? (uint16_t) (CANAL_DL_POR_CANAL + (cuantos * 8U)) : 0U);
+}
+
+/** borra las graficas */
+void canales_init(void)
+{
+    for (uint8_t canal = 0U; canal < CANALES; canal++)
+    {
+        canales[canal].ultimo = 0U;
+        canales[canal].lod = 0U;
+        vaciar_columna(&canales[canal]);
+    }
+    col_siguiente = 0U;
+    col_listas = 0U;
+    col_total = 0U;
+    acc_ms = 0U;
+    canales_vista_nueva();
+}
+
+/** una muestra del punto canal (0 a 5), se llama desde el loop */
+void canales_push(uint8_t canal, int16_t muestra)
+{
+    if (canal < CANALES)
+    {
+        canal_t *const p_canal = &canales[canal];
+        uint8_t const pixel = a_pixel(muestra);
+
+        if (pixel < p_canal->acc_min)
+        {
+            p_canal->acc_min = pixel;
+        }
+        if (pixel > p_canal->acc_max)
+        {
+            p_canal->acc_max = pixel;
+        }
+        p_canal->ultimo = pixel;
+    }
+}
+
+/** avanza el tiempo, cierra las columnas de los seis canales cada CANAL_VENTANA_S / CANAL_COLUMNAS
+   paso: milisegundos que pasaron desde la ultima llamada */
+void canales_tick(uint16_t paso)
+{
+    acc_ms += (uint32_t) paso * CANAL_COLUMNAS;
+    while (acc_ms >= (CANAL_VENTANA_S * 1000UL))
+    {
+        acc_ms -= CANAL_VENTANA_S * 1000UL;
+        for (uint8_t canal = 0U; canal < CANALES; canal++)
+        {
+            canales[canal].minimo[col_siguiente] = canales[canal].acc_min;
+            canales[canal].maximo[col_siguiente] = canales[canal].acc_max;
+            vaciar_columna(&canales[canal]);
+        }
+        col_siguiente++;
+        if (col_siguiente >= CANAL_COLUMNAS)
+        {
+            col_siguiente = 0U;
+        }
+        if (col_listas < CANAL_COLUMNAS)
+        {
+            col_listas++;
+        }
+        col_total++;
+    }
+}
+
+/** reparte el display-list entre los canales, va fuera del burst antes de armar el frame
+   si el coprocesador todavia esta ejecutando el frame anterior se usa la medicion anterior */
+void canales_presupuesto(void)
+{
+    uint16_t disponible = 0U;
+    uint16_t parte;
+    uint16_t usado = 0U;
+    uint8_t cambio;
+
+    if ((dl_medir != 0U) && (E_OK == EVE_busy()))
+    {
+        uint16_t const cmd_dl = EVE_memRead16(REG_CMD_DL); /* bytes del frame anterior, con el plan anterior */
+
+        if (cmd_dl > dl_plan)
+        {
+            dl_fijo = (uint16_t) (cmd_dl - dl_plan);
+        }
+    }
+
+    if ((dl_fijo + CANAL_DL_RESERVA) < EVE_RAM_DL_SIZE)
+    {
+        disponible = (uint16_t) (EVE_RAM_DL_SIZE - dl_fijo - CANAL_DL_RESERVA);
+    }
+    parte = disponible / CANALES;
+
+    for (uint8_t canal = 0U; canal < CANALES; canal++) /* el LOD mas fino que cabe en la parte de cada canal */
+    {
+        uint8_t lod = 0U;
+
+        while ((costo(lod) > parte) && (lod < CANAL_LOD_MAX))
+        {
+            lod++;
+        }
+        canales[canal].lod = (costo(lod) <= parte) ? lod : CANAL_LOD_NADA;
+        if (canales[canal].lod != CANAL_LOD_NADA)
+        {
+            usado += costo(lod);
+        }
+    }
+
+    do /* lo que sobro baja el LOD un paso a la vez, por turnos, para que no se lo lleve un solo canal */
+    {
+        cambio = 0U;
+        for (uint8_t canal = 0U; canal < CANALES; canal++)
+        {
+            canal_t *const p_canal = &canales[canal];
+            uint8_t const lod = (CANAL_LOD_NADA == p_canal->lod) ? (uint8_t) (CANAL_LOD_MAX + 1U) : p_canal->lod;
+            uint16_t const actual = (CANAL_LOD_NADA == p_canal->lod) ? 0U : costo(p_canal->lod);
+
+            if ((lod > 0U) && ((usado - actual + costo((uint8_t) (lod - 1U))) <= disponible))
+            {
+                p_canal->lod = (uint8_t) (lod - 1U);
+                usado = (uint16_t) (usado - actual + costo(p_canal->lod));
+                cambio = 1U;
+            }
+        }
+    } while (cambio != 0U);
+    dl_plan = usado;
+    dl_medir = 1U;
+}
+
+/** el proximo canales_presupuesto() empieza de nuevo con CANAL_DL_FIJO en lugar de medir el frame anterior,
+   se llama al entrar a la vista general */
+void canales_vista_nueva(void)
+{
+    dl_fijo = CANAL_DL_FIJO;
+    dl_plan = 0U;
+    dl_medir = 0U;
+}
+
+/* un grupo de columnas desde la columna absoluta "desde" hasta antes de "hasta" */
+static void dibujar_grupo(canal_t const *const p_canal, uint32_t const desde, uint32_t const hasta, int16_t const xc0, int16_t const yc0, uint8_t const zig)
+{
+    uint32_t const primera = col_total - col_listas;
+    uint16_t col = (uint16_t) ((col_siguiente + CANAL_COLUMNAS - col_listas + (desde - primera)) % CANAL_COLUMNAS);
+    uint8_t minimo = 0xffU;
+    uint8_t maximo = 0U;
+    uint16_t posicion = (uint16_t) ((desde - primera) + (CANAL_COLUMNAS - col_listas)); /* columnas desde el borde izquierdo */
+    int16_t xc1;
+
+    for (uint32_t indice = desde; indice < hasta; indice++)
+    {
+        if (p_canal->minimo[col] < minimo)
+        {
+            minimo = p_canal->minimo[col];
+        }
+        if (p_canal->maximo[col] > maximo)
+        {
+            maximo = p_canal->maximo[col];
+        }
+        col++;
+        if (col >= CANAL_COLUMNAS)
+        {
+            col = 0U;
+        }
+    }
+
+    posicion = (uint16_t) ((posicion * 2U) + (uint16_t) (hasta - desde)); /* al centro del grupo, en medias columnas */
+    xc1 = (int16_t) (xc0 + (int16_t) (((uint32_t) posicion * CANAL_ANCHO) / (2U * CANAL_COLUMNAS)));
+    EVE_vertex2f_burst(xc1 * PRESICION, (int16_t) (yc0 - ((zig != 0U) ? maximo : minimo)) * PRESICION);
+    EVE_vertex2f_burst(xc1 * PRESICION, (int16_t) (yc0 - ((zig != 0U) ? minimo : maximo)) * PRESICION);
+}
+
+/** pinta los seis paneles con el plan de canales_presupuesto()
+   va dentro de tft_build_frame(), usa las funciones _burst */
+void canales_dibujar(void)
+{
+    EVE_vertex_format_burst(_FRAC_PRESICION); /* sin la parte estatica nadie lo puso en este frame */
+    EVE_line_width_burst(16U);
+    for (uint8_t canal = 0U; canal < CANALES; canal++)
+    {
+        canal_t const *const p_canal = &canales[canal];
+        int16_t const xc0 = (int16_t) (((canal % 3U) * CANAL_PANEL_ANCHO) + ((CANAL_PANEL_ANCHO - (int16_t) CANAL_ANCHO) / 2));
+        int16_t const yc0 = (int16_t) (Y_PANEL_TOP + ((canal / 3U) * CANAL_PANEL_ALTO));
+
+        EVE_color_rgb_burst(BLACK);
+        EVE_cmd_number_burst(xc0, (int16_t) (yc0 + 6), USER_FONT_SIZE, 0U, (int32_t) canal + 1);
+
+        if ((p_canal->lod != CANAL_LOD_NADA) && (col_listas > 0U))
+        {
+            uint32_t desde = col_total - col_listas;
+            uint8_t zig = 0U;
+
+            EVE_color_rgb_burst(color_canal[canal]);
+            EVE_begin_burst(EVE_LINE_STRIP);
+            while (desde < col_total)
+            {
+                uint32_t hasta = (desde | ((1UL << p_canal->lod) - 1U)) + 1U;
+
+                if (hasta > col_total)
+                {
+                    hasta = col_total;
+                }
+                dibujar_grupo(p_canal, desde, hasta, xc0, (int16_t) (yc0 + 34 + (int16_t) CANAL_ALTO), zig);
+                zig ^= 1U;
+                desde = hasta;
+            }
+            EVE_end_burst();
+        }
+    }
+}
+
+/** genera muestras de prueba mientras no hay ADC: ruido y un pulso por canal con su propio periodo
+   paso: milisegundos que pasaron desde la ultima llamada, una muestra por canal cada 10 ms */
+void canales_simulador(uint16_t paso)
+{
+    uint32_t const hasta = sim_ms + paso;
+
+    for (sim_ms = ((sim_ms + 9U) / 10U) * 10U; sim_ms < hasta; sim_ms += 10U)
+    {
+        for (uint8_t canal = 0U; canal < CANALES; canal++)
+        {
+            uint32_t const periodo = (3UL + canal) * 1000UL;
+            uint32_t const fase = (sim_ms + ((uint32_t) canal * 700UL)) % periodo;
+            int16_t valor;
+
+            sim_lfsr = (uint16_t) ((sim_lfsr >> 1U) ^ (-(sim_lfsr & 1U) & 0xb400U));
+            valor = (int16_t) (20 + (sim_lfsr & 0x0fU));
+            if (fase < 400U) /* triangulo de 400 ms */
+            {
+                uint32_t const lado = (fase < 200U) ? fase : (400U - fase);
+
+                valor += (int16_t) ((lado * (100UL + (30UL * canal))) / 200U);
+            }
+            canales_push(canal, valor);
+        }
+    }
+    sim_ms = hasta;
+}
+
+/** el LOD que uso el ultimo plan, CANAL_LOD_NADA si el canal no cupo */
+uint8_t canales_lod(uint8_t canal)
+{
+    return ((canal < CANALES) ? canales[canal].lod : CANAL_LOD_NADA);
+}
+
+/** bytes de display-list de las trazas del plan actual */
+uint16_t canales_dl_trazas(void)
+{
+    return (dl_plan);
+}
@@ -0,0 +1,93 @@
+/**
+@file    TFTcanales.h
+@brief   vista general: las graficas de los seis puntos de medicion en una pantalla, con presupuesto de display-list
+@version 1.1
+@date    2026-10-18
+@author  Christian Lara
+
+@section info
+
+Cada punto tiene su arreglo circular de columnas min/max de la ultima ventana de CANAL_VENTANA_S.
+Antes de armar el frame, canales_presupuesto() lee REG_CMD_DL del frame anterior, le resta lo que
+usaron las trazas y reparte lo que queda de los 8 kB de RAM_DL entre los seis canales. El canal
+que no cabe con una columna por vertice junta 2, 4, 8... columnas (nivel de detalle, LOD) y si ni
+asi cabe no se pinta, el display-list nunca se desborda.
+
+En AVR se guardan CANAL_COLUMNAS 24 columnas por canal (288 bytes, 2.5 s cada una), en lo demas una por pixel.
+Al entrar a la vista general hay que llamar canales_vista_nueva(), el frame anterior no tenia las trazas.
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- version inicial
+1.1
+- canales_dibujar() pone VERTEX_FORMAT, la vista general no agrega la parte estatica que lo tiene
+- canales_vista_nueva() para que el primer plan no mida un frame de la otra vista
+- en AVR 24 columnas por canal
+*/
+#ifndef _TFTCANALES_H_
+#define _TFTCANALES_H_
+
+#include "EVE.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CANALES 6U
+#define CANAL_VENTANA_S 60UL
+#define CANAL_ANCHO 240U /* pixeles de cada grafica */
+#define CANAL_ALTO 150U
+#define CANAL_PANEL_ANCHO ((int16_t) EVE_HSIZE / 3) /* 3 x 2 paneles debajo de Y_PANEL_TOP */
+#define CANAL_PANEL_ALTO (((int16_t) EVE_VSIZE - Y_PANEL_TOP) / 2)
+
+#if !defined (CANAL_COLUMNAS)
+#if defined (__AVR__)
+#define CANAL_COLUMNAS 24U /* 6 * (2 * 24 + 4) bytes, con signal_history cabe en los 2 kB del Nano */
+#else
+#define CANAL_COLUMNAS CANAL_ANCHO
+#endif
+#endif
+
+#define CANAL_LOD_MAX 8U /* hasta 256 columnas por vertice */
+#define CANAL_LOD_NADA 0xffU /* el canal no cabe y no se pinta */
+#define CANAL_DL_RESERVA 128U /* DISPLAY, el texto del reloj que crece y margen */
+#define CANAL_DL_POR_CANAL 12U /* COLOR_RGB, BEGIN y END de cada traza */
+
+void canales_init(void);
+void canales_push(uint8_t canal, int16_t muestra);
+void canales_tick(uint16_t paso);
+void canales_presupuesto(void);
+void canales_vista_nueva(void);
+void canales_dibujar(void);
+void canales_simulador(uint16_t paso);
+uint8_t canales_lod(uint8_t canal);
+uint16_t canales_dl_trazas(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
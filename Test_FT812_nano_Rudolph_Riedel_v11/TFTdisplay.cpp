@@ -1,22 +1,22 @@
 
 
 #include "EVE.h"
+#include "EVE_text.h"
 #include "colores.h"
 #include "TFTdisplay.h"
 
 
 /* Pinta las lineas que forma el plano 
- cartesiano +X+Y del PortalInicio-punto1*/
-void display_Grafica_Signal_ejes(void){
-    EVE_begin(EVE_RECTS);//LINEA VERTICAL
-    EVE_line_width(3U*PRESICION); /* size is in 1/16 pixel */
-    EVE_color_rgb(CHARCOAL_GRAY);
-    EVE_vertex2f(X_VERT_GRAPH_P0*PRESICION,Y_VERT_GRAPH_P0*PRESICION); /* set to 0 / 0 */
-    EVE_vertex2f(X_VERT_GRAPH_P1*PRESICION,Y_VERT_GRAPH_P1*PRESICION);
+ cartesiano +X+Y del PortalInicio-punto1, se agregan al lote y salen con EVE_batch_flush() */
+void display_Grafica_Signal_ejes(EVE_batch_t *lote){
+    EVE_batch_begin(lote, EVE_RECTS);//LINEA VERTICAL
+    EVE_batch_line_width(lote, 3U*PRESICION); /* size is in 1/16 pixel */
+    EVE_batch_color_rgb(lote, CHARCOAL_GRAY);
+    EVE_batch_vertex2f(lote, X_VERT_GRAPH_P0*PRESICION,Y_VERT_GRAPH_P0*PRESICION); /* set to 0 / 0 */
+    EVE_batch_vertex2f(lote, X_VERT_GRAPH_P1*PRESICION,Y_VERT_GRAPH_P1*PRESICION);
     //**LINEA HORIZONTAL-----------------
-    EVE_vertex2f(X_VERT_GRAPH_P1*PRESICION,Y_VERT_GRAPH_P1*PRESICION); /* set to 0 / 0 */
-    EVE_vertex2f(X_VERT_GRAPH_P2*PRESICION,Y_VERT_GRAPH_P1*PRESICION);
-    EVE_end();
+    EVE_batch_vertex2f(lote, X_VERT_GRAPH_P1*PRESICION,Y_VERT_GRAPH_P1*PRESICION); /* set to 0 / 0 */
+    EVE_batch_vertex2f(lote, X_VERT_GRAPH_P2*PRESICION,Y_VERT_GRAPH_P1*PRESICION);
 }//-------------------------------------------------------
 
 /*despliega las letras de la grafica de Portal inicio del punto-1 */
@@ -26,9 +26,14 @@ void display_letras_de_Grafica_Signal(void){
     EVE_cmd_text_bold(45,Y_NUMS_GRAPH+GAP2*2, USER_FONT_SIZE, 0, "100");
     EVE_cmd_text_bold(45+28,Y_NUMS_GRAPH+GAP2*3, USER_FONT_SIZE,0, "0");
     EVE_cmd_text_bold(X_LabelParameter-50, Y_METAL_SIGNAL+GAP1*4, USER_FONT_SIZE, 0, "0s");
-    EVE_cmd_text_bold(X_LabelParameter-200, Y_METAL_SIGNAL+GAP1*4, USER_FONT_SIZE, 0, "-60s");
 }//fin display de letras de graficas signal-----------------------
 
+/*despliega el extremo izquierdo del eje de tiempo, cambia con el zoom de la grafica ("-10s","-1min"...) */
+void display_Ventana_Grafica(const char *etiqueta){
+    EVE_color_rgb(BLACK); /* como las demas letras de la grafica, no depende de lo que quedo antes en el frame */
+    EVE_cmd_text_bold(X_LabelParameter-200, Y_METAL_SIGNAL+GAP1*4, USER_FONT_SIZE, 0, etiqueta);
+}//fin display de ventana de grafica-----------------------
+
 //Despliega la seleccion de Seleccion de Puntos
 /* pametro status: 0:Ninguno {Boton Apretado Presionado:[1:Izquierdo,2:derecho]} 
    parameter: Puntos: {1-6} <-Punto seleccionado */
@@ -49,12 +54,6 @@ void display_btn_Select(uint8_t punto){
 }
 
 
-//Pinta la Grafica de Señal de Portal Inicio del Punto-1
-void display_Graphica_Signal(void){
-    display_letras_de_Grafica_Signal();//dibuja las letras de la grafica
-    display_Grafica_Signal_ejes();  //dibujar los ejes de la grafica
-}//fin.------------------------------------------------------------   
-
 /**Despliega el texto de los parametros del Punto uno al lado de la grafica */
 void display_Param_Punto_1(void){
     EVE_cmd_text_bold(X_LabelParameter,Y_METAL_SIGNAL , USER_FONT_SIZE, 0, "Metal signal");
@@ -64,10 +63,10 @@ void display_Param_Punto_1(void){
 }//fin de display parametros punto 1-------------------------------------------------------------
 
 /** simula un reloj actualizando las variables del tiempo
-   la interrupcion es cada 25mseg "segun"*/
-void simulador_de_reloj(uint16_t *horas,uint16_t *minutos,uint16_t *segundos,uint16_t *mseg){
-    *mseg += 25;
-    if (*mseg >= 1000) {
+   paso: milisegundos que pasaron desde la ultima llamada (frames de la pantalla)*/
+void simulador_de_reloj(uint16_t *horas,uint16_t *minutos,uint16_t *segundos,uint16_t *mseg,uint16_t paso){
+    *mseg += paso;
+    while (*mseg >= 1000) {
         *mseg -= 1000;(*segundos)++;
         if (*segundos >= 60) {
             *segundos = 0;(*minutos)++;
@@ -78,6 +77,35 @@ void simulador_de_reloj(uint16_t *horas,uint16_t *minutos,uint16_t *segundos,uin
 }//fin de simulador de reloj------------------------------------------------------------------------
 
 
+/* texto en negrita como EVE_cmd_text_bold(), pero con VERTEX2II desde EVE_text en vez de cuatro CMD_TEXT,
+   las cuatro copias comparten un VERTEX_TRANSLATE porque el reloj esta despues de x=511 */
+static void texto_bold(uint16_t x,uint16_t y,uint16_t font,uint16_t option,const char *texto){
+    EVE_text_origin_burst(x-64,0);
+    EVE_text_burst(x-1,y,font,option,texto);
+    EVE_text_burst(x,y,font,option,texto);
+    EVE_text_burst(x+1,y+1,font,option,texto);
+    EVE_text_burst(x+2,y,font,option,texto);
+    EVE_text_origin_burst(0,0);
+}
+
+/* numero en negrita como EVE_cmd_number_burst_bold(), las tres copias salen de EVE_text en vez de tres CMD_NUMBER,
+   sin opciones de digitos: el texto es el numero en decimal sin ceros a la izquierda, igual que CMD_NUMBER */
+static void numero_bold(uint16_t x,uint16_t y,uint16_t font,uint16_t option,uint16_t numero){
+char texto[6]; //hasta 65535
+uint8_t i=sizeof(texto)-1U;
+    texto[i]='\0';
+    do{
+        i--;
+        texto[i]=(char)('0'+(numero%10U));
+        numero/=10U;
+    }while(numero!=0U);
+    EVE_text_origin_burst(x-64,0);
+    EVE_text_burst(x,y,font,option,&texto[i]);
+    EVE_text_burst(x+1,y+1,font,option,&texto[i]);
+    EVE_text_burst(x+2,y,font,option,&texto[i]);
+    EVE_text_origin_burst(0,0);
+}
+
 /* fin de despliegue de tiempo den pantlla */
 void display_Reloj(uint16_t horas,uint16_t minutos,uint16_t segundos,uint16_t mseg){
 const uint16_t d=8, g=3; //digito 8 pixeles,gap=3 
@@ -87,7 +115,7 @@ uint16_t m;      //xxpmmpssplll<<--chars a pintar, pos x minutos
 uint16_t s;      //xxpmpssplll      pos x segundos
 uint16_t l;      // xpmpsplll       pos x milisegundos
 uint16_t p1,p2,p3;//posicion del char->':'
-const uint16_t font=24,option=EVE_OPT_CENTERX;
+const uint16_t font=RELOJ_FONT,option=EVE_OPT_CENTERX; /* RELOJ_FONT se carga con EVE_text_load() en TFT_init() */
     if(horas<10){p1=x+d+g;}else{p1=x+d*2+g;}
     m=p1+d+g;
     if(minutos<10){p2=m+d+g;}else{p2=m+d*2+g;}
@@ -95,11 +123,11 @@ const uint16_t font=24,option=EVE_OPT_CENTERX;
     if(segundos<10){p3=s+d+g;}else{p3=s+d*2+g;}
     l=p3+d+g+13;//<<--en revision
     EVE_color_rgb_burst(BLACK);
-    EVE_cmd_number_burst_bold(x,y,font,option, horas); /* number of bytes written to the display-list by the command co-pro */
-    EVE_cmd_text_bold(p1,y,font,option, " : ");//p1
-    EVE_cmd_number_burst_bold(m,y,font,option,minutos);
-    EVE_cmd_text_bold(p2,y,font,option, " : ");//p2
-    EVE_cmd_number_burst_bold(s,y,font,option,segundos); /* duration in us of TFT_loop() for the display-list part */
-    EVE_cmd_text_bold(p3,y ,font,option, " : ");
-    EVE_cmd_number_burst_bold(l,y,font,option, mseg); /* duration in us of TFT_loop() for the display-list part */
+    numero_bold(x,y,font,option, horas);
+    texto_bold(p1,y,font,option, " : ");//p1
+    numero_bold(m,y,font,option,minutos);
+    texto_bold(p2,y,font,option, " : ");//p2
+    numero_bold(s,y,font,option,segundos);
+    texto_bold(p3,y ,font,option, " : ");
+    numero_bold(l,y,font,option, mseg);
 }//fin de despliegue de tiempo en pantalla----------------------------------------
\ No newline at end of file
@@ -38,6 +38,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 
 -add 2025-Agt-1 fucion display grafica signal, funcion de despliegue de grafica
+-simulador_de_reloj() recibe los milisegundos que pasaron (paso) en vez de sumar 25ms fijos
+-la etiqueta "-60s" sale de la parte estatica, display_Ventana_Grafica() la pinta segun el zoom
+-display_Grafica_Signal_ejes() agrega los ejes a un lote de EVE_batch, display_Graphica_Signal() se quito
+-display_Reloj() pinta los " : " con EVE_text (VERTEX2II) en vez de CMD_TEXT, RELOJ_FONT
+-display_Reloj() pinta tambien los digitos con EVE_text (numero_bold()) en vez de CMD_NUMBER
 
 
 - added EVE_cmd_pclkfreq()
@@ -165,18 +170,22 @@ without the traling _burst in the name when exceution speed is not an issue - e.
 #ifndef _TFTDISPLAY_H_
 #define _TFTDISPLAY_H_
 
+#include "EVE_batch.h"
+
+#define RELOJ_FONT 24U // fuente ROM del reloj, la carga EVE_text_load() en TFT_init()
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-void display_Grafica_Signal_ejes(void);
+void display_Grafica_Signal_ejes(EVE_batch_t *lote);
 void display_letras_de_Grafica_Signal(void);
-void display_Graphica_Signal(void);
+void display_Ventana_Grafica(const char *etiqueta);
 void display_Puntos(uint8_t status);
 void display_btn_Select(uint8_t punto);
 void display_Selector_de_Puntos(uint8_t status,uint8_t punto);
 void display_Param_Punto_1(void);
-void simulador_de_reloj(uint16_t *horas,uint16_t *minutos,uint16_t *segundos,uint16_t *mseg);
+void simulador_de_reloj(uint16_t *horas,uint16_t *minutos,uint16_t *segundos,uint16_t *mseg,uint16_t paso);
 void display_Reloj(uint16_t horas,uint16_t minutos,uint16_t segundos,uint16_t mseg);
 
    
@@ -0,0 +1,416 @@
+/**
+@file    TFTsignal.c
+@brief   motor de graficas en tiempo real para la señal del detector (Metal signal)
+@version 1.6
+@date    2026-10-19
+@author  Christian Lara
+
+@section info
+
+Cada columna de la grafica guarda el minimo y el maximo de las muestras que le tocan,
+(SIGNAL_MUESTRAS_S * 60) / SIGNAL_COLUMNAS muestras por columna, con un acumulador tipo Bresenham
+para que la division no tenga que ser exacta. Las columnas se guardan ya en pixeles (uint8_t)
+en un buffer circular, con 2 bytes por columna.
+
+La traza se pinta como un EVE_LINE_STRIP en zigzag: min->max en columnas pares y max->min en las
+impares, 2 vertices por columna, maximo 4 * (2 * SIGNAL_COLUMNAS + 4) bytes de display-list.
+
+En el modo bitmap el tiempo va en las lineas del bitmap y el valor en los pixeles de cada linea,
+asi una columna de la grafica es una linea contigua de SIGNAL_STRIDE bytes en RAM_G y se escribe
+con un solo EVE_memWrite_sram_buffer() en el indice circular. Al dibujar, BITMAP_TRANSFORM cambia
+x por y y voltea el valor hacia arriba, y el desplazamiento sale de pintar el bitmap en dos partes
+con EVE_bitmap_source() apuntando a la columna mas vieja y a la columna 0.
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- version inicial
+1.1
+- modo bitmap: la grafica es un bitmap en RAM_G que se actualiza una columna a la vez
+1.2
+- signal_procesar() reduce el anillo por bloques con los kernels de signal_kernels
+1.3
+- las columnas se guardan en signal_history, signal_zoom() cambia la ventana de la grafica
+1.4
+- el anillo entre la ISR y signal_procesar() es un signal_ring, fuera de AVR caben miles de muestras por frame
+1.5
+- modo bitmap: BITMAP_TRANSFORM_C es SIGNAL_ALTO, el valor 0 quedaba fuera del BITMAP_SIZE y la traza 1 px abajo
+1.6
+- modo bitmap: BITMAP_TRANSFORM_C lleva medio texel mas, la fila ya no depende de donde se muestrea el pixel
+*/
+
+#include <stddef.h>
+#include "EVE.h"
+#include "colores.h"
+#include "TFTsignal.h"
+#include "signal_kernels.h"
+#include "signal_history.h"
+#include "signal_ring.h"
+
+#if ((SIGNAL_ANILLO & (SIGNAL_ANILLO - 1U)) != 0U) || (SIGNAL_ANILLO > SIGNAL_RING_MAX)
+#error "SIGNAL_ANILLO tiene que ser potencia de dos y a lo mas SIGNAL_RING_MAX"
+#endif
+
+/* anillo entre la ISR (productor) y signal_procesar() (consumidor) */
+static int16_t anillo_datos[SIGNAL_ANILLO];
+static signal_ring_t anillo; /* p_datos en NULL hasta signal_init() */
+static volatile uint16_t perdidas = 0U;
+
+/* las columnas ya reducidas, en pixeles sobre SIGNAL_Y_CERO, viven en signal_history,
+   vista es el nivel que se dibuja */
+static uint8_t vista = (HISTORIA_NIVELES > 1U) ? 1U : 0U; /* 1 min, la grafica original */
+
+/* la columna del nivel 0 que se esta juntando */
+static uint8_t acc_min = 0xffU;
+static uint8_t acc_max = 0U;
+static uint32_t acc_paso = 0U;
+static uint32_t muestras_s = SIGNAL_MUESTRAS_S;
+static uint32_t muestras_ventana = SIGNAL_MUESTRAS_S * 10UL;
+
+/* modo bitmap, 0 = modo vertices */
+static uint32_t bitmap_dir = 0U;
+
+/* estado del simulador */
+static uint16_t sim_lfsr = 0xace1U;
+static uint32_t sim_resto = 0U;
+static uint32_t sim_muestra = 0U;
+
+static uint8_t a_pixel(int16_t muestra)
+{
+    if (muestra < 0)
+    {
+        muestra = 0;
+    }
+    if (muestra > SIGNAL_MAX)
+    {
+        muestra = SIGNAL_MAX;
+    }
+    return ((uint8_t) (((uint32_t) muestra * SIGNAL_ALTO) / (uint32_t) SIGNAL_MAX));
+}
+
+/* escribe la columna en su linea del bitmap, los pixeles entre el min y el max quedan prendidos */
+static void escribir_columna(uint16_t const col)
+{
+    historia_nivel_t const *const p_nivel = historia_nivel(vista);
+    uint8_t linea[SIGNAL_STRIDE];
+
+    for (uint16_t indice = 0U; indice < SIGNAL_STRIDE; indice++)
+    {
+        linea[indice] = 0U;
+    }
+    for (uint16_t pixel = p_nivel->minimo[col]; pixel <= p_nivel->maximo[col]; pixel++)
+    {
+#if defined (SIGNAL_BITMAP_L8)
+        linea[pixel] = 0xffU;
+#else
+        linea[pixel >> 3U] |= (uint8_t) (0x80U >> (pixel & 7U)); /* L1: el bit 7 es el pixel de la izquierda */
+#endif
+    }
+    EVE_memWrite_sram_buffer(bitmap_dir + ((uint32_t) col * SIGNAL_STRIDE), linea, SIGNAL_STRIDE);
+}
+
+static void cerrar_columna(void)
+{
+    uint8_t const cambios = historia_agregar(acc_min, acc_max);
+
+    if ((bitmap_dir != 0U) && ((cambios & (1U << vista)) != 0U))
+    {
+        historia_nivel_t const *const p_nivel = historia_nivel(vista);
+        uint16_t const nueva = (0U == p_nivel->siguiente) ? (HISTORIA_COLUMNAS - 1U) : (p_nivel->siguiente - 1U);
+
+        escribir_columna(nueva); /* el display-list cambia con la columna nueva, el frame hash lo nota */
+    }
+}
+
+/* un bloque contiguo del anillo: las muestras hasta cerrar la columna se reducen de una vez */
+static void agregar_bloque(const int16_t *p_muestras, uint16_t cuantas)
+{
+    while (cuantas > 0U)
+    {
+        /* muestras que faltan para que acc_paso llegue a muestras_ventana, al menos una */
+        uint32_t const faltan = ((muestras_ventana - acc_paso) + (SIGNAL_COLUMNAS - 1U)) / SIGNAL_COLUMNAS;
+        uint16_t const tomar = (cuantas < faltan) ? cuantas : (uint16_t) faltan;
+        int16_t minimo;
+        int16_t maximo;
+        uint8_t ultimo;
+
+        signal_k->minmax(p_muestras, tomar, tomar, &minimo, &maximo);
+        if (a_pixel(minimo) < acc_min)
+        {
+            acc_min = a_pixel(minimo);
+        }
+        if (a_pixel(maximo) > acc_max)
+        {
+            acc_max = a_pixel(maximo);
+        }
+
+        ultimo = a_pixel(p_muestras[tomar - 1U]);
+        acc_paso += (uint32_t) tomar * SIGNAL_COLUMNAS;
+        while (acc_paso >= muestras_ventana) /* con pocas muestras por segundo una muestra llena varias columnas */
+        {
+            acc_paso -= muestras_ventana;
+            cerrar_columna();
+            acc_min = ultimo;
+            acc_max = ultimo;
+        }
+        p_muestras = &p_muestras[tomar];
+        cuantas -= tomar;
+    }
+}
+
+/** empieza una grafica vacia
+   muestras_por_s: frecuencia con la que llegan las muestras a signal_push() */
+void signal_init(uint16_t muestras_por_s)
+{
+    if (0U == muestras_por_s)
+    {
+        muestras_por_s = 1U;
+    }
+    muestras_s = muestras_por_s;
+    muestras_ventana = (uint32_t) muestras_por_s * historia_ventana_s(0U);
+    historia_init();
+    acc_min = 0xffU;
+    acc_max = 0U;
+    acc_paso = 0U;
+    if (NULL == anillo.p_datos) /* la primera vez, antes de habilitar la ISR */
+    {
+        signal_ring_init(&anillo, anillo_datos, SIGNAL_ANILLO);
+    }
+    signal_ring_vaciar(&anillo);
+    perdidas = 0U;
+    signal_kernels_init();
+}
+
+/** guarda una muestra en el anillo, se puede llamar desde la ISR del ADC
+   si el anillo esta lleno la muestra se pierde y se cuenta en signal_perdidas() */
+void signal_push(int16_t muestra)
+{
+    if (0U == signal_ring_push(&anillo, muestra))
+    {
+        perdidas++;
+    }
+}
+
+/** vacia el anillo en las columnas min/max, se llama desde el loop
+   solo toma lo que habia al entrar, si la ISR sigue llenando el anillo la llamada igual termina */
+void signal_procesar(void)
+{
+    uint16_t pendientes = signal_ring_pendientes(&anillo);
+
+    while (pendientes > 0U) /* a lo mas dos bloques, antes y despues de dar la vuelta */
+    {
+        const int16_t *p_bloque;
+        uint16_t cuantas = signal_ring_bloque(&anillo, &p_bloque);
+
+        if (cuantas > pendientes)
+        {
+            cuantas = pendientes;
+        }
+        agregar_bloque(p_bloque, cuantas);
+        signal_ring_consumir(&anillo, cuantas);
+        pendientes = (uint16_t) (pendientes - cuantas);
+    }
+}
+
+/* un pedazo del bitmap: cuantas columnas desde la columna col, en la posicion x de la pantalla */
+static void dibujar_pedazo(uint16_t const col, uint16_t const cuantas, int16_t const xc0)
+{
+    EVE_bitmap_source_burst(bitmap_dir + ((uint32_t) col * SIGNAL_STRIDE));
+    EVE_bitmap_size_burst(EVE_NEAREST, EVE_BORDER, EVE_BORDER, cuantas, (uint16_t) (SIGNAL_ALTO + 1U));
+    EVE_vertex2f_burst(xc0 * PRESICION, (int16_t) (SIGNAL_Y_CERO - SIGNAL_ALTO) * PRESICION);
+}
+
+/* modo bitmap: unas 20 palabras sin importar el ancho de la grafica */
+static void dibujar_bitmap(void)
+{
+    historia_nivel_t const *const p_nivel = historia_nivel(vista);
+    uint16_t const vieja = (p_nivel->listas < SIGNAL_COLUMNAS) ? 0U : p_nivel->siguiente;
+    uint16_t const hasta_el_final = SIGNAL_COLUMNAS - vieja;
+    uint16_t const primera = (p_nivel->listas < hasta_el_final) ? p_nivel->listas : hasta_el_final;
+    int16_t const xc0 = (int16_t) (SIGNAL_X0 + (SIGNAL_COLUMNAS - p_nivel->listas));
+
+    EVE_save_context_burst(); /* el transform y el handle no pasan al resto del frame */
+    EVE_color_rgb_burst(ROYAL_BLUE);
+    EVE_bitmap_handle_burst(SIGNAL_HANDLE);
+    EVE_bitmap_layout_burst(SIGNAL_FORMATO, SIGNAL_STRIDE, SIGNAL_COLUMNAS);
+    /* u = alto + 1/2 - y, v = x: la linea del bitmap es el tiempo y el valor crece hacia arriba,
+       el valor p queda en la fila alto - p, en SIGNAL_Y_CERO - p como en el modo de vertices,
+       con el medio texel da la misma fila si el pixel se muestrea en la esquina o en el centro */
+    EVE_cmd_dl_burst(DL_BITMAP_TRANSFORM_A);
+    EVE_cmd_dl_burst(DL_BITMAP_TRANSFORM_B | (((uint32_t) -256L) & 0x1ffffUL));
+    EVE_cmd_dl_burst(DL_BITMAP_TRANSFORM_C | (((uint32_t) SIGNAL_ALTO << 8U) + 128UL));
+    EVE_cmd_dl_burst(DL_BITMAP_TRANSFORM_D | 256UL);
+    EVE_cmd_dl_burst(DL_BITMAP_TRANSFORM_E);
+    EVE_cmd_dl_burst(DL_BITMAP_TRANSFORM_F);
+    EVE_begin_burst(EVE_BITMAPS);
+    dibujar_pedazo(vieja, primera, xc0);
+    if (p_nivel->listas > primera) /* la parte que ya dio la vuelta al indice circular */
+    {
+        dibujar_pedazo(0U, (uint16_t) (p_nivel->listas - primera), (int16_t) (xc0 + (int16_t) primera));
+    }
+    EVE_end_burst();
+    EVE_restore_context_burst();
+}
+
+/** la traza queda en RAM_G como bitmap, necesita SIGNAL_BITMAP_SIZE bytes en direccion
+   va fuera de un burst, escribe las columnas que ya hay */
+void signal_modo_bitmap(uint32_t direccion)
+{
+    historia_nivel_t const *const p_nivel = historia_nivel(vista);
+    uint16_t col = (p_nivel->listas < SIGNAL_COLUMNAS) ? 0U : p_nivel->siguiente;
+
+    bitmap_dir = direccion;
+    for (uint16_t cuenta = 0U; cuenta < p_nivel->listas; cuenta++)
+    {
+        escribir_columna(col);
+        col++;
+        if (col >= SIGNAL_COLUMNAS)
+        {
+            col = 0U;
+        }
+    }
+}
+
+/** la traza se pinta con vertices, el bitmap en RAM_G ya no se usa */
+void signal_modo_vertices(void)
+{
+    bitmap_dir = 0U;
+}
+
+/** cambia la ventana de la grafica, nivel de signal_history: 0 = 10 s, 1 = 1 min, 2 = 10 min, 3 = 1 h
+   no recorre muestras, en modo bitmap vuelve a escribir las columnas del nivel, va fuera de un burst */
+void signal_zoom(uint8_t nivel)
+{
+    if (nivel >= HISTORIA_NIVELES)
+    {
+        nivel = HISTORIA_NIVELES - 1U;
+    }
+    if (nivel != vista)
+    {
+        vista = nivel;
+        if (bitmap_dir != 0U)
+        {
+            signal_modo_bitmap(bitmap_dir);
+        }
+    }
+}
+
+/** el nivel de signal_history que se esta dibujando */
+uint8_t signal_zoom_nivel(void)
+{
+    return (vista);
+}
+
+/** pinta la ventana del zoom, la columna mas nueva queda en "0s"
+   va dentro de tft_build_frame(), usa las funciones _burst */
+void signal_dibujar(void)
+{
+    historia_nivel_t const *const p_nivel = historia_nivel(vista);
+
+    if ((p_nivel->listas > 0U) && (bitmap_dir != 0U))
+    {
+        dibujar_bitmap();
+    }
+    else if (p_nivel->listas > 0U)
+    {
+        uint16_t col = (p_nivel->listas < SIGNAL_COLUMNAS) ? 0U : p_nivel->siguiente; /* la mas vieja */
+        int16_t xc0 = (int16_t) (SIGNAL_X0 + (SIGNAL_COLUMNAS - p_nivel->listas));
+
+        EVE_color_rgb_burst(ROYAL_BLUE);
+        EVE_line_width_burst(16U); /* 1 pixel, en 1/16 de pixel */
+        EVE_begin_burst(EVE_LINE_STRIP);
+        for (uint16_t cuenta = 0U; cuenta < p_nivel->listas; cuenta++)
+        {
+            uint8_t primero = p_nivel->minimo[col];
+            uint8_t segundo = p_nivel->maximo[col];
+
+            if ((cuenta & 1U) != 0U) /* zigzag, la union con la siguiente columna queda corta */
+            {
+                primero = p_nivel->maximo[col];
+                segundo = p_nivel->minimo[col];
+            }
+            EVE_vertex2f_burst(xc0 * PRESICION, (int16_t) (SIGNAL_Y_CERO - primero) * PRESICION);
+            EVE_vertex2f_burst(xc0 * PRESICION, (int16_t) (SIGNAL_Y_CERO - segundo) * PRESICION);
+            xc0++;
+            col++;
+            if (col >= SIGNAL_COLUMNAS)
+            {
+                col = 0U;
+            }
+        }
+        EVE_end_burst();
+    }
+    else
+    {
+        /* todavia no hay columnas */
+    }
+}
+
+/** genera muestras de prueba mientras no hay ADC: ruido de fondo y un pulso de metal cada 5 s
+   paso: milisegundos que pasaron desde la ultima llamada */
+void signal_simulador(uint16_t paso)
+{
+    uint32_t muestras;
+
+    sim_resto += (uint32_t) paso * muestras_s;
+    muestras = sim_resto / 1000UL;
+    sim_resto %= 1000UL;
+
+    while (muestras > 0U)
+    {
+        uint32_t const fase = sim_muestra % (5UL * muestras_s); /* muestra dentro del periodo de 5 s */
+        uint32_t const pulso = muestras_s / 4U; /* 250 ms */
+        int16_t valor;
+
+        sim_lfsr = (uint16_t) ((sim_lfsr >> 1U) ^ (-(sim_lfsr & 1U) & 0xb400U)); /* ruido */
+        valor = (int16_t) (20 + (sim_lfsr & 0x0fU));
+        if (fase < pulso) /* triangulo hasta 220 */
+        {
+            uint32_t const lado = (fase < (pulso / 2U)) ? fase : (pulso - fase);
+
+            valor += (int16_t) ((lado * 440UL) / pulso);
+        }
+        signal_push(valor);
+        sim_muestra++;
+        muestras--;
+        if (0U == (sim_muestra & ((SIGNAL_ANILLO / 2U) - 1U))) /* sin ISR el simulador tambien vacia el anillo */
+        {
+            signal_procesar();
+        }
+    }
+}
+
+/** columnas con datos en el zoom actual, llega a SIGNAL_COLUMNAS cuando paso toda la ventana */
+uint16_t signal_columnas_listas(void)
+{
+    return (historia_nivel(vista)->listas);
+}
+
+/** muestras que no cupieron en el anillo */
+uint16_t signal_perdidas(void)
+{
+    return (perdidas);
+}
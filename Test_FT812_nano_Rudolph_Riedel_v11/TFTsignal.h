@@ -0,0 +1,109 @@
+/**
+@file    TFTsignal.h
+@brief   motor de graficas en tiempo real para la señal del detector (Metal signal)
+@version 1.4
+@date    2026-10-18
+@author  Christian Lara
+
+@section info
+
+Las muestras entran por signal_push() (ISR del ADC o el simulador) a un signal_ring sin bloqueos,
+signal_procesar() las reduce a un par min/max por columna de pixel y signal_dibujar() pinta
+la ventana elegida con signal_zoom() (10 s, 1 min, 10 min o 1 h, ver signal_history) con un solo EVE_LINE_STRIP. El tamaño del display-list depende solo del
+ancho de la grafica, no de la frecuencia de muestreo.
+
+Con signal_modo_bitmap() la traza vive en RAM_G como un bitmap L1 (o L8 con SIGNAL_BITMAP_L8) y cada
+columna nueva es una sola escritura de una linea del bitmap, el display-list queda en unas 20 palabras.
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- version inicial
+1.1
+- modo bitmap: la grafica es un bitmap en RAM_G que se actualiza una columna a la vez
+1.2
+- signal_procesar() reduce el anillo por bloques con los kernels de signal_kernels
+1.3
+- las columnas se guardan en signal_history, signal_zoom() cambia la ventana de la grafica
+1.4
+- el anillo entre la ISR y signal_procesar() es un signal_ring, fuera de AVR caben miles de muestras por frame
+*/
+#ifndef _TFTSIGNAL_H_
+#define _TFTSIGNAL_H_
+
+#include "EVE.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SIGNAL_MAX 300 /* escala de la grafica: "0" a "300" */
+#define SIGNAL_ALTO 150U /* pixeles entre "0" y "300" (GAP2 * 3) */
+#define SIGNAL_Y_CERO (Y_NUMS_GRAPH + 8 + SIGNAL_ALTO) /* y del valor 0, a la altura de la etiqueta "0" */
+#define SIGNAL_X0 (X_VERT_GRAPH_P1 + 2) /* primera columna, a la derecha del eje vertical */
+#define SIGNAL_COLUMNAS ((uint16_t) (X_VERT_GRAPH_P2 - SIGNAL_X0)) /* una columna por pixel */
+
+#if !defined (SIGNAL_MUESTRAS_S)
+#define SIGNAL_MUESTRAS_S 2000U /* frecuencia de muestreo del detector */
+#endif
+
+#if !defined (SIGNAL_HANDLE)
+#define SIGNAL_HANDLE 1U /* bitmap handle del modo bitmap */
+#endif
+
+#if defined (SIGNAL_BITMAP_L8)
+#define SIGNAL_FORMATO EVE_L8
+#define SIGNAL_STRIDE ((uint16_t) (SIGNAL_ALTO + 1U)) /* bytes por columna de la grafica */
+#else
+#define SIGNAL_FORMATO EVE_L1
+#define SIGNAL_STRIDE ((uint16_t) ((SIGNAL_ALTO + 8U) / 8U))
+#endif
+#define SIGNAL_BITMAP_SIZE ((uint32_t) SIGNAL_STRIDE * SIGNAL_COLUMNAS) /* bytes en RAM_G */
+
+#if !defined (SIGNAL_ANILLO)
+#if defined (__AVR__)
+#define SIGNAL_ANILLO 64U /* muestras entre la ISR y signal_procesar(), potencia de dos, maximo SIGNAL_RING_MAX */
+#else
+#define SIGNAL_ANILLO 4096U
+#endif
+#endif
+
+void signal_init(uint16_t muestras_por_s);
+void signal_push(int16_t muestra);
+void signal_procesar(void);
+void signal_dibujar(void);
+void signal_modo_bitmap(uint32_t direccion);
+void signal_modo_vertices(void);
+void signal_zoom(uint8_t nivel);
+uint8_t signal_zoom_nivel(void);
+void signal_simulador(uint16_t paso);
+uint16_t signal_columnas_listas(void);
+uint16_t signal_perdidas(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -10,6 +10,8 @@
 #include <SPI.h>
 #include "EVE_custom_module.h"
 #include "EVE.h"
+#include "EVE_frame.h"
+#include "EVE_touch.h"
 #include "colores.h"
 #include "imagenes_test.h"
 #include "tft.h"
@@ -20,6 +22,10 @@ void setup()
     digitalWrite(EVE_CS, HIGH);
     pinMode(EVE_PDN, OUTPUT);
     digitalWrite(EVE_PDN, LOW);
+#if defined (EVE_INT) /* only the AVR target header has a pin for INT_N so far */
+    pinMode(EVE_INT, INPUT_PULLUP); /* INT_N of EVE */
+    attachInterrupt(digitalPinToInterrupt(EVE_INT), EVE_touch_isr, FALLING);
+#endif
 
 #if defined (ESP32)
     #if defined (EVE_USE_ESP_IDF) /* not using the Arduino SPI class in order to use DMA */
@@ -38,22 +44,15 @@ void setup()
 
 void loop()
 {
-    uint32_t current_millis;
-    static uint32_t previous_millis = 0;
-    static uint8_t display_delay = 0;
-    uint32_t micros_start, micros_end;
-    current_millis = millis();
+    (void) EVE_touch_service(); /* only uses the SPI after INT_N signaled a touch event */
 
-    if ((current_millis - previous_millis) > 4) /* execute the code every 5 milli-seconds */
-    { previous_millis = current_millis;
-      micros_start = micros();
-      display_delay++;
-      if(display_delay>4) /* refresh the display every 25ms / 40 per second */
-        {display_delay = 0;
-         TFT_display();
-         micros_end = micros();}// = (micros_end - micros_start); }/* calculate the micro-seconds passed during the call to TFT_display */
-        else
-        {  TFT_touch();
-           micros_end = micros();}// = (micros_end - micros_start);} /* calculate the micro-seconds passed during the call to TFT_touch */
-    }//-------------------------------------------------------------------------------------------------------------------------
+    if (E_OK == EVE_frame_ready()) /* the last swap is visible, build the next frame right away */
+    {
+#if !defined (EVE_INT)
+        EVE_touch_isr(); /* without INT_N the flags are polled once per frame */
+        (void) EVE_touch_service();
+#endif
+        TFT_touch(); /* handle the queued touch events right before building the frame for the least input-to-photon latency */
+        TFT_display();
+    }
 }//*****************************************************************************************************************************
@@ -0,0 +1,167 @@
+/**
+@file    signal_history.c
+@brief   historia de la señal en varios niveles de min/max para cambiar el zoom de la grafica sin recalcular
+@version 1.0
+@date    2026-10-18
+@author  Christian Lara
+
+@section info
+
+El nivel n+1 toma el min de los minimos y el max de los maximos de "factor" columnas del nivel n,
+el factor es la razon entre las ventanas: 6, 10 y 6.
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- version inicial
+*/
+
+#include <string.h>
+#include "signal_history.h"
+
+#if (HISTORIA_NIVELES < 1U) || (HISTORIA_NIVELES > 4U)
+#error "HISTORIA_NIVELES tiene que estar entre 1 y 4"
+#endif
+
+static const uint16_t ventana_s[4] = {10U, 60U, 600U, 3600U};
+static const char *const etiqueta[4] = {"-10s", "-1min", "-10min", "-1h"};
+
+static historia_nivel_t niveles[HISTORIA_NIVELES];
+
+static void vaciar_acumulador(historia_nivel_t *p_nivel)
+{
+    p_nivel->acc_min = 0xffU;
+    p_nivel->acc_max = 0U;
+    p_nivel->acc_cuenta = 0U;
+}
+
+/** borra todos los niveles */
+void historia_init(void)
+{
+    for (uint8_t nivel = 0U; nivel < HISTORIA_NIVELES; nivel++)
+    {
+        niveles[nivel].siguiente = 0U;
+        niveles[nivel].listas = 0U;
+        vaciar_acumulador(&niveles[nivel]);
+    }
+}
+
+/** agrega una columna al nivel 0 y la sube por los niveles de arriba
+   regresa un bit por cada nivel que recibio una columna nueva, el bit 0 siempre esta prendido */
+uint8_t historia_agregar(uint8_t minimo, uint8_t maximo)
+{
+    uint8_t cambios = 0U;
+    uint8_t nivel = 0U;
+    uint8_t seguir = 1U;
+
+    while (seguir != 0U)
+    {
+        historia_nivel_t *const p_nivel = &niveles[nivel];
+
+        p_nivel->minimo[p_nivel->siguiente] = minimo;
+        p_nivel->maximo[p_nivel->siguiente] = maximo;
+        p_nivel->siguiente++;
+        if (p_nivel->siguiente >= HISTORIA_COLUMNAS)
+        {
+            p_nivel->siguiente = 0U;
+        }
+        if (p_nivel->listas < HISTORIA_COLUMNAS)
+        {
+            p_nivel->listas++;
+        }
+        cambios |= (uint8_t) (1U << nivel);
+        seguir = 0U;
+
+        if ((nivel + 1U) < HISTORIA_NIVELES) /* se junta para el nivel de arriba */
+        {
+            if (minimo < p_nivel->acc_min)
+            {
+                p_nivel->acc_min = minimo;
+            }
+            if (maximo > p_nivel->acc_max)
+            {
+                p_nivel->acc_max = maximo;
+            }
+            p_nivel->acc_cuenta++;
+            if (p_nivel->acc_cuenta >= (ventana_s[nivel + 1U] / ventana_s[nivel]))
+            {
+                minimo = p_nivel->acc_min;
+                maximo = p_nivel->acc_max;
+                vaciar_acumulador(p_nivel);
+                nivel++;
+                seguir = 1U;
+            }
+        }
+    }
+    return (cambios);
+}
+
+/** el nivel para dibujarlo directo, sin copiar, la columna mas vieja es
+   siguiente si listas == HISTORIA_COLUMNAS y 0 si no */
+const historia_nivel_t *historia_nivel(uint8_t nivel)
+{
+    if (nivel >= HISTORIA_NIVELES)
+    {
+        nivel = HISTORIA_NIVELES - 1U;
+    }
+    return (&niveles[nivel]);
+}
+
+/** copia las columnas de un nivel, de la mas vieja a la mas nueva
+   p_min y p_max necesitan HISTORIA_COLUMNAS bytes, regresa cuantas columnas se copiaron */
+uint16_t historia_copiar(uint8_t nivel, uint8_t *p_min, uint8_t *p_max)
+{
+    historia_nivel_t const *const p_nivel = historia_nivel(nivel);
+    uint16_t const vieja = (p_nivel->listas < HISTORIA_COLUMNAS) ? 0U : p_nivel->siguiente;
+    uint16_t const hasta_el_final = (uint16_t) (HISTORIA_COLUMNAS - vieja);
+    uint16_t const primera = (p_nivel->listas < hasta_el_final) ? p_nivel->listas : hasta_el_final;
+
+    (void) memcpy(p_min, &p_nivel->minimo[vieja], primera);
+    (void) memcpy(p_max, &p_nivel->maximo[vieja], primera);
+    (void) memcpy(&p_min[primera], p_nivel->minimo, (size_t) p_nivel->listas - primera);
+    (void) memcpy(&p_max[primera], p_nivel->maximo, (size_t) p_nivel->listas - primera);
+    return (p_nivel->listas);
+}
+
+/** segundos que cubre el nivel de "0s" a la columna mas vieja */
+uint16_t historia_ventana_s(uint8_t nivel)
+{
+    if (nivel >= HISTORIA_NIVELES)
+    {
+        nivel = HISTORIA_NIVELES - 1U;
+    }
+    return (ventana_s[nivel]);
+}
+
+/** el texto para el extremo izquierdo de la grafica */
+const char *historia_etiqueta(uint8_t nivel)
+{
+    if (nivel >= HISTORIA_NIVELES)
+    {
+        nivel = HISTORIA_NIVELES - 1U;
+    }
+    return (etiqueta[nivel]);
+}
@@ -0,0 +1,89 @@
+/**
+@file    signal_history.h
+@brief   historia de la señal en varios niveles de min/max para cambiar el zoom de la grafica sin recalcular
+@version 1.1
+@date    2026-10-18
+@author  Christian Lara
+
+@section info
+
+Cada nivel guarda HISTORIA_COLUMNAS pares min/max en un arreglo circular y cubre una ventana de tiempo
+mas larga que el de abajo: 10 s, 1 min, 10 min y 1 h. historia_agregar() recibe las columnas del
+nivel 0 y cada nivel junta las de abajo en una propia, la memoria es fija y agregar cuesta O(1)
+amortizado. Cambiar de zoom no recorre muestras: se dibuja el nivel directo con historia_nivel()
+o se copia con historia_copiar().
+
+En AVR se usa un solo nivel (10 s, 563 bytes) por los 2 kB de RAM del ATmega328, el zoom se queda en
+el nivel 0, con HISTORIA_NIVELES se cambia.
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- version inicial
+1.1
+- en AVR un solo nivel, con dos no cabia junto con TFTcanales en la RAM del Nano
+*/
+#ifndef _SIGNAL_HISTORY_H_
+#define _SIGNAL_HISTORY_H_
+
+#include "TFTsignal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if !defined (HISTORIA_NIVELES)
+#if defined (__AVR__)
+#define HISTORIA_NIVELES 1U /* cada nivel son 2 * HISTORIA_COLUMNAS + 7 bytes */
+#else
+#define HISTORIA_NIVELES 4U /* maximo 4, ver historia_ventana_s() */
+#endif
+#endif
+
+#define HISTORIA_COLUMNAS SIGNAL_COLUMNAS /* una columna por pixel de la grafica */
+
+typedef struct
+{
+    uint8_t minimo[HISTORIA_COLUMNAS];
+    uint8_t maximo[HISTORIA_COLUMNAS];
+    uint16_t siguiente; /* la columna que se escribe despues */
+    uint16_t listas; /* columnas con datos, hasta HISTORIA_COLUMNAS */
+    uint8_t acc_min; /* la columna que se esta juntando para el nivel de arriba */
+    uint8_t acc_max;
+    uint8_t acc_cuenta;
+} historia_nivel_t;
+
+void historia_init(void);
+uint8_t historia_agregar(uint8_t minimo, uint8_t maximo);
+const historia_nivel_t *historia_nivel(uint8_t nivel);
+uint16_t historia_copiar(uint8_t nivel, uint8_t *p_min, uint8_t *p_max);
+uint16_t historia_ventana_s(uint8_t nivel);
+const char *historia_etiqueta(uint8_t nivel);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,441 @@
+/**
+@file    signal_kernels.c
+@brief   kernels de reduccion para bloques de muestras int16: min/max por cubeta, media, pico y cruces de umbral
+@version 1.0
+@date    2026-10-18
+@author  Christian Lara
+
+@section info
+
+Las versiones SSE2 y AVX2 se compilan con __attribute__((target)), no hace falta -mavx2 para todo
+el proyecto, y se eligen en tiempo de ejecucion con __builtin_cpu_supports(). El ESP32 (Xtensa LX6)
+no tiene instrucciones SIMD para int16 que GCC pueda usar, ahi queda la version escalar igual que en AVR.
+
+Cruces de umbral: la mascara de "muestra >= umbral" se arma de 16 o 32 muestras a la vez y un cruce
+es un bit prendido cuyo bit anterior (o el estado del bloque anterior) esta apagado.
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- version inicial
+*/
+
+#include "signal_kernels.h"
+
+#if defined (__GNUC__) && (defined (__x86_64__) || defined (__i386__))
+#define SIGNAL_K_X86
+#include <immintrin.h>
+#endif
+
+/* ################################################################## */
+/* escalar */
+
+static void minmax_escalar(const int16_t *p_muestras, uint16_t cuantas, uint16_t cubeta, int16_t *p_min, int16_t *p_max)
+{
+    uint16_t salida = 0U;
+
+    for (uint16_t inicio = 0U; inicio < cuantas; inicio += cubeta)
+    {
+        uint16_t const fin = ((cuantas - inicio) < cubeta) ? cuantas : (uint16_t) (inicio + cubeta);
+        int16_t minimo = p_muestras[inicio];
+        int16_t maximo = p_muestras[inicio];
+
+        for (uint16_t indice = (uint16_t) (inicio + 1U); indice < fin; indice++)
+        {
+            if (p_muestras[indice] < minimo)
+            {
+                minimo = p_muestras[indice];
+            }
+            if (p_muestras[indice] > maximo)
+            {
+                maximo = p_muestras[indice];
+            }
+        }
+        p_min[salida] = minimo;
+        p_max[salida] = maximo;
+        salida++;
+        if (fin == cuantas)
+        {
+            break;
+        }
+    }
+}
+
+static int16_t media_escalar(const int16_t *p_muestras, uint16_t cuantas)
+{
+    int32_t suma = 0;
+
+    for (uint16_t indice = 0U; indice < cuantas; indice++)
+    {
+        suma += p_muestras[indice];
+    }
+    return ((cuantas > 0U) ? (int16_t) (suma / (int32_t) cuantas) : 0);
+}
+
+static int16_t pico_escalar(const int16_t *p_muestras, uint16_t cuantas, int16_t pico)
+{
+    for (uint16_t indice = 0U; indice < cuantas; indice++)
+    {
+        if (p_muestras[indice] > pico)
+        {
+            pico = p_muestras[indice];
+        }
+    }
+    return (pico);
+}
+
+static uint16_t cruces_escalar(const int16_t *p_muestras, uint16_t cuantas, int16_t umbral, uint8_t *p_arriba)
+{
+    uint16_t cruces = 0U;
+    uint8_t arriba = *p_arriba;
+
+    for (uint16_t indice = 0U; indice < cuantas; indice++)
+    {
+        uint8_t const ahora = (p_muestras[indice] >= umbral) ? 1U : 0U;
+
+        if ((ahora != 0U) && (0U == arriba))
+        {
+            cruces++;
+        }
+        arriba = ahora;
+    }
+    *p_arriba = arriba;
+    return (cruces);
+}
+
+static const signal_kernels_t kernels_escalar =
+{
+    minmax_escalar, media_escalar, pico_escalar, cruces_escalar, SIGNAL_K_ESCALAR
+};
+
+#if defined (SIGNAL_K_X86)
+/* ################################################################## */
+/* SSE2, 8 muestras por registro */
+
+__attribute__((target("sse2")))
+static int16_t hmin_sse2(__m128i valor)
+{
+    valor = _mm_min_epi16(valor, _mm_shuffle_epi32(valor, 0x4e));
+    valor = _mm_min_epi16(valor, _mm_shuffle_epi32(valor, 0xb1));
+    valor = _mm_min_epi16(valor, _mm_shufflelo_epi16(valor, 0xb1));
+    return ((int16_t) _mm_cvtsi128_si32(valor));
+}
+
+__attribute__((target("sse2")))
+static int16_t hmax_sse2(__m128i valor)
+{
+    valor = _mm_max_epi16(valor, _mm_shuffle_epi32(valor, 0x4e));
+    valor = _mm_max_epi16(valor, _mm_shuffle_epi32(valor, 0xb1));
+    valor = _mm_max_epi16(valor, _mm_shufflelo_epi16(valor, 0xb1));
+    return ((int16_t) _mm_cvtsi128_si32(valor));
+}
+
+__attribute__((target("sse2")))
+static void minmax_sse2(const int16_t *p_muestras, uint16_t cuantas, uint16_t cubeta, int16_t *p_min, int16_t *p_max)
+{
+    uint16_t salida = 0U;
+
+    if (cubeta < 16U) /* cubetas chicas no llenan un registro */
+    {
+        minmax_escalar(p_muestras, cuantas, cubeta, p_min, p_max);
+        return;
+    }
+
+    for (uint32_t inicio = 0U; inicio < cuantas; inicio += cubeta)
+    {
+        uint32_t const fin = ((cuantas - inicio) < cubeta) ? cuantas : (inicio + cubeta);
+        __m128i minimo = _mm_set1_epi16(p_muestras[inicio]);
+        __m128i maximo = minimo;
+        uint32_t indice = inicio;
+
+        for (; (indice + 8U) <= fin; indice += 8U)
+        {
+            __m128i const bloque = _mm_loadu_si128((const __m128i *) &p_muestras[indice]);
+
+            minimo = _mm_min_epi16(minimo, bloque);
+            maximo = _mm_max_epi16(maximo, bloque);
+        }
+        if ((indice < fin) && ((fin - inicio) >= 8U)) /* el resto se lee como las ultimas 8 muestras de la cubeta, repetir no cambia el min/max */
+        {
+            __m128i const bloque = _mm_loadu_si128((const __m128i *) &p_muestras[fin - 8U]);
+
+            minimo = _mm_min_epi16(minimo, bloque);
+            maximo = _mm_max_epi16(maximo, bloque);
+        }
+        else
+        {
+            for (; indice < fin; indice++) /* cubeta final mas corta que un registro */
+            {
+                __m128i const bloque = _mm_set1_epi16(p_muestras[indice]);
+
+                minimo = _mm_min_epi16(minimo, bloque);
+                maximo = _mm_max_epi16(maximo, bloque);
+            }
+        }
+        p_min[salida] = hmin_sse2(minimo);
+        p_max[salida] = hmax_sse2(maximo);
+        salida++;
+    }
+}
+
+__attribute__((target("sse2")))
+static int16_t media_sse2(const int16_t *p_muestras, uint16_t cuantas)
+{
+    __m128i suma = _mm_setzero_si128();
+    __m128i const unos = _mm_set1_epi16(1);
+    uint32_t indice = 0U;
+    int32_t parcial[4];
+    int32_t total;
+
+    for (; (indice + 8U) <= cuantas; indice += 8U)
+    {
+        suma = _mm_add_epi32(suma, _mm_madd_epi16(_mm_loadu_si128((const __m128i *) &p_muestras[indice]), unos));
+    }
+    _mm_storeu_si128((__m128i *) parcial, suma);
+    total = parcial[0] + parcial[1] + parcial[2] + parcial[3];
+    for (; indice < cuantas; indice++)
+    {
+        total += p_muestras[indice];
+    }
+    return ((cuantas > 0U) ? (int16_t) (total / (int32_t) cuantas) : 0);
+}
+
+__attribute__((target("sse2")))
+static int16_t pico_sse2(const int16_t *p_muestras, uint16_t cuantas, int16_t pico)
+{
+    __m128i maximo = _mm_set1_epi16(pico);
+    uint32_t indice = 0U;
+
+    for (; (indice + 8U) <= cuantas; indice += 8U)
+    {
+        maximo = _mm_max_epi16(maximo, _mm_loadu_si128((const __m128i *) &p_muestras[indice]));
+    }
+    return (pico_escalar(&p_muestras[indice], (uint16_t) (cuantas - indice), hmax_sse2(maximo)));
+}
+
+__attribute__((target("sse2,popcnt")))
+static uint16_t cruces_sse2_popcnt(const int16_t *p_muestras, uint16_t cuantas, int16_t umbral, uint8_t *p_arriba)
+{
+    __m128i const limite = _mm_set1_epi16((int16_t) (umbral - 1));
+    uint32_t arriba = *p_arriba;
+    uint32_t cruces = 0U;
+    uint32_t indice = 0U;
+
+    if (umbral == INT16_MIN) /* umbral - 1 no existe, todas las muestras estan arriba */
+    {
+        return (cruces_escalar(p_muestras, cuantas, umbral, p_arriba));
+    }
+
+    for (; (indice + 16U) <= cuantas; indice += 16U)
+    {
+        __m128i const bajo = _mm_cmpgt_epi16(_mm_loadu_si128((const __m128i *) &p_muestras[indice]), limite);
+        __m128i const alto = _mm_cmpgt_epi16(_mm_loadu_si128((const __m128i *) &p_muestras[indice + 8U]), limite);
+        uint32_t const mascara = (uint32_t) _mm_movemask_epi8(_mm_packs_epi16(bajo, alto)); /* bit i: muestra i >= umbral */
+
+        cruces += (uint32_t) _mm_popcnt_u32(mascara & ~((mascara << 1U) | arriba));
+        arriba = (mascara >> 15U) & 1U;
+    }
+    *p_arriba = (uint8_t) arriba;
+    return ((uint16_t) (cruces + cruces_escalar(&p_muestras[indice], (uint16_t) (cuantas - indice), umbral, p_arriba)));
+}
+
+static const signal_kernels_t kernels_sse2 =
+{
+    minmax_sse2, media_sse2, pico_sse2, cruces_sse2_popcnt, SIGNAL_K_SSE2
+};
+
+/* ################################################################## */
+/* AVX2, 16 muestras por registro */
+
+__attribute__((target("avx2")))
+static void minmax_avx2(const int16_t *p_muestras, uint16_t cuantas, uint16_t cubeta, int16_t *p_min, int16_t *p_max)
+{
+    uint16_t salida = 0U;
+
+    if (cubeta < 32U)
+    {
+        minmax_sse2(p_muestras, cuantas, cubeta, p_min, p_max);
+        return;
+    }
+
+    for (uint32_t inicio = 0U; inicio < cuantas; inicio += cubeta)
+    {
+        uint32_t const fin = ((cuantas - inicio) < cubeta) ? cuantas : (inicio + cubeta);
+        __m256i minimo = _mm256_set1_epi16(p_muestras[inicio]);
+        __m256i maximo = minimo;
+        uint32_t indice = inicio;
+
+        for (; (indice + 16U) <= fin; indice += 16U)
+        {
+            __m256i const bloque = _mm256_loadu_si256((const __m256i *) &p_muestras[indice]);
+
+            minimo = _mm256_min_epi16(minimo, bloque);
+            maximo = _mm256_max_epi16(maximo, bloque);
+        }
+        if ((indice < fin) && ((fin - inicio) >= 16U)) /* el resto se lee como las ultimas 16 muestras de la cubeta, repetir no cambia el min/max */
+        {
+            __m256i const bloque = _mm256_loadu_si256((const __m256i *) &p_muestras[fin - 16U]);
+
+            minimo = _mm256_min_epi16(minimo, bloque);
+            maximo = _mm256_max_epi16(maximo, bloque);
+        }
+        else
+        {
+            for (; indice < fin; indice++) /* cubeta final mas corta que un registro */
+            {
+                __m256i const bloque = _mm256_set1_epi16(p_muestras[indice]);
+
+                minimo = _mm256_min_epi16(minimo, bloque);
+                maximo = _mm256_max_epi16(maximo, bloque);
+            }
+        }
+        p_min[salida] = hmin_sse2(_mm_min_epi16(_mm256_castsi256_si128(minimo), _mm256_extracti128_si256(minimo, 1)));
+        p_max[salida] = hmax_sse2(_mm_max_epi16(_mm256_castsi256_si128(maximo), _mm256_extracti128_si256(maximo, 1)));
+        salida++;
+    }
+}
+
+__attribute__((target("avx2")))
+static int16_t media_avx2(const int16_t *p_muestras, uint16_t cuantas)
+{
+    __m256i suma = _mm256_setzero_si256();
+    __m256i const unos = _mm256_set1_epi16(1);
+    uint32_t indice = 0U;
+    int32_t parcial[8];
+    int32_t total = 0;
+
+    for (; (indice + 16U) <= cuantas; indice += 16U)
+    {
+        suma = _mm256_add_epi32(suma, _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *) &p_muestras[indice]), unos));
+    }
+    _mm256_storeu_si256((__m256i *) parcial, suma);
+    for (uint8_t carril = 0U; carril < 8U; carril++)
+    {
+        total += parcial[carril];
+    }
+    for (; indice < cuantas; indice++)
+    {
+        total += p_muestras[indice];
+    }
+    return ((cuantas > 0U) ? (int16_t) (total / (int32_t) cuantas) : 0);
+}
+
+__attribute__((target("avx2")))
+static int16_t pico_avx2(const int16_t *p_muestras, uint16_t cuantas, int16_t pico)
+{
+    __m256i maximo = _mm256_set1_epi16(pico);
+    uint32_t indice = 0U;
+
+    for (; (indice + 16U) <= cuantas; indice += 16U)
+    {
+        maximo = _mm256_max_epi16(maximo, _mm256_loadu_si256((const __m256i *) &p_muestras[indice]));
+    }
+    pico = hmax_sse2(_mm_max_epi16(_mm256_castsi256_si128(maximo), _mm256_extracti128_si256(maximo, 1)));
+    return (pico_escalar(&p_muestras[indice], (uint16_t) (cuantas - indice), pico));
+}
+
+__attribute__((target("avx2,popcnt")))
+static uint16_t cruces_avx2(const int16_t *p_muestras, uint16_t cuantas, int16_t umbral, uint8_t *p_arriba)
+{
+    __m256i const limite = _mm256_set1_epi16((int16_t) (umbral - 1));
+    uint32_t arriba = *p_arriba;
+    uint32_t cruces = 0U;
+    uint32_t indice = 0U;
+
+    if (umbral == INT16_MIN)
+    {
+        return (cruces_escalar(p_muestras, cuantas, umbral, p_arriba));
+    }
+
+    for (; (indice + 32U) <= cuantas; indice += 32U)
+    {
+        __m256i const bajo = _mm256_cmpgt_epi16(_mm256_loadu_si256((const __m256i *) &p_muestras[indice]), limite);
+        __m256i const alto = _mm256_cmpgt_epi16(_mm256_loadu_si256((const __m256i *) &p_muestras[indice + 16U]), limite);
+        /* packs trabaja por mitades de 128 bits, el permute deja las 32 muestras en orden */
+        __m256i const juntos = _mm256_permute4x64_epi64(_mm256_packs_epi16(bajo, alto), 0xd8);
+        uint32_t const mascara = (uint32_t) _mm256_movemask_epi8(juntos);
+
+        cruces += (uint32_t) _mm_popcnt_u32(mascara & ~((mascara << 1U) | arriba));
+        arriba = mascara >> 31U;
+    }
+    *p_arriba = (uint8_t) arriba;
+    return ((uint16_t) (cruces + cruces_sse2_popcnt(&p_muestras[indice], (uint16_t) (cuantas - indice), umbral, p_arriba)));
+}
+
+static const signal_kernels_t kernels_avx2 =
+{
+    minmax_avx2, media_avx2, pico_avx2, cruces_avx2, SIGNAL_K_AVX2
+};
+#endif /* SIGNAL_K_X86 */
+
+const signal_kernels_t *signal_k = &kernels_escalar;
+
+/** elige la version mas rapida para el procesador, se llama una vez al inicio */
+void signal_kernels_init(void)
+{
+#if defined (SIGNAL_K_X86)
+    __builtin_cpu_init();
+    if ((__builtin_cpu_supports("avx2") != 0) && (__builtin_cpu_supports("popcnt") != 0))
+    {
+        signal_k = &kernels_avx2;
+    }
+    else if ((__builtin_cpu_supports("sse2") != 0) && (__builtin_cpu_supports("popcnt") != 0))
+    {
+        signal_k = &kernels_sse2;
+    }
+    else
+    {
+        signal_k = &kernels_escalar;
+    }
+#else
+    signal_k = &kernels_escalar;
+#endif
+}
+
+/** fuerza una version, para comparar en el host
+   regresa el nivel que quedo, si el procesador no soporta el pedido queda el escalar */
+uint8_t signal_kernels_nivel(uint8_t nivel)
+{
+    signal_k = &kernels_escalar;
+#if defined (SIGNAL_K_X86)
+    __builtin_cpu_init();
+    if ((SIGNAL_K_AVX2 == nivel) && (__builtin_cpu_supports("avx2") != 0) && (__builtin_cpu_supports("popcnt") != 0))
+    {
+        signal_k = &kernels_avx2;
+    }
+    else if ((SIGNAL_K_SSE2 == nivel) && (__builtin_cpu_supports("sse2") != 0) && (__builtin_cpu_supports("popcnt") != 0))
+    {
+        signal_k = &kernels_sse2;
+    }
+    else
+    {
+        /* escalar */
+    }
+#else
+    (void) nivel;
+#endif
+    return (signal_k->nivel);
+}
@@ -0,0 +1,76 @@
+/**
+@file    signal_kernels.h
+@brief   kernels de reduccion para bloques de muestras int16: min/max por cubeta, media, pico y cruces de umbral
+@version 1.0
+@date    2026-10-18
+@author  Christian Lara
+
+@section info
+
+signal_kernels_init() elige la version mas rapida que soporta el procesador: AVX2 o SSE2 en x86
+(Linux / host) y la version escalar en todo lo demas (AVR, ESP32, ARM). Las tres dan exactamente
+el mismo resultado.
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- version inicial
+*/
+#ifndef _SIGNAL_KERNELS_H_
+#define _SIGNAL_KERNELS_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SIGNAL_K_ESCALAR 0U
+#define SIGNAL_K_SSE2 1U
+#define SIGNAL_K_AVX2 2U
+
+typedef struct
+{
+    /* min y max de cada cubeta de "cubeta" muestras, la ultima puede ser mas corta */
+    void (*minmax)(const int16_t *p_muestras, uint16_t cuantas, uint16_t cubeta, int16_t *p_min, int16_t *p_max);
+    /* promedio, truncado hacia cero */
+    int16_t (*media)(const int16_t *p_muestras, uint16_t cuantas);
+    /* el mayor entre pico y las muestras */
+    int16_t (*pico)(const int16_t *p_muestras, uint16_t cuantas, int16_t pico);
+    /* cuantas veces la señal sube de abajo del umbral a umbral o mas, p_arriba sigue entre bloques */
+    uint16_t (*cruces)(const int16_t *p_muestras, uint16_t cuantas, int16_t umbral, uint8_t *p_arriba);
+    uint8_t nivel; /* SIGNAL_K_xxx */
+} signal_kernels_t;
+
+extern const signal_kernels_t *signal_k;
+
+void signal_kernels_init(void);
+uint8_t signal_kernels_nivel(uint8_t nivel);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,141 @@
+/**
+@file    signal_ring.c
+@brief   anillo de muestras de un productor y un consumidor, sin bloqueos, entre la ISR del ADC y el loop
+@version 1.0
+@date    2026-10-18
+@author  Christian Lara
+
+@section info
+
+Productor: signal_ring_push(). Consumidor: signal_ring_pendientes(), signal_ring_bloque() +
+signal_ring_consumir() sin copiar, signal_ring_pop() copiando, signal_ring_vaciar().
+signal_ring_init() va antes de habilitar la interrupcion.
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- version inicial
+*/
+
+#include <string.h>
+#include "signal_ring.h"
+
+#if defined (__GNUC__)
+#define CARGAR_ADQ(indice) __atomic_load_n(&(indice), __ATOMIC_ACQUIRE)
+#define GUARDAR_LIB(indice, valor) __atomic_store_n(&(indice), (valor), __ATOMIC_RELEASE)
+#else
+#define CARGAR_ADQ(indice) (*(volatile signal_ring_idx_t *) &(indice))
+#define GUARDAR_LIB(indice, valor) (*(volatile signal_ring_idx_t *) &(indice) = (valor))
+#endif
+
+/** capacidad: muestras en p_buffer, se usa la potencia de dos mas grande que no la pasa y a lo mas SIGNAL_RING_MAX */
+void signal_ring_init(signal_ring_t *p_ring, int16_t *p_buffer, uint16_t capacidad)
+{
+    uint16_t potencia = 1U;
+
+    if (capacidad > SIGNAL_RING_MAX)
+    {
+        capacidad = SIGNAL_RING_MAX;
+    }
+    while ((uint16_t) (potencia << 1U) <= capacidad)
+    {
+        potencia = (uint16_t) (potencia << 1U);
+    }
+    p_ring->p_datos = p_buffer;
+    p_ring->mascara = (signal_ring_idx_t) (potencia - 1U);
+    p_ring->escribe = 0U;
+    p_ring->lee = 0U;
+}
+
+/** productor: guarda una muestra, regresa 0 si el anillo esta lleno y la muestra se pierde */
+uint8_t signal_ring_push(signal_ring_t *p_ring, int16_t muestra)
+{
+    signal_ring_idx_t const escribe = p_ring->escribe; /* propio, no cambia por debajo */
+    signal_ring_idx_t const lee = CARGAR_ADQ(p_ring->lee);
+    uint8_t guardada = 0U;
+
+    if ((signal_ring_idx_t) (escribe - lee) <= p_ring->mascara)
+    {
+        p_ring->p_datos[escribe & p_ring->mascara] = muestra;
+        GUARDAR_LIB(p_ring->escribe, (signal_ring_idx_t) (escribe + 1U)); /* publica la muestra */
+        guardada = 1U;
+    }
+    return (guardada);
+}
+
+/** consumidor: muestras que se pueden leer */
+uint16_t signal_ring_pendientes(signal_ring_t *p_ring)
+{
+    return ((uint16_t) (signal_ring_idx_t) (CARGAR_ADQ(p_ring->escribe) - p_ring->lee));
+}
+
+/** consumidor: el bloque contiguo mas viejo, sin copiar, se libera con signal_ring_consumir()
+   despues de dar la vuelta queda otro bloque desde el inicio del buffer */
+uint16_t signal_ring_bloque(signal_ring_t *p_ring, const int16_t **pp_bloque)
+{
+    signal_ring_idx_t const lee = p_ring->lee;
+    signal_ring_idx_t const inicio = lee & p_ring->mascara;
+    uint16_t const pendientes = signal_ring_pendientes(p_ring);
+    uint16_t const hasta_el_final = (uint16_t) ((p_ring->mascara + 1U) - inicio);
+
+    *pp_bloque = &p_ring->p_datos[inicio];
+    return ((pendientes < hasta_el_final) ? pendientes : hasta_el_final);
+}
+
+/** consumidor: libera las muestras ya leidas para el productor */
+void signal_ring_consumir(signal_ring_t *p_ring, uint16_t cuantas)
+{
+    GUARDAR_LIB(p_ring->lee, (signal_ring_idx_t) (p_ring->lee + cuantas));
+}
+
+/** consumidor: copia hasta maximo muestras a p_destino, regresa cuantas */
+uint16_t signal_ring_pop(signal_ring_t *p_ring, int16_t *p_destino, uint16_t maximo)
+{
+    uint16_t copiadas = 0U;
+    uint8_t vueltas = 0U;
+
+    while ((copiadas < maximo) && (vueltas < 2U)) /* a lo mas dos bloques, antes y despues de dar la vuelta */
+    {
+        const int16_t *p_bloque;
+        uint16_t cuantas = signal_ring_bloque(p_ring, &p_bloque);
+
+        if (cuantas > (maximo - copiadas))
+        {
+            cuantas = (uint16_t) (maximo - copiadas);
+        }
+        (void) memcpy(&p_destino[copiadas], p_bloque, (size_t) cuantas * sizeof(int16_t));
+        signal_ring_consumir(p_ring, cuantas);
+        copiadas = (uint16_t) (copiadas + cuantas);
+        vueltas++;
+    }
+    return (copiadas);
+}
+
+/** consumidor: descarta todo lo pendiente */
+void signal_ring_vaciar(signal_ring_t *p_ring)
+{
+    GUARDAR_LIB(p_ring->lee, CARGAR_ADQ(p_ring->escribe));
+}
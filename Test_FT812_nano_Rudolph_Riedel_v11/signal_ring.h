@@ -0,0 +1,91 @@
+/**
+@file    signal_ring.h
+@brief   anillo de muestras de un productor y un consumidor, sin bloqueos, entre la ISR del ADC y el loop
+@version 1.0
+@date    2026-10-18
+@author  Christian Lara
+
+@section info
+
+Cada indice lo escribe un solo lado: "escribe" el productor (ISR) y "lee" el consumidor (loop), asi
+que no hace falta apagar interrupciones. Los indices corren libres y se enmascaran con la capacidad,
+que es potencia de dos.
+
+- AVR: indices de 8 bits porque solo la lectura y escritura de un byte es atomica, capacidad maxima 128
+- ESP32 / Linux: indices de 32 bits, capacidad maxima 32768, cada indice en su propia linea de cache
+  en el host para que los dos nucleos no se peleen la misma linea
+
+El orden de memoria lo dan __atomic_load_n(ACQUIRE) y __atomic_store_n(RELEASE) de GCC: la muestra
+queda escrita antes de publicar el indice, tambien en el ESP32 con la ISR en el otro nucleo.
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- version inicial
+*/
+#ifndef _SIGNAL_RING_H_
+#define _SIGNAL_RING_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined (__AVR__)
+typedef uint8_t signal_ring_idx_t;
+#define SIGNAL_RING_MAX 128U
+#define SIGNAL_RING_ALINEADO
+#elif defined (__x86_64__) || defined (__i386__) || defined (__aarch64__)
+typedef uint32_t signal_ring_idx_t;
+#define SIGNAL_RING_MAX 32768U
+#define SIGNAL_RING_ALINEADO __attribute__((aligned(64))) /* una linea de cache por indice */
+#else
+typedef uint32_t signal_ring_idx_t;
+#define SIGNAL_RING_MAX 32768U
+#define SIGNAL_RING_ALINEADO __attribute__((aligned(4)))
+#endif
+
+typedef struct
+{
+    signal_ring_idx_t escribe SIGNAL_RING_ALINEADO; /* solo lo cambia el productor */
+    signal_ring_idx_t lee SIGNAL_RING_ALINEADO; /* solo lo cambia el consumidor */
+    int16_t *p_datos;
+    signal_ring_idx_t mascara;
+} signal_ring_t;
+
+void signal_ring_init(signal_ring_t *p_ring, int16_t *p_buffer, uint16_t capacidad);
+uint8_t signal_ring_push(signal_ring_t *p_ring, int16_t muestra);
+uint16_t signal_ring_pendientes(signal_ring_t *p_ring);
+uint16_t signal_ring_bloque(signal_ring_t *p_ring, const int16_t **pp_bloque);
+void signal_ring_consumir(signal_ring_t *p_ring, uint16_t cuantas);
+uint16_t signal_ring_pop(signal_ring_t *p_ring, int16_t *p_destino, uint16_t maximo);
+void signal_ring_vaciar(signal_ring_t *p_ring);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,170 @@
+/*
+@file    bench_backoff.c
+@brief   benchmark for EVE_BACKOFF: reads of REG_CMDB_SPACE per EVE_execute_cmd() on the SOFTWARE_TEST emulation
+@version 1.1
+@date    2026-10-19
+@author  Christian Lara
+
+@section info
+
+The emulation drains the cmd-FIFO at a fixed rate on its virtual clock and counts the reads of
+REG_CMDB_SPACE, every frame has 1 to 20 CMD_TEXT and is followed by EVE_execute_cmd().
+The first FRAMES frames are only there to let the estimate of EVE_BACKOFF settle.
+With EVE_BACKOFF and EVE_JOURNAL it also checks that the journal EVE_busy() replays after a coprocessor
+fault is part of the estimate: the EVE_execute_cmd() right after the recovery must not need more reads
+than a frame of the same size, the program returns 1 if it does.
+
+Build and run from the sketch directory, once with and once without EVE_BACKOFF:
+gcc -std=c99 -Wall -Wextra -DSOFTWARE_TEST -D_POSIX_C_SOURCE=200809L -I. -o bench_backoff test/bench_backoff.c EVE_commands.c EVE_target.c && ./bench_backoff
+gcc -std=c99 -Wall -Wextra -DSOFTWARE_TEST -DEVE_NO_BACKOFF -D_POSIX_C_SOURCE=200809L -I. -o bench_plain test/bench_backoff.c EVE_commands.c EVE_target.c && ./bench_plain
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+1.1
+- added the check of the journal replay after a coprocessor fault
+
+*/
+
+#include <stdio.h>
+#include "EVE.h"
+
+#define FRAMES 200U
+#define SPI_NS 125UL /* 8 MHz */
+
+static const uint32_t rates[] = {1000UL, 2000UL, 5000UL, 20000UL}; /* bytes per ms the co-processor works off */
+
+static void frame(uint16_t const widgets)
+{
+    EVE_start_cmd_burst();
+    EVE_cmd_dl_burst(CMD_DLSTART);
+    EVE_cmd_dl_burst(DL_CLEAR | CLR_COL | CLR_STN | CLR_TAG);
+    for (uint16_t index = 0U; index < widgets; index++)
+    {
+        EVE_cmd_text_burst(10, (int16_t) (10U + index), 28, 0, "Hello World");
+    }
+    EVE_cmd_dl_burst(DL_DISPLAY);
+    EVE_cmd_dl_burst(CMD_SWAP);
+    EVE_end_cmd_burst();
+}
+
+#if defined (EVE_BACKOFF) && defined (EVE_JOURNAL)
+/* the same seven words the journal records, there is no widget in it */
+static void state_frame(void)
+{
+    EVE_start_cmd_burst();
+    EVE_cmd_bgcolor_burst(0x00402000UL);
+    EVE_cmd_fgcolor_burst(0x00003870UL);
+    EVE_cmd_romfont_burst(1UL, 31UL);
+    EVE_end_cmd_burst();
+}
+
+static uint8_t check_replay(void)
+{
+    uint32_t polls;
+    uint32_t replay_polls;
+
+    EVE_test_reset();
+    (void) EVE_init();
+    EVE_test_set_drain(1000UL, SPI_NS); /* the seven words take 28 us, far more than the first delay */
+
+    EVE_journal_begin();
+    EVE_cmd_bgcolor_burst(0x00402000UL);
+    EVE_cmd_fgcolor_burst(0x00003870UL);
+    EVE_cmd_romfont_burst(1UL, 31UL);
+    (void) EVE_journal_end();
+    EVE_execute_cmd();
+
+    for (uint16_t count = 0U; count < FRAMES; count++)
+    {
+        state_frame();
+        EVE_execute_cmd();
+    }
+
+    polls = EVE_get_busy_polls();
+    state_frame();
+    EVE_execute_cmd();
+    polls = EVE_get_busy_polls() - polls;
+
+    EVE_test_fault();
+    (void) EVE_busy(); /* recovers and replays the journal, like TFT_display() does */
+    replay_polls = EVE_get_busy_polls();
+    EVE_execute_cmd();
+    replay_polls = EVE_get_busy_polls() - replay_polls;
+
+    printf("journal replay: %lu reads, same words as a frame: %lu reads\n", (unsigned long) replay_polls,
+           (unsigned long) polls);
+    return ((replay_polls > (polls + 1UL)) ? 1U : 0U);
+}
+#endif
+
+int main(void)
+{
+    uint8_t ret = 0U;
+
+#if defined (EVE_BACKOFF)
+    printf("EVE_BACKOFF, %u frames per rate\n", FRAMES);
+#else
+    printf("plain polling, %u frames per rate\n", FRAMES);
+#endif
+
+    for (uint8_t index = 0U; index < (sizeof(rates) / sizeof(rates[0])); index++)
+    {
+        uint32_t reads;
+        uint32_t time_us;
+
+        EVE_test_reset();
+        (void) EVE_init();
+        EVE_test_set_drain(rates[index], SPI_NS);
+
+        for (uint16_t count = 0U; count < FRAMES; count++)
+        {
+            frame((uint16_t) (1U + (count % 20U)));
+            EVE_execute_cmd();
+        }
+
+        reads = EVE_test_space_reads();
+        time_us = EVE_test_time_us();
+        for (uint16_t count = 0U; count < FRAMES; count++)
+        {
+            frame((uint16_t) (1U + (count % 20U)));
+            EVE_execute_cmd();
+        }
+        reads = EVE_test_space_reads() - reads;
+        time_us = EVE_test_time_us() - time_us;
+
+        printf("%6lu B/ms: %7.1f reads per wait, %4lu us per frame\n", (unsigned long) rates[index],
+               (double) reads / FRAMES, (unsigned long) (time_us / FRAMES));
+    }
+
+#if defined (EVE_BACKOFF) && defined (EVE_JOURNAL)
+    ret = check_replay();
+    printf("%s\n", (0U == ret) ? "PASS" : "FAIL");
+#endif
+    return ((int) ret);
+}
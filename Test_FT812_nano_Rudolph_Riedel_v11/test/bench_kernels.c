@@ -0,0 +1,189 @@
+/*
+@file    bench_kernels.c
+@brief   prueba y benchmark de signal_kernels: las versiones escalar, SSE2 y AVX2 dan lo mismo y cuantas muestras por segundo procesan
+@version 1.0
+@date    2026-10-19
+@author  Christian Lara
+
+@section info
+
+Primero corre PRUEBAS bloques al azar, con INT16_MIN / INT16_MAX y cubetas que no dividen el bloque,
+por todas las versiones que tiene el host y compara cada salida con la escalar.
+Despues mide Mmuestras/s de cada kernel sobre bloques de MUESTRAS muestras.
+Las versiones x86 solo existen con GCC o clang en x86, en otro host solo se mide la escalar.
+
+Compilar y correr desde el directorio del sketch:
+gcc -std=c99 -O2 -Wall -Wextra -D_POSIX_C_SOURCE=200809L -I. -o bench_kernels test/bench_kernels.c signal_kernels.c && ./bench_kernels
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- version inicial
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "signal_kernels.h"
+
+#define MUESTRAS 60000U
+#define PRUEBAS 2000U
+#define REPETICIONES 2000U
+#define MAX_CUBETAS 3000U
+
+static int16_t datos[MUESTRAS];
+static int16_t minimos[3][MAX_CUBETAS];
+static int16_t maximos[3][MAX_CUBETAS];
+static const char *const nombres[] = {"escalar", "sse2", "avx2"};
+
+static double ahora(void)
+{
+    struct timespec t;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &t);
+    return ((double) t.tv_sec + ((double) t.tv_nsec * 1e-9));
+}
+
+/* compara todas las versiones con la escalar, regresa cuantas pruebas no coincidieron */
+static uint32_t comparar(void)
+{
+    uint32_t errores = 0UL;
+
+    for (uint32_t prueba = 0UL; prueba < PRUEBAS; prueba++)
+    {
+        uint16_t const inicio = (uint16_t) (rand() % 1000);
+        uint16_t const cuantas = (uint16_t) (1 + (rand() % 2999));
+        uint16_t const cubeta = (uint16_t) (1 + (rand() % 200));
+        int16_t const umbral = (0UL == (prueba % 50UL)) ? INT16_MIN : (int16_t) ((rand() & 0xffff) - 32768);
+        int16_t media[3];
+        int16_t pico[3];
+        uint16_t cruces[3];
+        uint8_t arriba[3];
+        uint16_t const cubetas = (uint16_t) ((cuantas + cubeta - 1U) / cubeta);
+
+        for (uint8_t nivel = 0U; nivel < 3U; nivel++)
+        {
+            if (signal_kernels_nivel(nivel) != nivel)
+            {
+                continue;
+            }
+            signal_k->minmax(&datos[inicio], cuantas, cubeta, minimos[nivel], maximos[nivel]);
+            media[nivel] = signal_k->media(&datos[inicio], cuantas);
+            pico[nivel] = signal_k->pico(&datos[inicio], cuantas, -5);
+            arriba[nivel] = (uint8_t) (prueba & 1UL);
+            cruces[nivel] = signal_k->cruces(&datos[inicio], cuantas, umbral, &arriba[nivel]);
+        }
+
+        for (uint8_t nivel = 1U; nivel < 3U; nivel++)
+        {
+            if (signal_kernels_nivel(nivel) != nivel)
+            {
+                continue;
+            }
+            if ((memcmp(minimos[0], minimos[nivel], cubetas * sizeof(int16_t)) != 0) ||
+                (memcmp(maximos[0], maximos[nivel], cubetas * sizeof(int16_t)) != 0) ||
+                (media[0] != media[nivel]) || (pico[0] != pico[nivel]) ||
+                (cruces[0] != cruces[nivel]) || (arriba[0] != arriba[nivel]))
+            {
+                if (errores < 5UL)
+                {
+                    printf("%s no coincide: %u muestras, cubeta %u\n", nombres[nivel], cuantas, cubeta);
+                }
+                errores++;
+            }
+        }
+    }
+    return (errores);
+}
+
+int main(void)
+{
+    uint32_t errores;
+    volatile int32_t suma = 0; /* para que el compilador no quite las llamadas */
+
+    srand(1);
+    for (uint32_t indice = 0UL; indice < MUESTRAS; indice++)
+    {
+        datos[indice] = (int16_t) ((rand() & 0xffff) - 32768);
+    }
+    for (uint32_t indice = 0UL; indice < 5000UL; indice++)
+    {
+        datos[indice] = INT16_MIN;
+    }
+    datos[7] = INT16_MAX;
+
+    errores = comparar();
+    printf("%lu pruebas, %lu no coinciden\n", (unsigned long) PRUEBAS, (unsigned long) errores);
+
+    for (uint8_t nivel = 0U; nivel < 3U; nivel++)
+    {
+        double const total = (double) REPETICIONES * MUESTRAS / 1e6;
+        double t_minmax;
+        double t_media;
+        double t_pico;
+        double t_cruces;
+        uint8_t arriba = 0U;
+
+        if (signal_kernels_nivel(nivel) != nivel)
+        {
+            printf("%-8s no disponible\n", nombres[nivel]);
+            continue;
+        }
+        t_minmax = ahora();
+        for (uint32_t rep = 0UL; rep < REPETICIONES; rep++)
+        {
+            signal_k->minmax(datos, MUESTRAS, 216U, minimos[0], maximos[0]);
+            suma += minimos[0][rep % 100U];
+        }
+        t_minmax = ahora() - t_minmax;
+        t_media = ahora();
+        for (uint32_t rep = 0UL; rep < REPETICIONES; rep++)
+        {
+            suma += signal_k->media(&datos[rep & 7U], MUESTRAS - 8U);
+        }
+        t_media = ahora() - t_media;
+        t_pico = ahora();
+        for (uint32_t rep = 0UL; rep < REPETICIONES; rep++)
+        {
+            suma += signal_k->pico(&datos[rep & 7U], MUESTRAS - 8U, 0);
+        }
+        t_pico = ahora() - t_pico;
+        t_cruces = ahora();
+        for (uint32_t rep = 0UL; rep < REPETICIONES; rep++)
+        {
+            suma += signal_k->cruces(&datos[rep & 7U], MUESTRAS - 8U, 100, &arriba);
+        }
+        t_cruces = ahora() - t_cruces;
+        printf("%-8s Mmuestras/s: minmax %6.0f  media %6.0f  pico %6.0f  cruces %6.0f\n", nombres[nivel],
+               total / t_minmax, total / t_media, total / t_pico, total / t_cruces);
+    }
+
+    signal_kernels_init();
+    printf("signal_kernels_init() elige %s\n", nombres[signal_k->nivel]);
+    return ((0UL == errores) ? 0 : 1);
+}
@@ -0,0 +1,368 @@
+/*
+@file    bench_signal.c
+@brief   benchmark de TFTsignal: muestras por segundo que pasan por signal_push() / signal_procesar() y bytes de display-list por frame
+@version 1.1
+@date    2026-10-19
+@author  Christian Lara
+
+@section info
+
+Corre sobre la emulacion de SOFTWARE_TEST, el simulador del detector genera 70 s de muestras en
+frames de 16 ms para cada frecuencia de muestreo, despues se mide lo que signal_dibujar() manda al
+cmd-FIFO en el modo de vertices y en el modo bitmap. El tiempo incluye al simulador.
+Falla si se pierde alguna muestra o si los bytes por frame cambian con la frecuencia de muestreo.
+Despues rasteriza lo que manda cada modo con una senal que pasa por todos los valores de 0 a 300:
+la traza de vertices fila por fila y el bitmap con el BITMAP_TRANSFORM y los bytes de RAM_G, muestreando
+el pixel en su esquina y en su centro. Falla si algun pixel del bitmap no queda en la fila de la traza
+de vertices, es la prueba de la fila del BITMAP_TRANSFORM_C.
+Con -DSIGNAL_BITMAP_L8 prueba el bitmap L8:
+gcc -std=c99 -O2 -Wall -Wextra -DSOFTWARE_TEST -DSIGNAL_BITMAP_L8 -D_POSIX_C_SOURCE=200809L -I. -o bench_signal_l8 test/bench_signal.c TFTsignal.c signal_kernels.c signal_history.c signal_ring.c EVE_commands.c EVE_target.c && ./bench_signal_l8
+
+Compilar y correr desde el directorio del sketch:
+gcc -std=c99 -O2 -Wall -Wextra -DSOFTWARE_TEST -D_POSIX_C_SOURCE=200809L -I. -o bench_signal test/bench_signal.c TFTsignal.c signal_kernels.c signal_history.c signal_ring.c EVE_commands.c EVE_target.c && ./bench_signal
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- version inicial
+
+1.1
+- compara las filas del modo bitmap con las de la traza de vertices
+
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "EVE.h"
+#include "TFTsignal.h"
+
+#define FRAME_MS 16U
+#define SEGUNDOS 70U /* un poco mas que la ventana de 60 s */
+#define MEM_SIGNAL 0x000f6000UL /* como en tft.c */
+#define MEM_FILAS 0x00010000UL /* la prueba de filas tambien con SIGNAL_BITMAP_L8, que no cabe en MEM_SIGNAL */
+
+static const uint16_t frecuencias[] = {100U, 500U, 2000U, 8000U, 32000U};
+
+static double ahora(void)
+{
+    struct timespec t;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &t);
+    return ((double) t.tv_sec + ((double) t.tv_nsec * 1e-9));
+}
+
+static uint32_t bytes_dibujar(void)
+{
+    uint32_t const antes = EVE_test_cmd_bytes();
+
+    EVE_start_cmd_burst();
+    EVE_cmd_dlstart_burst(); /* como en un frame, con EVE_STATE_CACHE el estado empieza de nuevo */
+    signal_dibujar();
+    EVE_end_cmd_burst();
+    return (EVE_test_cmd_bytes() - antes - 4UL);
+}
+
+#define CAPTURA 2048U
+#define FILA0 ((int32_t) SIGNAL_Y_CERO - (int32_t) SIGNAL_ALTO) /* fila de pantalla del valor SIGNAL_MAX */
+#define FILAS (SIGNAL_ALTO + 1U)
+
+static uint32_t captura[CAPTURA];
+static uint8_t traza[SIGNAL_COLUMNAS][FILAS]; /* pixeles de la traza de vertices */
+static uint8_t imagen[SIGNAL_COLUMNAS][FILAS]; /* pixeles del modo bitmap */
+
+/* las palabras que signal_dibujar() manda en un frame */
+static uint32_t capturar(void)
+{
+    uint32_t palabras;
+
+    EVE_test_capture(captura, CAPTURA);
+    EVE_start_cmd_burst();
+    EVE_cmd_dlstart_burst();
+    signal_dibujar();
+    EVE_end_cmd_burst();
+    palabras = EVE_test_captured();
+    EVE_test_capture(NULL, 0UL);
+    return (palabras);
+}
+
+static int32_t extender(uint32_t const valor, uint8_t const bits)
+{
+    uint32_t const signo = 1UL << (bits - 1U);
+
+    return ((int32_t) ((valor & ((signo << 1U) - 1UL)) ^ signo) - (int32_t) signo);
+}
+
+/* division entre 2^bits hacia menos infinito, tambien para negativos */
+static int32_t piso(int64_t const valor, uint8_t const bits)
+{
+    int64_t const divisor = (int64_t) 1 << bits;
+    int64_t cociente = valor / divisor;
+
+    if (((valor % divisor) != 0) && (valor < 0))
+    {
+        cociente--;
+    }
+    return ((int32_t) cociente);
+}
+
+/* prende el pixel de pantalla (x, y) en p_pixeles, cuenta los que caen fuera de la grafica */
+static uint32_t prender(uint8_t p_pixeles[SIGNAL_COLUMNAS][FILAS], int32_t const x, int32_t const y)
+{
+    uint32_t fuera = 0UL;
+
+    if ((x < (int32_t) SIGNAL_X0) || (x >= ((int32_t) SIGNAL_X0 + (int32_t) SIGNAL_COLUMNAS)) ||
+        (y < FILA0) || (y >= (FILA0 + (int32_t) FILAS)))
+    {
+        fuera = 1UL;
+    }
+    else
+    {
+        p_pixeles[x - (int32_t) SIGNAL_X0][y - FILA0] = 1U;
+    }
+    return (fuera);
+}
+
+/* modo vertices: cada par de VERTEX2F es una columna, el vertice en y prende la fila y */
+static uint32_t rasterizar_vertices(uint32_t const palabras)
+{
+    uint32_t fuera = 0UL;
+    uint32_t vertices = 0UL;
+    int32_t x_previo = 0;
+    int32_t y_previo = 0;
+
+    for (uint32_t indice = 0UL; indice < palabras; indice++)
+    {
+        uint32_t const palabra = captura[indice];
+
+        if (1UL == (palabra >> 30U)) /* VERTEX2F */
+        {
+            int32_t const x_pix = extender(palabra >> 15U, 15U) / PRESICION;
+            int32_t const y_pix = extender(palabra, 15U) / PRESICION;
+
+            if ((vertices & 1UL) != 0UL)
+            {
+                int32_t const desde = (y_pix < y_previo) ? y_pix : y_previo;
+                int32_t const hasta = (y_pix < y_previo) ? y_previo : y_pix;
+
+                if (x_pix != x_previo) /* el par siempre es vertical */
+                {
+                    fuera++;
+                }
+                for (int32_t fila = desde; fila <= hasta; fila++)
+                {
+                    fuera += prender(traza, x_pix, fila);
+                }
+            }
+            x_previo = x_pix;
+            y_previo = y_pix;
+            vertices++;
+        }
+    }
+    return (fuera);
+}
+
+/* modo bitmap: cada VERTEX2F dibuja el BITMAP_SIZE con el transform, el texel (u, v) sale de RAM_G,
+   centro = 0: el pixel se muestrea en su esquina, centro = 1: en su centro */
+static uint32_t rasterizar_bitmap(uint32_t const palabras, uint8_t const centro)
+{
+    int32_t transform[6] = {256, 0, 0, 0, 256, 0};
+    uint32_t fuente = 0UL;
+    uint32_t formato = 0UL;
+    uint32_t linea = 0UL;
+    uint32_t lineas = 0UL;
+    uint32_t ancho = 0UL;
+    uint32_t alto = 0UL;
+    uint32_t fuera = 0UL;
+
+    for (uint32_t indice = 0UL; indice < palabras; indice++)
+    {
+        uint32_t const palabra = captura[indice];
+        uint32_t const codigo = palabra >> 24U;
+
+        if (1UL == (palabra >> 30U)) /* VERTEX2F */
+        {
+            int32_t const x0 = extender(palabra >> 15U, 15U) / PRESICION;
+            int32_t const y0 = extender(palabra, 15U) / PRESICION;
+
+            for (int32_t col = 0; col < (int32_t) ancho; col++)
+            {
+                for (int32_t fila = 0; fila < (int32_t) alto; fila++)
+                {
+                    /* en 1/512 de pixel para poder sumar el medio pixel del centro */
+                    int64_t const x_s = (2 * (int64_t) col) + centro;
+                    int64_t const y_s = (2 * (int64_t) fila) + centro;
+                    int32_t const u_tex = piso((transform[0] * x_s) + (transform[1] * y_s) + (2 * (int64_t) transform[2]), 9U);
+                    int32_t const v_tex = piso((transform[3] * x_s) + (transform[4] * y_s) + (2 * (int64_t) transform[5]), 9U);
+                    uint32_t const pixeles_linea = (EVE_L1 == formato) ? (linea * 8UL) : linea;
+
+                    if ((u_tex >= 0) && (u_tex < (int32_t) pixeles_linea) && (v_tex >= 0) && (v_tex < (int32_t) lineas))
+                    {
+                        uint32_t const direccion = fuente + ((uint32_t) v_tex * linea) +
+                                                   ((EVE_L1 == formato) ? ((uint32_t) u_tex >> 3U) : (uint32_t) u_tex);
+                        uint8_t const byte = (uint8_t) (EVE_test_read32(direccion & ~3UL) >> ((direccion & 3UL) * 8U));
+                        uint8_t const prendido = (EVE_L1 == formato) ? (byte & (0x80U >> ((uint32_t) u_tex & 7U))) : byte;
+
+                        if (prendido != 0U)
+                        {
+                            fuera += prender(imagen, x0 + col, y0 + fila);
+                        }
+                    }
+                }
+            }
+        }
+        else if ((codigo >= (DL_BITMAP_TRANSFORM_A >> 24U)) && (codigo <= (DL_BITMAP_TRANSFORM_F >> 24U)))
+        {
+            transform[codigo - (DL_BITMAP_TRANSFORM_A >> 24U)] = extender(palabra, 17U);
+        }
+        else if ((DL_BITMAP_SOURCE >> 24U) == codigo)
+        {
+            fuente = palabra & 0x3fffffUL;
+        }
+        else if ((DL_BITMAP_LAYOUT >> 24U) == codigo)
+        {
+            formato = (palabra >> 19U) & 0x1fUL;
+            linea = (palabra >> 9U) & 0x3ffUL;
+            lineas = palabra & 0x1ffUL;
+        }
+        else if ((DL_BITMAP_SIZE >> 24U) == codigo)
+        {
+            ancho = (palabra >> 9U) & 0x1ffUL;
+            alto = palabra & 0x1ffUL;
+        }
+        else
+        {
+            /* el resto no cambia que pixeles se prenden */
+        }
+    }
+    return (fuera);
+}
+
+/* 70 s con todos los valores de 0 a 300, en escalones de 37 muestras para que haya columnas angostas */
+static int comparar_filas(void)
+{
+    uint32_t palabras;
+    uint32_t fuera;
+    uint32_t distintos[2] = {0UL, 0UL};
+    uint32_t prendidos = 0UL;
+    int ret = 0;
+
+    signal_modo_vertices();
+    signal_init(2000U);
+    for (uint32_t muestra = 0UL; muestra < (2000UL * SEGUNDOS); muestra++)
+    {
+        signal_push((int16_t) (((muestra / 37UL) * 13UL) % (SIGNAL_MAX + 1UL)));
+        if (0UL == (muestra & 1023UL))
+        {
+            signal_procesar();
+        }
+    }
+    signal_procesar();
+
+    memset(traza, 0, sizeof(traza));
+    palabras = capturar();
+    fuera = rasterizar_vertices(palabras);
+
+    signal_modo_bitmap(MEM_FILAS);
+    palabras = capturar();
+    for (uint8_t centro = 0U; centro < 2U; centro++)
+    {
+        memset(imagen, 0, sizeof(imagen));
+        fuera += rasterizar_bitmap(palabras, centro);
+        for (uint16_t col = 0U; col < SIGNAL_COLUMNAS; col++)
+        {
+            for (uint16_t fila = 0U; fila < FILAS; fila++)
+            {
+                distintos[centro] += (traza[col][fila] != imagen[col][fila]) ? 1UL : 0UL;
+                prendidos += imagen[col][fila];
+            }
+        }
+    }
+    signal_modo_vertices();
+
+    printf("filas del bitmap contra los vertices: %lu pixeles, %lu distintos en la esquina, %lu en el centro, %lu fuera\n",
+           (unsigned long) (prendidos / 2UL), (unsigned long) distintos[0], (unsigned long) distintos[1],
+           (unsigned long) fuera);
+    if ((0UL == prendidos) || (distintos[0] != 0UL) || (distintos[1] != 0UL) || (fuera != 0UL) ||
+        (signal_columnas_listas() != SIGNAL_COLUMNAS))
+    {
+        ret = 1;
+    }
+    return (ret);
+}
+
+int main(void)
+{
+    uint32_t vertices_ref = 0UL;
+    int ret = 0;
+
+    EVE_test_reset();
+    (void) EVE_init();
+
+    for (uint8_t indice = 0U; indice < (sizeof(frecuencias) / sizeof(frecuencias[0])); indice++)
+    {
+        uint32_t const muestras = (uint32_t) frecuencias[indice] * SEGUNDOS;
+        double tiempo;
+        uint32_t vertices;
+        uint32_t bitmap;
+
+        signal_modo_vertices();
+        signal_init(frecuencias[indice]);
+        tiempo = ahora();
+        for (uint32_t ms = 0UL; ms < (SEGUNDOS * 1000UL); ms += FRAME_MS)
+        {
+            signal_simulador(FRAME_MS);
+            signal_procesar();
+        }
+        tiempo = ahora() - tiempo;
+
+        vertices = bytes_dibujar();
+        signal_modo_bitmap(MEM_SIGNAL);
+        bitmap = bytes_dibujar();
+
+        printf("%5u muestras/s: %7.1f Mmuestras/s, %u perdidas, %u columnas, DL %lu bytes vertices, %lu bytes bitmap\n",
+               frecuencias[indice], ((double) muestras / tiempo) / 1e6, signal_perdidas(), signal_columnas_listas(),
+               (unsigned long) vertices, (unsigned long) bitmap);
+
+        if (signal_perdidas() != 0U)
+        {
+            ret = 1;
+        }
+        if ((vertices_ref != 0UL) && (vertices != vertices_ref))
+        {
+            ret = 1;
+        }
+        vertices_ref = vertices;
+    }
+
+    if (comparar_filas() != 0)
+    {
+        ret = 1;
+    }
+
+    printf("%s\n", (0 == ret) ? "PASS" : "FAIL");
+    return (ret);
+}
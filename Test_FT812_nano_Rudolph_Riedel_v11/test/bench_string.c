@@ -0,0 +1,333 @@
+/*
+@file    bench_string.c
+@brief   byte-identical check and benchmark for private_string_write() and EVE_cmd_text_packed() on the SOFTWARE_TEST emulation
+@version 1.1
+@date    2026-10-19
+@author  Christian Lara
+
+@section info
+
+The strings of EVE_cmd_text() / EVE_cmd_text_burst() are read and sent one word at a time since
+private_string_write() was reworked. This sends the same CMD_TEXT with the byte by byte writer the
+library had before, captures both with EVE_test_capture() and compares the cmd-FIFO word by word:
+- every length from 0 to 300 characters, so the cut-off at 249 / 252 characters is covered as well
+- all four alignments of the string, aligned strings take the SWAR path on little endian hosts
+- the bytes in front of and behind the string are zero or not
+- non-burst and burst mode
+- EVE_cmd_text_packed() with EVE_PACK_WORD() against EVE_cmd_text() with the same literal
+EVE_commands.c is included, the old writer goes through the same spi_transmit_burst() as the new one.
+The benchmark needs EVE_TEST_SPI_SINK, the SPI then only stores to EVE_test_sink and what is
+measured is private_string_write() against the old writer in burst mode, like on a target with DMA.
+Both go thru the spi_transmit_burst() chain of the default configuration in EVE_custom_module.h,
+the old writer thru all of it like before, the words of private_string_write() skip the state cache.
+Without the emulation there is no EVE_init() and no check, so this is a second build.
+
+Build and run from the sketch directory:
+gcc -std=c99 -O2 -Wall -Wextra -DSOFTWARE_TEST -D_POSIX_C_SOURCE=200809L -I. -o bench_string test/bench_string.c EVE_target.c && ./bench_string
+gcc -std=c99 -O2 -Wall -Wextra -DSOFTWARE_TEST -DEVE_TEST_SPI_SINK -D_POSIX_C_SOURCE=200809L -I. -o bench_sink test/bench_string.c EVE_target.c && ./bench_sink
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+1.1
+- strings of 1 to 4 characters in the benchmark, the best of 15 runs
+- bytes around the string that are zero
+- the old writer is called thru a pointer like the new one, it was inlined into the loop of the benchmark
+
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "EVE_commands.c" /* private_string_write() is static and the old writer has to use the same spi_transmit_burst() */
+
+#define MAX_LENGTH 300U
+#define CAPTURE_WORDS 128U
+#define BENCH_STRINGS 64U
+#define BENCH_ROUNDS 200000UL
+
+static uint32_t failures = 0UL;
+
+/* the byte by byte writer of private_string_write() before the rework, burst */
+static void old_string_write_burst(const char * const p_text)
+{
+    const uint8_t *const p_bytes = (const uint8_t *)p_text;
+    uint8_t exit_flag = 0U;
+
+    for (uint8_t textindex = 0U; (textindex < 249U) && (0U == exit_flag); textindex += 4U)
+    {
+        uint32_t calc = 0U;
+
+        for (uint8_t index = 0U; index < 4U; index++)
+        {
+            uint8_t const data = p_bytes[textindex + index];
+
+            if (0U == data)
+            {
+                exit_flag = 1U;
+                break;
+            }
+            calc += ((uint32_t) data) << (index * 8U);
+        }
+
+        spi_transmit_burst(calc);
+    }
+
+    if (0U == exit_flag)
+    {
+        spi_transmit_burst(0U);
+    }
+}
+
+#if !defined (EVE_TEST_SPI_SINK)
+/* the byte by byte writer of private_string_write() before the rework, non-burst */
+static void old_string_write(const char * const p_text)
+{
+    const uint8_t *const p_bytes = (const uint8_t *)p_text;
+    uint8_t textindex = 0U;
+    uint8_t padding;
+
+    while ((textindex < 249U) && (p_bytes[textindex] != 0U))
+    {
+        spi_transmit(p_bytes[textindex]);
+        textindex++;
+    }
+
+    padding = textindex & 3U;
+    padding = 4U - padding;
+
+    while (padding > 0U)
+    {
+        spi_transmit(0U);
+        padding--;
+    }
+}
+
+/* CMD_TEXT like the library did it before, non-burst */
+static void old_cmd_text(const int16_t xc0, const int16_t yc0, const uint16_t font, const uint16_t options,
+                         const char * const p_text)
+{
+    eve_begin_cmd(CMD_TEXT);
+    spi_transmit_32(i16_i16_to_u32(xc0, yc0));
+    spi_transmit_32(u16_u16_to_u32(font, options));
+    old_string_write(p_text);
+    EVE_cs_clear();
+}
+
+/* CMD_TEXT like the library did it before, inside of EVE_start_cmd_burst() / EVE_end_cmd_burst() */
+static void old_cmd_text_burst(const int16_t xc0, const int16_t yc0, const uint16_t font, const uint16_t options,
+                               const char * const p_text)
+{
+    spi_transmit_burst(CMD_TEXT);
+    spi_transmit_burst(i16_i16_to_u32(xc0, yc0));
+    spi_transmit_burst(u16_u16_to_u32(font, options));
+    old_string_write_burst(p_text);
+}
+
+static void compare(const char * const p_what, uint32_t const length, uint32_t const offset,
+                    uint32_t const * const p_old, uint32_t const old_count,
+                    uint32_t const * const p_new, uint32_t const new_count)
+{
+    if ((old_count != new_count) || (memcmp(p_old, p_new, old_count * sizeof(uint32_t)) != 0))
+    {
+        printf("FAIL: %s, %lu characters at offset %lu: %lu words before, %lu words now\n", p_what,
+               (unsigned long) length, (unsigned long) offset, (unsigned long) old_count, (unsigned long) new_count);
+        failures++;
+    }
+}
+
+static void test_identical(void)
+{
+    static uint32_t buffer[MAX_LENGTH + 8U]; /* uint32_t for the alignment */
+    char * const p_pool = (char *) buffer;
+    uint32_t old_words[CAPTURE_WORDS];
+    uint32_t new_words[CAPTURE_WORDS];
+    uint32_t checked = 0UL;
+
+    for (uint32_t length = 0UL; length <= MAX_LENGTH; length++)
+    {
+        for (uint32_t offset = 0UL; offset < 4UL; offset++)
+        {
+            char * const p_text = &p_pool[offset];
+            uint32_t old_count;
+
+            /* no zero bytes around the string or all zero */
+            memset(buffer, ((length & 1UL) != 0UL) ? 0x00 : 0x55, sizeof(buffer));
+            for (uint32_t index = 0UL; index < length; index++)
+            {
+                p_text[index] = (char) (0x21UL + ((index * 7UL) % 0x5eUL));
+            }
+            p_text[length] = 0;
+
+            EVE_test_capture(old_words, CAPTURE_WORDS);
+            old_cmd_text(10, 20, 28U, EVE_OPT_CENTERX, p_text);
+            old_count = EVE_test_captured();
+            EVE_test_capture(new_words, CAPTURE_WORDS);
+            EVE_cmd_text(10, 20, 28U, EVE_OPT_CENTERX, p_text);
+            compare("EVE_cmd_text()", length, offset, old_words, old_count, new_words, EVE_test_captured());
+
+            EVE_test_capture(old_words, CAPTURE_WORDS);
+            EVE_start_cmd_burst();
+            old_cmd_text_burst(10, 20, 28U, EVE_OPT_CENTERX, p_text);
+            EVE_end_cmd_burst();
+            old_count = EVE_test_captured();
+            EVE_test_capture(new_words, CAPTURE_WORDS);
+            EVE_start_cmd_burst();
+            EVE_cmd_text_burst(10, 20, 28U, EVE_OPT_CENTERX, p_text);
+            EVE_end_cmd_burst();
+            compare("EVE_cmd_text_burst()", length, offset, old_words, old_count, new_words, EVE_test_captured());
+            checked += 2UL;
+        }
+    }
+    EVE_test_capture(NULL, 0UL);
+    printf("%lu strings compared with the byte by byte writer\n", (unsigned long) checked);
+}
+
+#define TXT_SHORT "Hola"
+#define TXT_LONG "Ningun usuario"
+
+static void test_packed(void)
+{
+    static const uint32_t txt_short[EVE_PACKED_WORDS(TXT_SHORT)] = {EVE_PACK_WORD(TXT_SHORT, 0U),
+                                                                    EVE_PACK_WORD(TXT_SHORT, 1U)};
+    static const uint32_t txt_long[EVE_PACKED_WORDS(TXT_LONG)] = {EVE_PACK_WORD(TXT_LONG, 0U),
+                                                                  EVE_PACK_WORD(TXT_LONG, 1U),
+                                                                  EVE_PACK_WORD(TXT_LONG, 2U),
+                                                                  EVE_PACK_WORD(TXT_LONG, 3U)};
+    uint32_t old_words[CAPTURE_WORDS];
+    uint32_t new_words[CAPTURE_WORDS];
+    uint32_t old_count;
+
+    EVE_test_capture(old_words, CAPTURE_WORDS);
+    EVE_cmd_text(1, 2, 26U, 0U, TXT_SHORT);
+    EVE_cmd_text(3, 4, 27U, EVE_OPT_RIGHTX, TXT_LONG);
+    old_count = EVE_test_captured();
+    EVE_test_capture(new_words, CAPTURE_WORDS);
+    EVE_cmd_text_packed(1, 2, 26U, 0U, txt_short, EVE_PACKED_WORDS(TXT_SHORT));
+    EVE_cmd_text_packed(3, 4, 27U, EVE_OPT_RIGHTX, txt_long, EVE_PACKED_WORDS(TXT_LONG));
+    compare("EVE_cmd_text_packed()", 0UL, 0UL, old_words, old_count, new_words, EVE_test_captured());
+
+    EVE_test_capture(old_words, CAPTURE_WORDS);
+    EVE_start_cmd_burst();
+    EVE_cmd_text_burst(1, 2, 26U, 0U, TXT_SHORT);
+    EVE_cmd_text_burst(3, 4, 27U, EVE_OPT_RIGHTX, TXT_LONG);
+    EVE_end_cmd_burst();
+    old_count = EVE_test_captured();
+    EVE_test_capture(new_words, CAPTURE_WORDS);
+    EVE_start_cmd_burst();
+    EVE_cmd_text_packed_burst(1, 2, 26U, 0U, txt_short, EVE_PACKED_WORDS(TXT_SHORT));
+    EVE_cmd_text_packed_burst(3, 4, 27U, EVE_OPT_RIGHTX, txt_long, EVE_PACKED_WORDS(TXT_LONG));
+    EVE_end_cmd_burst();
+    compare("EVE_cmd_text_packed_burst()", 0UL, 0UL, old_words, old_count, new_words, EVE_test_captured());
+    EVE_test_capture(NULL, 0UL);
+}
+
+#else
+
+static double now(void)
+{
+    struct timespec stamp;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &stamp);
+    return ((double) stamp.tv_sec + ((double) stamp.tv_nsec * 1e-9));
+}
+
+static void bench(uint32_t const max_length, uint32_t const aligned)
+{
+    static uint32_t pool[BENCH_STRINGS][80];
+    const char *p_text[BENCH_STRINGS];
+    double best_old = 1e9;
+    double best_new = 1e9;
+    /* both writers are called like EVE_cmd_text_burst() calls private_string_write(), the old one is not inlined into the loop */
+    void (* volatile p_old)(const char * const) = old_string_write_burst;
+    void (* volatile p_new)(const char * const) = private_string_write;
+
+    for (uint32_t index = 0UL; index < BENCH_STRINGS; index++)
+    {
+        char * const p_string = &((char *) pool[index])[(0UL == aligned) ? (index & 3UL) : 0UL];
+        uint32_t const length = 1UL + ((index * 37UL) % max_length);
+
+        for (uint32_t pos = 0UL; pos < length; pos++)
+        {
+            p_string[pos] = (char) ('A' + ((index + pos) % 26UL));
+        }
+        p_string[length] = 0;
+        p_text[index] = p_string;
+    }
+
+    for (uint8_t repeat = 0U; repeat < 15U; repeat++)
+    {
+        double start = now();
+        double spent;
+
+        EVE_start_cmd_burst();
+        for (uint32_t round = 0UL; round < BENCH_ROUNDS; round++)
+        {
+            p_old(p_text[round % BENCH_STRINGS]);
+        }
+        EVE_end_cmd_burst();
+        spent = now() - start;
+        best_old = (spent < best_old) ? spent : best_old;
+
+        start = now();
+        EVE_start_cmd_burst();
+        for (uint32_t round = 0UL; round < BENCH_ROUNDS; round++)
+        {
+            p_new(p_text[round % BENCH_STRINGS]);
+        }
+        EVE_end_cmd_burst();
+        spent = now() - start;
+        best_new = (spent < best_new) ? spent : best_new;
+    }
+
+    printf("burst, 1 to %3lu characters, %-9s: %6.1f ns before, %6.1f ns now per string, %.2fx\n",
+           (unsigned long) max_length, (0UL == aligned) ? "any align" : "aligned", (best_old * 1e9) / BENCH_ROUNDS,
+           (best_new * 1e9) / BENCH_ROUNDS, best_old / best_new);
+}
+#endif
+
+int main(void)
+{
+#if !defined (EVE_TEST_SPI_SINK)
+    EVE_test_reset();
+    (void) EVE_init();
+    test_identical();
+    test_packed();
+    printf("%s\n", (0UL == failures) ? "PASS" : "FAIL");
+#else
+    bench(4UL, 1UL);
+    bench(4UL, 0UL);
+    bench(8UL, 1UL);
+    bench(8UL, 0UL);
+    bench(64UL, 1UL);
+    bench(64UL, 0UL);
+    bench(250UL, 1UL);
+    bench(250UL, 0UL);
+#endif
+    return ((0UL == failures) ? 0 : 1);
+}
@@ -0,0 +1,571 @@
+/*
+@file    test_batch.c
+@brief   host test for EVE_batch: 3000 random scripts drawn through the batch and with the direct commands
+@version 1.0
+@date    2026-10-19
+@author  Christian Lara
+
+@section info
+
+Every script is a random mix of EVE_batch_begin() with two primitives, color, alpha, tag, line width,
+point size, EVE_batch_independent() and vertices. The batch gets between 1 and 8 segments and between
+2 and 12 vertices so batch_overflow() has to carry strips and half pairs into the next flush, one in
+four scripts gets enough storage for everything. The same script is also sent with EVE_begin(),
+EVE_color_rgb() and so on. The words written to the cmd-FIFO are captured on the SOFTWARE_TEST
+emulation and replayed through a model of the render state that lists what is drawn: every point,
+bitmap, line, rectangle and strip segment with its vertices, color, alpha, tag and size.
+The lists have to be identical in order, except inside a run of independent draws where the batch
+may reorder, these are compared as sorted lists. Every vertex is unique, so a draw that lost its
+state, a merged BEGIN that joined two strips or a pair that was split the wrong way shows up.
+A vertex of a point, bitmap, line or rectangle has to be sent exactly once, a carried half pair
+that also stays in the flush before draws nothing but is still wrong.
+With only points and bitmaps or only whole lines and rectangles every segment can be moved, when
+these scripts set every state up front and fit the storage each group has to come out in one piece,
+this checks the rules of same_group().
+
+Build and run from the sketch directory, with and without the state cache:
+gcc -std=c99 -Wall -Wextra -DSOFTWARE_TEST -D_POSIX_C_SOURCE=200809L -I. -o test_batch test/test_batch.c EVE_batch.c EVE_commands.c EVE_target.c && ./test_batch
+gcc -std=c99 -Wall -Wextra -DSOFTWARE_TEST -DEVE_NO_STATE_CACHE -D_POSIX_C_SOURCE=200809L -I. -o test_batch_plain test/test_batch.c EVE_batch.c EVE_commands.c EVE_target.c && ./test_batch_plain
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "EVE.h"
+#include "EVE_batch.h"
+
+#define SCRIPTS 3000U
+#define OPS_MAX 250U
+#define VERTICES_MAX 400U
+#define CAPTURE_WORDS 4096U
+#define DRAWS_MAX 1024U
+#define GRID 500U /* vertex n is at (n % GRID, n / GRID) */
+
+#define OP_BEGIN 0U
+#define OP_COLOR 1U
+#define OP_ALPHA 2U
+#define OP_TAG 3U
+#define OP_WIDTH 4U
+#define OP_SIZE 5U
+#define OP_INDEPENDENT 6U
+#define OP_VERTEX 7U
+
+typedef struct
+{
+    uint8_t op;
+    uint32_t value;
+} op_t;
+
+typedef struct
+{
+    uint32_t v0;
+    uint32_t v1; /* 0xffffffff for points and bitmaps */
+    uint32_t color;
+    uint16_t size;
+    uint8_t prim;
+    uint8_t alpha;
+    uint8_t tag;
+    uint8_t run; /* 0 = in recorded order, else the run of independent draws */
+} draw_t;
+
+static uint32_t failures = 0UL;
+static uint32_t random_state = 0x9e3779b9UL;
+static op_t script[OPS_MAX];
+static uint8_t script_ops;
+static uint8_t script_prim[2U];
+static uint8_t script_movable; /* 1: only bitmaps and points, 2: only whole lines and rectangles, 3: lines and rectangles */
+static uint8_t vertex_run[VERTICES_MAX];
+static uint32_t capture[CAPTURE_WORDS];
+static draw_t draws[2][DRAWS_MAX];
+static uint16_t draw_count[2];
+static uint8_t sent[2][VERTICES_MAX]; /* how often a vertex was sent as point, bitmap, line or rectangle */
+
+static const uint8_t prims[] = {(uint8_t) EVE_BITMAPS, (uint8_t) EVE_POINTS, (uint8_t) EVE_LINES, (uint8_t) EVE_LINE_STRIP,
+                                (uint8_t) EVE_EDGE_STRIP_R, (uint8_t) EVE_EDGE_STRIP_L, (uint8_t) EVE_EDGE_STRIP_A,
+                                (uint8_t) EVE_EDGE_STRIP_B, (uint8_t) EVE_RECTS};
+
+static void check(uint8_t const condition, const char * const p_what)
+{
+    if (0U == condition)
+    {
+        printf("FAIL: %s\n", p_what);
+        failures++;
+    }
+}
+
+static uint32_t next_random(uint32_t const range)
+{
+    random_state = (random_state * 1103515245UL) + 12345UL;
+    return ((random_state >> 8U) % range);
+}
+
+/* two primitives per script and two values of every state, so that segments often share a group,
+   with a preamble every state is set before the first vertex and all segments have the same set */
+static void make_script(uint8_t const preamble)
+{
+    static const uint8_t preamble_kinds[] = {2U, 4U, 5U, 6U, 7U, 0U};
+    uint8_t independent = 0U;
+    uint8_t run = 0U;
+    uint16_t vertices = 0U;
+    uint8_t const first = (preamble != 0U) ? 0U : 5U;
+
+    script_movable = (uint8_t) next_random(4UL);
+    if (0U == script_movable)
+    {
+        script_prim[0U] = prims[next_random(sizeof(prims))];
+        script_prim[1U] = prims[next_random(sizeof(prims))];
+    }
+    else if (1U == script_movable)
+    {
+        script_prim[0U] = (0UL == next_random(2UL)) ? (uint8_t) EVE_BITMAPS : (uint8_t) EVE_POINTS;
+        script_prim[1U] = (0UL == next_random(2UL)) ? (uint8_t) EVE_BITMAPS : (uint8_t) EVE_POINTS;
+    }
+    else /* 2 and 3 */
+    {
+        script_prim[0U] = (0UL == next_random(2UL)) ? (uint8_t) EVE_LINES : (uint8_t) EVE_RECTS;
+        script_prim[1U] = (0UL == next_random(2UL)) ? (uint8_t) EVE_LINES : (uint8_t) EVE_RECTS;
+    }
+    script_ops = (uint8_t) (8U + next_random(OPS_MAX - 8U));
+    for (uint8_t index = 0U; index < script_ops; index++)
+    {
+        uint32_t const kind = (index < (6U - first)) ? preamble_kinds[first + index] : next_random(20UL);
+        op_t * const p_op = &script[index];
+
+        if (kind < 2UL)
+        {
+            p_op->op = OP_BEGIN;
+            p_op->value = (index < (6U - first)) ? script_prim[0U] : script_prim[next_random(2UL)];
+        }
+        else if (kind < 4UL)
+        {
+            p_op->op = OP_COLOR;
+            p_op->value = (0UL == next_random(2UL)) ? 0x000000ffUL : 0x00ff0000UL;
+        }
+        else if (kind < 5UL)
+        {
+            p_op->op = OP_ALPHA;
+            p_op->value = (0UL == next_random(2UL)) ? 128UL : 255UL;
+        }
+        else if (kind < 6UL)
+        {
+            p_op->op = OP_TAG;
+            p_op->value = 1UL + next_random(2UL);
+        }
+        else if (kind < 7UL)
+        {
+            p_op->op = OP_WIDTH;
+            p_op->value = (0UL == next_random(2UL)) ? 16UL : 32UL;
+        }
+        else if (kind < 8UL)
+        {
+            p_op->op = OP_SIZE;
+            p_op->value = (0UL == next_random(2UL)) ? 16UL : 40UL;
+        }
+        else if (kind < 9UL)
+        {
+            p_op->op = OP_INDEPENDENT;
+            p_op->value = next_random(2UL);
+            if ((p_op->value != 0UL) && (0U == independent))
+            {
+                run++;
+            }
+            independent = (uint8_t) p_op->value;
+        }
+        else
+        {
+            p_op->op = OP_VERTEX;
+            p_op->value = vertices;
+            vertex_run[vertices] = (independent != 0U) ? run : 0U;
+            vertices++;
+            if (2U == script_movable) /* lines and rectangles only in whole pairs */
+            {
+                if ((index + 1U) < script_ops)
+                {
+                    index++;
+                    script[index].op = OP_VERTEX;
+                    script[index].value = vertices;
+                    vertex_run[vertices] = vertex_run[vertices - 1U];
+                    vertices++;
+                }
+                else
+                {
+                    p_op->op = OP_INDEPENDENT; /* no room for the second vertex, changes nothing */
+                    p_op->value = independent;
+                    vertices--;
+                }
+            }
+        }
+    }
+}
+
+static uint32_t vertex_command(uint8_t const prim, uint32_t const number)
+{
+    uint32_t ret;
+
+    if ((uint8_t) EVE_BITMAPS == prim)
+    {
+        ret = VERTEX2II(number % GRID, number / GRID, 0U, 0U);
+    }
+    else
+    {
+        ret = VERTEX2F((int16_t) (number % GRID), (int16_t) (number / GRID));
+    }
+    return (ret);
+}
+
+static uint32_t vertex_number(uint32_t const command)
+{
+    uint32_t ret;
+
+    if (2UL == (command >> 30U)) /* VERTEX2II */
+    {
+        ret = (((command >> 12U) & 0x1ffUL) * GRID) + ((command >> 21U) & 0x1ffUL);
+    }
+    else
+    {
+        ret = ((command & 0x7fffUL) * GRID) + ((command >> 15U) & 0x7fffUL);
+    }
+    return (ret);
+}
+
+static void run_script_direct(void)
+{
+    uint8_t prim = (uint8_t) EVE_POINTS;
+
+    for (uint8_t index = 0U; index < script_ops; index++)
+    {
+        uint32_t const value = script[index].value;
+
+        switch (script[index].op)
+        {
+            case OP_BEGIN:
+                prim = (uint8_t) value;
+                EVE_begin(value);
+                break;
+            case OP_COLOR:
+                EVE_color_rgb(value);
+                break;
+            case OP_ALPHA:
+                EVE_color_a((uint8_t) value);
+                break;
+            case OP_TAG:
+                EVE_tag((uint8_t) value);
+                break;
+            case OP_WIDTH:
+                EVE_line_width((uint16_t) value);
+                break;
+            case OP_SIZE:
+                EVE_point_size((uint16_t) value);
+                break;
+            case OP_VERTEX:
+                EVE_cmd_dl(vertex_command(prim, value));
+                break;
+            default:
+                break;
+        }
+    }
+    EVE_end();
+}
+
+static uint16_t run_script_batch(uint16_t const segments_max, uint16_t const vertices_max)
+{
+    EVE_batch_t batch;
+    EVE_batch_segment_t segments[OPS_MAX];
+    uint32_t vertices[VERTICES_MAX];
+    uint8_t prim = (uint8_t) EVE_POINTS;
+
+    EVE_batch_init(&batch, segments, segments_max, vertices, vertices_max);
+    for (uint8_t index = 0U; index < script_ops; index++)
+    {
+        uint32_t const value = script[index].value;
+
+        switch (script[index].op)
+        {
+            case OP_BEGIN:
+                prim = (uint8_t) value;
+                EVE_batch_begin(&batch, value);
+                break;
+            case OP_COLOR:
+                EVE_batch_color_rgb(&batch, value);
+                break;
+            case OP_ALPHA:
+                EVE_batch_color_a(&batch, (uint8_t) value);
+                break;
+            case OP_TAG:
+                EVE_batch_tag(&batch, (uint8_t) value);
+                break;
+            case OP_WIDTH:
+                EVE_batch_line_width(&batch, (uint16_t) value);
+                break;
+            case OP_SIZE:
+                EVE_batch_point_size(&batch, (uint16_t) value);
+                break;
+            case OP_INDEPENDENT:
+                EVE_batch_independent(&batch, (uint8_t) value);
+                break;
+            case OP_VERTEX:
+                if ((uint8_t) EVE_BITMAPS == prim)
+                {
+                    EVE_batch_vertex2ii(&batch, (uint16_t) (value % GRID), (uint16_t) (value / GRID), 0U, 0U);
+                }
+                else
+                {
+                    EVE_batch_vertex2f(&batch, (int16_t) (value % GRID), (int16_t) (value / GRID));
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return (EVE_batch_flush(&batch));
+}
+
+/* replay the display-list words through the render state, every draw goes to draws[list] */
+static void model(uint32_t const words, uint8_t const list)
+{
+    uint8_t prim = 0U;
+    uint8_t begun = 0U;
+    uint8_t have_previous = 0U;
+    uint32_t previous = 0UL;
+    uint32_t color = 0x00ffffffUL; /* the values after CMD_DLSTART */
+    uint8_t alpha = 255U;
+    uint8_t tag = 255U;
+    uint16_t line_width = 16U;
+    uint16_t point_size = 16U;
+
+    draw_count[list] = 0U;
+    (void) memset(sent[list], 0, VERTICES_MAX);
+    for (uint32_t index = 0UL; index < words; index++)
+    {
+        uint32_t const word = capture[index];
+        uint32_t const code = word >> 24U;
+
+        if ((1UL == (word >> 30U)) || (2UL == (word >> 30U))) /* VERTEX2F, VERTEX2II */
+        {
+            uint8_t const single = (((uint8_t) EVE_BITMAPS == prim) || ((uint8_t) EVE_POINTS == prim)) ? 1U : 0U;
+            uint8_t const strip = ((prim >= (uint8_t) EVE_LINE_STRIP) && (prim <= (uint8_t) EVE_EDGE_STRIP_B)) ? 1U : 0U;
+
+            check(begun, "no vertex without BEGIN");
+            if (0U == strip)
+            {
+                sent[list][vertex_number(word)]++;
+            }
+            if ((single != 0U) || (have_previous != 0U))
+            {
+                draw_t * const p_draw = &draws[list][draw_count[list]];
+
+                p_draw->prim = prim;
+                p_draw->v0 = (single != 0U) ? word : previous;
+                p_draw->v1 = (single != 0U) ? 0xffffffffUL : word;
+                p_draw->color = color;
+                p_draw->alpha = alpha;
+                p_draw->tag = tag;
+                p_draw->size = ((uint8_t) EVE_POINTS == prim) ? point_size :
+                               ((((uint8_t) EVE_LINES == prim) || ((uint8_t) EVE_LINE_STRIP == prim) ||
+                                 ((uint8_t) EVE_RECTS == prim)) ? line_width : 0U);
+                p_draw->run = vertex_run[vertex_number(word)];
+                if (draw_count[list] < (DRAWS_MAX - 1U))
+                {
+                    draw_count[list]++;
+                }
+                have_previous = strip; /* a strip goes on from this vertex, a pair is complete */
+            }
+            else
+            {
+                have_previous = 1U;
+            }
+            previous = word;
+        }
+        else if ((DL_BEGIN >> 24U) == code)
+        {
+            prim = (uint8_t) (word & 0x0fUL);
+            begun = 1U;
+            have_previous = 0U;
+        }
+        else if ((DL_END >> 24U) == code)
+        {
+            begun = 0U;
+            have_previous = 0U;
+        }
+        else if ((DL_COLOR_RGB >> 24U) == code)
+        {
+            color = word & 0x00ffffffUL;
+        }
+        else if ((DL_COLOR_A >> 24U) == code)
+        {
+            alpha = (uint8_t) word;
+        }
+        else if ((DL_TAG >> 24U) == code)
+        {
+            tag = (uint8_t) word;
+        }
+        else if ((DL_LINE_WIDTH >> 24U) == code)
+        {
+            line_width = (uint16_t) (word & 0x0fffUL);
+        }
+        else if ((DL_POINT_SIZE >> 24U) == code)
+        {
+            point_size = (uint16_t) (word & 0x1fffUL);
+        }
+        else
+        {
+            /* CMD_DLSTART */
+        }
+    }
+}
+
+static int compare_draws(const void *p_a, const void *p_b)
+{
+    return (memcmp(p_a, p_b, sizeof(draw_t)));
+}
+
+static uint8_t same_group(const draw_t * const p_a, const draw_t * const p_b)
+{
+    return (((p_a->prim == p_b->prim) && (p_a->color == p_b->color) && (p_a->alpha == p_b->alpha) &&
+             (p_a->tag == p_b->tag) && (p_a->size == p_b->size)) ? 1U : 0U);
+}
+
+/* in a run of independent draws no group comes back after an other group started */
+static uint8_t grouped(void)
+{
+    uint8_t ret = 1U;
+
+    for (uint16_t index = 1U; index < draw_count[1U]; index++)
+    {
+        const draw_t * const p_draw = &draws[1U][index];
+
+        if ((p_draw->run != 0U) && (0U == same_group(p_draw, &draws[1U][index - 1U])))
+        {
+            for (uint16_t search = 0U; search < (index - 1U); search++)
+            {
+                if ((draws[1U][search].run == p_draw->run) && (same_group(&draws[1U][search], p_draw) != 0U))
+                {
+                    ret = 0U;
+                }
+            }
+        }
+    }
+    return (ret);
+}
+
+/* identical in order, a run of independent draws is compared sorted */
+static uint8_t same_picture(void)
+{
+    uint16_t index = 0U;
+    uint8_t ret = (draw_count[0U] == draw_count[1U]) ? 1U : 0U;
+
+    while ((0U != ret) && (index < draw_count[0U]))
+    {
+        uint16_t end = (uint16_t) (index + 1U);
+        uint8_t const run = draws[0U][index].run;
+
+        if (run != 0U)
+        {
+            while ((end < draw_count[0U]) && (run == draws[0U][end].run))
+            {
+                end++;
+            }
+            qsort(&draws[0U][index], (size_t) (end - index), sizeof(draw_t), compare_draws);
+            qsort(&draws[1U][index], (size_t) (end - index), sizeof(draw_t), compare_draws);
+        }
+        if (memcmp(&draws[0U][index], &draws[1U][index], (size_t) (end - index) * sizeof(draw_t)) != 0)
+        {
+            ret = 0U;
+        }
+        index = end;
+    }
+    return (ret);
+}
+
+static void test_batch_random(void)
+{
+    uint32_t direct_words = 0UL;
+    uint32_t batch_words = 0UL;
+    uint32_t grouped_scripts = 0UL;
+
+    EVE_test_reset();
+    (void) EVE_init();
+
+    for (uint16_t count = 0U; count < SCRIPTS; count++)
+    {
+        uint8_t const roomy = (0U == (count & 3U)) ? 1U : 0U;
+        uint16_t const segments_max = (roomy != 0U) ? OPS_MAX : (uint16_t) (1U + next_random(8UL));
+        uint16_t const vertices_max = (roomy != 0U) ? VERTICES_MAX : (uint16_t) (2U + next_random(11UL));
+        uint32_t words;
+
+        (void) memset(draws, 0, sizeof(draws)); /* the padding of draw_t is compared too */
+        uint8_t const preamble = (uint8_t) next_random(2UL);
+
+        make_script(preamble);
+
+        EVE_test_capture(capture, CAPTURE_WORDS);
+        EVE_cmd_dl(CMD_DLSTART);
+        run_script_direct();
+        words = EVE_test_captured();
+        EVE_test_capture(NULL, 0UL);
+        model(words, 0U);
+        direct_words += words;
+
+        EVE_test_capture(capture, CAPTURE_WORDS);
+        EVE_cmd_dl(CMD_DLSTART);
+        (void) run_script_batch(segments_max, vertices_max);
+        words = EVE_test_captured();
+        EVE_test_capture(NULL, 0UL);
+        model(words, 1U);
+        batch_words += words;
+
+        check((0 == memcmp(sent[0U], sent[1U], VERTICES_MAX)) ? 1U : 0U,
+              "every point, bitmap, line and rectangle vertex is sent once");
+        /* every segment can be moved, so every run is one span that has to come out grouped */
+        if ((roomy != 0U) && (preamble != 0U) && ((1U == script_movable) || (2U == script_movable)))
+        {
+            check(grouped(), "the batch groups a run of independent draws by state");
+            grouped_scripts++;
+        }
+
+        if (0U == same_picture())
+        {
+            printf("script %u: %u draws direct, %u with the batch of %u segments and %u vertices\n", count,
+                   draw_count[0U], draw_count[1U], segments_max, vertices_max);
+            check(0U, "the batch draws the same as the direct commands");
+        }
+    }
+    printf("%u scripts: %lu words direct, %lu words with the batch, %lu checked for grouping\n", (unsigned) SCRIPTS,
+           (unsigned long) direct_words, (unsigned long) batch_words, (unsigned long) grouped_scripts);
+}
+
+int main(void)
+{
+    test_batch_random();
+    printf("%s\n", (0UL == failures) ? "PASS" : "FAIL");
+    return ((0UL == failures) ? 0 : 1);
+}
@@ -0,0 +1,204 @@
+/*
+@file    test_canales.c
+@brief   prueba de canales_presupuesto(): las trazas de los seis canales caben en los 8 kB de RAM_DL
+@version 1.0
+@date    2026-10-19
+@author  Christian Lara
+
+@section info
+
+Corre sobre la emulacion de SOFTWARE_TEST, el simulador llena 70 s de columnas (280 columnas cerradas,
+las ultimas 240 en la grafica). Para cada parte fija del frame, de 600 bytes hasta mas alla del limite,
+escribe en REG_CMD_DL lo que midio el frame anterior (parte fija + trazas del plan) y llama
+canales_presupuesto() tres veces para que el plan llegue a la medicion. Despues captura lo que manda
+canales_dibujar() y cuenta los vertices de cada canal.
+Falla si los vertices de un canal no son los de su LOD, si los bytes de las trazas no son los del plan,
+si parte fija + trazas pasa de EVE_RAM_DL_SIZE - CANAL_DL_RESERVA o si algun canal todavia cabia con
+un LOD un paso mas fino.
+
+Compilar y correr desde el directorio del sketch:
+gcc -std=c99 -Wall -Wextra -DSOFTWARE_TEST -D_POSIX_C_SOURCE=200809L -I. -o test_canales test/test_canales.c TFTcanales.c EVE_commands.c EVE_target.c && ./test_canales
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- version inicial
+
+*/
+
+#include <stdio.h>
+#include "EVE.h"
+#include "TFTcanales.h"
+
+#define FRAME_MS 16U
+#define SEGUNDOS 70UL
+#define COL_TOTAL ((SEGUNDOS * CANAL_COLUMNAS) / CANAL_VENTANA_S) /* columnas cerradas en SEGUNDOS */
+#define COL_PRIMERA (COL_TOTAL - CANAL_COLUMNAS) /* la mas vieja en la grafica */
+#define CAPTURA 4096U
+#define LIMITE (EVE_RAM_DL_SIZE - CANAL_DL_RESERVA)
+
+static const uint16_t fijos[] = {600U, 1500U, 3000U, 5000U, 6500U, 7200U, 7600U, 7800U, 7900U, 7950U, 8000U, 8050U, 8100U};
+
+static uint32_t captura[CAPTURA];
+
+/* vertices de una traza con el LOD, dos por grupo de 2^lod columnas alineado con la columna absoluta */
+static uint32_t vertices_lod(uint8_t const lod)
+{
+    return (2UL * (((COL_TOTAL - 1UL) >> lod) - (COL_PRIMERA >> lod) + 1UL));
+}
+
+/* bytes de una traza con el LOD, como costo() en TFTcanales.c */
+static uint32_t costo_lod(uint8_t const lod)
+{
+    return (CANAL_DL_POR_CANAL + (4UL * vertices_lod(lod)));
+}
+
+/* cuenta los vertices de cada traza entre BEGIN y END, regresa los bytes de las trazas con su COLOR_RGB */
+static uint32_t contar(uint32_t const palabras, uint32_t p_vertices[CANALES], uint8_t *p_trazas)
+{
+    uint32_t bytes = 0UL;
+    uint8_t traza = 0U;
+    uint8_t dentro = 0U;
+
+    for (uint8_t canal = 0U; canal < CANALES; canal++)
+    {
+        p_vertices[canal] = 0UL;
+    }
+    for (uint32_t indice = 0UL; indice < palabras; indice++)
+    {
+        uint32_t const palabra = captura[indice];
+
+        if ((DL_BEGIN >> 24U) == (palabra >> 24U))
+        {
+            dentro = 1U;
+            bytes += ((indice > 0UL) && ((DL_COLOR_RGB >> 24U) == (captura[indice - 1UL] >> 24U))) ? 8UL : 4UL;
+        }
+        else if (0U == dentro)
+        {
+            /* el numero del panel y el estado son parte fija */
+        }
+        else if ((DL_END >> 24U) == (palabra >> 24U))
+        {
+            dentro = 0U;
+            bytes += 4UL;
+            traza++;
+        }
+        else
+        {
+            if ((1UL == (palabra >> 30U)) && (traza < CANALES)) /* VERTEX2F */
+            {
+                p_vertices[traza]++;
+            }
+            bytes += 4UL;
+        }
+    }
+    *p_trazas = traza;
+    return (bytes);
+}
+
+int main(void)
+{
+    int ret = 0;
+
+    EVE_test_reset();
+    (void) EVE_init();
+    canales_init();
+    for (uint32_t ms = 0UL; ms < (SEGUNDOS * 1000UL); ms += FRAME_MS)
+    {
+        canales_simulador(FRAME_MS);
+        canales_tick(FRAME_MS);
+    }
+
+    for (uint8_t indice = 0U; indice < (sizeof(fijos) / sizeof(fijos[0])); indice++)
+    {
+        uint32_t vertices[CANALES];
+        uint32_t palabras;
+        uint32_t trazas;
+        uint8_t dibujadas;
+        uint8_t esperadas = 0U;
+        uint32_t const disponible = (fijos[indice] < LIMITE) ? (LIMITE - fijos[indice]) : 0UL;
+        int error = 0;
+
+        canales_vista_nueva();
+        for (uint8_t vuelta = 0U; vuelta < 3U; vuelta++) /* el plan llega a la parte fija medida */
+        {
+            EVE_test_write32(REG_CMD_DL, (uint32_t) fijos[indice] + canales_dl_trazas());
+            canales_presupuesto();
+        }
+
+        EVE_test_capture(captura, CAPTURA);
+        EVE_start_cmd_burst();
+        canales_dibujar();
+        EVE_end_cmd_burst();
+        palabras = EVE_test_captured();
+        EVE_test_capture(NULL, 0UL);
+        trazas = contar(palabras, vertices, &dibujadas);
+
+        printf("parte fija %4u: LOD", fijos[indice]);
+        for (uint8_t canal = 0U; canal < CANALES; canal++)
+        {
+            uint8_t const lod = canales_lod(canal);
+            uint32_t const actual = (CANAL_LOD_NADA == lod) ? 0UL : costo_lod(lod);
+            uint8_t const fino = (CANAL_LOD_NADA == lod) ? (uint8_t) CANAL_LOD_MAX : (uint8_t) (lod - 1U);
+
+            /* el plan no deja bytes que alcancen para bajar un canal un paso */
+            if ((lod != 0U) && ((trazas - actual + costo_lod(fino)) <= disponible))
+            {
+                error = 1;
+            }
+            if (CANAL_LOD_NADA == lod)
+            {
+                printf("  -");
+            }
+            else
+            {
+                printf(" %2u", lod);
+                if ((esperadas >= CANALES) || (vertices[esperadas] != vertices_lod(lod))) /* las trazas van en orden */
+                {
+                    error = 1;
+                }
+                esperadas++;
+            }
+        }
+        if ((dibujadas != esperadas) || (trazas != canales_dl_trazas()))
+        {
+            error = 1;
+        }
+        if ((trazas > 0UL) && (((uint32_t) fijos[indice] + trazas) > LIMITE))
+        {
+            error = 1;
+        }
+        printf("  trazas %4lu bytes (plan %4u), DL %4lu de %u%s\n", (unsigned long) trazas, canales_dl_trazas(),
+               (unsigned long) (fijos[indice] + trazas), (unsigned) LIMITE, (0 == error) ? "" : "  ERROR");
+        if (error != 0)
+        {
+            ret = 1;
+        }
+    }
+
+    printf("%s\n", (0 == ret) ? "PASS" : "FAIL");
+    return (ret);
+}
@@ -0,0 +1,247 @@
+/*
+@file    test_frame.c
+@brief   host test for EVE_frame: SPI transfers that EVE_frame_ready() needs per frame on the SOFTWARE_TEST emulation
+@version 1.1
+@date    2026-10-19
+@author  Christian Lara
+
+@section info
+
+The emulation runs a VSYNC every EVE_frame_period_us() on its virtual clock and drains the cmd-FIFO
+at a fixed rate, the loop polls EVE_frame_ready() every LOOP_US like the sketch does and builds a
+frame whenever it returns E_OK. The test fails if a VSYNC passes without a new frame or if the
+polls need more than MAX_READY_TRANSFERS SPI transfers per frame.
+
+EVE_start_dl_burst() / EVE_end_dl_burst() write RAM_DL directly: a list that is longer than RAM_DL
+has to return E_NOT_OK without a swap and without touching the registers behind RAM_DL, a list
+that fills RAM_DL exactly is fine. With EVE_DLSWAP_DONE EVE_end_dl_burst() leaves REG_DLSWAP alone,
+the loop runs with EVE_DLSWAP_LINE where EVE_frame_ready() issues the swap and a new list may only
+be written to RAM_DL after the swap of the previous one is done.
+
+Build and run from the sketch directory:
+gcc -std=c99 -Wall -Wextra -DSOFTWARE_TEST -D_POSIX_C_SOURCE=200809L -I. -o test_frame test/test_frame.c EVE_frame.c EVE_commands.c EVE_target.c && ./test_frame
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+1.1
+- added the overflow of EVE_start_dl_burst() / EVE_end_dl_burst() and the loop with EVE_DLSWAP_DONE
+
+*/
+
+#include <stdio.h>
+#include "EVE.h"
+#include "EVE_frame.h"
+
+#define RUN_US 2000000UL /* two seconds on the virtual clock */
+#define LOOP_US 20U /* rest of loop() between two polls */
+#define FRAME_COMMANDS 400U /* display-list commands per frame */
+#define MAX_READY_TRANSFERS 12UL
+#define DL_WORDS (EVE_RAM_DL_SIZE / 4U)
+#define REG_WORDS 64U /* registers right behind RAM_DL that an overflow would hit first */
+
+static uint32_t failures = 0UL;
+
+static void check(uint8_t const condition, const char * const p_what)
+{
+    if (0U == condition)
+    {
+        printf("FAIL: %s\n", p_what);
+        failures++;
+    }
+}
+
+static void setup(void)
+{
+    EVE_test_reset();
+    EVE_test_write32(REG_HCYCLE, 928UL);
+    EVE_test_write32(REG_VCYCLE, 525UL);
+    EVE_test_write32(REG_PCLK, 2UL);
+    EVE_test_write32(REG_FREQUENCY, 60000000UL);
+    EVE_test_set_drain(2000UL, 125UL); /* a frame keeps the co-processor busy for about 0.8 ms */
+}
+
+static void build_frame(void)
+{
+    EVE_start_cmd_burst();
+    EVE_cmd_dl_burst(CMD_DLSTART);
+    EVE_cmd_dl_burst(DL_CLEAR | CLR_COL | CLR_STN | CLR_TAG);
+    for (uint16_t index = 0U; index < FRAME_COMMANDS; index++)
+    {
+        EVE_cmd_dl_burst(DL_COLOR_RGB | index);
+    }
+    EVE_cmd_dl_burst(DL_DISPLAY);
+    EVE_cmd_dl_burst(CMD_SWAP);
+    EVE_end_cmd_burst();
+    EVE_test_write32(REG_DLSWAP, EVE_DLSWAP_FRAME); /* the emulation does not decode CMD_SWAP */
+}
+
+static void test_frame_loop(void)
+{
+    uint32_t start_us;
+    uint32_t start_frames;
+    uint32_t ready_transfers = 0UL;
+    uint32_t polls = 0UL;
+    uint32_t built = 0UL;
+    uint32_t vsyncs;
+
+    setup();
+    EVE_frame_init(EVE_DLSWAP_FRAME, 1U);
+    EVE_test_set_frame(EVE_frame_period_us());
+    start_us = EVE_test_time_us();
+    start_frames = EVE_test_read32(REG_FRAMES);
+
+    while ((EVE_test_time_us() - start_us) < RUN_US)
+    {
+        uint32_t const before = EVE_test_transactions();
+        uint8_t const ready = EVE_frame_ready();
+
+        ready_transfers += EVE_test_transactions() - before;
+        polls++;
+        if (E_OK == ready)
+        {
+            build_frame();
+            EVE_frame_submit();
+            built++;
+        }
+        EVE_test_delay_us(LOOP_US);
+    }
+
+    vsyncs = EVE_test_read32(REG_FRAMES) - start_frames;
+    printf("frame period %lu us, %lu VSYNCs, %lu frames built, %lu polls\n", (unsigned long) EVE_frame_period_us(),
+           (unsigned long) vsyncs, (unsigned long) built, (unsigned long) polls);
+    printf("SPI transfers in EVE_frame_ready(): %lu, %lu per frame\n", (unsigned long) ready_transfers,
+           (unsigned long) (ready_transfers / ((built > 0UL) ? built : 1UL)));
+
+    if ((built + 1UL) < vsyncs)
+    {
+        printf("FAIL: %lu VSYNCs without a new frame\n", (unsigned long) (vsyncs - built));
+        failures++;
+    }
+    if ((ready_transfers / ((built > 0UL) ? built : 1UL)) > MAX_READY_TRANSFERS)
+    {
+        printf("FAIL: more than %lu SPI transfers per frame\n", (unsigned long) MAX_READY_TRANSFERS);
+        failures++;
+    }
+}
+
+/* a list of that many commands written directly to RAM_DL, every word is different */
+static uint8_t write_dl(uint32_t const words, uint8_t const swap)
+{
+    EVE_start_dl_burst();
+    for (uint32_t index = 0UL; index < words; index++)
+    {
+        EVE_cmd_dl_burst(DL_COLOR_RGB | index);
+    }
+    return (EVE_end_dl_burst(swap));
+}
+
+static void test_dl_overflow(void)
+{
+    uint32_t registers[REG_WORDS];
+    uint32_t transfers;
+    uint32_t transfers_done;
+    uint8_t same = 1U;
+
+    setup();
+    for (uint32_t index = 0UL; index < REG_WORDS; index++)
+    {
+        registers[index] = EVE_test_read32(EVE_RAM_REG + (index * 4UL));
+    }
+
+    check((E_NOT_OK == write_dl(DL_WORDS + 100UL, EVE_DLSWAP_FRAME)) ? 1U : 0U, "a list longer than RAM_DL returns E_NOT_OK");
+    check((EVE_DLSWAP_DONE == EVE_test_read32(REG_DLSWAP)) ? 1U : 0U, "a list that did not fit is not swapped");
+    check(((DL_COLOR_RGB | (DL_WORDS - 1UL)) == EVE_test_read32(EVE_RAM_DL + ((DL_WORDS - 1UL) * 4UL))) ? 1U : 0U,
+          "RAM_DL is written up to its end");
+    for (uint32_t index = 0UL; index < REG_WORDS; index++)
+    {
+        if (registers[index] != EVE_test_read32(EVE_RAM_REG + (index * 4UL)))
+        {
+            same = 0U;
+        }
+    }
+    check(same, "the registers behind RAM_DL are not written");
+
+    transfers = EVE_test_transactions();
+    check((E_OK == write_dl(DL_WORDS, EVE_DLSWAP_FRAME)) ? 1U : 0U, "a list that fills RAM_DL returns E_OK");
+    transfers = EVE_test_transactions() - transfers;
+    check((EVE_DLSWAP_FRAME == EVE_test_read32(REG_DLSWAP)) ? 1U : 0U, "the list that fits is swapped");
+
+    EVE_test_write32(REG_DLSWAP, EVE_DLSWAP_DONE);
+    transfers_done = EVE_test_transactions();
+    check((E_OK == write_dl(FRAME_COMMANDS, EVE_DLSWAP_DONE)) ? 1U : 0U, "a short list returns E_OK");
+    transfers_done = EVE_test_transactions() - transfers_done;
+    check(((transfers_done + 1UL) == transfers) ? 1U : 0U, "EVE_DLSWAP_DONE saves the transfer to REG_DLSWAP");
+}
+
+/* EVE_DLSWAP_LINE with EVE_DLSWAP_DONE for EVE_end_dl_burst(), EVE_frame_ready() writes REG_DLSWAP */
+static void test_dl_swap_done(void)
+{
+    uint32_t start_us;
+    uint32_t start_frames;
+    uint32_t built = 0UL;
+    uint32_t early = 0UL;
+    uint32_t vsyncs;
+
+    setup();
+    EVE_frame_init(EVE_DLSWAP_LINE, 1U);
+    EVE_test_set_frame(EVE_frame_period_us());
+    start_us = EVE_test_time_us();
+    start_frames = EVE_test_read32(REG_FRAMES);
+
+    while ((EVE_test_time_us() - start_us) < (RUN_US / 4UL))
+    {
+        if (E_OK == EVE_frame_ready())
+        {
+            if (EVE_test_read32(REG_DLSWAP) != EVE_DLSWAP_DONE)
+            {
+                early++; /* RAM_DL is still the list that is shown */
+            }
+            check((E_OK == write_dl(FRAME_COMMANDS, EVE_DLSWAP_DONE)) ? 1U : 0U, "the list fits");
+            check((EVE_DLSWAP_DONE == EVE_test_read32(REG_DLSWAP)) ? 1U : 0U, "EVE_DLSWAP_DONE does not write REG_DLSWAP");
+            EVE_frame_submit();
+            built++;
+        }
+        EVE_test_delay_us(LOOP_US);
+    }
+
+    vsyncs = EVE_test_read32(REG_FRAMES) - start_frames;
+    printf("EVE_DLSWAP_LINE with direct lists: %lu VSYNCs, %lu frames built\n", (unsigned long) vsyncs, (unsigned long) built);
+    check((0UL == early) ? 1U : 0U, "a list is only written after the previous swap is done");
+    check(((built + 1UL) >= vsyncs) ? 1U : 0U, "a new frame for every VSYNC");
+    check(((EVE_frame_swap_count() + 1UL) >= EVE_frame_submit_count()) ? 1U : 0U, "every frame but the last was swapped");
+}
+
+int main(void)
+{
+    test_frame_loop();
+    test_dl_overflow();
+    test_dl_swap_done();
+    printf("%s\n", (0UL == failures) ? "PASS" : "FAIL");
+    return ((0UL == failures) ? 0 : 1);
+}
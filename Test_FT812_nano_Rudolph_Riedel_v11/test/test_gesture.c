@@ -0,0 +1,231 @@
+/*
+@file    test_gesture.c
+@brief   host test for the gesture recognizer of EVE_gesture on the SOFTWARE_TEST emulation
+@version 1.0
+@date    2026-10-19
+@author  Christian Lara
+
+@section info
+
+The samples are read by EVE_gesture_capture() from the emulated touch registers:
+- swipes in all four directions, a tap, a swipe that is too slow or too short
+- a long press reports the tag it started on, moving more than EVE_GESTURE_SLOP is no long press
+- with EVE_MULTI_TOUCH: the mapping of the five touch points and the 8.8 scale of a pinch
+
+Build and run from the sketch directory, once with and once without EVE_MULTI_TOUCH:
+gcc -std=c99 -Wall -Wextra -DSOFTWARE_TEST -D_POSIX_C_SOURCE=200809L -I. -o test_gesture test/test_gesture.c EVE_gesture.c EVE_commands.c EVE_target.c && ./test_gesture
+gcc -std=c99 -Wall -Wextra -DSOFTWARE_TEST -DEVE_MULTI_TOUCH -D_POSIX_C_SOURCE=200809L -I. -o test_multi test/test_gesture.c EVE_gesture.c EVE_commands.c EVE_target.c && ./test_multi
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#include <stdio.h>
+#include "EVE.h"
+#include "EVE_touch.h"
+#include "EVE_gesture.h"
+
+#define FRAME_MS 16U
+
+static uint32_t failures = 0UL;
+
+static void check(uint8_t const condition, const char * const p_what)
+{
+    if (0U == condition)
+    {
+        printf("FAIL: %s\n", p_what);
+        failures++;
+    }
+}
+
+#if !defined (EVE_MULTI_TOUCH)
+/* one frame of the recognizer, xc0 = EVE_TOUCH_NONE releases */
+static uint8_t sample(int16_t const xc0, int16_t const yc0, uint8_t const tag, EVE_gesture_t * const p_gesture)
+{
+    EVE_touch_points_t points;
+
+    if (EVE_TOUCH_NONE == xc0)
+    {
+        EVE_test_release();
+    }
+    else
+    {
+        EVE_test_touch(xc0, yc0, tag);
+    }
+    (void) EVE_gesture_capture(&points);
+    return (EVE_gesture_update(&points, FRAME_MS, p_gesture));
+}
+
+/* a straight line from (x0, y0) by (dx, dy) in the given number of frames, returns the gesture of the release */
+static uint8_t stroke(int16_t const x0, int16_t const y0, int16_t const dx, int16_t const dy, uint8_t const frames,
+                      EVE_gesture_t * const p_gesture)
+{
+    uint8_t ret = EVE_GESTURE_NONE;
+
+    for (uint8_t frame = 0U; frame <= frames; frame++)
+    {
+        uint8_t const type = sample((int16_t) (x0 + ((dx * frame) / frames)), (int16_t) (y0 + ((dy * frame) / frames)),
+                                    0U, p_gesture);
+
+        check(EVE_GESTURE_NONE == type, "nothing is reported before the release of a stroke");
+    }
+    ret = sample(EVE_TOUCH_NONE, EVE_TOUCH_NONE, 0U, p_gesture);
+    check(0U == EVE_gesture_active(), "the release ends the gesture");
+    return (ret);
+}
+
+static void test_gestures(void)
+{
+    EVE_gesture_t gesture;
+    uint8_t type = EVE_GESTURE_NONE;
+
+    EVE_test_reset();
+    (void) EVE_init();
+    EVE_gesture_init();
+
+    check(EVE_GESTURE_SWIPE_LEFT == stroke(400, 200, -120, 10, 10U, &gesture), "swipe left");
+    check((-120 == gesture.dx) && (10 == gesture.dy), "swipe left reports the movement");
+    check(EVE_GESTURE_SWIPE_RIGHT == stroke(100, 200, 120, -10, 10U, &gesture), "swipe right");
+    check(EVE_GESTURE_SWIPE_UP == stroke(200, 250, 5, -100, 10U, &gesture), "swipe up");
+    check(EVE_GESTURE_SWIPE_DOWN == stroke(200, 50, -5, 100, 10U, &gesture), "swipe down");
+    check(EVE_GESTURE_NONE == stroke(200, 200, 3, 2, 5U, &gesture), "a tap is no swipe");
+    check(EVE_GESTURE_NONE == stroke(200, 200, 50, 0, 10U, &gesture), "shorter than EVE_GESTURE_SWIPE_MIN");
+    check(EVE_GESTURE_NONE == stroke(200, 200, 80, 80, 10U, &gesture), "a diagonal is no swipe");
+    check(EVE_GESTURE_NONE == stroke(400, 200, -200, 0, (uint8_t) ((EVE_GESTURE_SWIPE_MAX_MS / FRAME_MS) + 2U), &gesture),
+          "slower than EVE_GESTURE_SWIPE_MAX_MS");
+
+    /* long press on tag 10, reported once after EVE_GESTURE_LONG_PRESS_MS */
+    for (uint16_t frame = 0U; frame <= ((EVE_GESTURE_LONG_PRESS_MS / FRAME_MS) + 10U); frame++)
+    {
+        uint8_t const now = sample((int16_t) (300 + (frame & 3U)), 100, 10U, &gesture);
+
+        if (now != EVE_GESTURE_NONE)
+        {
+            check(EVE_GESTURE_NONE == type, "a long press is reported only once");
+            check(((uint32_t) frame * FRAME_MS) >= EVE_GESTURE_LONG_PRESS_MS, "not before EVE_GESTURE_LONG_PRESS_MS");
+            check(((uint32_t) frame * FRAME_MS) < (EVE_GESTURE_LONG_PRESS_MS + FRAME_MS), "right after EVE_GESTURE_LONG_PRESS_MS");
+            type = now;
+        }
+    }
+    check(EVE_GESTURE_LONG_PRESS == type, "long press");
+    check((10U == gesture.tag) && (256U == gesture.scale), "a long press reports the tag it started on");
+    check(EVE_GESTURE_NONE == sample(EVE_TOUCH_NONE, EVE_TOUCH_NONE, 0U, &gesture), "no swipe after a long press");
+
+    /* moving away is no long press, no matter how long */
+    type = EVE_GESTURE_NONE;
+    for (uint16_t frame = 0U; frame <= ((EVE_GESTURE_LONG_PRESS_MS / FRAME_MS) + 10U); frame++)
+    {
+        int16_t const xc0 = (frame < 10U) ? (int16_t) (300 + (3 * (int16_t) frame)) : 330;
+
+        type |= sample(xc0, 100, 0U, &gesture);
+    }
+    check(EVE_GESTURE_NONE == type, "moving more than EVE_GESTURE_SLOP is no long press");
+    (void) sample(EVE_TOUCH_NONE, EVE_TOUCH_NONE, 0U, &gesture);
+}
+
+#else
+/* the extended mode registers, EVE_TOUCH_NONE for all points */
+static void multi_clear(void)
+{
+    EVE_test_write32(REG_CTOUCH_TOUCH0_XY, 0x80008000UL);
+    EVE_test_write32(REG_CTOUCH_TOUCH1_XY, 0x80008000UL);
+    EVE_test_write32(REG_CTOUCH_TOUCH2_XY, 0x80008000UL);
+    EVE_test_write32(REG_CTOUCH_TOUCH3_XY, 0x80008000UL);
+    EVE_test_write32(REG_CTOUCH_TOUCH4_Y, 0x8000UL);
+    EVE_test_write32(REG_CTOUCH_TOUCH4_X, 0x8000UL);
+}
+
+static uint8_t pinch(int16_t const distance_x, int16_t const distance_y, EVE_gesture_t * const p_gesture)
+{
+    EVE_touch_points_t points;
+
+    EVE_test_write32(REG_CTOUCH_TOUCH0_XY, (100UL << 16U) | 200UL); /* x 100, y 200 */
+    EVE_test_write32(REG_CTOUCH_TOUCH1_XY, ((uint32_t) (100 + distance_x) << 16U) | (uint32_t) (200 + distance_y));
+    (void) EVE_gesture_capture(&points);
+    return (EVE_gesture_update(&points, FRAME_MS, p_gesture));
+}
+
+static void test_multi(void)
+{
+    EVE_touch_points_t points;
+    EVE_gesture_t gesture;
+
+    EVE_test_reset();
+    (void) EVE_init();
+    EVE_gesture_init();
+    multi_clear();
+
+    EVE_test_write32(REG_CTOUCH_TOUCH0_XY, (10UL << 16U) | 11UL);
+    EVE_test_write32(REG_CTOUCH_TOUCH1_XY, (20UL << 16U) | 21UL);
+    EVE_test_write32(REG_CTOUCH_TOUCH2_XY, (30UL << 16U) | 31UL);
+    EVE_test_write32(REG_CTOUCH_TOUCH3_XY, (40UL << 16U) | 41UL);
+    EVE_test_write32(REG_CTOUCH_TOUCH4_X, 50UL);
+    EVE_test_write32(REG_CTOUCH_TOUCH4_Y, 51UL);
+    EVE_test_write32(REG_TOUCH_TAG, 7UL);
+    check(5U == EVE_gesture_capture(&points), "five points are touched");
+    for (uint8_t index = 0U; index < 5U; index++)
+    {
+        check(((int16_t) (10 * (index + 1U)) == points.xc0[index]) && ((int16_t) ((10 * (index + 1U)) + 1U) == points.yc0[index]),
+              "point n is REG_CTOUCH_TOUCHn");
+    }
+    check(7U == points.tag, "the tag is read with the points");
+    multi_clear();
+    EVE_test_write32(REG_TOUCH_TAG, 0UL);
+
+    /* 100 pixels apart, then 150 and 60, 8.8 scale against the start */
+    check(EVE_GESTURE_NONE == pinch(100, 0, &gesture), "the first sample starts the gesture");
+    check(EVE_GESTURE_NONE == pinch(100, 0, &gesture), "the second sample sets the start distance");
+    check(EVE_GESTURE_NONE == pinch(105, 0, &gesture), "less than EVE_GESTURE_PINCH_STEP is not reported");
+    check(EVE_GESTURE_PINCH == pinch(150, 0, &gesture), "spreading is a pinch");
+    check(384U == gesture.scale, "150 / 100 is 384 / 256");
+    check(EVE_GESTURE_PINCH == pinch(60, 0, &gesture), "closing is a pinch");
+    check(153U == gesture.scale, "60 / 100 is 153 / 256");
+    check(EVE_GESTURE_PINCH == pinch(60, 80, &gesture), "a diagonal distance");
+    check(261U == gesture.scale, "max + 3/8 min of 60 / 80 is 102, 102 / 100 is 261 / 256");
+    multi_clear();
+    {
+        EVE_touch_points_t released;
+
+        (void) EVE_gesture_capture(&released);
+        check(EVE_GESTURE_NONE == EVE_gesture_update(&released, FRAME_MS, &gesture), "no swipe after a pinch");
+    }
+    check(0U == EVE_gesture_active(), "the release ends the pinch");
+}
+#endif
+
+int main(void)
+{
+#if defined (EVE_MULTI_TOUCH)
+    test_multi();
+#else
+    test_gestures();
+#endif
+    printf("%s\n", (0UL == failures) ? "PASS" : "FAIL");
+    return ((0UL == failures) ? 0 : 1);
+}
@@ -0,0 +1,528 @@
+/*
+@file    test_glyphcache.c
+@brief   host test for EVE_glyphcache: the order cells are replaced in and that pinned labels keep their cells
+@version 1.0
+@date    2026-10-19
+@author  Christian Lara
+
+@section info
+
+Runs with the EVE_GLYPHCACHE_CELLS 10U of the sketch. The master font has one L8 cell of 4 x 1 pixels
+per glyph and every cell carries its code point, so the RAM_G of the SOFTWARE_TEST emulation tells
+which glyph is in which cell of the cache.
+- directed: free cells are used first, also when a glyph was not used for hundreds of frames, then the cell that was not used for the longest time,
+  a cell used in one of the last three frames is not replaced, using a glyph again keeps its cell
+- 20000 random steps of prepare, commit, pin and unpin compared with a model of the cache:
+  the return values, the glyph in every cell and the bytes that were uploaded
+- the cells of the pinned label are never replaced, the label is drawn from them after every step
+- "Ningún usuario" pins all ten cells, then nothing else gets a cell until EVE_glyphcache_unpin()
+  and three frames
+
+Build and run from the sketch directory:
+gcc -std=c99 -Wall -Wextra -DSOFTWARE_TEST -D_POSIX_C_SOURCE=200809L -I. -o test_glyphcache test/test_glyphcache.c EVE_glyphcache.c EVE_handles.c EVE_commands.c EVE_target.c && ./test_glyphcache
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "EVE.h"
+#include "EVE_glyphcache.h"
+#include "EVE_handles.h"
+
+#if (EVE_GLYPHCACHE_CELLS != 10U)
+#error "the expected cells are for EVE_GLYPHCACHE_CELLS 10U"
+#endif
+
+#define CELLS EVE_GLYPHCACHE_CELLS
+#define CACHE_ADDRESS 0x00010000UL
+#define CELL_BYTES 4UL
+#define CELL_MARK 0xa55a0000UL /* the upper half of every cell, the lower half is the code point */
+#define GLYPHS 26U
+#define STEPS 20000U
+#define LABEL_MAX 16U
+#define CAPTURE_WORDS 256U
+#define MODEL_PINNED 0xffU
+#define MODEL_FREE 0x100U
+#define NOT_IN_FONT 0x71U /* 'q' */
+
+typedef struct
+{
+    uint16_t code; /* 0 - free */
+    uint16_t age;
+} model_cell_t;
+
+static uint32_t failures = 0UL;
+static uint32_t random_state = 0x2f6e2b1dUL;
+static uint32_t capture[CAPTURE_WORDS];
+
+/* sorted ascending, the space advances only */
+static uint16_t const glyph_codes[GLYPHS] =
+{
+    0x0020U, 0x0041U, 0x004eU, 0x0061U, 0x0062U, 0x0063U, 0x0064U, 0x0065U, 0x0066U, 0x0067U, 0x0068U, 0x0069U,
+    0x006eU, 0x006fU, 0x0072U, 0x0073U, 0x0075U, 0x0076U, 0x0078U, 0x0079U, 0x007aU, 0x00e1U, 0x00e9U, 0x00f1U,
+    0x00faU, 0x20acU
+};
+
+static uint8_t font_codes[GLYPHS * 2U];
+static uint8_t font_advance[GLYPHS];
+static uint8_t font_cells[GLYPHS * CELL_BYTES];
+static EVE_glyph_font_t const font = {font_codes, font_advance, font_cells, GLYPHS, EVE_L8, 4U, 1U};
+
+static model_cell_t model[CELLS];
+static uint32_t model_uploaded = 0UL;
+static uint8_t handle = EVE_HANDLE_NONE;
+
+static void check(uint8_t const condition, const char * const p_what)
+{
+    if (0U == condition)
+    {
+        printf("FAIL: %s\n", p_what);
+        failures++;
+    }
+}
+
+static uint32_t next_random(uint32_t const range)
+{
+    random_state = (random_state * 1103515245UL) + 12345UL;
+    return ((random_state >> 8U) % range);
+}
+
+static void font_build(void)
+{
+    for (uint8_t index = 0U; index < GLYPHS; index++)
+    {
+        uint32_t const cell = CELL_MARK | glyph_codes[index];
+
+        font_codes[index * 2U] = (uint8_t) glyph_codes[index];
+        font_codes[(index * 2U) + 1U] = (uint8_t) (glyph_codes[index] >> 8U);
+        font_advance[index] = (uint8_t) (5U + (index % 7U));
+        for (uint8_t byte = 0U; byte < CELL_BYTES; byte++)
+        {
+            font_cells[(index * CELL_BYTES) + byte] = (uint8_t) (cell >> (8U * byte));
+        }
+    }
+}
+
+/* UTF-8 of a list of code points */
+static void utf8(char * const p_text, uint16_t const * const p_codes, uint8_t const count)
+{
+    uint8_t *p_out = (uint8_t *) p_text;
+
+    for (uint8_t index = 0U; index < count; index++)
+    {
+        uint16_t const code = p_codes[index];
+
+        if (code < 0x80U)
+        {
+            *p_out++ = (uint8_t) code;
+        }
+        else if (code < 0x800U)
+        {
+            *p_out++ = (uint8_t) (0xc0U | (code >> 6U));
+            *p_out++ = (uint8_t) (0x80U | (code & 0x3fU));
+        }
+        else
+        {
+            *p_out++ = (uint8_t) (0xe0U | (code >> 12U));
+            *p_out++ = (uint8_t) (0x80U | ((code >> 6U) & 0x3fU));
+            *p_out++ = (uint8_t) (0x80U | (code & 0x3fU));
+        }
+    }
+    *p_out = 0U;
+}
+
+/* the glyph in a cell of the cache as RAM_G has it, 0 - free */
+static uint16_t cell_code(uint8_t const cell)
+{
+    uint32_t const word = EVE_test_read32(CACHE_ADDRESS + ((uint32_t) cell * CELL_BYTES));
+
+    return (((word & 0xffff0000UL) == CELL_MARK) ? (uint16_t) word : 0U);
+}
+
+static uint8_t cell_of(uint16_t const code)
+{
+    uint8_t cell = 0U;
+
+    while ((cell < CELLS) && (cell_code(cell) != code))
+    {
+        cell++;
+    }
+    return (cell);
+}
+
+static void model_reset(void)
+{
+    for (uint8_t cell = 0U; cell < CELLS; cell++)
+    {
+        model[cell].code = 0U;
+        model[cell].age = MODEL_FREE;
+    }
+    model_uploaded = 0UL;
+}
+
+/* a free cell with the lowest index, else the oldest cell that was not used in the last three frames */
+static uint8_t model_victim(void)
+{
+    uint8_t victim = CELLS;
+
+    for (uint8_t cell = 0U; (cell < CELLS) && (CELLS == victim); cell++)
+    {
+        if (0U == model[cell].code)
+        {
+            victim = cell;
+        }
+    }
+    for (uint8_t cell = 0U; (cell < CELLS) && ((CELLS == victim) || (model[victim].code != 0U)); cell++)
+    {
+        if ((model[cell].age != MODEL_PINNED) && (model[cell].age >= 3U) &&
+            ((CELLS == victim) || (model[cell].age > model[victim].age)))
+        {
+            victim = cell;
+        }
+    }
+    return (victim);
+}
+
+static uint8_t model_prepare(uint16_t const * const p_codes, uint8_t const count, uint8_t const pin)
+{
+    uint8_t ret = E_OK;
+
+    for (uint8_t index = 0U; index < count; index++)
+    {
+        uint16_t const code = p_codes[index];
+        uint8_t cell = 0U;
+
+        if (0x20U == code)
+        {
+            continue;
+        }
+        while ((cell < CELLS) && (model[cell].code != code))
+        {
+            cell++;
+        }
+        if ((CELLS == cell) && (code != NOT_IN_FONT))
+        {
+            cell = model_victim();
+            if (cell != CELLS)
+            {
+                model[cell].code = code;
+                model_uploaded += CELL_BYTES;
+            }
+        }
+        if (CELLS == cell)
+        {
+            ret = E_NOT_OK;
+        }
+        else if (pin != 0U)
+        {
+            model[cell].age = MODEL_PINNED;
+        }
+        else if (model[cell].age != MODEL_PINNED)
+        {
+            model[cell].age = 0U;
+        }
+        else
+        {
+            /* stays pinned */
+        }
+    }
+    return (ret);
+}
+
+static void model_commit(void)
+{
+    for (uint8_t cell = 0U; cell < CELLS; cell++)
+    {
+        if ((model[cell].code != 0U) && (model[cell].age < 0xfeU))
+        {
+            model[cell].age++;
+        }
+    }
+}
+
+static void model_unpin(void)
+{
+    for (uint8_t cell = 0U; cell < CELLS; cell++)
+    {
+        if (MODEL_PINNED == model[cell].age)
+        {
+            model[cell].age = 0U;
+        }
+    }
+}
+
+static uint8_t model_matches(void)
+{
+    uint8_t ret = (model_uploaded == EVE_glyphcache_uploaded()) ? 1U : 0U;
+
+    for (uint8_t cell = 0U; cell < CELLS; cell++)
+    {
+        if (cell_code(cell) != model[cell].code)
+        {
+            ret = 0U;
+        }
+    }
+    return (ret);
+}
+
+static uint8_t prepare(uint16_t const * const p_codes, uint8_t const count, uint8_t const pin)
+{
+    char text[(LABEL_MAX * 3U) + 1U];
+    uint8_t ret;
+    uint8_t expected;
+
+    utf8(text, p_codes, count);
+    ret = (0U == pin) ? EVE_glyphcache_prepare(text) : EVE_glyphcache_pin(text);
+    expected = model_prepare(p_codes, count, pin);
+    check((ret == expected) ? 1U : 0U, "the return value of the model");
+    return (ret);
+}
+
+static uint8_t prepare_text(const char * const p_text)
+{
+    uint16_t codes[LABEL_MAX];
+    uint8_t count = 0U;
+
+    while ((p_text[count] != 0) && (count < LABEL_MAX))
+    {
+        codes[count] = (uint8_t) p_text[count];
+        count++;
+    }
+    return (prepare(codes, count, 0U));
+}
+
+static void commit(void)
+{
+    EVE_glyphcache_commit();
+    model_commit();
+}
+
+static void start(void)
+{
+    EVE_test_reset();
+    (void) EVE_init();
+    handle = EVE_glyphcache_init(&font, CACHE_ADDRESS);
+    check((handle != EVE_HANDLE_NONE) ? 1U : 0U, "EVE_glyphcache_init() gets a handle");
+    model_reset();
+}
+
+/* the label is drawn from the cells that hold its glyphs */
+static uint8_t drawn_from_cells(uint16_t const * const p_codes, uint8_t const count)
+{
+    char text[(LABEL_MAX * 3U) + 1U];
+    uint32_t words;
+    uint8_t glyph = 0U;
+    uint8_t ret = 1U;
+
+    utf8(text, p_codes, count);
+    EVE_test_capture(capture, CAPTURE_WORDS);
+    EVE_start_cmd_burst();
+    EVE_glyphcache_text_burst(10, 10, 0U, text);
+    EVE_end_cmd_burst();
+    words = EVE_test_captured();
+    EVE_test_capture(NULL, 0UL);
+
+    for (uint32_t index = 0UL; index < words; index++)
+    {
+        if (2UL == (capture[index] >> 30U)) /* VERTEX2II */
+        {
+            while ((glyph < count) && (0x20U == p_codes[glyph]))
+            {
+                glyph++;
+            }
+            if ((glyph >= count) || (((capture[index] >> 7U) & 0x1fUL) != handle) ||
+                (cell_code((uint8_t) (capture[index] & 0x7fUL)) != p_codes[glyph]))
+            {
+                ret = 0U;
+            }
+            glyph++;
+        }
+    }
+    while ((glyph < count) && (0x20U == p_codes[glyph]))
+    {
+        glyph++;
+    }
+    return (((1U == ret) && (glyph == count)) ? 1U : 0U);
+}
+
+static void test_order(void)
+{
+    static const char letters[] = "ANabcdefgh";
+
+    start();
+
+    /* one glyph per frame, the free cells in order */
+    for (uint8_t index = 0U; index < CELLS; index++)
+    {
+        char const text[2U] = {letters[index], 0};
+
+        check((E_OK == prepare_text(text)) ? 1U : 0U, "a free cell for every glyph");
+        check((cell_of((uint8_t) letters[index]) == index) ? 1U : 0U, "the free cells are used in order");
+        commit();
+    }
+    check((CELLS == cell_of('i')) ? 1U : 0U, "i is not in the cache yet");
+
+    /* 'h' was used in the last frame, 'A' nine frames ago */
+    check((E_OK == prepare_text("i")) ? 1U : 0U, "the cache is full but old cells can be replaced");
+    check((0U == cell_of('i')) ? 1U : 0U, "the cell of the oldest glyph A is replaced first");
+    check((E_OK == prepare_text("b")) ? 1U : 0U, "a glyph in the cache");
+    check((3U == cell_of('b')) ? 1U : 0U, "stays in its cell");
+    check((E_OK == prepare_text("n")) ? 1U : 0U, "the next glyph");
+    check((1U == cell_of('n')) ? 1U : 0U, "replaces N, the oldest one now");
+    check((E_OK == prepare_text("o")) ? 1U : 0U, "one more");
+    check((2U == cell_of('o')) ? 1U : 0U, "replaces a, b was used again");
+    check((E_OK == prepare_text("r")) ? 1U : 0U, "and one more");
+    check((4U == cell_of('r')) ? 1U : 0U, "replaces c, not b");
+
+    /* f was used three frames ago, g two, h one and everything else in this frame */
+    check((E_OK == prepare_text("des")) ? 1U : 0U, "d and e are in the cache");
+    check((7U == cell_of('s')) ? 1U : 0U, "s replaces f, d and e are used in this frame");
+    check((E_NOT_OK == prepare_text("uv")) ? 1U : 0U, "no cell is old enough");
+    check(((CELLS == cell_of('u')) && (CELLS == cell_of('v'))) ? 1U : 0U, "u and v have no cell");
+    check(((8U == cell_of('g')) && (9U == cell_of('h'))) ? 1U : 0U, "g and h stay");
+    commit();
+    check((E_OK == prepare_text("u")) ? 1U : 0U, "one frame later g is old enough");
+    check((8U == cell_of('u')) ? 1U : 0U, "u replaces g");
+    check((E_NOT_OK == prepare_text("v")) ? 1U : 0U, "h is not");
+    commit();
+    check((E_OK == prepare_text("v")) ? 1U : 0U, "one more frame for h");
+    check((9U == cell_of('v')) ? 1U : 0U, "v replaces h");
+    check((E_NOT_OK == prepare_text("q")) ? 1U : 0U, "q is not in the master font");
+    check(model_matches(), "the directed steps match the model");
+}
+
+/* a free cell goes before a glyph that was not used for a long time */
+static void test_free(void)
+{
+    start();
+    check((E_OK == prepare_text("A")) ? 1U : 0U, "A in an empty cache");
+    for (uint16_t frame = 0U; frame < 300U; frame++)
+    {
+        commit();
+    }
+    check((E_OK == prepare_text("N")) ? 1U : 0U, "N in the next cell");
+    check(((0U == cell_of('A')) && (1U == cell_of('N'))) ? 1U : 0U, "A keeps its cell while there are free ones");
+    check(model_matches(), "the free cells match the model");
+}
+
+static void test_random(void)
+{
+    uint16_t label[LABEL_MAX];
+    uint8_t label_count = 0U;
+
+    start();
+
+    for (uint16_t step = 0U; step < STEPS; step++)
+    {
+        uint32_t const action = next_random(20UL);
+
+        if (action < 12UL)
+        {
+            uint16_t codes[LABEL_MAX];
+            uint8_t const count = (uint8_t) (1UL + next_random(5UL));
+
+            for (uint8_t index = 0U; index < count; index++)
+            {
+                codes[index] = (0UL == next_random(40UL)) ? NOT_IN_FONT : glyph_codes[next_random(GLYPHS)];
+            }
+            (void) prepare(codes, count, 0U);
+        }
+        else if (action < 19UL)
+        {
+            commit();
+        }
+        else
+        {
+            /* a new static part of the display list, it has a label with up to five glyphs */
+            EVE_glyphcache_unpin();
+            model_unpin();
+            label_count = (uint8_t) next_random(6UL);
+            for (uint8_t index = 0U; index < label_count; index++)
+            {
+                label[index] = glyph_codes[next_random(GLYPHS)];
+            }
+            if (E_NOT_OK == prepare(label, label_count, 1U))
+            {
+                label_count = 0U; /* not all of it fit in, not drawn */
+            }
+        }
+
+        check(model_matches(), "the cells match the model");
+        check(drawn_from_cells(label, label_count), "the pinned label keeps its cells");
+        if (failures > 20UL)
+        {
+            break;
+        }
+    }
+}
+
+static void test_pinned(void)
+{
+    static uint16_t const label[] = {0x004eU, 0x0069U, 0x006eU, 0x0067U, 0x00faU, 0x006eU, 0x0020U,
+                                     0x0075U, 0x0073U, 0x0075U, 0x0061U, 0x0072U, 0x0069U, 0x006fU};
+    static uint16_t const other[] = {0x20acU};
+    uint8_t const count = (uint8_t) (sizeof(label) / sizeof(label[0U]));
+    uint32_t uploaded;
+
+    start();
+    check((E_OK == prepare(label, count, 1U)) ? 1U : 0U, "the ten glyphs of \"Ningún usuario\" fit in");
+    uploaded = EVE_glyphcache_uploaded();
+
+    for (uint8_t frame = 0U; frame < 10U; frame++)
+    {
+        check((E_NOT_OK == prepare(other, 1U, 0U)) ? 1U : 0U, "no cell while all are pinned");
+        check((E_OK == prepare_text("usa")) ? 1U : 0U, "glyphs of the label are in the cache");
+        check((uploaded == EVE_glyphcache_uploaded()) ? 1U : 0U, "nothing is uploaded");
+        check(drawn_from_cells(label, count), "the label keeps its cells");
+        commit();
+    }
+
+    EVE_glyphcache_unpin();
+    model_unpin();
+    check((E_NOT_OK == prepare(other, 1U, 0U)) ? 1U : 0U, "the label can still be on the screen after the unpin");
+    commit();
+    commit();
+    check((E_NOT_OK == prepare(other, 1U, 0U)) ? 1U : 0U, "two frames are not enough");
+    commit();
+    check((E_OK == prepare(other, 1U, 0U)) ? 1U : 0U, "after three frames a cell is replaced");
+    check(model_matches(), "the pinned steps match the model");
+}
+
+int main(void)
+{
+    font_build();
+    test_order();
+    test_free();
+    test_random();
+    test_pinned();
+    printf("%s\n", (0UL == failures) ? "PASS" : "FAIL");
+    return ((0UL == failures) ? 0 : 1);
+}
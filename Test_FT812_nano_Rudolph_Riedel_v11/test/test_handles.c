@@ -0,0 +1,226 @@
+/*
+@file    test_handles.c
+@brief   host test for EVE_handles: what the prologue sets up between assign, commit, release and a fault
+@version 1.0
+@date    2026-10-19
+@author  Christian Lara
+
+@section info
+
+The words the prologue writes to the cmd-FIFO are captured on the SOFTWARE_TEST emulation and
+decoded into the handles that got a CMD_SETBITMAP or a CMD_SETFONT2 and with which asset.
+- an assignment is set up by the next prologue, a prologue without EVE_handles_commit() behind it
+  is repeated by the next one, after the commit the prologue is empty
+- an asset that already has a handle gets the same one back and is not set up again
+- a handle that is released after the prologue and assigned to an other asset before the commit
+  is set up for the new asset
+- after a coprocessor fault was recovered by EVE_busy() EVE_handles_invalidate() has the prologue
+  set up every assigned handle again, also when the commit of the frame before comes in between
+- the same with EVE_handles_prologue_burst()
+
+Build and run from the sketch directory:
+gcc -std=c99 -Wall -Wextra -DSOFTWARE_TEST -D_POSIX_C_SOURCE=200809L -I. -o test_handles test/test_handles.c EVE_handles.c EVE_commands.c EVE_target.c && ./test_handles
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "EVE.h"
+#include "EVE_handles.h"
+
+#define CAPTURE_WORDS 256U
+#define HANDLES 16U
+#define ASSETS 4U
+
+static uint32_t failures = 0UL;
+static uint32_t capture[CAPTURE_WORDS];
+static uint32_t setup[HANDLES]; /* the source address the last prologue set up, 0 - not set up */
+
+static EVE_asset_t const assets[ASSETS] =
+{
+    {0x00001000UL, EVE_RGB565, 64U, 32U, 0U, 0U},
+    {0x00002000UL, EVE_ARGB1555, 16U, 16U, 0U, 0U},
+    {0x00003000UL, 0U, 0U, 0U, 1U, 32U},
+    {0x00004000UL, EVE_L8, 100U, 10U, 0U, 0U},
+};
+
+static void check(uint8_t const condition, const char * const p_what)
+{
+    if (0U == condition)
+    {
+        printf("FAIL: %s\n", p_what);
+        failures++;
+    }
+}
+
+/* run the prologue and decode it into setup[], returns the number of handles that were set up */
+static uint8_t prologue(uint8_t const burst)
+{
+    uint32_t words;
+    uint32_t handle = 0UL;
+    uint8_t count = 0U;
+
+    (void) memset(setup, 0, sizeof(setup));
+    EVE_test_capture(capture, CAPTURE_WORDS);
+    EVE_cmd_dl(CMD_DLSTART); /* the state cache must not drop a BITMAP_HANDLE */
+    if (burst != 0U)
+    {
+        EVE_start_cmd_burst();
+        EVE_handles_prologue_burst();
+        EVE_end_cmd_burst();
+    }
+    else
+    {
+        EVE_handles_prologue();
+    }
+    words = EVE_test_captured();
+    EVE_test_capture(NULL, 0UL);
+
+    for (uint32_t index = 1UL; index < words; index++)
+    {
+        uint32_t const word = capture[index];
+
+        if (DL_BITMAP_HANDLE == (word & 0xff000000UL))
+        {
+            handle = word & 0x1fUL;
+        }
+        else if ((CMD_SETBITMAP == word) && ((index + 3UL) < words))
+        {
+            check((handle < HANDLES) ? 1U : 0U, "CMD_SETBITMAP for a valid handle");
+            setup[handle & (HANDLES - 1UL)] = capture[index + 1UL];
+            count++;
+            index += 3UL;
+        }
+        else if ((CMD_SETFONT2 == word) && ((index + 3UL) < words))
+        {
+            check((capture[index + 1UL] < HANDLES) ? 1U : 0U, "CMD_SETFONT2 for a valid handle");
+            setup[capture[index + 1UL] & (HANDLES - 1UL)] = capture[index + 2UL];
+            count++;
+            index += 3UL;
+        }
+        else
+        {
+            check(0U, "the prologue only sets up handles");
+        }
+    }
+    check(((0U == count) || (0UL == handle)) ? 1U : 0U, "the prologue leaves handle 0 selected");
+    check(((0U == count) || (words > 1UL)) ? 1U : 0U, "the prologue is not empty");
+    return (count);
+}
+
+static uint8_t is_setup(uint8_t const handle, uint8_t const asset)
+{
+    return (((handle < HANDLES) && (assets[asset].source == setup[handle])) ? 1U : 0U);
+}
+
+static void test_handles(uint8_t const burst)
+{
+    uint8_t handle[ASSETS];
+
+    EVE_test_reset();
+    (void) EVE_init();
+
+    /* assign -> prologue without commit -> the prologue is repeated */
+    handle[0U] = EVE_handle_assign(&assets[0U]);
+    handle[2U] = EVE_handle_assign(&assets[2U]);
+    check(((handle[0U] >= EVE_HANDLES_FIRST) && (handle[0U] <= EVE_HANDLES_LAST)) ? 1U : 0U, "a handle in range");
+    check((handle[0U] != handle[2U]) ? 1U : 0U, "two assets get two handles");
+    check((2U == prologue(burst)) ? 1U : 0U, "the prologue sets up the two assignments");
+    check((is_setup(handle[0U], 0U) && is_setup(handle[2U], 2U)) ? 1U : 0U, "the bitmap and the font are set up");
+    check((2U == prologue(burst)) ? 1U : 0U, "a prologue without a commit is repeated");
+    check((is_setup(handle[0U], 0U) && is_setup(handle[2U], 2U)) ? 1U : 0U, "the repeated prologue has the same assets");
+    EVE_handles_commit();
+    check((0U == prologue(burst)) ? 1U : 0U, "the prologue is empty after the commit");
+    EVE_handles_commit();
+
+    /* a second assignment only sets up the new handle */
+    check((handle[0U] == EVE_handle_assign(&assets[0U])) ? 1U : 0U, "an assigned asset gets its handle back");
+    handle[1U] = EVE_handle_assign(&assets[1U]);
+    check((1U == prologue(burst)) ? 1U : 0U, "only the new assignment is set up");
+    check(is_setup(handle[1U], 1U), "the new asset is set up");
+    EVE_handles_commit();
+    check((0U == prologue(burst)) ? 1U : 0U, "nothing after the second commit");
+    EVE_handles_commit();
+
+    /* released after the prologue and assigned again before the commit */
+    EVE_handle_release(handle[0U]);
+    handle[3U] = EVE_handle_assign(&assets[3U]);
+    check((handle[3U] == handle[0U]) ? 1U : 0U, "a released handle is assigned again");
+    check((1U == prologue(burst)) ? 1U : 0U, "the reassigned handle is set up");
+    EVE_handle_release(handle[3U]);
+    handle[0U] = EVE_handle_assign(&assets[0U]);
+    EVE_handles_commit();
+    check((1U == prologue(burst)) ? 1U : 0U, "a handle reassigned before the commit is set up after it");
+    check(is_setup(handle[0U], 0U), "with the asset it has now");
+    EVE_handles_commit();
+    check((0U == prologue(burst)) ? 1U : 0U, "nothing after the third commit");
+    EVE_handles_commit();
+
+    /* a fault: the coprocessor forgot the fonts, everything that is assigned is set up again */
+    EVE_test_fault();
+    check((EVE_FAULT_RECOVERED == EVE_busy()) ? 1U : 0U, "EVE_busy() recovers from the fault");
+    check((EVE_FAULT_RECOVERED == EVE_get_and_reset_fault_state()) ? 1U : 0U, "the fault is reported");
+    EVE_handles_invalidate();
+    check((3U == prologue(burst)) ? 1U : 0U, "the prologue after the fault sets up every assigned handle");
+    check((is_setup(handle[0U], 0U) && is_setup(handle[1U], 1U) && is_setup(handle[2U], 2U)) ? 1U : 0U,
+          "every asset is set up again");
+    EVE_handles_commit();
+    check((0U == prologue(burst)) ? 1U : 0U, "nothing after the commit of the recovery");
+    EVE_handles_commit();
+
+    /* the fault hits a frame that was built, the commit of that frame comes after the invalidation */
+    (void) EVE_handle_assign(&assets[3U]);
+    check((1U == prologue(burst)) ? 1U : 0U, "the frame before the fault sets up the new asset");
+    EVE_test_fault();
+    (void) EVE_busy();
+    if (EVE_FAULT_RECOVERED == EVE_get_and_reset_fault_state())
+    {
+        EVE_handles_invalidate();
+    }
+    EVE_handles_commit();
+    check((4U == prologue(burst)) ? 1U : 0U, "a commit after the invalidation does not drop a handle");
+    EVE_handles_commit();
+    check((0U == prologue(burst)) ? 1U : 0U, "nothing at the end");
+    EVE_handles_commit();
+
+    for (uint8_t asset = 0U; asset < ASSETS; asset++)
+    {
+        EVE_handle_release(EVE_handle_assign(&assets[asset]));
+    }
+}
+
+int main(void)
+{
+    test_handles(0U);
+    test_handles(1U);
+    printf("%s\n", (0UL == failures) ? "PASS" : "FAIL");
+    return ((0UL == failures) ? 0 : 1);
+}
@@ -0,0 +1,335 @@
+/*
+@file    test_matrix.c
+@brief   host test for EVE_matrix against a double precision model of the coprocessor matrix commands
+@version 1.0
+@date    2026-10-19
+@author  Christian Lara
+
+@section info
+
+The model keeps the matrix of the coprocessor in double precision and applies CMD_TRANSLATE, CMD_ROTATE,
+CMD_SCALE and CMD_ROTATEAROUND as the product with the inverse of the transform, like the coprocessor
+maps screen pixels to bitmap pixels. Random chains of these are run through EVE_matrix and the model,
+every one of the six BITMAP_TRANSFORM words has to be within one step of 1/256 of the exactly rounded
+value of the model.
+Also checked:
+- a 90 degree rotation around (50,50) gives exact words
+- BITMAP_TRANSFORM_C() / _F() from EVE.h keep 24 bits, translations beyond 256 pixels are not cut off
+- EVE_matrix_set() / EVE_matrix_set_burst() write the words of EVE_matrix_words() to the cmd-FIFO
+
+Build and run from the sketch directory:
+gcc -std=c99 -Wall -Wextra -DSOFTWARE_TEST -D_POSIX_C_SOURCE=200809L -I. -o test_matrix test/test_matrix.c EVE_matrix.c EVE_commands.c EVE_target.c -lm && ./test_matrix
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "EVE.h"
+#include "EVE_matrix.h"
+
+#define CHAINS 200000UL
+#define MAX_STEPS 6U
+#define PI_D 3.14159265358979323846
+
+typedef struct
+{
+    double m[2][3]; /* the third row is 0 0 1 */
+} model_t;
+
+static uint32_t failures = 0UL;
+
+static void model_identity(model_t * const p_model)
+{
+    p_model->m[0][0] = 1.0;
+    p_model->m[0][1] = 0.0;
+    p_model->m[0][2] = 0.0;
+    p_model->m[1][0] = 0.0;
+    p_model->m[1][1] = 1.0;
+    p_model->m[1][2] = 0.0;
+}
+
+/* M = T * M with T = (t00 t01 t02 / t10 t11 t12 / 0 0 1) */
+static void model_apply(model_t * const p_model, double const t00, double const t01, double const t02,
+                        double const t10, double const t11, double const t12)
+{
+    model_t result;
+
+    for (uint8_t col = 0U; col < 3U; col++)
+    {
+        result.m[0][col] = (t00 * p_model->m[0][col]) + (t01 * p_model->m[1][col]);
+        result.m[1][col] = (t10 * p_model->m[0][col]) + (t11 * p_model->m[1][col]);
+    }
+    result.m[0][2] += t02;
+    result.m[1][2] += t12;
+    *p_model = result;
+}
+
+static void model_translate(model_t * const p_model, double const tx0, double const ty0)
+{
+    model_apply(p_model, 1.0, 0.0, -tx0, 0.0, 1.0, -ty0);
+}
+
+static void model_rotate(model_t * const p_model, uint16_t const angle)
+{
+    double const rad = ((double) angle * 2.0 * PI_D) / 65536.0;
+
+    model_apply(p_model, cos(rad), sin(rad), 0.0, -sin(rad), cos(rad), 0.0);
+}
+
+static void model_scale(model_t * const p_model, double const scx, double const scy)
+{
+    model_apply(p_model, 1.0 / scx, 0.0, 0.0, 0.0, 1.0 / scy, 0.0);
+}
+
+/* signed value of a word with bits of value, 8 fractional bits */
+static int32_t word_value(uint32_t const word, uint8_t const bits)
+{
+    uint32_t const mask = (1UL << bits) - 1UL;
+    uint32_t const val = word & mask;
+
+    return (((val >> (bits - 1U)) != 0UL) ? (int32_t) (val | ~mask) : (int32_t) val);
+}
+
+/* compares the words with the model, returns the largest difference in steps of 1/256 */
+static int32_t compare(EVE_matrix_t const * const p_matrix, model_t const * const p_model)
+{
+    static const uint8_t bits[6] = {17U, 17U, 24U, 17U, 17U, 24U};
+    uint32_t words[6];
+    int32_t worst = 0;
+
+    EVE_matrix_words(p_matrix, words);
+    for (uint8_t index = 0U; index < 6U; index++)
+    {
+        int32_t const expected = (int32_t) lround(p_model->m[index / 3U][index % 3U] * 256.0);
+        int32_t diff = word_value(words[index], bits[index]) - expected;
+
+        if ((words[index] >> 24U) != (0x15UL + index))
+        {
+            diff = 0x7fffffff;
+        }
+        diff = (diff < 0) ? -diff : diff;
+        worst = (diff > worst) ? diff : worst;
+    }
+    return (worst);
+}
+
+/* the model has to stay inside of what the words can hold, 8.8 for A / B / D / E and 15.8 for C / F */
+static uint8_t in_range(model_t const * const p_model)
+{
+    uint8_t ret = 1U;
+
+    for (uint8_t index = 0U; index < 6U; index++)
+    {
+        double const limit = ((index % 3U) == 2U) ? 32000.0 : 120.0;
+
+        if (fabs(p_model->m[index / 3U][index % 3U]) > limit)
+        {
+            ret = 0U;
+        }
+    }
+    return (ret);
+}
+
+static int32_t random_range(int32_t const low, int32_t const high)
+{
+    return (low + (int32_t) (rand() % (high - low + 1)));
+}
+
+static void test_chains(void)
+{
+    uint32_t compared = 0UL;
+    uint32_t beyond = 0UL;
+    int32_t worst = 0;
+
+    srand(44);
+    for (uint32_t chain = 0UL; chain < CHAINS; chain++)
+    {
+        EVE_matrix_t matrix;
+        model_t model;
+        uint8_t const steps = (uint8_t) random_range(1, MAX_STEPS);
+
+        EVE_matrix_identity(&matrix);
+        model_identity(&model);
+        for (uint8_t step = 0U; step < steps; step++)
+        {
+            switch (rand() % 4)
+            {
+                case 0:
+                {
+                    int32_t const tx0 = random_range(-400 * 256, 400 * 256) * 256; /* 16.16, to 1/256 pixel */
+                    int32_t const ty0 = random_range(-400 * 256, 400 * 256) * 256;
+
+                    EVE_matrix_translate(&matrix, tx0, ty0);
+                    model_translate(&model, tx0 / 65536.0, ty0 / 65536.0);
+                    break;
+                }
+                case 1:
+                {
+                    uint16_t const angle = (uint16_t) random_range(0, 65535);
+
+                    EVE_matrix_rotate(&matrix, angle);
+                    model_rotate(&model, angle);
+                    break;
+                }
+                case 2:
+                {
+                    int32_t const scx = random_range(EVE_MATRIX_ONE / 4, EVE_MATRIX_ONE * 4);
+                    int32_t const scy = random_range(EVE_MATRIX_ONE / 4, EVE_MATRIX_ONE * 4);
+
+                    EVE_matrix_scale(&matrix, scx, scy);
+                    model_scale(&model, scx / 65536.0, scy / 65536.0);
+                    break;
+                }
+                default:
+                {
+                    int32_t const xc0 = random_range(-200, 600);
+                    int32_t const yc0 = random_range(-200, 400);
+                    uint16_t const angle = (uint16_t) random_range(0, 65535);
+                    int32_t const scale = random_range(EVE_MATRIX_ONE / 2, EVE_MATRIX_ONE * 2);
+
+                    EVE_matrix_rotatearound(&matrix, xc0, yc0, angle, scale);
+                    /* CMD_ROTATEAROUND is translate, rotate, scale and translate back */
+                    model_translate(&model, xc0, yc0);
+                    model_rotate(&model, angle);
+                    model_scale(&model, scale / 65536.0, scale / 65536.0);
+                    model_translate(&model, -xc0, -yc0);
+                    break;
+                }
+            }
+        }
+
+        if (in_range(&model) != 0U)
+        {
+            int32_t const diff = compare(&matrix, &model);
+
+            worst = (diff > worst) ? diff : worst;
+            compared++;
+        }
+        else
+        {
+            beyond++;
+        }
+    }
+
+    printf("%lu chains compared, %lu beyond the range of the words, worst difference %ld/256\n",
+           (unsigned long) compared, (unsigned long) beyond, (long) worst);
+    if (worst > 1)
+    {
+        printf("FAIL: the matrix is off by more than 1/256\n");
+        failures++;
+    }
+}
+
+static void expect_word(const char * const p_what, uint32_t const got, uint32_t const expected)
+{
+    if (got != expected)
+    {
+        printf("FAIL: %s is %08lx, expected %08lx\n", p_what, (unsigned long) got, (unsigned long) expected);
+        failures++;
+    }
+}
+
+static void test_rotatearound_90(void)
+{
+    EVE_matrix_t matrix;
+    uint32_t words[6];
+
+    EVE_matrix_identity(&matrix);
+    EVE_matrix_rotatearound(&matrix, 50, 50, 0x4000UL, EVE_MATRIX_ONE);
+    EVE_matrix_words(&matrix, words);
+    expect_word("A of 90 degrees around (50,50)", words[0], DL_BITMAP_TRANSFORM_A);
+    expect_word("B of 90 degrees around (50,50)", words[1], DL_BITMAP_TRANSFORM_B | 0x100UL);
+    expect_word("C of 90 degrees around (50,50)", words[2], DL_BITMAP_TRANSFORM_C);
+    expect_word("D of 90 degrees around (50,50)", words[3], DL_BITMAP_TRANSFORM_D | 0x1ff00UL);
+    expect_word("E of 90 degrees around (50,50)", words[4], DL_BITMAP_TRANSFORM_E);
+    expect_word("F of 90 degrees around (50,50)", words[5], DL_BITMAP_TRANSFORM_F | (100UL << 8U));
+}
+
+static void test_masks(void)
+{
+    EVE_matrix_t matrix;
+    uint32_t words[6];
+
+    /* 600 pixels need 18 bits in 15.8, a 17 bit mask would leave 88 pixels */
+    expect_word("BITMAP_TRANSFORM_C(600 px)", BITMAP_TRANSFORM_C(600UL << 8U), DL_BITMAP_TRANSFORM_C | 0x025800UL);
+    expect_word("BITMAP_TRANSFORM_F(600 px)", BITMAP_TRANSFORM_F(600UL << 8U), DL_BITMAP_TRANSFORM_F | 0x025800UL);
+    expect_word("BITMAP_TRANSFORM_C(-600 px)", BITMAP_TRANSFORM_C((uint32_t) (-600L * 256L)), DL_BITMAP_TRANSFORM_C | 0xfda800UL);
+    expect_word("BITMAP_TRANSFORM_F(-32768 px)", BITMAP_TRANSFORM_F((uint32_t) (-32768L * 256L)), DL_BITMAP_TRANSFORM_F | 0x800000UL);
+    expect_word("BITMAP_TRANSFORM_C() keeps the opcode", BITMAP_TRANSFORM_C(0xffffffffUL), DL_BITMAP_TRANSFORM_C | 0xffffffUL);
+
+    EVE_matrix_identity(&matrix);
+    EVE_matrix_translate(&matrix, 600L * EVE_MATRIX_ONE, -700L * EVE_MATRIX_ONE);
+    EVE_matrix_words(&matrix, words);
+    expect_word("C of a translation by 600 px", words[2], DL_BITMAP_TRANSFORM_C | 0xfda800UL);
+    expect_word("F of a translation by -700 px", words[5], DL_BITMAP_TRANSFORM_F | 0x02bc00UL);
+}
+
+static void test_set(void)
+{
+    EVE_matrix_t matrix;
+    uint32_t expected[6];
+    uint32_t captured[6];
+
+    EVE_test_reset();
+    (void) EVE_init();
+    EVE_matrix_identity(&matrix);
+    EVE_matrix_rotatearound(&matrix, 320, 240, 0x1234UL, EVE_MATRIX_ONE + (EVE_MATRIX_ONE / 3));
+    EVE_matrix_words(&matrix, expected);
+
+    EVE_test_capture(captured, 6UL);
+    EVE_matrix_set(&matrix);
+    EVE_test_capture(NULL, 0UL);
+    for (uint8_t index = 0U; index < 6U; index++)
+    {
+        expect_word("EVE_matrix_set()", captured[index], expected[index]);
+    }
+
+    EVE_test_capture(captured, 6UL);
+    EVE_start_cmd_burst();
+    EVE_matrix_set_burst(&matrix);
+    EVE_end_cmd_burst();
+    EVE_test_capture(NULL, 0UL);
+    for (uint8_t index = 0U; index < 6U; index++)
+    {
+        expect_word("EVE_matrix_set_burst()", captured[index], expected[index]);
+    }
+}
+
+int main(void)
+{
+    test_chains();
+    test_rotatearound_90();
+    test_masks();
+    test_set();
+    printf("%s\n", (0UL == failures) ? "PASS" : "FAIL");
+    return ((0UL == failures) ? 0 : 1);
+}
@@ -0,0 +1,229 @@
+/*
+@file    test_shadow.c
+@brief   host test for EVE_shadow on the SOFTWARE_TEST emulation
+@version 1.0
+@date    2026-10-19
+@author  Christian Lara
+
+@section info
+
+- 3000 random updates of a region: single bytes, short runs, long runs of one value and of zero,
+  sub-ranges and the whole region, after every update the region in the emulated RAM_G has to match
+- the emulation does not run the coprocessor, the CMD_MEMSET / CMD_MEMZERO that EVE_shadow_update()
+  writes to the cmd-FIFO are captured and applied by the test
+- an update without changes sends nothing, an update never sends more than a full upload
+- after EVE_shadow_invalidate() the next update restores a region that was overwritten behind its back
+- EVE_shadow_stats() adds up to the return values of EVE_shadow_update()
+
+Build and run from the sketch directory:
+gcc -std=c99 -Wall -Wextra -DSOFTWARE_TEST -D_POSIX_C_SOURCE=200809L -I. -o test_shadow test/test_shadow.c EVE_shadow.c EVE_commands.c EVE_target.c && ./test_shadow
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "EVE.h"
+#include "EVE_shadow.h"
+
+#define REGION_ADDRESS 0x00001000UL
+#define REGION_SIZE 3000U
+#define UPDATES 3000U
+#define CAPTURE_WORDS 4096U
+
+static uint32_t failures = 0UL;
+static uint32_t random_state = 0x2545f491UL;
+static uint8_t mirror[REGION_SIZE];
+static uint8_t image[REGION_SIZE]; /* what the region has to hold */
+static uint8_t buffer[REGION_SIZE];
+static uint32_t capture[CAPTURE_WORDS];
+
+static void check(uint8_t const condition, const char * const p_what)
+{
+    if (0U == condition)
+    {
+        printf("FAIL: %s\n", p_what);
+        failures++;
+    }
+}
+
+static uint32_t next_random(uint32_t const range)
+{
+    random_state = (random_state * 1103515245UL) + 12345UL;
+    return ((random_state >> 8U) % range);
+}
+
+/* run the CMD_MEMSET / CMD_MEMZERO of the captured cmd-FIFO words on the emulated RAM_G */
+static void run_coprocessor(uint32_t const words)
+{
+    uint32_t index = 0UL;
+
+    while (index < words)
+    {
+        uint32_t const command = capture[index];
+        uint32_t address = 0UL;
+        uint32_t length = 0UL;
+        uint8_t value = 0U;
+
+        if ((CMD_MEMZERO == command) && ((index + 2UL) < words))
+        {
+            address = capture[index + 1UL];
+            length = capture[index + 2UL];
+            index += 3UL;
+        }
+        else if ((CMD_MEMSET == command) && ((index + 3UL) < words))
+        {
+            address = capture[index + 1UL];
+            value = (uint8_t) capture[index + 2UL];
+            length = capture[index + 3UL];
+            index += 4UL;
+        }
+        else
+        {
+            check(0U, "only CMD_MEMSET and CMD_MEMZERO in the cmd-FIFO");
+            index++;
+        }
+
+        if ((length > 0UL) && (length <= REGION_SIZE))
+        {
+            (void) memset(buffer, value, length);
+            EVE_memWrite_sram_buffer(address, buffer, length);
+        }
+    }
+}
+
+/* update a range and check the whole region in RAM_G */
+static uint32_t update(EVE_shadow_t * const p_shadow, uint32_t const offset, uint32_t const len)
+{
+    uint32_t sent;
+
+    EVE_test_capture(capture, CAPTURE_WORDS);
+    sent = EVE_shadow_update(p_shadow, offset, &image[offset], len);
+    run_coprocessor(EVE_test_captured());
+    EVE_test_capture(NULL, 0UL);
+
+    EVE_memRead_sram_buffer(REGION_ADDRESS, buffer, REGION_SIZE);
+    check(0 == memcmp(buffer, image, REGION_SIZE), "RAM_G matches the image after the update");
+    return (sent);
+}
+
+/* change something in the range, the kind of change is random */
+static void change(uint32_t const offset, uint32_t const len)
+{
+    uint32_t const kind = next_random(5UL);
+    uint32_t const start = offset + next_random(len);
+    uint32_t const room = (offset + len) - start;
+    uint32_t const run = 1UL + next_random((room < 200UL) ? room : 200UL);
+
+    if (0UL == kind) /* a few single bytes */
+    {
+        for (uint8_t count = 0U; count < 4U; count++)
+        {
+            image[offset + next_random(len)] = (uint8_t) next_random(256UL);
+        }
+    }
+    else if (1UL == kind) /* random bytes */
+    {
+        for (uint32_t index = 0UL; index < run; index++)
+        {
+            image[start + index] = (uint8_t) next_random(256UL);
+        }
+    }
+    else if (2UL == kind) /* a run of one value */
+    {
+        (void) memset(&image[start], (int) (1UL + next_random(255UL)), run);
+    }
+    else if (3UL == kind) /* a run of zero */
+    {
+        (void) memset(&image[start], 0, run);
+    }
+    else
+    {
+        /* nothing changes */
+    }
+}
+
+static void test_shadow_random(void)
+{
+    EVE_shadow_t shadow;
+    uint32_t sent_total = 0UL;
+    uint32_t stats_sent;
+    uint32_t stats_saved;
+
+    EVE_test_reset();
+    (void) EVE_init();
+    EVE_shadow_stats(NULL, NULL);
+
+    for (uint32_t index = 0UL; index < REGION_SIZE; index++)
+    {
+        image[index] = (uint8_t) next_random(256UL);
+    }
+    EVE_shadow_init(&shadow, REGION_ADDRESS, mirror, REGION_SIZE);
+    sent_total += update(&shadow, 0UL, REGION_SIZE);
+    check(0U != shadow.valid, "a full update makes the mirror valid");
+
+    for (uint32_t count = 0UL; count < UPDATES; count++)
+    {
+        uint32_t const whole = (0UL == next_random(4UL)) ? 1UL : 0UL;
+        uint32_t const offset = (whole != 0UL) ? 0UL : next_random(REGION_SIZE);
+        uint32_t const len = (whole != 0UL) ? REGION_SIZE : (1UL + next_random(REGION_SIZE - offset));
+        uint32_t sent;
+
+        change(offset, len);
+        sent = update(&shadow, offset, len);
+        check(sent <= (3UL + len), "never more than a full upload");
+        sent_total += sent;
+
+        sent = update(&shadow, offset, len);
+        check(0UL == sent, "nothing is sent for an unchanged range");
+
+        if (0UL == (count % 500UL)) /* like EVE_init() after a reset, RAM_G is lost */
+        {
+            (void) memset(buffer, 0xa5, REGION_SIZE);
+            EVE_memWrite_sram_buffer(REGION_ADDRESS, buffer, REGION_SIZE);
+            EVE_shadow_invalidate(&shadow);
+            check(0U == shadow.valid, "EVE_shadow_invalidate() clears valid");
+            sent_total += update(&shadow, 0UL, REGION_SIZE);
+        }
+    }
+
+    EVE_shadow_stats(&stats_sent, &stats_saved);
+    check(stats_sent == sent_total, "EVE_shadow_stats() adds up the updates");
+    check(stats_saved > 0UL, "something was saved against full uploads");
+    printf("%u updates: %lu bytes sent, %lu saved\n", (unsigned) UPDATES, (unsigned long) stats_sent,
+           (unsigned long) stats_saved);
+}
+
+int main(void)
+{
+    test_shadow_random();
+    printf("%s\n", (0UL == failures) ? "PASS" : "FAIL");
+    return ((0UL == failures) ? 0 : 1);
+}
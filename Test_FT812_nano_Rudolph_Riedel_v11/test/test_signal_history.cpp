@@ -0,0 +1,173 @@
+/*
+@file    test_signal_history.cpp
+@brief   prueba de signal_history contra un modelo de referencia de la piramide min/max
+@version 1.0
+@date    2026-10-19
+@author  Christian Lara
+
+@section info
+
+El modelo guarda todas las columnas del nivel 0 que entran a historia_agregar() y calcula cada
+columna del nivel k como el min/max de las 1, 6, 60 o 360 columnas del nivel 0 que le tocan.
+Despues de cada columna compara los bits que regresa historia_agregar() y lo que copia
+historia_copiar() en todos los niveles, las ultimas HISTORIA_COLUMNAS columnas de la mas vieja a
+la mas nueva. Con 150000 columnas el nivel de 1 h da la vuelta a su arreglo circular.
+Falla si una sola columna no es igual a la del modelo.
+
+Compilar y correr desde el directorio del sketch, con los 4 niveles y con el nivel unico de AVR:
+g++ -std=c++11 -O2 -Wall -Wextra -DSOFTWARE_TEST -I. -o test_signal_history test/test_signal_history.cpp signal_history.c && ./test_signal_history
+g++ -std=c++11 -O2 -Wall -Wextra -DSOFTWARE_TEST -DHISTORIA_NIVELES=1U -I. -o test_history_avr test/test_signal_history.cpp signal_history.c && ./test_history_avr
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- version inicial
+
+*/
+
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "signal_history.h"
+
+#define COLUMNAS_PRUEBA 150000L
+
+static const long factor[4] = {1L, 6L, 60L, 360L}; /* columnas del nivel 0 en una columna del nivel */
+
+/* las columnas completas del nivel segun el modelo, de la mas vieja a la mas nueva */
+static void modelo(std::vector<uint8_t> const &minimos, std::vector<uint8_t> const &maximos, uint8_t const nivel,
+                   std::vector<uint8_t> &p_min, std::vector<uint8_t> &p_max)
+{
+    long const completas = (long) minimos.size() / factor[nivel];
+    long const primera = (completas > (long) HISTORIA_COLUMNAS) ? (completas - (long) HISTORIA_COLUMNAS) : 0L;
+
+    p_min.clear();
+    p_max.clear();
+    for (long columna = primera; columna < completas; columna++)
+    {
+        uint8_t minimo = 0xffU;
+        uint8_t maximo = 0U;
+
+        for (long indice = columna * factor[nivel]; indice < ((columna + 1L) * factor[nivel]); indice++)
+        {
+            minimo = (minimos[indice] < minimo) ? minimos[indice] : minimo;
+            maximo = (maximos[indice] > maximo) ? maximos[indice] : maximo;
+        }
+        p_min.push_back(minimo);
+        p_max.push_back(maximo);
+    }
+}
+
+/* regresa el numero de columnas distintas al modelo */
+static long comparar(std::vector<uint8_t> const &minimos, std::vector<uint8_t> const &maximos, uint8_t const nivel)
+{
+    static uint8_t copia_min[HISTORIA_COLUMNAS];
+    static uint8_t copia_max[HISTORIA_COLUMNAS];
+    std::vector<uint8_t> ref_min;
+    std::vector<uint8_t> ref_max;
+    uint16_t const copiadas = historia_copiar(nivel, copia_min, copia_max);
+    historia_nivel_t const *const p_nivel = historia_nivel(nivel);
+    long errores = 0L;
+
+    modelo(minimos, maximos, nivel, ref_min, ref_max);
+    if ((copiadas != ref_min.size()) || (p_nivel->listas != copiadas))
+    {
+        errores++;
+    }
+    else
+    {
+        /* historia_nivel() sin copiar: la mas vieja esta en siguiente cuando el arreglo esta lleno */
+        uint16_t columna = (p_nivel->listas < HISTORIA_COLUMNAS) ? 0U : p_nivel->siguiente;
+
+        for (uint16_t indice = 0U; indice < copiadas; indice++)
+        {
+            if ((copia_min[indice] != ref_min[indice]) || (copia_max[indice] != ref_max[indice]) ||
+                (p_nivel->minimo[columna] != ref_min[indice]) || (p_nivel->maximo[columna] != ref_max[indice]))
+            {
+                errores++;
+            }
+            columna = (uint16_t) ((columna + 1U) % HISTORIA_COLUMNAS);
+        }
+    }
+    return (errores);
+}
+
+int main()
+{
+    std::mt19937 azar(12345U);
+    std::vector<uint8_t> minimos;
+    std::vector<uint8_t> maximos;
+    long errores = 0L;
+    long vueltas = 0L;
+
+    historia_init();
+    for (uint8_t nivel = 0U; nivel < HISTORIA_NIVELES; nivel++)
+    {
+        errores += comparar(minimos, maximos, nivel);
+    }
+
+    for (long cuenta = 1L; cuenta <= COLUMNAS_PRUEBA; cuenta++)
+    {
+        /* columnas angostas casi siempre, de vez en cuando un pulso que llega a los extremos */
+        uint8_t const centro = (uint8_t) (azar() % (SIGNAL_ALTO + 1U));
+        uint8_t const ancho = ((azar() % 50U) == 0U) ? (uint8_t) SIGNAL_ALTO : (uint8_t) (azar() % 4U);
+        uint8_t const minimo = (centro > ancho) ? (uint8_t) (centro - ancho) : 0U;
+        uint8_t const maximo = ((centro + ancho) > SIGNAL_ALTO) ? (uint8_t) SIGNAL_ALTO : (uint8_t) (centro + ancho);
+        uint8_t cambios_ref = 0U;
+        uint8_t const cambios = historia_agregar(minimo, maximo);
+
+        minimos.push_back(minimo);
+        maximos.push_back(maximo);
+        for (uint8_t nivel = 0U; nivel < HISTORIA_NIVELES; nivel++)
+        {
+            if (0L == (cuenta % factor[nivel]))
+            {
+                cambios_ref |= (uint8_t) (1U << nivel);
+                errores += comparar(minimos, maximos, nivel);
+                if (0L == ((cuenta / factor[nivel]) % (long) HISTORIA_COLUMNAS))
+                {
+                    vueltas++; /* el arreglo del nivel dio la vuelta */
+                }
+            }
+        }
+        if (cambios != cambios_ref)
+        {
+            errores++;
+        }
+    }
+
+    /* los niveles que no existen se limitan al ultimo */
+    if ((historia_nivel(3U) != historia_nivel(HISTORIA_NIVELES - 1U)) ||
+        (historia_ventana_s(3U) != historia_ventana_s(HISTORIA_NIVELES - 1U)))
+    {
+        errores++;
+    }
+
+    printf("%u niveles, %ld columnas, %ld vueltas de los arreglos, %ld errores\n", (unsigned) HISTORIA_NIVELES,
+           COLUMNAS_PRUEBA, vueltas, errores);
+    printf("%s\n", (0L == errores) ? "PASS" : "FAIL");
+    return ((0L == errores) ? 0 : 1);
+}
@@ -0,0 +1,158 @@
+/*
+@file    test_signal_ring.cpp
+@brief   prueba de esfuerzo de signal_ring: un productor y un consumidor en hilos distintos
+@version 1.0
+@date    2026-10-19
+@author  Christian Lara
+
+@section info
+
+El productor empuja una cuenta que sube de uno en uno, el consumidor revisa que llegue completa y
+en orden, con signal_ring_bloque() / signal_ring_consumir() y con signal_ring_pop(), para
+capacidades de 8, 64 y 4096 muestras. Falla si falta, sobra o se repite una sola muestra.
+El numero de muestras por caso es el primer argumento, 20000000 si no se da.
+
+Compilar y correr desde el directorio del sketch:
+g++ -std=c++11 -O2 -Wall -Wextra -pthread -I. -o test_signal_ring test/test_signal_ring.cpp signal_ring.c && ./test_signal_ring
+con ThreadSanitizer, con menos muestras porque es mucho mas lento:
+g++ -std=c++11 -O1 -g -fsanitize=thread -pthread -I. -o test_signal_ring_tsan test/test_signal_ring.cpp signal_ring.c && ./test_signal_ring_tsan 200000
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- version inicial
+
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include "signal_ring.h"
+
+static int16_t datos[4096];
+
+/* regresa el numero de muestras que no llegaron en orden */
+static long probar(uint16_t const capacidad, bool const con_pop, long const total)
+{
+    signal_ring_t ring;
+    long recibidas = 0L;
+    long errores = 0L;
+    long lotes = 0L;
+    long lote_max = 0L;
+    int16_t esperado = 0;
+    int16_t copia[512];
+
+    signal_ring_init(&ring, datos, capacidad);
+    auto const inicio = std::chrono::steady_clock::now();
+
+    std::thread productor([&ring, total]
+    {
+        for (long cuenta = 0L; cuenta < total;)
+        {
+            if (signal_ring_push(&ring, (int16_t) cuenta) != 0U)
+            {
+                cuenta++;
+            }
+            else
+            {
+                std::this_thread::yield(); /* lleno */
+            }
+        }
+    });
+
+    while (recibidas < total)
+    {
+        const int16_t *p_bloque = copia;
+        uint16_t cuantas;
+
+        if (con_pop)
+        {
+            cuantas = signal_ring_pop(&ring, copia, 512U);
+        }
+        else
+        {
+            cuantas = signal_ring_bloque(&ring, &p_bloque);
+        }
+        for (uint16_t indice = 0U; indice < cuantas; indice++)
+        {
+            if (p_bloque[indice] != esperado)
+            {
+                errores++;
+                esperado = p_bloque[indice]; /* se sigue desde lo que llego */
+            }
+            esperado++;
+        }
+        if (!con_pop && (cuantas > 0U))
+        {
+            signal_ring_consumir(&ring, cuantas);
+        }
+        if (cuantas > 0U)
+        {
+            lotes++;
+            lote_max = (cuantas > lote_max) ? cuantas : lote_max;
+        }
+        else
+        {
+            std::this_thread::yield(); /* vacio */
+        }
+        recibidas += cuantas;
+    }
+    productor.join();
+
+    if (recibidas != total)
+    {
+        errores++;
+    }
+    if (signal_ring_pendientes(&ring) != 0U)
+    {
+        errores++;
+    }
+
+    double const segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    printf("%s capacidad %4u: %ld muestras, %ld errores, %.0f Mmuestras/s, lote promedio %.1f, maximo %ld\n",
+           con_pop ? "pop   " : "bloque", capacidad, recibidas, errores, (double) recibidas / segundos / 1e6,
+           (double) recibidas / (double) ((lotes > 0L) ? lotes : 1L), lote_max);
+    return (errores);
+}
+
+int main(int argc, char **argv)
+{
+    long const total = (argc > 1) ? atol(argv[1]) : 20000000L;
+    uint16_t const capacidades[] = {8U, 64U, 4096U};
+    long errores = 0L;
+
+    for (int modo = 0; modo < 2; modo++)
+    {
+        for (uint16_t const capacidad : capacidades)
+        {
+            errores += probar(capacidad, 1 == modo, total);
+        }
+    }
+    printf("%s\n", (0L == errores) ? "PASS" : "FAIL");
+    return ((0L == errores) ? 0 : 1);
+}
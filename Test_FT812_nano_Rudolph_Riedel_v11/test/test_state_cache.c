@@ -0,0 +1,365 @@
+/*
+@file    test_state_cache.c
+@brief   host test for EVE_STATE_CACHE: the cmd-FIFO words of a frame with and without the cache, replayed through a model of the render state
+@version 1.0
+@date    2026-10-19
+@author  Christian Lara
+
+@section info
+
+The frame has EVE_widget_circle() / EVE_widget_rectangle(), the color + CMD_NUMBER / CMD_TEXT pattern
+of display_Reloj() twice, tags, a button, save / restore context, signal_dibujar() and canales_dibujar().
+The words written to the cmd-FIFO are captured on the SOFTWARE_TEST emulation and replayed through a
+model of COLOR_RGB, COLOR_A, LINE_WIDTH, POINT_SIZE, VERTEX_FORMAT, TAG and BEGIN, every vertex and
+every widget writes the state it sees to a trace.
+The build without the cache writes the trace to the file given as argument, the build with the cache
+compares its trace to that file and fails on the first difference.
+
+Build and run from the sketch directory, the plain build first:
+gcc -std=c99 -Wall -Wextra -DSOFTWARE_TEST -DEVE_NO_STATE_CACHE -D_POSIX_C_SOURCE=200809L -I. -o state_plain test/test_state_cache.c TFTsignal.c TFTcanales.c signal_kernels.c signal_history.c signal_ring.c EVE_supplemental.c EVE_commands.c EVE_target.c
+gcc -std=c99 -Wall -Wextra -DSOFTWARE_TEST -D_POSIX_C_SOURCE=200809L -I. -o state_cache test/test_state_cache.c TFTsignal.c TFTcanales.c signal_kernels.c signal_history.c signal_ring.c EVE_supplemental.c EVE_commands.c EVE_target.c
+./state_plain state.txt && ./state_cache state.txt
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "EVE.h"
+#include "EVE_supplemental.h"
+#include "TFTsignal.h"
+#include "TFTcanales.h"
+
+#define MAX_WORDS 8192U
+#define MODEL_STACK 4U
+#define STATE_UNKNOWN 0xffffffffUL
+
+enum
+{
+    SLOT_COLOR_RGB,
+    SLOT_COLOR_A,
+    SLOT_LINE_WIDTH,
+    SLOT_POINT_SIZE,
+    SLOT_VERTEX_FORMAT,
+    SLOT_TAG,
+    SLOT_BEGIN,
+    SLOTS
+};
+
+static uint32_t words[MAX_WORDS];
+static uint32_t model[SLOTS];
+static uint32_t model_stack[MODEL_STACK][SLOTS];
+static uint8_t model_depth = 0U;
+
+static void model_reset(void)
+{
+    model[SLOT_COLOR_RGB] = 0xffffffUL;
+    model[SLOT_COLOR_A] = 0xffUL;
+    model[SLOT_LINE_WIDTH] = 16UL;
+    model[SLOT_POINT_SIZE] = 16UL;
+    model[SLOT_VERTEX_FORMAT] = 4UL;
+    model[SLOT_TAG] = 255UL;
+    model[SLOT_BEGIN] = STATE_UNKNOWN;
+}
+
+static void trace_state(FILE * const p_file, const char * const p_what, uint32_t const word)
+{
+    fprintf(p_file, "%s %08lx:", p_what, (unsigned long) word);
+    for (uint8_t slot = 0U; slot < SLOTS; slot++)
+    {
+        fprintf(p_file, " %08lx", (unsigned long) model[slot]);
+    }
+    fprintf(p_file, "\n");
+}
+
+/* the number of parameter words of the coprocessor commands in the frame, the string of CMD_TEXT and CMD_BUTTON is extra */
+static uint32_t coprocessor(FILE * const p_file, uint32_t const index, uint32_t const count)
+{
+    uint32_t const command = words[index];
+    uint32_t params = 0UL;
+    uint8_t string = 0U;
+
+    switch (command)
+    {
+        case CMD_DLSTART:
+            model_reset();
+            break;
+        case CMD_SWAP:
+            break;
+        case CMD_FGCOLOR:
+        case CMD_BGCOLOR:
+            params = 1UL;
+            break;
+        case CMD_NUMBER:
+            params = 3UL;
+            break;
+        case CMD_TEXT:
+            params = 2UL;
+            string = 1U;
+            break;
+        case CMD_BUTTON:
+            params = 3UL;
+            string = 1U;
+            break;
+        default:
+            printf("unexpected coprocessor command %08lx\n", (unsigned long) command);
+            params = count;
+            break;
+    }
+
+    if (command != CMD_DLSTART)
+    {
+        trace_state(p_file, "widget", command);
+    }
+    if ((CMD_TEXT == command) || (CMD_NUMBER == command) || (CMD_BUTTON == command))
+    {
+        /* these leave the primitive and the vertex format to the coprocessor */
+        model[SLOT_BEGIN] = STATE_UNKNOWN;
+        model[SLOT_VERTEX_FORMAT] = STATE_UNKNOWN;
+    }
+    if (string != 0U)
+    {
+        uint32_t word;
+
+        do /* the string is padded with zeros to whole words */
+        {
+            word = words[index + 1UL + params];
+            params++;
+        } while ((((word & 0xffUL) != 0UL) && ((word & 0xff00UL) != 0UL) &&
+                  ((word & 0xff0000UL) != 0UL) && ((word & 0xff000000UL) != 0UL)) &&
+                 ((index + 1UL + params) < count));
+    }
+    return (params);
+}
+
+static void replay(FILE * const p_file, uint32_t const count)
+{
+    model_reset();
+    for (uint32_t index = 0UL; index < count; index++)
+    {
+        uint32_t const word = words[index];
+
+        if (0xffffff00UL == (word & 0xffffff00UL))
+        {
+            index += coprocessor(p_file, index, count);
+        }
+        else if ((word >> 30U) != 0UL) /* VERTEX2F or VERTEX2II */
+        {
+            trace_state(p_file, "vertex", word);
+        }
+        else
+        {
+            switch (word >> 24U)
+            {
+                case 0x04U:
+                    model[SLOT_COLOR_RGB] = word & 0xffffffUL;
+                    break;
+                case 0x10U:
+                    model[SLOT_COLOR_A] = word & 0xffUL;
+                    break;
+                case 0x0eU:
+                    model[SLOT_LINE_WIDTH] = word & 0xfffUL;
+                    break;
+                case 0x0dU:
+                    model[SLOT_POINT_SIZE] = word & 0x1fffUL;
+                    break;
+                case 0x27U:
+                    model[SLOT_VERTEX_FORMAT] = word & 0x7UL;
+                    break;
+                case 0x03U:
+                    model[SLOT_TAG] = word & 0xffUL;
+                    break;
+                case 0x1fU:
+                    model[SLOT_BEGIN] = word & 0xfUL;
+                    break;
+                case 0x21U: /* END */
+                    model[SLOT_BEGIN] = STATE_UNKNOWN;
+                    break;
+                case 0x22U: /* SAVE_CONTEXT, the primitive is not part of the context */
+                    if (model_depth < MODEL_STACK)
+                    {
+                        memcpy(model_stack[model_depth], model, sizeof(model));
+                    }
+                    model_depth++;
+                    break;
+                case 0x23U: /* RESTORE_CONTEXT */
+                    if (model_depth > 0U)
+                    {
+                        uint32_t const primitive = model[SLOT_BEGIN];
+
+                        model_depth--;
+                        if (model_depth < MODEL_STACK)
+                        {
+                            memcpy(model, model_stack[model_depth], sizeof(model));
+                        }
+                        model[SLOT_BEGIN] = primitive;
+                    }
+                    break;
+                default:
+                    break; /* CLEAR, BITMAP_xxx and so on do not change the tracked state */
+            }
+        }
+    }
+}
+
+static void build_frame(void)
+{
+    EVE_cmd_dl(CMD_DLSTART);
+    EVE_cmd_dl(DL_CLEAR_COLOR_RGB | 0x808080UL);
+    EVE_cmd_dl(DL_CLEAR | CLR_COL | CLR_STN | CLR_TAG);
+    EVE_vertex_format(0U);
+    EVE_widget_circle(60, 60, 30U, 4U, 0x0000ffUL);
+    EVE_widget_rectangle(120, 30, 80, 60, 4, 16U, 0x00ff00UL);
+
+    EVE_start_cmd_burst();
+    for (uint8_t pass = 0U; pass < 2U; pass++) /* the pattern of display_Reloj() */
+    {
+        EVE_color_rgb_burst(0x000000UL);
+        EVE_cmd_number_burst(400, (int16_t) (10 + (pass * 30)), 28, EVE_OPT_RIGHTX, 12);
+        EVE_color_rgb_burst(0x000000UL);
+        EVE_cmd_text_burst(410, (int16_t) (10 + (pass * 30)), 28, 0U, ":");
+    }
+    EVE_color_rgb_burst(0x32cd32UL);
+    EVE_cmd_fgcolor_burst(0xffa500UL);
+    EVE_tag_burst(10U);
+    EVE_cmd_button_burst(20, 115, 80U, 30U, 28U, 0U, "Touch!");
+    EVE_tag_burst(0U);
+    EVE_tag_burst(0U);
+    EVE_begin_burst(EVE_POINTS);
+    EVE_point_size_burst(80U);
+    EVE_vertex2f_burst(300, 300);
+    EVE_begin_burst(EVE_POINTS);
+    EVE_vertex2f_burst(320, 300);
+    EVE_save_context_burst();
+    EVE_color_rgb_burst(0xff0000UL);
+    EVE_vertex2f_burst(340, 300);
+    EVE_restore_context_burst();
+    EVE_vertex2f_burst(360, 300);
+    EVE_cmd_text_burst(380, 280, 28, 0U, "x"); /* the coprocessor leaves BITMAPS behind, the next BEGIN is needed */
+    EVE_begin_burst(EVE_POINTS);
+    EVE_vertex2f_burst(380, 300);
+    EVE_end_burst();
+    signal_dibujar();
+    canales_dibujar();
+    EVE_display_burst();
+    EVE_cmd_swap_burst();
+    EVE_end_cmd_burst();
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t count;
+    FILE *p_trace;
+    int ret = 0;
+
+    if (argc < 2)
+    {
+        printf("usage: %s <trace file>\n", argv[0]);
+        return (2);
+    }
+
+    EVE_test_reset();
+    (void) EVE_init();
+    signal_init(SIGNAL_MUESTRAS_S);
+    canales_init();
+    for (uint16_t frame = 0U; frame < 4375U; frame++) /* 70 s, the traces are full */
+    {
+        signal_simulador(16U);
+        signal_procesar();
+        canales_simulador(16U);
+        canales_tick(16U);
+    }
+    canales_presupuesto();
+
+    EVE_test_capture(words, MAX_WORDS);
+    build_frame();
+    count = EVE_test_captured();
+    EVE_test_capture(NULL, 0UL);
+
+#if defined (EVE_STATE_CACHE)
+    p_trace = tmpfile();
+    if (NULL == p_trace)
+    {
+        return (2);
+    }
+    replay(p_trace, count);
+    rewind(p_trace);
+    {
+        FILE * const p_plain = fopen(argv[1], "r");
+        char line_plain[160];
+        char line_cache[160];
+        uint32_t line = 0UL;
+
+        if (NULL == p_plain)
+        {
+            printf("%s not found, run the build without EVE_STATE_CACHE first\n", argv[1]);
+            return (2);
+        }
+        for (;;)
+        {
+            char * const p_a = fgets(line_plain, sizeof(line_plain), p_plain);
+            char * const p_b = fgets(line_cache, sizeof(line_cache), p_trace);
+
+            if ((NULL == p_a) || (NULL == p_b))
+            {
+                if (p_a != p_b)
+                {
+                    printf("the traces differ in length after %lu lines\n", (unsigned long) line);
+                    ret = 1;
+                }
+                break;
+            }
+            line++;
+            if (strcmp(line_plain, line_cache) != 0)
+            {
+                printf("line %lu differs\nplain: %scache: %s", (unsigned long) line, line_plain, line_cache);
+                ret = 1;
+                break;
+            }
+        }
+        (void) fclose(p_plain);
+        printf("EVE_STATE_CACHE: %lu words (%lu bytes), %lu commands dropped, %lu vertices / widgets compared\n",
+               (unsigned long) count, (unsigned long) (count * 4UL), (unsigned long) EVE_get_state_dropped(),
+               (unsigned long) line);
+    }
+    (void) fclose(p_trace);
+    printf("%s\n", (0 == ret) ? "PASS" : "FAIL");
+#else
+    p_trace = fopen(argv[1], "w");
+    if (NULL == p_trace)
+    {
+        return (2);
+    }
+    replay(p_trace, count);
+    (void) fclose(p_trace);
+    printf("plain: %lu words (%lu bytes), trace written to %s\n", (unsigned long) count, (unsigned long) (count * 4UL), argv[1]);
+#endif
+    return (ret);
+}
@@ -0,0 +1,192 @@
+/*
+@file    test_surface.c
+@brief   host test for EVE_surface with EVE_frame on the SOFTWARE_TEST emulation
+@version 1.0
+@date    2026-10-19
+@author  Christian Lara
+
+@section info
+
+The emulation runs a VSYNC every EVE_frame_period_us() on its virtual clock, the loop builds a frame
+with EVE_surface_source_burst() whenever EVE_frame_ready() returns E_OK and in between writes the
+back buffer for WRITE_US and marks it ready. The test follows which buffer the display-list on screen
+and the one waiting for its swap use, REG_DLSWAP tells when the swap happened.
+- the buffer that EVE_surface_back() hands out is never on screen or in a submitted display-list,
+  from the start to the end of the write
+- BITMAP_SOURCE in the frame is EVE_surface_address()
+- a ready buffer is on screen within three frames
+- EVE_surface_back() returns 0 while a flip is pending and a buffer again once the flip is on screen
+
+Build and run from the sketch directory:
+gcc -std=c99 -Wall -Wextra -DSOFTWARE_TEST -D_POSIX_C_SOURCE=200809L -I. -o test_surface test/test_surface.c EVE_surface.c EVE_frame.c EVE_commands.c EVE_target.c && ./test_surface
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#include <stdio.h>
+#include "EVE.h"
+#include "EVE_surface.h"
+
+#define RUN_US 2000000UL /* two seconds on the virtual clock */
+#define LOOP_US 20U
+#define WRITE_US 3000U /* the host writes the back buffer for a fifth of a frame */
+#define SURFACE_A 0x00010000UL
+#define SURFACE_B 0x00020000UL
+
+static uint32_t failures = 0UL;
+static uint32_t screen_address = SURFACE_A; /* BITMAP_SOURCE of the display-list on screen */
+static uint32_t pending_address = 0UL; /* BITMAP_SOURCE of the submitted display-list, 0 = none */
+static uint32_t ready_frame = 0UL; /* frames built since the last EVE_surface_ready(), 0 = nothing waiting */
+static uint32_t ready_address = 0UL;
+static uint32_t capture[8];
+
+static void check(uint8_t const condition, const char * const p_what)
+{
+    if (0U == condition)
+    {
+        printf("FAIL: %s\n", p_what);
+        failures++;
+    }
+}
+
+/* the submitted display-list is on screen once the emulation finished its swap */
+static void observe(void)
+{
+    if ((pending_address != 0UL) && (EVE_DLSWAP_DONE == EVE_test_read32(REG_DLSWAP)))
+    {
+        screen_address = pending_address;
+        pending_address = 0UL;
+        if ((ready_frame != 0UL) && (screen_address == ready_address))
+        {
+            ready_frame = 0UL;
+        }
+    }
+}
+
+static void build_frame(EVE_surface_t const * const p_surface)
+{
+    EVE_test_capture(capture, 8UL);
+    EVE_start_cmd_burst();
+    EVE_cmd_dl_burst(CMD_DLSTART);
+    EVE_surface_source_burst(p_surface);
+    EVE_end_cmd_burst();
+    check((capture[1U] == (DL_BITMAP_SOURCE | EVE_surface_address(p_surface))) && (2UL == EVE_test_captured()),
+          "BITMAP_SOURCE is EVE_surface_address()");
+    EVE_test_capture(NULL, 0UL);
+
+    EVE_start_cmd_burst();
+    EVE_cmd_dl_burst(DL_CLEAR | CLR_COL | CLR_STN | CLR_TAG);
+    for (uint16_t index = 0U; index < 200U; index++)
+    {
+        EVE_cmd_dl_burst(DL_COLOR_RGB | index);
+    }
+    EVE_cmd_dl_burst(DL_DISPLAY);
+    EVE_cmd_dl_burst(CMD_SWAP);
+    EVE_end_cmd_burst();
+    EVE_test_write32(REG_DLSWAP, EVE_DLSWAP_FRAME); /* the emulation does not decode CMD_SWAP */
+}
+
+static void test_surface_flip(void)
+{
+    EVE_surface_t surface;
+    uint32_t start_us;
+    uint32_t frames = 0UL;
+    uint32_t writes = 0UL;
+    uint32_t refused = 0UL;
+
+    EVE_test_reset();
+    EVE_test_write32(REG_HCYCLE, 928UL);
+    EVE_test_write32(REG_VCYCLE, 525UL);
+    EVE_test_write32(REG_PCLK, 2UL);
+    EVE_test_write32(REG_FREQUENCY, 60000000UL);
+    EVE_test_set_drain(2000UL, 125UL);
+
+    EVE_frame_init(EVE_DLSWAP_FRAME, 1U);
+    EVE_test_set_frame(EVE_frame_period_us());
+    EVE_surface_init(&surface, SURFACE_A, SURFACE_B);
+    check(SURFACE_A == EVE_surface_address(&surface), "address_a is on screen first");
+    start_us = EVE_test_time_us();
+
+    while ((EVE_test_time_us() - start_us) < RUN_US)
+    {
+        uint8_t const ready = EVE_frame_ready();
+
+        observe();
+        if (E_OK == ready)
+        {
+            EVE_surface_sync(&surface);
+            build_frame(&surface);
+            EVE_frame_submit();
+            pending_address = EVE_surface_address(&surface);
+            frames++;
+            if (ready_frame != 0UL)
+            {
+                ready_frame++;
+                check(ready_frame <= 4UL, "a ready buffer is on screen within three frames");
+            }
+            observe();
+        }
+        else
+        {
+            uint32_t const back = EVE_surface_back(&surface);
+
+            if (0UL == back)
+            {
+                check((EVE_SURFACE_FLIPPING == surface.state) && (ready_frame != 0UL), "no back buffer only while a flip is pending");
+                refused++;
+            }
+            else
+            {
+                check(0UL == ready_frame, "no back buffer before the ready one is on screen");
+                check((back != screen_address) && (back != pending_address), "the back buffer is not shown when the write starts");
+                EVE_test_delay_us(WRITE_US);
+                observe();
+                check((back != screen_address) && (back != pending_address), "the back buffer is not shown when the write ends");
+                EVE_surface_ready(&surface);
+                ready_frame = 1UL;
+                ready_address = back;
+                writes++;
+            }
+        }
+        EVE_test_delay_us(LOOP_US);
+        observe();
+    }
+
+    check(writes > (frames / 3UL), "the buffers flip");
+    printf("%lu frames, %lu buffers written, %lu times no free buffer\n", (unsigned long) frames,
+           (unsigned long) writes, (unsigned long) refused);
+}
+
+int main(void)
+{
+    test_surface_flip();
+    printf("%s\n", (0UL == failures) ? "PASS" : "FAIL");
+    return ((0UL == failures) ? 0 : 1);
+}
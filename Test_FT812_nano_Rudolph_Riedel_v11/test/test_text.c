@@ -0,0 +1,398 @@
+/*
+@file    test_text.c
+@brief   host test for EVE_text: the glyph positions of EVE_text_burst() against a reference CMD_TEXT layout
+@version 1.0
+@date    2026-10-19
+@author  Christian Lara
+
+@section info
+
+The SOFTWARE_TEST emulation has the metric blocks of the ROM fonts behind EVE_ROM_FONTROOT, the test
+writes widths of 3 to 25 pixels with many odd ones and a height of 41 there and loads font 29
+with EVE_text_load(), the sketch has EVE_TEXT_FONTS 1U. The reference is the layout of CMD_TEXT: the string starts at x, RIGHTX moves it
+left by its width, CENTERX by half of it and CENTERY moves it up by half the font height, the halves
+rounded down, the characters advance by the width from the metric block, a space has no glyph.
+The words EVE_text_burst() writes to the cmd-FIFO are captured and decoded, VERTEX_TRANSLATE_X / _Y
+included, into the pixel position, font and character of every glyph, these have to be the same.
+- 5000 random strings, x from -150 to 1100 and y from -100 to 700, every combination of the options
+- strings of one character with odd and even widths for CENTERX and CENTERY with the odd height
+- strings that cross x = 511 and y = 511, these need VERTEX_TRANSLATE and have to set it back after
+- labels after EVE_text_origin_burst() keep absolute coordinates
+- EVE_text_compile() writes the same words as EVE_text_burst()
+- a second font is not loaded and goes to CMD_TEXT, relative to the origin
+
+Build and run from the sketch directory:
+gcc -std=c99 -Wall -Wextra -DSOFTWARE_TEST -D_POSIX_C_SOURCE=200809L -I. -o test_text test/test_text.c EVE_text.c EVE_commands.c EVE_target.c && ./test_text
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "EVE.h"
+#include "EVE_text.h"
+
+#define STRINGS 5000U
+#define LENGTH_MAX 60U
+#define CAPTURE_WORDS 512U
+#define GLYPHS_MAX 256U
+#define METRIC_SIZE 148UL
+#define METRIC_HEIGHT 140UL
+#define FONT 29U /* 12 + 29 = 41 pixels high */
+#define FONT_OTHER 26U
+
+typedef struct
+{
+    int32_t x;
+    int32_t y;
+    uint8_t font;
+    uint8_t character;
+} glyph_t;
+
+static uint32_t failures = 0UL;
+static uint32_t random_state = 0x6b43a9b5UL;
+static uint8_t widths[32U][128U]; /* the metric blocks as the test wrote them */
+static uint8_t heights[32U];
+static uint32_t capture[CAPTURE_WORDS];
+static uint32_t compiled[CAPTURE_WORDS];
+static glyph_t expected[GLYPHS_MAX];
+static glyph_t decoded[GLYPHS_MAX];
+static uint32_t translated = 0UL; /* strings that needed VERTEX_TRANSLATE */
+
+static const uint16_t options[] = {0U, EVE_OPT_CENTERX, EVE_OPT_CENTERY, EVE_OPT_CENTER, EVE_OPT_RIGHTX,
+                                   EVE_OPT_RIGHTX | EVE_OPT_CENTERY, EVE_OPT_RIGHTX | EVE_OPT_CENTERX,
+                                   EVE_OPT_RIGHTX | EVE_OPT_CENTER};
+
+static void check(uint8_t const condition, const char * const p_what)
+{
+    if (0U == condition)
+    {
+        printf("FAIL: %s\n", p_what);
+        failures++;
+    }
+}
+
+static uint32_t next_random(uint32_t const range)
+{
+    random_state = (random_state * 1103515245UL) + 12345UL;
+    return ((random_state >> 8U) % range);
+}
+
+/* widths for every character of the ROM fonts, the height of the font at offset 140 */
+static void write_metrics(void)
+{
+    uint32_t const root = EVE_test_read32(EVE_ROM_FONTROOT);
+
+    for (uint8_t font = 16U; font < 32U; font++)
+    {
+        uint32_t const block = root + (METRIC_SIZE * ((uint32_t) font - 16UL));
+
+        for (uint8_t character = 0U; character < 128U; character++)
+        {
+            widths[font][character] = (uint8_t) (3UL + next_random(23UL));
+        }
+        for (uint8_t index = 0U; index < 128U; index += 4U)
+        {
+            EVE_test_write32(block + index, ((uint32_t) widths[font][index]) | ((uint32_t) widths[font][index + 1U] << 8U) |
+                             ((uint32_t) widths[font][index + 2U] << 16U) | ((uint32_t) widths[font][index + 3U] << 24U));
+        }
+        heights[font] = (uint8_t) (12U + font); /* odd and even */
+        EVE_test_write32(block + METRIC_HEIGHT, heights[font]);
+    }
+}
+
+/* where CMD_TEXT puts the glyphs */
+static uint16_t reference(int32_t xc0, int32_t yc0, uint8_t const font, uint16_t const option, const char * const p_text)
+{
+    const uint8_t * const p_bytes = (const uint8_t *) p_text;
+    int32_t width = 0;
+    uint16_t count = 0U;
+
+    for (uint16_t index = 0U; p_bytes[index] != 0U; index++)
+    {
+        if ((p_bytes[index] >= 32U) && (p_bytes[index] < 128U))
+        {
+            width += widths[font][p_bytes[index]];
+        }
+    }
+
+    if ((option & EVE_OPT_RIGHTX) != 0U)
+    {
+        xc0 -= width;
+    }
+    else if ((option & EVE_OPT_CENTERX) != 0U)
+    {
+        xc0 -= width / 2;
+    }
+    else
+    {
+        /* starts at x */
+    }
+    if ((option & EVE_OPT_CENTERY) != 0U)
+    {
+        yc0 -= heights[font] / 2;
+    }
+
+    for (uint16_t index = 0U; p_bytes[index] != 0U; index++)
+    {
+        uint8_t const character = p_bytes[index];
+
+        if ((character > 32U) && (character < 128U) && (count < GLYPHS_MAX))
+        {
+            expected[count].x = xc0;
+            expected[count].y = yc0;
+            expected[count].font = font;
+            expected[count].character = character;
+            count++;
+        }
+        if ((character >= 32U) && (character < 128U))
+        {
+            xc0 += widths[font][character];
+        }
+    }
+    return (count);
+}
+
+static int32_t translate_pixels(uint32_t const word)
+{
+    int32_t value = (int32_t) (word & 0x1ffffUL);
+
+    if ((word & 0x10000UL) != 0UL)
+    {
+        value -= 0x20000L;
+    }
+    return (value / 16);
+}
+
+/* the glyphs in the captured words, the translation has to be back at the origin at the end */
+static uint16_t decode(uint32_t const words, int32_t const origin_x, int32_t const origin_y)
+{
+    int32_t translate_x = origin_x;
+    int32_t translate_y = origin_y;
+    uint16_t count = 0U;
+    uint8_t begun = 0U;
+    uint8_t moved = 0U;
+
+    for (uint32_t index = 0UL; index < words; index++)
+    {
+        uint32_t const word = capture[index];
+
+        if (2UL == (word >> 30U)) /* VERTEX2II */
+        {
+            check(begun, "BEGIN(BITMAPS) before the first glyph");
+            if (count < GLYPHS_MAX)
+            {
+                decoded[count].x = translate_x + (int32_t) ((word >> 21U) & 0x1ffUL);
+                decoded[count].y = translate_y + (int32_t) ((word >> 12U) & 0x1ffUL);
+                decoded[count].font = (uint8_t) ((word >> 7U) & 0x1fUL);
+                decoded[count].character = (uint8_t) (word & 0x7fUL);
+                count++;
+            }
+        }
+        else if ((DL_VERTEX_TRANSLATE_X >> 24U) == (word >> 24U))
+        {
+            translate_x = translate_pixels(word);
+            moved = 1U;
+        }
+        else if ((DL_VERTEX_TRANSLATE_Y >> 24U) == (word >> 24U))
+        {
+            translate_y = translate_pixels(word);
+            moved = 1U;
+        }
+        else if ((DL_BEGIN | EVE_BITMAPS) == word)
+        {
+            begun = 1U;
+        }
+        else
+        {
+            check(0U, "only BEGIN, VERTEX_TRANSLATE and VERTEX2II");
+        }
+    }
+    check(((translate_x == origin_x) && (translate_y == origin_y)) ? 1U : 0U, "VERTEX_TRANSLATE is set back");
+    translated += moved;
+    return (count);
+}
+
+/* EVE_text_burst() against the reference, returns 1 for the same glyphs */
+static uint8_t same_layout(int16_t const xc0, int16_t const yc0, uint8_t const font, uint16_t const option,
+                           const char * const p_text, int16_t const origin_x, int16_t const origin_y)
+{
+    uint16_t const count = reference(xc0, yc0, font, option, p_text);
+    uint32_t words;
+    uint16_t glyphs;
+    uint8_t ret;
+
+    EVE_state_invalidate(); /* every label starts with its BEGIN */
+    EVE_test_capture(capture, CAPTURE_WORDS);
+    EVE_start_cmd_burst();
+    EVE_text_burst(xc0, yc0, font, option, p_text);
+    EVE_end_cmd_burst();
+    words = EVE_test_captured();
+    EVE_test_capture(NULL, 0UL);
+
+    glyphs = decode(words, origin_x, origin_y);
+    ret = ((glyphs == count) && (0 == memcmp(decoded, expected, count * sizeof(glyph_t)))) ? 1U : 0U;
+
+    if ((0 == origin_x) && (0 == origin_y))
+    {
+        uint16_t const compiled_words = EVE_text_compile(xc0, yc0, font, option, p_text, compiled, CAPTURE_WORDS);
+
+        check(((compiled_words == words) && (0 == memcmp(compiled, capture, words * sizeof(uint32_t)))) ? 1U : 0U,
+              "EVE_text_compile() writes the same words as EVE_text_burst()");
+    }
+    if (0U == ret)
+    {
+        printf("\"%s\" at %d / %d, font %u, options 0x%04x: %u glyphs, %u expected\n", p_text, xc0, yc0, font, option,
+               glyphs, count);
+    }
+    return (ret);
+}
+
+static void test_random(void)
+{
+    char text[LENGTH_MAX + 1U];
+
+    for (uint16_t count = 0U; count < STRINGS; count++)
+    {
+        uint32_t const length = next_random(LENGTH_MAX);
+        int16_t const xc0 = (int16_t) ((int32_t) next_random(1251UL) - 150);
+        int16_t const yc0 = (int16_t) ((int32_t) next_random(801UL) - 100);
+
+        for (uint32_t index = 0UL; index < length; index++)
+        {
+            text[index] = (char) ((0UL == next_random(8UL)) ? ' ' : (char) (33UL + next_random(94UL)));
+        }
+        text[length] = 0;
+        check(same_layout(xc0, yc0, FONT, options[next_random(sizeof(options) / sizeof(options[0U]))], text, 0, 0),
+              "random strings have the layout of CMD_TEXT");
+    }
+}
+
+/* half of an odd width or height is rounded down, like CMD_TEXT does it */
+static void test_rounding(void)
+{
+    char text[2U] = {0, 0};
+    uint8_t odd = 0U;
+    uint8_t even = 0U;
+
+    for (uint8_t character = 33U; character < 128U; character++)
+    {
+        uint16_t const width = widths[FONT][character];
+
+        text[0U] = (char) character;
+        odd |= (uint8_t) (width & 1U);
+        even |= (uint8_t) ((width & 1U) ^ 1U);
+        check(same_layout(100, 100, FONT, EVE_OPT_CENTERX, text, 0, 0), "CENTERX of one character");
+        check(same_layout(-7, 300, FONT, EVE_OPT_CENTER, text, 0, 0), "CENTER of one character left of the screen");
+        check(same_layout(300, 0, FONT, EVE_OPT_CENTERY, text, 0, 0), "CENTERY above the screen");
+        check(same_layout(500, 515, FONT, EVE_OPT_RIGHTX | EVE_OPT_CENTERY, text, 0, 0), "RIGHTX of one character");
+    }
+    check((odd & even), "the font has odd and even widths");
+    check((heights[FONT] & 1U), "the font has an odd height");
+    check((100 - (int32_t) (EVE_text_width(FONT, "!") / 2U)) == (100 - (widths[FONT]['!'] / 2)) ? 1U : 0U,
+          "EVE_text_width() uses the widths of the metric block");
+}
+
+/* strings that go past 511 need VERTEX_TRANSLATE in the middle of the string */
+static void test_translate(void)
+{
+    static const char text[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ abcdefghijklmnopqrstuvwxyz";
+    uint32_t const before = translated;
+
+    for (int16_t xc0 = 380; xc0 <= 530; xc0++)
+    {
+        check(same_layout(xc0, 200, FONT, 0U, text, 0, 0), "a string across x = 511");
+        check(same_layout((int16_t) (xc0 + 300), 200, FONT, EVE_OPT_CENTERX, text, 0, 0), "a centered string across x = 511");
+        check(same_layout(xc0, (int16_t) (xc0 + 120), FONT, EVE_OPT_RIGHTX | EVE_OPT_CENTERY, text, 0, 0),
+              "RIGHTX and CENTERY across y = 511");
+    }
+    check(same_layout(0, 0, FONT, EVE_OPT_RIGHTX, text, 0, 0), "a string left of the screen");
+    check((translated > before) ? 1U : 0U, "the strings needed VERTEX_TRANSLATE");
+
+    EVE_start_cmd_burst();
+    EVE_text_origin_burst(466, 300);
+    EVE_end_cmd_burst();
+    for (int16_t xc0 = 400; xc0 <= 900; xc0 += 7)
+    {
+        check(same_layout(xc0, 310, FONT, EVE_OPT_CENTER, "12:34:56", 466, 300), "absolute coordinates with an origin");
+        check(same_layout(xc0, 1000, FONT, EVE_OPT_RIGHTX, "12:34", 466, 300), "far from the origin");
+    }
+    EVE_start_cmd_burst();
+    EVE_text_origin_burst(0, 0);
+    EVE_end_cmd_burst();
+}
+
+/* without a free slot the font stays with the coprocessor */
+static void test_fallback(void)
+{
+    uint32_t words;
+
+    check((E_NOT_OK == EVE_text_load(FONT_OTHER)) ? 1U : 0U, "EVE_TEXT_FONTS is 1");
+    check((0U == EVE_text_width(FONT_OTHER, "12:34")) ? 1U : 0U, "EVE_text_width() of a font that is not loaded");
+
+    EVE_start_cmd_burst();
+    EVE_text_origin_burst(100, 50);
+    EVE_end_cmd_burst();
+    EVE_test_capture(capture, CAPTURE_WORDS);
+    EVE_start_cmd_burst();
+    EVE_text_burst(130, 60, FONT_OTHER, EVE_OPT_CENTER, "12:34");
+    EVE_text_burst(130, 60, FONT, EVE_OPT_FLAT, "12:34");
+    EVE_end_cmd_burst();
+    words = EVE_test_captured();
+    EVE_test_capture(NULL, 0UL);
+    EVE_start_cmd_burst();
+    EVE_text_origin_burst(0, 0);
+    EVE_end_cmd_burst();
+
+    check(((words > 6UL) && (CMD_TEXT == capture[0U]) && (0x000a001eUL == capture[1U]) &&
+           ((((uint32_t) EVE_OPT_CENTER << 16U) | FONT_OTHER) == capture[2U])) ? 1U : 0U,
+          "a font that is not loaded goes to CMD_TEXT relative to the origin");
+    check(((words > 8UL) && (CMD_TEXT == capture[5U]) &&
+           ((((uint32_t) EVE_OPT_FLAT << 16U) | FONT) == capture[7U])) ? 1U : 0U,
+          "other options go to CMD_TEXT");
+}
+
+int main(void)
+{
+    EVE_test_reset();
+    (void) EVE_init();
+    write_metrics();
+    check((E_OK == EVE_text_load(FONT)) ? 1U : 0U, "EVE_text_load()");
+    check((E_OK == EVE_text_load(FONT)) ? 1U : 0U, "EVE_text_load() of a loaded font");
+    check((heights[FONT] == EVE_text_height(FONT)) ? 1U : 0U, "EVE_text_height() reads the metric block");
+
+    test_random();
+    test_rounding();
+    test_translate();
+    test_fallback();
+    printf("%lu labels needed VERTEX_TRANSLATE\n", (unsigned long) translated);
+    printf("%s\n", (0UL == failures) ? "PASS" : "FAIL");
+    return ((0UL == failures) ? 0 : 1);
+}
@@ -0,0 +1,121 @@
+/*
+@file    test_touch.c
+@brief   host test for EVE_touch on the SOFTWARE_TEST emulation
+@version 1.0
+@date    2026-10-19
+@author  Christian Lara
+
+@section info
+
+- without an interrupt EVE_touch_service() does not transfer anything
+- touch, move and release from EVE_test_touch() / EVE_test_release() go through EVE_touch_isr() into the queue,
+  EVE_INT_CONVCOMPLETE is only in REG_INT_MASK while the screen is touched
+- a full queue counts the lost events in EVE_touch_dropped()
+
+Build and run from the sketch directory:
+gcc -std=c99 -Wall -Wextra -DSOFTWARE_TEST -D_POSIX_C_SOURCE=200809L -I. -o test_touch test/test_touch.c EVE_touch.c EVE_commands.c EVE_target.c && ./test_touch
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#include <stdio.h>
+#include "EVE.h"
+#include "EVE_touch.h"
+
+static uint32_t failures = 0UL;
+
+static void check(uint8_t const condition, const char * const p_what)
+{
+    if (0U == condition)
+    {
+        printf("FAIL: %s\n", p_what);
+        failures++;
+    }
+}
+
+static void test_touch_queue(void)
+{
+    EVE_touch_event_t event;
+    uint32_t transactions;
+
+    EVE_test_reset();
+    (void) EVE_init();
+    EVE_test_set_int_handler(EVE_touch_isr);
+    EVE_touch_init();
+
+    transactions = EVE_test_transactions();
+    check(E_NOT_OK == EVE_touch_service(), "no interrupt, no event");
+    check(transactions == EVE_test_transactions(), "no interrupt, no SPI transfer");
+    check(E_NOT_OK == EVE_touch_get(&event), "the queue starts empty");
+
+    EVE_test_touch(100, 200, 10U);
+    check(E_OK == EVE_touch_service(), "touch down is serviced");
+    check(E_OK == EVE_touch_get(&event), "touch down is queued");
+    check((100 == event.xc0) && (200 == event.yc0) && (10U == event.tag), "touch down has x, y and tag");
+    check((event.flags & EVE_INT_TOUCH) != 0U, "touch down has EVE_INT_TOUCH");
+    check((EVE_test_read32(REG_INT_MASK) & EVE_INT_CONVCOMPLETE) != 0UL, "EVE_INT_CONVCOMPLETE while touched");
+
+    EVE_test_touch(110, 205, 10U); /* only EVE_INT_CONVCOMPLETE */
+    check(E_OK == EVE_touch_service(), "movement is serviced");
+    check((E_OK == EVE_touch_get(&event)) && (110 == event.xc0) && (205 == event.yc0), "movement is queued");
+
+    EVE_test_release();
+    check(E_OK == EVE_touch_service(), "release is serviced");
+    check((E_OK == EVE_touch_get(&event)) && (EVE_TOUCH_NONE == event.xc0) && (0U == event.tag), "release is queued");
+    check((EVE_test_read32(REG_INT_MASK) & EVE_INT_CONVCOMPLETE) == 0UL, "no EVE_INT_CONVCOMPLETE after the release");
+
+    transactions = EVE_test_transactions();
+    check(E_NOT_OK == EVE_touch_service(), "nothing after the release");
+    check(transactions == EVE_test_transactions(), "no SPI transfer after the release");
+
+    for (int16_t step = 0; step < (int16_t) (EVE_TOUCH_QUEUE_SIZE + 3U); step++)
+    {
+        EVE_test_touch((int16_t) (10 + step), 20, 0U);
+        (void) EVE_touch_service();
+    }
+    check((EVE_TOUCH_QUEUE_SIZE - 1U) == 7U, "the test expects a queue of 8");
+    check(4U == EVE_touch_dropped(), "a full queue drops the events that do not fit");
+    for (uint8_t count = 0U; count < (EVE_TOUCH_QUEUE_SIZE - 1U); count++)
+    {
+        check(E_OK == EVE_touch_get(&event), "the queue holds EVE_TOUCH_QUEUE_SIZE - 1 events");
+        check((int16_t) (10 + count) == event.xc0, "the queue keeps the order");
+    }
+    check(E_NOT_OK == EVE_touch_get(&event), "the queue is empty again");
+    EVE_test_release();
+    (void) EVE_touch_service();
+    EVE_test_set_int_handler(NULL);
+}
+
+int main(void)
+{
+    test_touch_queue();
+    printf("%s\n", (0UL == failures) ? "PASS" : "FAIL");
+    return ((0UL == failures) ? 0 : 1);
+}
@@ -1,8 +1,8 @@
 /*
 @file    tft.c
 @brief   TFT handling functions for EVE_Test project
-@version 1.25
-@date    2025-04-20
+@version 1.42
+@date    2026-10-19
 @author  Rudolph Riedel
 @section History
 
@@ -30,16 +30,74 @@
   the second is for all other architectures which do not benefit as much from using these functions,
 1.25
 - first minimum changes for BT820
+1.26
+- split TFT_display() into the state update and tft_build_frame(), with EVE_FRAME_HASH the frame
+  is sent with EVE_burst_frame() which drops frames that are identical to the one on screen
+1.27
+- frames are paced by EVE_frame_ready() from loop() instead of millis(), the clock advances by
+  the panel frames that passed, TFT_DLSWAP selects the swap policy
+1.28
+- TFT_touch() takes the events from EVE_touch_get() instead of polling REG_TOUCH_TAG
+1.29
+- TFT_touch() feeds EVE_gesture_update() while the screen is touched, a swipe left / right selects
+  the point, display_Selector_de_Puntos() moved from the static part to tft_build_frame()
+1.30
+- the coprocessor state from TFT_init() is recorded with EVE_journal_begin() / EVE_journal_end()
+  so EVE_busy() can restore it after a coprocessor fault without running TFT_init() again
+1.31
+- the Metal signal graph shows the detector trace from TFTsignal, fed by signal_simulador() until
+  there is an ADC
+1.32
+- TFT_SIGNAL_BITMAP selects the scrolling-bitmap mode of TFTsignal, the trace is kept at MEM_SIGNAL
+1.33
+- a swipe up / down changes the window of the Metal signal graph between the levels of signal_history,
+  the "-60s" label is drawn by display_Ventana_Grafica() in tft_build_frame()
+1.34
+- a long press switches to the overview of all six points from TFTcanales, canales_presupuesto()
+  sizes the traces to the display-list space the rest of the frame leaves
+1.35
+- initStaticBackground() records the top panel, the separator line and the axes of the graph with
+  EVE_batch, the rectangles share one BEGIN, the text is drawn after the batch
+1.36
+- the picture rotates again while the button is active, the transform is calculated with EVE_matrix
+  and goes to the display list as BITMAP_TRANSFORM_A...F, no CMD_ROTATE / CMD_SETMATRIX
+1.37
+- the logo and the picture get a bitmap handle from EVE_handles in TFT_init(), the frame no longer
+  sends CMD_SETBITMAP for the picture and the static part draws the logo with VERTEX2II
+1.38
+- the " : " of the clock are laid out by EVE_text from the metrics of RELOJ_FONT, the frame sends
+  VERTEX2II for them instead of twelve CMD_TEXT
+1.39
+- "Ningún usuario" is drawn from the glyph cache of EVE_glyphcache, RAM_G only holds the glyphs
+  of glifos_usuario at MEM_GLIFOS, the unused MEM_FONT and TEST_UTF8 are gone
+1.40
+- the long press into the overview calls canales_vista_nueva(), the first plan no longer measures a frame of the other view
+1.41
+- the glyph cache only holds the pinned glyphs of TEXTO_USUARIO, EVE_glyphcache_commit() is no longer called
+  after every frame as pinned cells do not age
+1.42
+- the long press only switches to the overview when it did not start on a tagged object like the "Touch!" button
  */
 
 #include "EVE.h"
 #include "EVE_supplemental.h"
+#include "EVE_batch.h"
+#include "EVE_matrix.h"
+#include "EVE_handles.h"
+#include "EVE_text.h"
+#include "EVE_glyphcache.h"
+#include "EVE_frame.h"
+#include "EVE_touch.h"
+#include "EVE_gesture.h"
 #include "tft_data.h"
 #include "tft.h"
 #include "colores.h"
 #include "TFTdisplay.h"
+#include "TFTsignal.h"
+#include "signal_history.h"
+#include "TFTcanales.h"
 
-#define TEST_UTF8 0
+#define TFT_SIGNAL_BITMAP 1 /* 1: la grafica es un bitmap en RAM_G, una columna por escritura, 0: vertices */
 
 
 /* some pre-definded colors */
@@ -56,7 +114,8 @@
 */
 
 /* memory-map defines */
-#define MEM_FONT 0x000f7e00 /* the .xfont file for the UTF-8 font is copied here */
+#define MEM_GLIFOS 0x000f5000 /* glyph cache, EVE_glyphcache_size() bytes, 480 for 10 cells of glifos_usuario */
+#define MEM_SIGNAL 0x000f6000 /* bitmap of the signal graph, needs SIGNAL_BITMAP_SIZE bytes, 5282 for L1 */
 #define MEM_LOGO 0x000f8000 /* start-address of logo, needs 6272 bytes of memory */
 #define MEM_PIC1 0x000fa000 /* start of 100x100 pixel test image, ARGB565, needs 20000 bytes of memory */
 
@@ -67,9 +126,20 @@ uint8_t tft_active = 0;
 //uint16_t num_profile_a = 0;
 //uint16_t num_profile_b = 0;
 uint16_t toggle_state = 0;
-uint16_t horas,minutos,segundos,mseg,display_list_size = 0;
+uint16_t rotate = 0; /* angle of the picture in 1/65536 of a circle */
+
+static const EVE_asset_t asset_logo = {MEM_LOGO, EVE_ARGB1555, 56U, 56U, 0U, 0U};
+static const EVE_asset_t asset_pic1 = {MEM_PIC1, EVE_RGB565, 100U, 100U, 0U, 0U};
+static uint8_t handle_logo = 0U; /* from EVE_handle_assign() in TFT_init() */
+static uint8_t handle_pic1 = 0U;
+uint16_t horas,minutos,segundos,mseg = 0;
+uint8_t punto = 1; /* punto seleccionado {1-6}, se cambia deslizando a la izquierda / derecha */
+uint8_t vista_general = 0; /* 1: las graficas de los seis puntos, se cambia con una presion larga */
 
 #define LAYOUT_Y1 66
+#define TEXTO_USUARIO "Ningún usuario" /* tft_glifos.c tiene que tener todos sus caracteres */
+
+#define TFT_DLSWAP EVE_DLSWAP_FRAME /* EVE_DLSWAP_FRAME: swap with VSYNC, EVE_DLSWAP_LINE: swap right away, may tear */
 
 
 void touch_calibrate(void);
@@ -221,44 +291,51 @@ void touch_calibrate(void)
 
 
 void initStaticBackground(void){
+    EVE_batch_t lote; /* only needed until EVE_batch_flush(), the storage is on the stack */
+    EVE_batch_segment_t segmentos[4];
+    uint32_t vertices[8];
+
     EVE_cmd_dlstart(); /* Start the display list */
     EVE_tag(0); /* tag = 0 - do not use the following objects for touch-detection */
-    EVE_cmd_bgcolor(WHITE); /* light grey */
     EVE_vertex_format(_FRAC_PRESICION); /* set to 0 - reduce precision for VERTEX2F to 1 pixel instead of 1/16 pixel default */
 
+    /* the panel, the separator and the axes do not overlap, the rectangles are drawn together */
+    EVE_batch_init(&lote, segmentos, 4U, vertices, 8U);
+    EVE_batch_independent(&lote, 1U);
+
     /* PANEL TOP_PRTAL INICIO,,---------- draw a rectangle on top */
-    EVE_begin(EVE_RECTS);
-    EVE_line_width(1U*PRESICION); /* size is in 1/16 pixel */
-    EVE_color_rgb(COLOR_PANEL_TOP_PORTAL_INICIO);
-    EVE_vertex2f(0, 0); /* set to 0 / 0 */
-    EVE_vertex2f(EVE_HSIZE*PRESICION,Y_PANEL_TOP*PRESICION);
-    EVE_end();
+    EVE_batch_begin(&lote, EVE_RECTS);
+    EVE_batch_line_width(&lote, 1U*PRESICION); /* size is in 1/16 pixel */
+    EVE_batch_color_rgb(&lote, COLOR_PANEL_TOP_PORTAL_INICIO);
+    EVE_batch_vertex2f(&lote, 0, 0); /* set to 0 / 0 */
+    EVE_batch_vertex2f(&lote, EVE_HSIZE*PRESICION,Y_PANEL_TOP*PRESICION);
+
+    /* draw a black line to separate things */
+    EVE_batch_begin(&lote, EVE_LINES);
+    EVE_batch_color_rgb(&lote, DARK_ORANGE);
+    EVE_batch_vertex2f(&lote, 0,Y_PANEL_TOP*PRESICION);
+    EVE_batch_vertex2f(&lote, EVE_HSIZE*PRESICION,Y_PANEL_TOP*PRESICION);
+
+    display_Grafica_Signal_ejes(&lote); /* the axes of the graph */
+    (void) EVE_batch_flush(&lote);
 
     /* display the logo */
     EVE_color_rgb(BLUE);
     EVE_begin(EVE_BITMAPS);
-    EVE_cmd_setbitmap(MEM_LOGO, EVE_ARGB1555, 56U, 56U);
-    EVE_vertex2f(X_LOGO*PRESICION,Y_LOGO*PRESICION); //EVE_HSIZE - 78, 5);
-    EVE_end();
-
-    /* draw a black line to separate things */
-    EVE_color_rgb(DARK_ORANGE);
-    EVE_begin(EVE_LINES);
-    EVE_vertex2f(0,Y_PANEL_TOP*PRESICION);
-    EVE_vertex2f(EVE_HSIZE*PRESICION,Y_PANEL_TOP*PRESICION);
+    EVE_vertex2ii(X_LOGO, Y_LOGO, handle_logo, 0U); /* the handle is set up by the prologue of the first frame */
     EVE_end();
 
     EVE_color_rgb(BLACK); 
-    EVE_cmd_text(X_USER*PRESICION, Y_USER*PRESICION, USER_FONT_SIZE, EVE_OPT_CENTERX, "Ningun Usuario");
-    EVE_cmd_text(X_USER*PRESICION+1, Y_USER*PRESICION+1, USER_FONT_SIZE, EVE_OPT_CENTERX, "Ningun Usuario");
+    (void) EVE_glyphcache_pin(TEXTO_USUARIO); /* los glifos del static DL no se reemplazan */
+    EVE_glyphcache_text(X_USER, Y_USER, EVE_OPT_CENTERX, TEXTO_USUARIO);
+    EVE_glyphcache_text(X_USER+1, Y_USER+1, EVE_OPT_CENTERX, TEXTO_USUARIO);
     
 
     /* add the static text to the list */
     
     EVE_cmd_text_bold(80,Y_PANEL_TOP+25, PRODUCT_FONT_SIZE, 0, "1: Product 1");
     display_Param_Punto_1();
-    display_Graphica_Signal();//Dibuja la Grafica de Signal.
-    display_Selector_de_Puntos(0,1);//dibuja la Parte de Seleccion de Puntos
+    display_letras_de_Grafica_Signal(); /* the axes are in the batch above */
 
     EVE_execute_cmd();
     num_dl_static = EVE_memRead16(REG_CMD_DL);
@@ -273,9 +350,28 @@ void TFT_init(void){
         tft_active = 1;horas=12,minutos=0;segundos=0;mseg=0;
         EVE_memWrite32(REG_PWM_DUTY, 0x30);  /* setup backlight, range is from 0 = off to 0x80 = max */
         touch_calibrate();
+#if defined (EVE_JOURNAL)
+        EVE_journal_begin(); /* estado del coprocesador que se pierde si EVE_busy() lo resetea por una falla */
+#endif
+        EVE_cmd_bgcolor(WHITE);
+#if defined (EVE_JOURNAL)
+        (void) EVE_journal_end(); /* el static DL en MEM_DL_STATIC y las imagenes en RAM_G no se pierden */
+#endif
         EVE_cmd_inflate(MEM_LOGO, logo, sizeof(logo)); /* load logo into gfx-memory and de-compress it */
         EVE_cmd_loadimage(MEM_PIC1, EVE_OPT_NODL, pic, sizeof(pic));
+        handle_logo = EVE_handle_assign(&asset_logo);
+        handle_pic1 = EVE_handle_assign(&asset_pic1);
+        (void) EVE_text_load(RELOJ_FONT); /* sin la fuente el reloj sigue con CMD_TEXT */
+        (void) EVE_glyphcache_init(&glifos_usuario, MEM_GLIFOS); /* la fuente UTF-8 queda en el flash del Nano */
         initStaticBackground();
+        EVE_frame_init(TFT_DLSWAP, 1U); /* a new frame with every VSYNC */
+        EVE_touch_init(); /* touch events by INT_N instead of polling */
+        EVE_gesture_init();
+        signal_init(SIGNAL_MUESTRAS_S);
+        canales_init();
+#if TFT_SIGNAL_BITMAP
+        signal_modo_bitmap(MEM_SIGNAL);
+#endif
     }//------------------------------------------------------------------
 }//-----------------------------------------------------------------------------------------------------
 
@@ -283,37 +379,50 @@ void TFT_init(void){
 /* check for touch events and setup vars for TFT_display() */
 void TFT_touch(void)
 {if(tft_active != 0){
-        uint32_t tag;
+        EVE_touch_event_t event;
         static uint8_t toggle_lock = 0;
-
-        if(EVE_IS_BUSY == EVE_busy()){ /* is EVE still processing the last display list? */
-             return;}
-        display_list_size = EVE_memRead16(REG_CMD_DL); /* debug-information, get the size of the last generated display-list */
-        tag = EVE_memRead32(REG_TOUCH_TAG); /* read the value for the first touch point */
-        switch(tag){
-            case 0:toggle_lock = 0;break;
-            case 10:if(0 == toggle_lock){/* use button on top as on/off toggle-switch */
-                        toggle_lock = 42;
-                        if(0 == toggle_state){
-                             toggle_state = EVE_OPT_FLAT;}
-                        else{toggle_state = 0;}}
-                    break;
-            default:break;}}
+        static uint8_t touched = 0;
+
+        while(E_OK == EVE_touch_get(&event)){ /* EVE_touch_service() in loop() fills the queue, no SPI here */
+            touched = (event.xc0 != EVE_TOUCH_NONE) ? 1U : 0U;
+            switch(event.tag){
+                case 0:toggle_lock = 0;break;
+                case 10:if(0 == toggle_lock){/* use button on top as on/off toggle-switch */
+                            toggle_lock = 42;
+                            if(0 == toggle_state){
+                                 toggle_state = EVE_OPT_FLAT;}
+                            else{toggle_state = 0;}}
+                        break;
+                default:break;}}
+
+        if((touched != 0U) || (EVE_gesture_active() != 0U)){ /* una sola lectura SPI por frame mientras se toca la pantalla */
+            EVE_touch_points_t points;
+            EVE_gesture_t gesture;
+            uint16_t const ms = (uint16_t) (((uint32_t) EVE_frame_elapsed() * EVE_frame_period_us()) / 1000U);
+
+            (void) EVE_gesture_capture(&points);
+            switch(EVE_gesture_update(&points, ms, &gesture)){
+                case EVE_GESTURE_SWIPE_LEFT:if(punto < 6U){punto++;}break;
+                case EVE_GESTURE_SWIPE_RIGHT:if(punto > 1U){punto--;}break;
+                case EVE_GESTURE_SWIPE_UP:signal_zoom(signal_zoom_nivel() + 1U);break; /* ventana mas larga */
+                case EVE_GESTURE_SWIPE_DOWN:if(signal_zoom_nivel() > 0U){signal_zoom(signal_zoom_nivel() - 1U);}break;
+                case EVE_GESTURE_LONG_PRESS:if(0U == gesture.tag){ /* not on the "Touch!" button, it toggles on its own */
+                                                vista_general ^= 1U;
+                                                if(vista_general != 0U){
+                                                    canales_vista_nueva();}} /* the last frame had no traces to measure */
+                                            break;
+                default:break;}}}
 }//++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 /*dynamic portion of display-handling, meant to be called every 20ms or more*/
 #if defined (__AVR__)
 /*we are running on 8-bit without DMA,
  optimize some more by using the special EVE_cmd_xxx_burst() functions*/
-void TFT_display(void)
-{static int32_t rotate = 0;
-    if(tft_active != 0U)
-    {EVE_start_cmd_burst(); /* start writing to the cmd-fifo as one stream of bytes, only sending the address once */
-     EVE_cmd_dlstart_burst(); /* start the display list */
-     EVE_clear_color_rgb_burst(MEDIUM_GRAY); /* set the default clear color to white */
-     EVE_clear_burst(1, 1, 1); /* clear the screen - this and the previous prevent artifacts between lists, Attributes are the color, stencil and tag buffers */
-     EVE_tag_burst(0); /* no touch */
-     EVE_cmd_append_burst(MEM_DL_STATIC, num_dl_static); /* insert static part of display-list from copy in gfx-mem */
+/*the screen of the selected point, the graph with the static part around it*/
+static void tft_build_punto(void)
+{    EVE_cmd_append_burst(MEM_DL_STATIC, num_dl_static); /* insert static part of display-list from copy in gfx-mem */
+     signal_dibujar(); /* traza de la grafica Metal signal */
+     display_Ventana_Grafica(historia_etiqueta(signal_zoom_nivel()));
 
     /* display a button  boton de pruebas  mover aqui*/
      EVE_color_rgb_burst(LIME_GREEN);
@@ -323,21 +432,73 @@ void TFT_display(void)
      EVE_tag_burst(0); /* no touch */
 
     /* display a picture and rotate it when the button on top is activated */
-     EVE_cmd_setbitmap_burst(MEM_PIC1, EVE_RGB565, 100U, 100U);
-
-
-        if(toggle_state != 0U){rotate += 256;}
-
-        EVE_begin_burst(EVE_BITMAPS);
-        EVE_vertex2f_burst(EVE_HSIZE - 100, LAYOUT_Y1);
-        EVE_end_burst();
-
-        simulador_de_reloj(&horas,&minutos,&segundos,&mseg);
-        display_Reloj(horas,minutos,segundos,mseg);
-        
-        EVE_display_burst(); /* mark the end of the display list */
-        EVE_cmd_swap_burst(); /* make this list active */
-        EVE_end_cmd_burst(); /* stop writing to the cmd-fifo, the cmd-FIFO will be executed automatically after this or when DMA is done */
+     if(rotate != 0U){
+         EVE_matrix_t giro;
+         EVE_matrix_identity(&giro);
+         EVE_matrix_translate(&giro, 50L * EVE_MATRIX_ONE, 50L * EVE_MATRIX_ONE); /* around the center of the 100x100 picture */
+         EVE_matrix_rotate(&giro, rotate);
+         EVE_matrix_translate(&giro, -50L * EVE_MATRIX_ONE, -50L * EVE_MATRIX_ONE);
+         EVE_save_context_burst(); /* the transform would apply to the fonts that follow */
+         EVE_matrix_set_burst(&giro);}
+
+     EVE_begin_burst(EVE_BITMAPS);
+     EVE_bitmap_handle_burst(handle_pic1); /* x is beyond the 511 of VERTEX2II */
+     EVE_vertex2f_burst(EVE_HSIZE - 100, LAYOUT_Y1);
+     EVE_end_burst();
+     if(rotate != 0U){
+         EVE_restore_context_burst();}
+
+     display_Selector_de_Puntos(0,punto);//dibuja la Parte de Seleccion de Puntos
+}//----------------------------------------------------------------
+
+/*builds the frame from the current state, must not change anything as it
+ is called twice by EVE_burst_frame() when the frame changed*/
+static void tft_build_frame(void)
+{    EVE_cmd_dlstart_burst(); /* start the display list */
+     EVE_clear_color_rgb_burst(MEDIUM_GRAY); /* set the default clear color to white */
+     EVE_clear_burst(1, 1, 1); /* clear the screen - this and the previous prevent artifacts between lists, Attributes are the color, stencil and tag buffers */
+     EVE_tag_burst(0); /* no touch */
+     EVE_handles_prologue_burst(); /* only sends something when a handle changed */
+     if(vista_general != 0U){
+         canales_dibujar();} /* los seis puntos, con el presupuesto de canales_presupuesto() */
+     else{
+         tft_build_punto();}
+     display_Reloj(horas,minutos,segundos,mseg);
+
+     EVE_display_burst(); /* mark the end of the display list */
+     if(EVE_DLSWAP_FRAME == TFT_DLSWAP){
+         EVE_cmd_swap_burst();} /* make this list active, with EVE_DLSWAP_LINE EVE_frame_ready() does the swap */
+}//----------------------------------------------------------------
+
+/*meant to be called when EVE_frame_ready() returns E_OK*/
+void TFT_display(void)
+{static uint32_t micros_acc = 0;
+    if(tft_active != 0U)
+    {micros_acc += (uint32_t) EVE_frame_elapsed() * EVE_frame_period_us(); /* time that passed since the last frame */
+     uint16_t const paso = (uint16_t) (micros_acc / 1000U);
+     micros_acc %= 1000U;
+     simulador_de_reloj(&horas,&minutos,&segundos,&mseg,paso); /* state updates go here, not into tft_build_frame() */
+     signal_simulador(paso); /* sin ADC todavia, genera las muestras del detector */
+     signal_procesar();
+     canales_simulador(paso);
+     canales_tick(paso);
+     if(toggle_state != 0U){
+         rotate += 256U;}
+     if(vista_general != 0U){
+         canales_presupuesto();} /* lee REG_CMD_DL, tiene que ir antes del burst */
+     if(EVE_FAULT_RECOVERED == EVE_get_and_reset_fault_state()){ /* the coprocessor was reset, the prologue sets up the handles again */
+         EVE_handles_invalidate();}
+#if defined (EVE_FRAME_HASH)
+     if(E_OK == EVE_burst_frame(tft_build_frame)){ /* the cmd-FIFO is executed automatically, identical frames are not sent */
+         EVE_frame_submit();
+         EVE_handles_commit();}
+#else
+     EVE_start_cmd_burst(); /* start writing to the cmd-fifo as one stream of bytes, only sending the address once */
+     tft_build_frame();
+     EVE_end_cmd_burst(); /* stop writing to the cmd-fifo, the cmd-FIFO will be executed automatically after this or when DMA is done */
+     EVE_frame_submit();
+     EVE_handles_commit();
+#endif
     }
 }
 #else
@@ -10,8 +10,11 @@
     #endif
 #endif
 
+#include "EVE_glyphcache.h"
+
 extern const uint8_t logo[206] PROGMEM;
 extern const uint8_t pic[3391] PROGMEM;
 extern const uint8_t flash[7765] PROGMEM;
+extern const EVE_glyph_font_t glifos_usuario; /* tft_glifos.c, generado con tools/eve_glyph_pack */
 
 #endif /* TFT_DATA_H */
\ No newline at end of file
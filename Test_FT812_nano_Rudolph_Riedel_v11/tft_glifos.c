@@ -0,0 +1,52 @@
+/* 11 glyphs of DejaVuSans.ttf at 20 pixels, 13x24 pixel cells in L1 format with 48 bytes each, generated with eve_glyph_pack */
+
+/* eve_glyph_pack -p 20 -f L1 -c "Ningún usuario" -n glifos_usuario -o tft_glifos.c DejaVuSans.ttf */
+
+#include "EVE_glyphcache.h"
+
+#if defined (__AVR__)
+    #include <avr/pgmspace.h>
+#else
+    #if !defined(PROGMEM)
+        #define PROGMEM
+    #endif
+#endif
+
+const uint8_t glifos_usuario_codes[22] PROGMEM =
+{
+    0x20, 0x0, 0x4e, 0x0, 0x61, 0x0, 0x67, 0x0, 0x69, 0x0, 0x6e, 0x0, 0x6f, 0x0, 0x72, 0x0, 0x73, 0x0, 0x75, 0x0, 0xfa, 0x0,
+};
+
+const uint8_t glifos_usuario_advance[11] PROGMEM =
+{
+    0x6, 0xf, 0xc, 0xd, 0x6, 0xd, 0xc, 0x8, 0xa, 0xd, 0xd,
+};
+
+const uint8_t glifos_usuario_cells[528] PROGMEM =
+{
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x38, 0x18, 0x3c, 0x18, 0x3c, 0x18, 0x3e, 0x18, 0x36, 0x18, 0x37, 0x18, 0x33, 0x18, 0x33, 0x98,
+    0x31, 0x98, 0x31, 0xd8, 0x30, 0xd8, 0x30, 0xf8, 0x30, 0x78, 0x30, 0x38, 0x30, 0x38, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x1f, 0x0, 0x3f, 0x80, 0x21, 0xc0, 0x0, 0xc0,
+    0x1f, 0xc0, 0x3f, 0xc0, 0x60, 0xc0, 0x60, 0xc0, 0x61, 0xc0, 0x7f, 0xc0, 0x3e, 0xc0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x1f, 0x60, 0x3f, 0xe0, 0x30, 0xe0, 0x60, 0x60,
+    0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x30, 0xe0, 0x3f, 0xe0, 0x1f, 0x60, 0x0, 0x60, 0x20, 0xc0, 0x3f, 0xc0, 0x1f, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x30, 0x0, 0x30, 0x0, 0x0, 0x0, 0x0, 0x0, 0x30, 0x0, 0x30, 0x0, 0x30, 0x0, 0x30, 0x0,
+    0x30, 0x0, 0x30, 0x0, 0x30, 0x0, 0x30, 0x0, 0x30, 0x0, 0x30, 0x0, 0x30, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x37, 0x80, 0x3f, 0xc0, 0x38, 0xe0, 0x30, 0x60,
+    0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0xf, 0x0, 0x3f, 0xc0, 0x30, 0xc0, 0x60, 0x60,
+    0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x30, 0xc0, 0x3f, 0xc0, 0xf, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x37, 0x0, 0x3f, 0x0, 0x38, 0x0, 0x30, 0x0,
+    0x30, 0x0, 0x30, 0x0, 0x30, 0x0, 0x30, 0x0, 0x30, 0x0, 0x30, 0x0, 0x30, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x1f, 0x0, 0x7f, 0x80, 0x60, 0x80, 0x60, 0x0,
+    0x7e, 0x0, 0x1f, 0x0, 0x3, 0x80, 0x1, 0x80, 0x41, 0x80, 0x7f, 0x80, 0x3e, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60,
+    0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x38, 0xe0, 0x1f, 0xe0, 0xf, 0x60, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x1, 0x80, 0x3, 0x0, 0x6, 0x0, 0x4, 0x0, 0x0, 0x0, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60,
+    0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x38, 0xe0, 0x1f, 0xe0, 0xf, 0x60, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+};
+
+/* the arrays are read with fetch_flash_byte(), the struct itself is in RAM */
+const EVE_glyph_font_t glifos_usuario = {glifos_usuario_codes, glifos_usuario_advance, glifos_usuario_cells, 11U, EVE_L1, 13U, 24U};
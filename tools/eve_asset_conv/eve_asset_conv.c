@@ -0,0 +1,996 @@
+/*
+@file    eve_asset_conv.c
+@brief   host tool, converts PNG/PPM images to EVE bitmap formats for EVE_cmd_inflate()
+@version 1.1
+@date    2026-10-18
+@author  Christian Lara
+
+@section info
+
+Linux command line converter for bitmaps that are uploaded with EVE_cmd_inflate()
+or EVE_memWrite_flash_buffer(). The output is a C array like the ones in tft_data.c.
+
+build:
+    cc -std=c99 -O2 -Wall -o eve_asset_conv eve_asset_conv.c -lpng -lz
+
+usage:
+    eve_asset_conv [-f format] [-d] [-r] [-n name] [-o file.c] [-b file.bin] [-s] image.png
+
+    -f format   RGB565 (default), ARGB1555, ARGB4, L8, L4, L1, PALETTED565, PALETTED4444, PALETTED8
+    -d          Floyd-Steinberg dithering when reducing the color depth
+    -r          raw output, do not deflate the data
+    -n name     name of the array, default is the file name without extension
+    -o file     write the C array to a file instead of stdout
+    -b file     write the (compressed) binary data to a file, for PALETTED formats the index data
+    -s          only print the size report for all formats
+
+The L formats use the luminance multiplied with the alpha channel so that icons
+with transparency can be drawn in any color with EVE_color_rgb().
+
+The PALETTED formats reduce the image to at most 256 colors with a median-cut quantizer,
+images that already use 256 colors or less keep their exact colors.
+The output is the 8 bit index data plus a second array "name_lut" with the palette,
+PALETTED565 and PALETTED4444 use 2 bytes per entry, PALETTED8 uses 4 bytes per entry (ARGB8888).
+The palette is never compressed as it is at most 1 kiB, upload and draw both with
+EVE_paletted_load() and EVE_paletted_draw() from EVE_supplemental.c.
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+1.1
+- added PALETTED565, PALETTED4444 and PALETTED8 with a median-cut palette quantizer
+
+*/
+
+#define _POSIX_C_SOURCE 200809L /* getopt() */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <png.h>
+#include <zlib.h>
+
+/* same values as the bitmap formats in EVE.h */
+#define EVE_ARGB1555   0U
+#define EVE_L1         1U
+#define EVE_L4         2U
+#define EVE_L8         3U
+#define EVE_ARGB4      6U
+#define EVE_RGB565     7U
+#define EVE_PALETTED565   14U
+#define EVE_PALETTED4444  15U
+#define EVE_PALETTED8     16U
+
+#define MAX_COLORS 256U
+
+typedef struct
+{
+    const char *name;
+    uint8_t eve_format;
+    uint8_t bits_per_pixel;
+    uint8_t depth[4]; /* bits for r, g, b, a - or luminance in [0] */
+    uint8_t luminance;
+    uint8_t lut_bytes; /* bytes per palette entry, 0 for direct color formats */
+} conv_format_t;
+
+static const conv_format_t formats[] =
+{
+    { "RGB565",       EVE_RGB565,       16U, { 5U, 6U, 5U, 0U }, 0U, 0U },
+    { "ARGB1555",     EVE_ARGB1555,     16U, { 5U, 5U, 5U, 1U }, 0U, 0U },
+    { "ARGB4",        EVE_ARGB4,        16U, { 4U, 4U, 4U, 4U }, 0U, 0U },
+    { "L8",           EVE_L8,            8U, { 8U, 0U, 0U, 0U }, 1U, 0U },
+    { "L4",           EVE_L4,            4U, { 4U, 0U, 0U, 0U }, 1U, 0U },
+    { "L1",           EVE_L1,            1U, { 1U, 0U, 0U, 0U }, 1U, 0U },
+    { "PALETTED565",  EVE_PALETTED565,   8U, { 5U, 6U, 5U, 0U }, 0U, 2U },
+    { "PALETTED4444", EVE_PALETTED4444,  8U, { 4U, 4U, 4U, 4U }, 0U, 2U },
+    { "PALETTED8",    EVE_PALETTED8,     8U, { 8U, 8U, 8U, 8U }, 0U, 4U },
+};
+
+#define NUM_FORMATS (sizeof(formats) / sizeof(formats[0]))
+
+typedef struct
+{
+    uint32_t width;
+    uint32_t height;
+    uint8_t *p_rgba; /* width * height * 4 bytes */
+} conv_image_t;
+
+typedef struct
+{
+    uint8_t *p_data;
+    uint32_t len;
+    uint32_t stride;
+} conv_buffer_t;
+
+/* ##################################################################
+    image input
+##################################################################### */
+
+static int read_png(const char * const p_file, conv_image_t * const p_img)
+{
+    png_image image;
+    int ret = -1;
+
+    memset(&image, 0, sizeof(image));
+    image.version = PNG_IMAGE_VERSION;
+
+    if (png_image_begin_read_from_file(&image, p_file) != 0)
+    {
+        image.format = PNG_FORMAT_RGBA;
+        p_img->width = image.width;
+        p_img->height = image.height;
+        p_img->p_rgba = malloc(PNG_IMAGE_SIZE(image));
+
+        if ((p_img->p_rgba != NULL) &&
+            (png_image_finish_read(&image, NULL, p_img->p_rgba, 0, NULL) != 0))
+        {
+            ret = 0;
+        }
+        else
+        {
+            fprintf(stderr, "error: %s: %s\n", p_file, image.message);
+        }
+    }
+    else
+    {
+        fprintf(stderr, "error: %s: %s\n", p_file, image.message);
+    }
+
+    png_image_free(&image);
+    return (ret);
+}
+
+static int ppm_skip(FILE * const p_fp)
+{
+    int chr = fgetc(p_fp);
+
+    while ((chr == '#') || (chr == ' ') || (chr == '\t') || (chr == '\r') || (chr == '\n'))
+    {
+        if (chr == '#')
+        {
+            while ((chr != '\n') && (chr != EOF))
+            {
+                chr = fgetc(p_fp);
+            }
+        }
+        chr = fgetc(p_fp);
+    }
+    return (ungetc(chr, p_fp));
+}
+
+/* binary PPM (P6) and PGM (P5) with 8 bits per channel */
+static int read_ppm(const char * const p_file, conv_image_t * const p_img)
+{
+    FILE *p_fp = fopen(p_file, "rb");
+    char magic[3] = { 0 };
+    unsigned int width = 0U;
+    unsigned int height = 0U;
+    unsigned int maxval = 0U;
+    int ret = -1;
+
+    if (NULL == p_fp)
+    {
+        perror(p_file);
+        return (ret);
+    }
+
+    if ((fread(magic, 1U, 2U, p_fp) == 2U) && (magic[0] == 'P') && ((magic[1] == '6') || (magic[1] == '5')))
+    {
+        uint32_t const channels = (magic[1] == '6') ? 3U : 1U;
+
+        ppm_skip(p_fp);
+        if (fscanf(p_fp, "%u", &width) == 1) { ppm_skip(p_fp); }
+        if (fscanf(p_fp, "%u", &height) == 1) { ppm_skip(p_fp); }
+        if ((fscanf(p_fp, "%u", &maxval) == 1) && (maxval == 255U) && (width > 0U) && (height > 0U))
+        {
+            size_t const count = (size_t) width * height;
+            uint8_t *p_raw = malloc(count * channels);
+
+            (void) fgetc(p_fp); /* single white space after maxval */
+            p_img->width = width;
+            p_img->height = height;
+            p_img->p_rgba = malloc(count * 4U);
+
+            if ((p_raw != NULL) && (p_img->p_rgba != NULL) && (fread(p_raw, channels, count, p_fp) == count))
+            {
+                for (size_t pixel = 0U; pixel < count; pixel++)
+                {
+                    uint8_t *p_out = &p_img->p_rgba[pixel * 4U];
+
+                    p_out[0] = p_raw[pixel * channels];
+                    p_out[1] = p_raw[(pixel * channels) + ((channels == 3U) ? 1U : 0U)];
+                    p_out[2] = p_raw[(pixel * channels) + ((channels == 3U) ? 2U : 0U)];
+                    p_out[3] = 255U;
+                }
+                ret = 0;
+            }
+            free(p_raw);
+        }
+    }
+
+    if (ret != 0)
+    {
+        fprintf(stderr, "error: %s: only binary P5/P6 files with maxval 255 are supported\n", p_file);
+    }
+
+    fclose(p_fp);
+    return (ret);
+}
+
+static int read_image(const char * const p_file, conv_image_t * const p_img)
+{
+    FILE *p_fp = fopen(p_file, "rb");
+    uint8_t sig[8] = { 0 };
+    size_t num = 0U;
+
+    if (NULL == p_fp)
+    {
+        perror(p_file);
+        return (-1);
+    }
+    num = fread(sig, 1U, sizeof(sig), p_fp);
+    fclose(p_fp);
+
+    if ((num == sizeof(sig)) && (png_sig_cmp(sig, 0, sizeof(sig)) == 0))
+    {
+        return (read_png(p_file, p_img));
+    }
+    return (read_ppm(p_file, p_img));
+}
+
+/* ##################################################################
+    conversion
+##################################################################### */
+
+static uint32_t quantize(float const value, uint8_t const bits)
+{
+    float const levels = (float) ((1U << bits) - 1U);
+    float scaled = (value * levels / 255.0f) + 0.5f;
+
+    if (scaled < 0.0f)
+    {
+        scaled = 0.0f;
+    }
+    if (scaled > levels)
+    {
+        scaled = levels;
+    }
+    return ((uint32_t) scaled);
+}
+
+static float expand(uint32_t const value, uint8_t const bits)
+{
+    return (((float) value) * 255.0f / (float) ((1U << bits) - 1U));
+}
+
+/* Floyd-Steinberg error diffusion, the error of one channel of one pixel is spread to its neighbours */
+static void diffuse(float * const p_work, uint32_t const width, uint32_t const height,
+                    uint32_t const xc0, uint32_t const yc0, uint32_t const chan, float const error)
+{
+    uint32_t const base = ((yc0 * width) + xc0) * 4U + chan;
+
+    if ((xc0 + 1U) < width)
+    {
+        p_work[base + 4U] += error * (7.0f / 16.0f);
+    }
+    if ((yc0 + 1U) < height)
+    {
+        uint32_t const below = base + (width * 4U);
+
+        if (xc0 > 0U)
+        {
+            p_work[below - 4U] += error * (3.0f / 16.0f);
+        }
+        p_work[below] += error * (5.0f / 16.0f);
+        if ((xc0 + 1U) < width)
+        {
+            p_work[below + 4U] += error * (1.0f / 16.0f);
+        }
+    }
+}
+
+static void put_pixel(conv_buffer_t * const p_buf, const conv_format_t * const p_fmt,
+                        uint32_t const xc0, uint32_t const yc0, uint32_t const value)
+{
+    uint8_t * const p_row = &p_buf->p_data[yc0 * p_buf->stride];
+
+    switch (p_fmt->bits_per_pixel)
+    {
+        case 16U:
+            p_row[xc0 * 2U] = (uint8_t) (value & 0xffU);
+            p_row[(xc0 * 2U) + 1U] = (uint8_t) (value >> 8U);
+            break;
+        case 8U:
+            p_row[xc0] = (uint8_t) value;
+            break;
+        case 4U: /* first pixel in the upper nibble */
+            p_row[xc0 / 2U] |= (uint8_t) (value << (((xc0 & 1U) != 0U) ? 0U : 4U));
+            break;
+        default: /* L1, first pixel in the MSB */
+            p_row[xc0 / 8U] |= (uint8_t) (value << (7U - (xc0 & 7U)));
+            break;
+    }
+}
+
+/* ##################################################################
+    palette quantizer
+##################################################################### */
+
+typedef struct
+{
+    uint32_t rgba; /* r in bits 0..7, a in bits 24..31 */
+    uint32_t count;
+} conv_color_t;
+
+typedef struct
+{
+    uint32_t first;
+    uint32_t num;
+} conv_box_t;
+
+static uint32_t sort_chan;
+
+static uint8_t color_chan(uint32_t const rgba, uint32_t const chan)
+{
+    return ((uint8_t) (rgba >> (chan * 8U)));
+}
+
+static int cmp_rgba(const void *p_a, const void *p_b)
+{
+    uint32_t const val_a = *(const uint32_t *) p_a;
+    uint32_t const val_b = *(const uint32_t *) p_b;
+
+    return ((val_a > val_b) - (val_a < val_b));
+}
+
+static int cmp_chan(const void *p_a, const void *p_b)
+{
+    uint8_t const val_a = color_chan(((const conv_color_t *) p_a)->rgba, sort_chan);
+    uint8_t const val_b = color_chan(((const conv_color_t *) p_b)->rgba, sort_chan);
+
+    return ((int) val_a - (int) val_b);
+}
+
+/* the channel with the largest range in a box, returns the range */
+static uint32_t box_range(const conv_color_t * const p_colors, const conv_box_t * const p_box,
+                            const conv_format_t * const p_fmt, uint32_t * const p_chan)
+{
+    uint32_t best = 0U;
+
+    *p_chan = 0U;
+    for (uint32_t chan = 0U; chan < 4U; chan++)
+    {
+        uint8_t low = 255U;
+        uint8_t high = 0U;
+
+        if (0U == p_fmt->depth[chan])
+        {
+            continue;
+        }
+        for (uint32_t index = p_box->first; index < (p_box->first + p_box->num); index++)
+        {
+            uint8_t const val = color_chan(p_colors[index].rgba, chan);
+
+            low = (val < low) ? val : low;
+            high = (val > high) ? val : high;
+        }
+        if ((uint32_t) (high - low) > best)
+        {
+            best = (uint32_t) (high - low);
+            *p_chan = chan;
+        }
+    }
+    return (best);
+}
+
+/* reduces the color of a palette entry to the precision of the palette format */
+static uint32_t lut_round(uint32_t const rgba, const conv_format_t * const p_fmt)
+{
+    uint32_t ret = 0U;
+
+    for (uint32_t chan = 0U; chan < 4U; chan++)
+    {
+        uint32_t val = 255U;
+
+        if (p_fmt->depth[chan] != 0U)
+        {
+            val = (uint32_t) expand(quantize((float) color_chan(rgba, chan), p_fmt->depth[chan]), p_fmt->depth[chan]);
+        }
+        ret |= val << (chan * 8U);
+    }
+    return (ret);
+}
+
+/* median-cut: the box with the largest channel range is split at the median pixel until there are enough boxes */
+static uint32_t build_palette(const conv_image_t * const p_img, const conv_format_t * const p_fmt, uint32_t * const p_palette)
+{
+    uint32_t const count = p_img->width * p_img->height;
+    uint32_t *p_sorted = malloc(sizeof(uint32_t) * count);
+    conv_color_t *p_colors = malloc(sizeof(conv_color_t) * count);
+    conv_box_t boxes[MAX_COLORS];
+    uint32_t num_colors = 0U;
+    uint32_t num_boxes = 1U;
+
+    if ((NULL == p_sorted) || (NULL == p_colors))
+    {
+        free(p_sorted);
+        free(p_colors);
+        return (0U);
+    }
+
+    for (uint32_t pixel = 0U; pixel < count; pixel++)
+    {
+        uint32_t rgba = lut_round((uint32_t) p_img->p_rgba[pixel * 4U] |
+                                ((uint32_t) p_img->p_rgba[(pixel * 4U) + 1U] << 8U) |
+                                ((uint32_t) p_img->p_rgba[(pixel * 4U) + 2U] << 16U) |
+                                ((uint32_t) p_img->p_rgba[(pixel * 4U) + 3U] << 24U), p_fmt);
+        p_sorted[pixel] = rgba;
+    }
+    qsort(p_sorted, count, sizeof(uint32_t), cmp_rgba);
+
+    for (uint32_t pixel = 0U; pixel < count; pixel++)
+    {
+        if ((0U == num_colors) || (p_colors[num_colors - 1U].rgba != p_sorted[pixel]))
+        {
+            p_colors[num_colors].rgba = p_sorted[pixel];
+            p_colors[num_colors].count = 0U;
+            num_colors++;
+        }
+        p_colors[num_colors - 1U].count++;
+    }
+    free(p_sorted);
+
+    boxes[0].first = 0U;
+    boxes[0].num = num_colors;
+    while (num_boxes < MAX_COLORS)
+    {
+        uint32_t split = MAX_COLORS;
+        uint32_t split_chan = 0U;
+        uint32_t best = 0U;
+
+        for (uint32_t index = 0U; index < num_boxes; index++)
+        {
+            uint32_t chan;
+            uint32_t const range = (boxes[index].num > 1U) ? box_range(p_colors, &boxes[index], p_fmt, &chan) : 0U;
+
+            if (range > best)
+            {
+                best = range;
+                split = index;
+                split_chan = chan;
+            }
+        }
+        if (split == MAX_COLORS)
+        {
+            break; /* every box holds a single color */
+        }
+
+        conv_box_t * const p_box = &boxes[split];
+        uint32_t total = 0U;
+        uint32_t half = 0U;
+        uint32_t cut = 1U;
+
+        sort_chan = split_chan;
+        qsort(&p_colors[p_box->first], p_box->num, sizeof(conv_color_t), cmp_chan);
+        for (uint32_t index = 0U; index < p_box->num; index++)
+        {
+            total += p_colors[p_box->first + index].count;
+        }
+        while ((cut < (p_box->num - 1U)) && ((half + p_colors[p_box->first + cut - 1U].count) < (total / 2U)))
+        {
+            half += p_colors[p_box->first + cut - 1U].count;
+            cut++;
+        }
+        boxes[num_boxes].first = p_box->first + cut;
+        boxes[num_boxes].num = p_box->num - cut;
+        p_box->num = cut;
+        num_boxes++;
+    }
+
+    for (uint32_t index = 0U; index < num_boxes; index++)
+    {
+        double sum[4] = { 0.0, 0.0, 0.0, 0.0 };
+        double weight = 0.0;
+        uint32_t rgba = 0U;
+
+        for (uint32_t color = boxes[index].first; color < (boxes[index].first + boxes[index].num); color++)
+        {
+            for (uint32_t chan = 0U; chan < 4U; chan++)
+            {
+                sum[chan] += (double) color_chan(p_colors[color].rgba, chan) * p_colors[color].count;
+            }
+            weight += p_colors[color].count;
+        }
+        for (uint32_t chan = 0U; chan < 4U; chan++)
+        {
+            rgba |= (uint32_t) ((sum[chan] / weight) + 0.5) << (chan * 8U);
+        }
+        p_palette[index] = lut_round(rgba, p_fmt);
+    }
+
+    free(p_colors);
+    return (num_boxes);
+}
+
+static uint32_t nearest_color(const float * const p_px, const uint32_t * const p_palette, uint32_t const num_colors,
+                                const conv_format_t * const p_fmt)
+{
+    uint32_t ret = 0U;
+    float best = 0.0f;
+
+    for (uint32_t index = 0U; index < num_colors; index++)
+    {
+        float dist = 0.0f;
+
+        for (uint32_t chan = 0U; chan < 4U; chan++)
+        {
+            if (p_fmt->depth[chan] != 0U)
+            {
+                float const diff = p_px[chan] - (float) color_chan(p_palette[index], chan);
+                dist += diff * diff;
+            }
+        }
+        if ((0U == index) || (dist < best))
+        {
+            best = dist;
+            ret = index;
+        }
+    }
+    return (ret);
+}
+
+static void put_lut(conv_buffer_t * const p_lut, const conv_format_t * const p_fmt, uint32_t const index, uint32_t const rgba)
+{
+    uint8_t * const p_entry = &p_lut->p_data[index * p_fmt->lut_bytes];
+    uint32_t qval[4];
+    uint32_t value;
+
+    for (uint32_t chan = 0U; chan < 4U; chan++)
+    {
+        qval[chan] = (p_fmt->depth[chan] != 0U) ? quantize((float) color_chan(rgba, chan), p_fmt->depth[chan]) : 0U;
+    }
+
+    switch (p_fmt->eve_format)
+    {
+        case EVE_PALETTED565:
+            value = (qval[0] << 11U) | (qval[1] << 5U) | qval[2];
+            break;
+        case EVE_PALETTED4444:
+            value = (qval[3] << 12U) | (qval[0] << 8U) | (qval[1] << 4U) | qval[2];
+            break;
+        default: /* PALETTED8, ARGB8888 */
+            value = (qval[3] << 24U) | (qval[0] << 16U) | (qval[1] << 8U) | qval[2];
+            break;
+    }
+
+    for (uint32_t byte = 0U; byte < p_fmt->lut_bytes; byte++)
+    {
+        p_entry[byte] = (uint8_t) (value >> (byte * 8U));
+    }
+}
+
+static int convert_paletted(const conv_image_t * const p_img, const conv_format_t * const p_fmt,
+                            uint8_t const dither, conv_buffer_t * const p_buf, conv_buffer_t * const p_lut)
+{
+    uint32_t const count = p_img->width * p_img->height;
+    uint32_t palette[MAX_COLORS];
+    uint32_t const num_colors = build_palette(p_img, p_fmt, palette);
+    float *p_work = malloc(sizeof(float) * count * 4U);
+
+    p_buf->stride = p_img->width;
+    p_buf->len = count;
+    p_buf->p_data = calloc(p_buf->len, 1U);
+    p_lut->stride = p_fmt->lut_bytes;
+    p_lut->len = num_colors * p_fmt->lut_bytes;
+    p_lut->p_data = calloc(MAX_COLORS * 4U, 1U);
+
+    if ((0U == num_colors) || (NULL == p_work) || (NULL == p_buf->p_data) || (NULL == p_lut->p_data))
+    {
+        free(p_work);
+        return (-1);
+    }
+
+    for (uint32_t index = 0U; index < num_colors; index++)
+    {
+        put_lut(p_lut, p_fmt, index, palette[index]);
+    }
+
+    for (uint32_t pixel = 0U; pixel < (count * 4U); pixel++)
+    {
+        p_work[pixel] = (float) p_img->p_rgba[pixel];
+    }
+
+    for (uint32_t yc0 = 0U; yc0 < p_img->height; yc0++)
+    {
+        for (uint32_t xc0 = 0U; xc0 < p_img->width; xc0++)
+        {
+            float * const p_px = &p_work[((yc0 * p_img->width) + xc0) * 4U];
+            uint32_t const index = nearest_color(p_px, palette, num_colors, p_fmt);
+
+            if (dither != 0U)
+            {
+                for (uint32_t chan = 0U; chan < 4U; chan++)
+                {
+                    if (p_fmt->depth[chan] != 0U)
+                    {
+                        diffuse(p_work, p_img->width, p_img->height, xc0, yc0, chan,
+                                p_px[chan] - (float) color_chan(palette[index], chan));
+                    }
+                }
+            }
+            p_buf->p_data[(yc0 * p_buf->stride) + xc0] = (uint8_t) index;
+        }
+    }
+
+    free(p_work);
+    return (0);
+}
+
+static int convert(const conv_image_t * const p_img, const conv_format_t * const p_fmt,
+                    uint8_t const dither, conv_buffer_t * const p_buf, conv_buffer_t * const p_lut)
+{
+    uint32_t const count = p_img->width * p_img->height;
+    float *p_work;
+
+    if (p_fmt->lut_bytes != 0U)
+    {
+        return (convert_paletted(p_img, p_fmt, dither, p_buf, p_lut));
+    }
+
+    p_work = malloc(sizeof(float) * count * 4U);
+
+    p_buf->stride = ((p_img->width * p_fmt->bits_per_pixel) + 7U) / 8U;
+    p_buf->len = p_buf->stride * p_img->height;
+    p_buf->p_data = calloc(p_buf->len, 1U);
+
+    if ((NULL == p_work) || (NULL == p_buf->p_data))
+    {
+        free(p_work);
+        return (-1);
+    }
+
+    for (uint32_t pixel = 0U; pixel < count; pixel++)
+    {
+        const uint8_t *p_in = &p_img->p_rgba[pixel * 4U];
+
+        if (p_fmt->luminance != 0U)
+        {
+            float const lum = ((0.299f * p_in[0]) + (0.587f * p_in[1]) + (0.114f * p_in[2])) * ((float) p_in[3] / 255.0f);
+
+            p_work[pixel * 4U] = lum;
+        }
+        else
+        {
+            for (uint32_t chan = 0U; chan < 4U; chan++)
+            {
+                p_work[(pixel * 4U) + chan] = (float) p_in[chan];
+            }
+        }
+    }
+
+    for (uint32_t yc0 = 0U; yc0 < p_img->height; yc0++)
+    {
+        for (uint32_t xc0 = 0U; xc0 < p_img->width; xc0++)
+        {
+            float * const p_px = &p_work[((yc0 * p_img->width) + xc0) * 4U];
+            uint32_t qval[4] = { 0U, 0U, 0U, 0U };
+            uint32_t value;
+
+            for (uint32_t chan = 0U; chan < 4U; chan++)
+            {
+                if (p_fmt->depth[chan] != 0U)
+                {
+                    qval[chan] = quantize(p_px[chan], p_fmt->depth[chan]);
+                    if (dither != 0U)
+                    {
+                        diffuse(p_work, p_img->width, p_img->height, xc0, yc0, chan,
+                                p_px[chan] - expand(qval[chan], p_fmt->depth[chan]));
+                    }
+                }
+            }
+
+            switch (p_fmt->eve_format)
+            {
+                case EVE_RGB565:
+                    value = (qval[0] << 11U) | (qval[1] << 5U) | qval[2];
+                    break;
+                case EVE_ARGB1555:
+                    value = (qval[3] << 15U) | (qval[0] << 10U) | (qval[1] << 5U) | qval[2];
+                    break;
+                case EVE_ARGB4:
+                    value = (qval[3] << 12U) | (qval[0] << 8U) | (qval[1] << 4U) | qval[2];
+                    break;
+                default: /* L8, L4, L1 */
+                    value = qval[0];
+                    break;
+            }
+            put_pixel(p_buf, p_fmt, xc0, yc0, value);
+        }
+    }
+
+    free(p_work);
+    return (0);
+}
+
+/* zlib format with header, as expected by CMD_INFLATE */
+static int deflate_buffer(const conv_buffer_t * const p_in, conv_buffer_t * const p_out)
+{
+    uLongf len = compressBound(p_in->len);
+
+    p_out->p_data = malloc(len);
+    p_out->stride = p_in->stride;
+    if ((NULL == p_out->p_data) || (compress2(p_out->p_data, &len, p_in->p_data, p_in->len, Z_BEST_COMPRESSION) != Z_OK))
+    {
+        return (-1);
+    }
+    p_out->len = (uint32_t) len;
+    return (0);
+}
+
+/* ##################################################################
+    output
+##################################################################### */
+
+static void write_bytes(FILE * const p_fp, const char * const p_name, const char * const p_suffix,
+                        const conv_buffer_t * const p_out)
+{
+    fprintf(p_fp, "const uint8_t %s%s[%u] PROGMEM =\n{\n", p_name, p_suffix, p_out->len);
+    for (uint32_t index = 0U; index < p_out->len; index++)
+    {
+        if ((index % 24U) == 0U)
+        {
+            fprintf(p_fp, "    ");
+        }
+        fprintf(p_fp, "0x%x,", p_out->p_data[index]);
+        if (((index % 24U) == 23U) || ((index + 1U) == p_out->len))
+        {
+            fprintf(p_fp, "\n");
+        }
+        else
+        {
+            fprintf(p_fp, " ");
+        }
+    }
+    fprintf(p_fp, "};\n");
+}
+
+static void write_array(FILE * const p_fp, const char * const p_name, const conv_image_t * const p_img,
+                        const conv_format_t * const p_fmt, const conv_buffer_t * const p_raw,
+                        const conv_buffer_t * const p_out, const conv_buffer_t * const p_lut, uint8_t const compressed)
+{
+    if (compressed != 0U)
+    {
+        fprintf(p_fp, "/* %ux%u pixel image in compressed %s format, length is %u when uncompressed, converted with eve_asset_conv */\n",
+                p_img->width, p_img->height, p_fmt->name, p_raw->len);
+    }
+    else
+    {
+        fprintf(p_fp, "/* %ux%u pixel image in %s format, linestride %u, converted with eve_asset_conv */\n",
+                p_img->width, p_img->height, p_fmt->name, p_raw->stride);
+    }
+
+    write_bytes(p_fp, p_name, "", p_out);
+
+    if (p_fmt->lut_bytes != 0U)
+    {
+        fprintf(p_fp, "\n/* palette for %s, %u entries with %u bytes each */\n", p_name, p_lut->len / p_fmt->lut_bytes, p_fmt->lut_bytes);
+        write_bytes(p_fp, p_name, "_lut", p_lut);
+    }
+}
+
+/* the palette is part of both sizes as it is transferred uncompressed */
+static void report(const char * const p_name, const conv_image_t * const p_img,
+                    const conv_format_t * const p_fmt, const conv_buffer_t * const p_raw,
+                    const conv_buffer_t * const p_packed, const conv_buffer_t * const p_lut)
+{
+    uint32_t const lut_len = (p_fmt->lut_bytes != 0U) ? p_lut->len : 0U;
+
+    fprintf(stderr, "%-12s %4ux%-4u raw: %7u bytes  deflated: %7u bytes (%5.1f%%)  stride: %u",
+            p_fmt->name, p_img->width, p_img->height, p_raw->len + lut_len, p_packed->len + lut_len,
+            (100.0 * (p_packed->len + lut_len)) / (double) (p_raw->len + lut_len), p_raw->stride);
+    if (lut_len != 0U)
+    {
+        fprintf(stderr, "  palette: %u colors", lut_len / p_fmt->lut_bytes);
+    }
+    fprintf(stderr, "\n");
+
+    if (p_name != NULL)
+    {
+        if (lut_len != 0U)
+        {
+            fprintf(stderr, "EVE_paletted_load(addr, %s, sizeof(%s), lut_addr, %s_lut, sizeof(%s_lut));\n",
+                    p_name, p_name, p_name, p_name);
+            fprintf(stderr, "EVE_cmd_setbitmap(addr, EVE_%s, %uU, %uU);\n", p_fmt->name, p_img->width, p_img->height);
+            fprintf(stderr, "EVE_paletted_draw(EVE_%s, lut_addr, xc0, yc0);\n", p_fmt->name);
+        }
+        else
+        {
+            fprintf(stderr, "EVE_cmd_setbitmap(addr, EVE_%s, %uU, %uU); /* %s */\n",
+                    p_fmt->name, p_img->width, p_img->height, p_name);
+        }
+    }
+}
+
+static const conv_format_t *find_format(const char * const p_name)
+{
+    for (uint32_t index = 0U; index < NUM_FORMATS; index++)
+    {
+        if (strcasecmp(p_name, formats[index].name) == 0)
+        {
+            return (&formats[index]);
+        }
+    }
+    return (NULL);
+}
+
+static void default_name(const char * const p_file, char * const p_name, size_t const size)
+{
+    const char *p_base = strrchr(p_file, '/');
+    size_t len = 0U;
+
+    p_base = (p_base != NULL) ? (p_base + 1) : p_file;
+    while ((p_base[len] != '\0') && (p_base[len] != '.') && (len < (size - 1U)))
+    {
+        char const chr = p_base[len];
+
+        p_name[len] = ((chr >= 'a') && (chr <= 'z')) || ((chr >= 'A') && (chr <= 'Z')) ||
+                      ((chr >= '0') && (chr <= '9') && (len > 0U)) ? chr : '_';
+        len++;
+    }
+    p_name[len] = '\0';
+}
+
+static void usage(const char * const p_prog)
+{
+    fprintf(stderr, "usage: %s [-f RGB565|ARGB1555|ARGB4|L8|L4|L1|PALETTED565|PALETTED4444|PALETTED8] [-d] [-r] [-n name] [-o file.c] [-b file.bin] [-s] image\n", p_prog);
+}
+
+int main(int argc, char *argv[])
+{
+    const conv_format_t *p_fmt = &formats[0];
+    const char *p_name = NULL;
+    const char *p_out_c = NULL;
+    const char *p_out_bin = NULL;
+    uint8_t dither = 0U;
+    uint8_t compressed = 1U;
+    uint8_t summary = 0U;
+    char name_buf[64];
+    conv_image_t img = { 0U, 0U, NULL };
+    int opt;
+
+    while ((opt = getopt(argc, argv, "f:drn:o:b:sh")) != -1)
+    {
+        switch (opt)
+        {
+            case 'f':
+                p_fmt = find_format(optarg);
+                if (NULL == p_fmt)
+                {
+                    fprintf(stderr, "error: unknown format %s\n", optarg);
+                    return (EXIT_FAILURE);
+                }
+                break;
+            case 'd': dither = 1U; break;
+            case 'r': compressed = 0U; break;
+            case 'n': p_name = optarg; break;
+            case 'o': p_out_c = optarg; break;
+            case 'b': p_out_bin = optarg; break;
+            case 's': summary = 1U; break;
+            default:
+                usage(argv[0]);
+                return (EXIT_FAILURE);
+        }
+    }
+
+    if ((optind >= argc) || (read_image(argv[optind], &img) != 0))
+    {
+        usage(argv[0]);
+        return (EXIT_FAILURE);
+    }
+
+    if (NULL == p_name)
+    {
+        default_name(argv[optind], name_buf, sizeof(name_buf));
+        p_name = name_buf;
+    }
+
+    if (summary != 0U) /* compare all formats to pick the one with the smallest flash and SPI footprint */
+    {
+        for (uint32_t index = 0U; index < NUM_FORMATS; index++)
+        {
+            conv_buffer_t raw = { NULL, 0U, 0U };
+            conv_buffer_t packed = { NULL, 0U, 0U };
+            conv_buffer_t lut = { NULL, 0U, 0U };
+
+            if ((convert(&img, &formats[index], dither, &raw, &lut) == 0) && (deflate_buffer(&raw, &packed) == 0))
+            {
+                report(NULL, &img, &formats[index], &raw, &packed, &lut);
+            }
+            free(raw.p_data);
+            free(packed.p_data);
+            free(lut.p_data);
+        }
+    }
+    else
+    {
+        conv_buffer_t raw = { NULL, 0U, 0U };
+        conv_buffer_t packed = { NULL, 0U, 0U };
+        conv_buffer_t lut = { NULL, 0U, 0U };
+        const conv_buffer_t *p_out = &raw;
+
+        if ((convert(&img, p_fmt, dither, &raw, &lut) != 0) || (deflate_buffer(&raw, &packed) != 0))
+        {
+            fprintf(stderr, "error: out of memory\n");
+            return (EXIT_FAILURE);
+        }
+        if (compressed != 0U)
+        {
+            p_out = &packed;
+        }
+
+        if (p_out_c != NULL)
+        {
+            FILE *p_fp = fopen(p_out_c, "w");
+
+            if (NULL == p_fp)
+            {
+                perror(p_out_c);
+                return (EXIT_FAILURE);
+            }
+            write_array(p_fp, p_name, &img, p_fmt, &raw, p_out, &lut, compressed);
+            fclose(p_fp);
+        }
+        else
+        {
+            write_array(stdout, p_name, &img, p_fmt, &raw, p_out, &lut, compressed);
+        }
+
+        if (p_out_bin != NULL)
+        {
+            FILE *p_fp = fopen(p_out_bin, "wb");
+
+            if ((NULL == p_fp) || (fwrite(p_out->p_data, 1U, p_out->len, p_fp) != p_out->len))
+            {
+                perror(p_out_bin);
+                return (EXIT_FAILURE);
+            }
+            fclose(p_fp);
+        }
+
+        report(p_name, &img, p_fmt, &raw, &packed, &lut);
+        free(raw.p_data);
+        free(packed.p_data);
+        free(lut.p_data);
+    }
+
+    free(img.p_rgba);
+    return (EXIT_SUCCESS);
+}
@@ -0,0 +1,558 @@
+/*
+@file    eve_glyph_pack.c
+@brief   host tool, renders the glyphs of a TTF/OTF font to a master font for EVE_glyphcache
+@version 1.0
+@date    2026-10-19
+@author  Christian Lara
+
+@section info
+
+Linux command line tool that renders the glyphs of a font with FreeType to equal sized cells
+in the L1, L4 or L8 format. The output is a C file with the code points, the advance and the
+cells in PROGMEM plus the EVE_glyph_font_t that goes to EVE_glyphcache_init().
+All cells have the baseline at the same row, the cell is as wide as the widest glyph.
+
+build:
+    cc -std=c99 -O2 -Wall -I/usr/include/freetype2 -o eve_glyph_pack eve_glyph_pack.c -lfreetype
+
+usage:
+    eve_glyph_pack [-p pixels] [-f format] [-c chars] [-t file] [-n name] [-o file.c] font.ttf
+
+    -p pixels   font size in pixels, default is 20
+    -f format   L1, L4 (default) or L8, L1 is rendered without anti-aliasing
+    -c chars    the characters to pack as UTF-8, can be used more than once
+    -t file     pack every character of a UTF-8 text file, e.g. the strings of the application
+    -n name     name of the font, default is the file name without extension
+    -o file     write the C file to a file instead of stdout
+
+Without -c and -t the printable ASCII characters plus áéíóúüñ ÁÉÍÓÚÜÑ ¡¿ are packed.
+The space is always part of the font as it sets the width of spaces.
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#define _POSIX_C_SOURCE 200809L /* getopt() */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+/* same values as the bitmap formats in EVE.h */
+#define EVE_L1         1U
+#define EVE_L4         2U
+#define EVE_L8         3U
+
+#define MAX_GLYPHS 0x10000U
+#define CACHE_CELLS 32U /* default of EVE_GLYPHCACHE_CELLS, for the report */
+
+static const char default_chars[] =
+    " !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~"
+    "\xc3\xa1\xc3\xa9\xc3\xad\xc3\xb3\xc3\xba\xc3\xbc\xc3\xb1" /* áéíóúüñ */
+    "\xc3\x81\xc3\x89\xc3\x8d\xc3\x93\xc3\x9a\xc3\x9c\xc3\x91" /* ÁÉÍÓÚÜÑ */
+    "\xc2\xa1\xc2\xbf"; /* ¡¿ */
+
+typedef struct
+{
+    const char *name;
+    uint8_t eve_format;
+    uint8_t bits_per_pixel;
+} pack_format_t;
+
+static const pack_format_t formats[] =
+{
+    { "L1", EVE_L1, 1U },
+    { "L4", EVE_L4, 4U },
+    { "L8", EVE_L8, 8U },
+};
+
+#define NUM_FORMATS (sizeof(formats) / sizeof(formats[0]))
+
+typedef struct
+{
+    uint16_t code;
+    uint8_t advance;
+    int32_t left; /* position of the bitmap in the cell */
+    int32_t top;
+    uint32_t width;
+    uint32_t rows;
+    uint8_t *p_gray; /* width * rows, 0...255 */
+} pack_glyph_t;
+
+static uint8_t charset[MAX_GLYPHS / 8U]; /* one bit per code point of the BMP */
+
+/* ##################################################################
+    character set
+##################################################################### */
+
+static void add_utf8(const uint8_t *p_bytes, size_t len)
+{
+    size_t index = 0U;
+
+    while (index < len)
+    {
+        uint32_t code = p_bytes[index];
+        uint32_t follow = 0U;
+
+        index++;
+        if (code >= 0xf0U)
+        {
+            code &= 0x07U;
+            follow = 3U;
+        }
+        else if (code >= 0xe0U)
+        {
+            code &= 0x0fU;
+            follow = 2U;
+        }
+        else if (code >= 0xc0U)
+        {
+            code &= 0x1fU;
+            follow = 1U;
+        }
+        else if (code >= 0x80U)
+        {
+            continue; /* continuation byte without a start */
+        }
+
+        for (; (follow > 0U) && (index < len) && ((p_bytes[index] & 0xc0U) == 0x80U); follow--)
+        {
+            code = (code << 6U) | (p_bytes[index] & 0x3fU);
+            index++;
+        }
+
+        if ((0U == follow) && (code >= 0x20U) && (code < MAX_GLYPHS))
+        {
+            charset[code / 8U] |= (uint8_t) (1U << (code % 8U));
+        }
+    }
+}
+
+static int add_file(const char * const p_file)
+{
+    FILE *p_fp = fopen(p_file, "rb");
+    uint8_t *p_text = NULL;
+    long len = -1;
+
+    if ((p_fp != NULL) && (fseek(p_fp, 0L, SEEK_END) == 0))
+    {
+        len = ftell(p_fp);
+        rewind(p_fp);
+    }
+
+    if (len >= 0)
+    {
+        p_text = malloc((size_t) len + 1U);
+    }
+
+    if ((NULL == p_text) || (fread(p_text, 1U, (size_t) len, p_fp) != (size_t) len))
+    {
+        perror(p_file);
+        free(p_text);
+        if (p_fp != NULL)
+        {
+            fclose(p_fp);
+        }
+        return (-1);
+    }
+
+    add_utf8(p_text, (size_t) len);
+    free(p_text);
+    fclose(p_fp);
+    return (0);
+}
+
+/* ##################################################################
+    rendering
+##################################################################### */
+
+static int render(FT_Face face, const pack_format_t * const p_fmt, uint16_t const code, pack_glyph_t * const p_glyph)
+{
+    FT_Int32 const flags = (EVE_L1 == p_fmt->eve_format) ? (FT_LOAD_RENDER | FT_LOAD_TARGET_MONO) : FT_LOAD_RENDER;
+    FT_Bitmap const *p_bitmap;
+
+    if ((0U == FT_Get_Char_Index(face, code)) || (FT_Load_Char(face, code, flags) != 0))
+    {
+        return (-1);
+    }
+
+    p_bitmap = &face->glyph->bitmap;
+    p_glyph->code = code;
+    p_glyph->advance = (uint8_t) ((face->glyph->advance.x + 32) >> 6);
+    p_glyph->left = face->glyph->bitmap_left;
+    p_glyph->top = face->glyph->bitmap_top;
+    p_glyph->width = p_bitmap->width;
+    p_glyph->rows = p_bitmap->rows;
+    p_glyph->p_gray = calloc((p_bitmap->width * p_bitmap->rows) + 1U, 1U);
+    if (NULL == p_glyph->p_gray)
+    {
+        return (-1);
+    }
+
+    for (uint32_t row = 0U; row < p_bitmap->rows; row++)
+    {
+        const uint8_t *p_row = &p_bitmap->buffer[(int32_t) row * p_bitmap->pitch];
+
+        for (uint32_t col = 0U; col < p_bitmap->width; col++)
+        {
+            uint8_t value;
+
+            if (FT_PIXEL_MODE_MONO == p_bitmap->pixel_mode)
+            {
+                value = ((p_row[col / 8U] >> (7U - (col % 8U))) & 1U) ? 255U : 0U;
+            }
+            else
+            {
+                value = p_row[col];
+            }
+            p_glyph->p_gray[(row * p_bitmap->width) + col] = value;
+        }
+    }
+    return (0);
+}
+
+/* the left bearing is dropped when it is negative so that the cell starts at the advance origin */
+static void put_cell(const pack_glyph_t * const p_glyph, const pack_format_t * const p_fmt, int32_t const ascender,
+                     uint32_t const stride, uint32_t const height, uint8_t * const p_cell)
+{
+    int32_t const left = (p_glyph->left > 0) ? p_glyph->left : 0;
+    int32_t const top = ascender - p_glyph->top;
+
+    for (uint32_t row = 0U; row < p_glyph->rows; row++)
+    {
+        int32_t const ypos = top + (int32_t) row;
+
+        if ((ypos < 0) || (ypos >= (int32_t) height))
+        {
+            continue; /* clipped at the top or bottom of the cell */
+        }
+
+        for (uint32_t col = 0U; col < p_glyph->width; col++)
+        {
+            uint32_t const xpos = (uint32_t) left + col;
+            uint8_t const gray = p_glyph->p_gray[(row * p_glyph->width) + col];
+            uint8_t * const p_byte = &p_cell[((uint32_t) ypos * stride) + ((xpos * p_fmt->bits_per_pixel) / 8U)];
+
+            if (EVE_L1 == p_fmt->eve_format)
+            {
+                if (gray >= 128U)
+                {
+                    *p_byte |= (uint8_t) (0x80U >> (xpos % 8U));
+                }
+            }
+            else if (EVE_L4 == p_fmt->eve_format)
+            {
+                uint8_t const nibble = (uint8_t) ((gray + 8U) / 17U); /* 0...15 */
+
+                *p_byte |= ((xpos % 2U) == 0U) ? (uint8_t) (nibble << 4U) : nibble;
+            }
+            else
+            {
+                *p_byte = gray;
+            }
+        }
+    }
+}
+
+/* ##################################################################
+    output
+##################################################################### */
+
+static void write_bytes(FILE * const p_fp, const char * const p_name, const char * const p_suffix,
+                        const uint8_t * const p_data, uint32_t const len)
+{
+    fprintf(p_fp, "const uint8_t %s%s[%u] PROGMEM =\n{\n", p_name, p_suffix, len);
+    for (uint32_t index = 0U; index < len; index++)
+    {
+        if ((index % 24U) == 0U)
+        {
+            fprintf(p_fp, "    ");
+        }
+        fprintf(p_fp, "0x%x,", p_data[index]);
+        if (((index % 24U) == 23U) || ((index + 1U) == len))
+        {
+            fprintf(p_fp, "\n");
+        }
+        else
+        {
+            fprintf(p_fp, " ");
+        }
+    }
+    fprintf(p_fp, "};\n");
+}
+
+static void write_font(FILE * const p_fp, const char * const p_name, const char * const p_font_file,
+                       const pack_format_t * const p_fmt, uint32_t const pixels, const pack_glyph_t * const p_glyphs,
+                       uint32_t const count, uint32_t const width, uint32_t const height, const uint8_t * const p_cells,
+                       uint32_t const cell_bytes, int argc, char * const argv[])
+{
+    uint8_t *p_codes = malloc(count * 2U);
+    uint8_t *p_advance = malloc(count);
+    const char *p_base = strrchr(p_font_file, '/');
+
+    if ((NULL == p_codes) || (NULL == p_advance))
+    {
+        fprintf(stderr, "error: out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (uint32_t index = 0U; index < count; index++)
+    {
+        p_codes[index * 2U] = (uint8_t) (p_glyphs[index].code & 0xffU);
+        p_codes[(index * 2U) + 1U] = (uint8_t) (p_glyphs[index].code >> 8U);
+        p_advance[index] = p_glyphs[index].advance;
+    }
+
+    fprintf(p_fp, "/* %u glyphs of %s at %u pixels, %ux%u pixel cells in %s format with %u bytes each,"
+            " generated with eve_glyph_pack */\n\n",
+            count, (p_base != NULL) ? (p_base + 1) : p_font_file, pixels, width, height, p_fmt->name, cell_bytes);
+    fprintf(p_fp, "/* eve_glyph_pack");
+    for (int arg = 1; arg < argc; arg++)
+    {
+        fprintf(p_fp, (strchr(argv[arg], ' ') != NULL) ? " \"%s\"" : " %s", argv[arg]);
+    }
+    fprintf(p_fp, " */\n\n#include \"EVE_glyphcache.h\"\n\n");
+    fprintf(p_fp, "#if defined (__AVR__)\n    #include <avr/pgmspace.h>\n#else\n"
+            "    #if !defined(PROGMEM)\n        #define PROGMEM\n    #endif\n#endif\n\n");
+    write_bytes(p_fp, p_name, "_codes", p_codes, count * 2U);
+    fprintf(p_fp, "\n");
+    write_bytes(p_fp, p_name, "_advance", p_advance, count);
+    fprintf(p_fp, "\n");
+    write_bytes(p_fp, p_name, "_cells", p_cells, count * cell_bytes);
+    fprintf(p_fp, "\n/* the arrays are read with fetch_flash_byte(), the struct itself is in RAM */\n");
+    fprintf(p_fp, "const EVE_glyph_font_t %s = {%s_codes, %s_advance, %s_cells, %uU, EVE_%s, %uU, %uU};\n",
+            p_name, p_name, p_name, p_name, count, p_fmt->name, width, height);
+
+    free(p_codes);
+    free(p_advance);
+}
+
+static const pack_format_t *find_format(const char * const p_name)
+{
+    for (uint32_t index = 0U; index < NUM_FORMATS; index++)
+    {
+        if (strcasecmp(p_name, formats[index].name) == 0)
+        {
+            return (&formats[index]);
+        }
+    }
+    return (NULL);
+}
+
+static void default_name(const char * const p_file, char * const p_name, size_t const size)
+{
+    const char *p_base = strrchr(p_file, '/');
+    size_t len = 0U;
+
+    p_base = (p_base != NULL) ? (p_base + 1) : p_file;
+    while ((p_base[len] != '\0') && (p_base[len] != '.') && (len < (size - 1U)))
+    {
+        char const chr = p_base[len];
+
+        p_name[len] = ((chr >= 'a') && (chr <= 'z')) || ((chr >= 'A') && (chr <= 'Z')) ||
+                      ((chr >= '0') && (chr <= '9') && (len > 0U)) ? chr : '_';
+        len++;
+    }
+    p_name[len] = '\0';
+}
+
+static void usage(const char * const p_prog)
+{
+    fprintf(stderr, "usage: %s [-p pixels] [-f L1|L4|L8] [-c chars] [-t file] [-n name] [-o file.c] font.ttf\n", p_prog);
+}
+
+int main(int argc, char *argv[])
+{
+    const pack_format_t *p_fmt = &formats[1];
+    const char *p_name = NULL;
+    const char *p_out_c = NULL;
+    uint32_t pixels = 20U;
+    uint8_t chars_given = 0U;
+    char name_buf[64];
+    FT_Library library;
+    FT_Face face;
+    pack_glyph_t *p_glyphs;
+    uint32_t count = 0U;
+    int32_t ascender;
+    uint32_t width = 1U;
+    uint32_t height;
+    uint32_t stride;
+    uint32_t cell_bytes;
+    uint8_t *p_cells;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "p:f:c:t:n:o:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 'p':
+                pixels = (uint32_t) strtoul(optarg, NULL, 10);
+                if ((pixels < 4U) || (pixels > 200U))
+                {
+                    fprintf(stderr, "error: size %s is out of range\n", optarg);
+                    return (EXIT_FAILURE);
+                }
+                break;
+            case 'f':
+                p_fmt = find_format(optarg);
+                if (NULL == p_fmt)
+                {
+                    fprintf(stderr, "error: unknown format %s\n", optarg);
+                    return (EXIT_FAILURE);
+                }
+                break;
+            case 'c':
+                add_utf8((const uint8_t *) optarg, strlen(optarg));
+                chars_given = 1U;
+                break;
+            case 't':
+                if (add_file(optarg) != 0)
+                {
+                    return (EXIT_FAILURE);
+                }
+                chars_given = 1U;
+                break;
+            case 'n': p_name = optarg; break;
+            case 'o': p_out_c = optarg; break;
+            default:
+                usage(argv[0]);
+                return (EXIT_FAILURE);
+        }
+    }
+
+    if (optind >= argc)
+    {
+        usage(argv[0]);
+        return (EXIT_FAILURE);
+    }
+
+    if (0U == chars_given)
+    {
+        add_utf8((const uint8_t *) default_chars, strlen(default_chars));
+    }
+    charset[0x20U / 8U] |= (uint8_t) (1U << (0x20U % 8U));
+
+    if ((FT_Init_FreeType(&library) != 0) || (FT_New_Face(library, argv[optind], 0, &face) != 0) ||
+        (FT_Set_Pixel_Sizes(face, 0, pixels) != 0))
+    {
+        fprintf(stderr, "error: can not open %s\n", argv[optind]);
+        return (EXIT_FAILURE);
+    }
+
+    if (NULL == p_name)
+    {
+        default_name(argv[optind], name_buf, sizeof(name_buf));
+        p_name = name_buf;
+    }
+
+    p_glyphs = calloc(MAX_GLYPHS, sizeof(pack_glyph_t));
+    if (NULL == p_glyphs)
+    {
+        fprintf(stderr, "error: out of memory\n");
+        return (EXIT_FAILURE);
+    }
+
+    /* ascending order, EVE_glyphcache searches the code points binary */
+    for (uint32_t code = 0x20U; code < MAX_GLYPHS; code++)
+    {
+        if ((charset[code / 8U] & (1U << (code % 8U))) != 0U)
+        {
+            if (render(face, p_fmt, (uint16_t) code, &p_glyphs[count]) != 0)
+            {
+                fprintf(stderr, "warning: U+%04X is not in the font\n", code);
+            }
+            else
+            {
+                uint32_t const left = (p_glyphs[count].left > 0) ? (uint32_t) p_glyphs[count].left : 0U;
+
+                if ((left + p_glyphs[count].width) > width)
+                {
+                    width = left + p_glyphs[count].width;
+                }
+                count++;
+            }
+        }
+    }
+
+    ascender = (int32_t) ((face->size->metrics.ascender + 63) >> 6);
+    height = (uint32_t) (ascender - (int32_t) (face->size->metrics.descender >> 6));
+    stride = ((width * p_fmt->bits_per_pixel) + 7U) / 8U;
+    cell_bytes = stride * height;
+
+    p_cells = calloc(count, cell_bytes);
+    if ((0U == count) || (NULL == p_cells) || (width > 511U) || (height > 511U))
+    {
+        fprintf(stderr, "error: no glyphs or the cells are too large\n");
+        return (EXIT_FAILURE);
+    }
+
+    for (uint32_t index = 0U; index < count; index++)
+    {
+        put_cell(&p_glyphs[index], p_fmt, ascender, stride, height, &p_cells[index * cell_bytes]);
+        free(p_glyphs[index].p_gray);
+    }
+
+    if (p_out_c != NULL)
+    {
+        FILE *p_fp = fopen(p_out_c, "w");
+
+        if (NULL == p_fp)
+        {
+            perror(p_out_c);
+            return (EXIT_FAILURE);
+        }
+        write_font(p_fp, p_name, argv[optind], p_fmt, pixels, p_glyphs, count, width, height, p_cells, cell_bytes, argc, argv);
+        fclose(p_fp);
+    }
+    else
+    {
+        write_font(stdout, p_name, argv[optind], p_fmt, pixels, p_glyphs, count, width, height, p_cells, cell_bytes, argc, argv);
+    }
+
+    /* the size report compares the cache to a font that is loaded to RAM_G in full */
+    fprintf(stderr, "%u glyphs, cell %ux%u %s, %u bytes per cell\n", count, width, height, p_fmt->name, cell_bytes);
+    fprintf(stderr, "host flash: %u bytes, full font in RAM_G: %u bytes, cache with %u cells: %u bytes\n",
+            (count * (cell_bytes + 3U)), count * cell_bytes, CACHE_CELLS, CACHE_CELLS * cell_bytes);
+    if (count <= CACHE_CELLS) /* the space has no cell */
+    {
+        fprintf(stderr, "note: all glyphs fit in %u cells, EVE_GLYPHCACHE_CELLS can be %uU\n", CACHE_CELLS, count - 1U);
+    }
+    fprintf(stderr, "extern const EVE_glyph_font_t %s;\n", p_name);
+
+    free(p_cells);
+    free(p_glyphs);
+    FT_Done_Face(face);
+    FT_Done_FreeType(library);
+    return (EXIT_SUCCESS);
+}
@@ -0,0 +1,341 @@
+/*
+@file    eve_size_report.c
+@brief   host tool, lists the flash used per function from a GNU ld map file
+@version 1.0
+@date    2026-10-18
+@author  Christian Lara
+
+@section info
+
+Reads the map file of a build and prints the size of every function that made it into the
+flash, biggest first, with the sums for the EVE_cmd_ functions and their _burst variants.
+This shows what EVE_CMD_NO_CONTROLS, EVE_CMD_NO_MEDIA and EVE_CMD_NO_MATRIX or dropping
+a function from the project would give back on the Nano.
+
+build:
+    cc -std=c99 -O2 -Wall -o eve_size_report eve_size_report.c
+
+map file from the Arduino IDE / arduino-cli for the Nano:
+    arduino-cli compile -b arduino:avr:nano --build-property "compiler.c.elf.extra_flags=-Wl,-Map,nano.map" ...
+
+usage:
+    eve_size_report [-p prefix] [-a] [-n count] file.map
+
+    -p prefix   only list functions that start with prefix, default is "EVE_"
+    -a          list all functions
+    -n count    only list the biggest count functions, the sums are always for all of them
+
+Works with and without -ffunction-sections, without the size of a function is the distance
+to the next symbol in the same input section. Sections in "Discarded input sections" are
+not in the flash and are not counted. With -flto the compiler may have inlined small
+functions into their callers, these are not listed then.
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Christian Lara
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+1.0
+- initial version
+
+*/
+
+#define _POSIX_C_SOURCE 200809L /* getopt() */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define LINE_MAX_LEN 1024U
+#define SYMBOLS_MAX 256U /* symbols in one input section */
+
+typedef struct
+{
+    char *name;
+    unsigned long size;
+} func_t;
+
+static func_t *funcs = NULL;
+static size_t funcs_count = 0U;
+static size_t funcs_alloc = 0U;
+
+/* the input section that is currently read */
+static unsigned long sect_start = 0UL;
+static unsigned long sect_size = 0UL;
+static int sect_text = 0; /* a .text section that is in the flash */
+static unsigned long sym_addr[SYMBOLS_MAX];
+static char *sym_name[SYMBOLS_MAX];
+static size_t sym_count = 0U;
+
+static void func_add(const char *name, unsigned long size)
+{
+    if (funcs_count == funcs_alloc)
+    {
+        funcs_alloc = (funcs_alloc != 0U) ? (funcs_alloc * 2U) : 256U;
+        funcs = realloc(funcs, funcs_alloc * sizeof(func_t));
+        if (NULL == funcs)
+        {
+            fprintf(stderr, "out of memory\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    funcs[funcs_count].name = strdup(name);
+    funcs[funcs_count].size = size;
+    funcs_count++;
+}
+
+/* the symbols of the last section are complete, their size is the distance to the next one */
+static void section_close(void)
+{
+    if ((sect_text != 0) && (sect_size != 0UL))
+    {
+        for (size_t index = 0U; index < sym_count; index++)
+        {
+            unsigned long const end = ((index + 1U) < sym_count) ? sym_addr[index + 1U] : (sect_start + sect_size);
+
+            func_add(sym_name[index], end - sym_addr[index]);
+        }
+    }
+    for (size_t index = 0U; index < sym_count; index++)
+    {
+        free(sym_name[index]);
+    }
+    sym_count = 0U;
+    sect_text = 0;
+}
+
+/* " .text.name 0xaddr 0xsize file" or " .text.name" with "0xaddr 0xsize file" on the next line */
+static int parse_addr_size(const char *p_text, unsigned long *p_addr, unsigned long *p_size)
+{
+    char *p_end;
+
+    *p_addr = strtoul(p_text, &p_end, 16);
+    if ((p_end == p_text) || (0 != strncmp(p_text + strspn(p_text, " "), "0x", 2U)))
+    {
+        return 0;
+    }
+    *p_size = strtoul(p_end, &p_end, 16);
+    return 1;
+}
+
+static int func_compare(const void *p_a, const void *p_b)
+{
+    const func_t *p_fa = p_a;
+    const func_t *p_fb = p_b;
+    int ret = 0;
+
+    if (p_fa->size != p_fb->size)
+    {
+        ret = (p_fa->size < p_fb->size) ? 1 : -1;
+    }
+    else
+    {
+        ret = strcmp(p_fa->name, p_fb->name);
+    }
+    return ret;
+}
+
+static int ends_with(const char *p_text, const char *p_end)
+{
+    size_t const len = strlen(p_text);
+    size_t const len_end = strlen(p_end);
+
+    return (len >= len_end) && (0 == strcmp(p_text + len - len_end, p_end));
+}
+
+static void read_map(FILE *p_file)
+{
+    char line[LINE_MAX_LEN];
+    char pending[LINE_MAX_LEN] = ""; /* section name that has its address on the next line */
+    int in_map = 0; /* after "Linker script and memory map", before that are the discarded sections */
+
+    while (NULL != fgets(line, (int) sizeof(line), p_file))
+    {
+        line[strcspn(line, "\r\n")] = 0;
+
+        if (0 == strncmp(line, "Linker script and memory map", 28U))
+        {
+            in_map = 1;
+            continue;
+        }
+        if (0 == in_map)
+        {
+            continue;
+        }
+
+        if ((' ' == line[0]) && ('.' == line[1])) /* an input section */
+        {
+            char name[LINE_MAX_LEN];
+            unsigned long addr;
+            unsigned long size;
+            char *p_rest;
+
+            section_close();
+            (void) sscanf(line + 1, "%1023s", name);
+            p_rest = line + 1 + strlen(name);
+            if (0 != parse_addr_size(p_rest, &addr, &size))
+            {
+                pending[0] = 0;
+                sect_start = addr;
+                sect_size = size;
+                sect_text = (0 == strncmp(name, ".text", 5U));
+            }
+            else
+            {
+                (void) snprintf(pending, sizeof(pending), "%s", name);
+            }
+        }
+        else if (pending[0] != 0) /* the address and size of a section with a long name */
+        {
+            unsigned long addr;
+            unsigned long size;
+
+            if (0 != parse_addr_size(line, &addr, &size))
+            {
+                sect_start = addr;
+                sect_size = size;
+                sect_text = (0 == strncmp(pending, ".text", 5U));
+            }
+            pending[0] = 0;
+        }
+        else if ((sect_text != 0) && (0 == strncmp(line, "                0x", 18U))) /* a symbol in the section */
+        {
+            unsigned long addr;
+            char name[LINE_MAX_LEN];
+
+            if ((2 == sscanf(line, " %lx %1023s", &addr, name)) && (NULL == strchr(line + 18, '=')) &&
+                (sym_count < SYMBOLS_MAX))
+            {
+                sym_addr[sym_count] = addr;
+                sym_name[sym_count] = strdup(name);
+                sym_count++;
+            }
+        }
+        else if ((line[0] != ' ') && (line[0] != 0)) /* an output section or the end of the map */
+        {
+            section_close();
+        }
+        else
+        {
+            /* fill, alignment, linker script lines */
+        }
+    }
+    section_close();
+}
+
+int main(int argc, char *argv[])
+{
+    const char *p_prefix = "EVE_";
+    unsigned long count_max = 0UL;
+    int opt;
+    FILE *p_file;
+    unsigned long total = 0UL;
+    unsigned long total_prefix = 0UL;
+    unsigned long cmd_plain = 0UL;
+    unsigned long cmd_burst = 0UL;
+    size_t cmd_plain_count = 0U;
+    size_t cmd_burst_count = 0U;
+    unsigned long listed = 0UL;
+
+    while (-1 != (opt = getopt(argc, argv, "p:an:")))
+    {
+        switch (opt)
+        {
+            case 'p':
+                p_prefix = optarg;
+                break;
+            case 'a':
+                p_prefix = "";
+                break;
+            case 'n':
+                count_max = strtoul(optarg, NULL, 10);
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-p prefix] [-a] [-n count] file.map\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if (optind >= argc)
+    {
+        fprintf(stderr, "usage: %s [-p prefix] [-a] [-n count] file.map\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    p_file = fopen(argv[optind], "r");
+    if (NULL == p_file)
+    {
+        perror(argv[optind]);
+        return EXIT_FAILURE;
+    }
+    read_map(p_file);
+    (void) fclose(p_file);
+
+    qsort(funcs, funcs_count, sizeof(func_t), func_compare);
+
+    printf("  bytes  function\n");
+    for (size_t index = 0U; index < funcs_count; index++)
+    {
+        total += funcs[index].size;
+        if (0 != strncmp(funcs[index].name, p_prefix, strlen(p_prefix)))
+        {
+            continue;
+        }
+        total_prefix += funcs[index].size;
+        if (0 == strncmp(funcs[index].name, "EVE_cmd_", 8U))
+        {
+            if (0 != ends_with(funcs[index].name, "_burst"))
+            {
+                cmd_burst += funcs[index].size;
+                cmd_burst_count++;
+            }
+            else
+            {
+                cmd_plain += funcs[index].size;
+                cmd_plain_count++;
+            }
+        }
+        if ((0UL == count_max) || (listed < count_max))
+        {
+            printf("%7lu  %s\n", funcs[index].size, funcs[index].name);
+            listed++;
+        }
+    }
+
+    printf("\n%7lu  all functions in .text\n", total);
+    if (p_prefix[0] != 0)
+    {
+        printf("%7lu  functions starting with %s\n", total_prefix, p_prefix);
+    }
+    printf("%7lu  EVE_cmd_ functions (%lu)\n", cmd_plain, (unsigned long) cmd_plain_count);
+    printf("%7lu  EVE_cmd_ _burst functions (%lu)\n", cmd_burst, (unsigned long) cmd_burst_count);
+
+    for (size_t index = 0U; index < funcs_count; index++)
+    {
+        free(funcs[index].name);
+    }
+    free(funcs);
+    return EXIT_SUCCESS;
+}